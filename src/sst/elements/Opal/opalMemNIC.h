@@ -94,6 +94,9 @@ public:
 
     virtual std::string findTargetDestination(MemHierarchy::Addr addr);
 
+    /* Destinations can also match the address masked to local memory, which the routing table does not know */
+    virtual bool routeByAddress(MemHierarchy::MemEventBase * ev) { return MemLinkBase::routeByAddress(ev); }
+
 protected:
     virtual MemHierarchy::MemNICBase::InitMemRtrEvent* createInitMemRtrEvent();
     virtual void processInitMemRtrEvent(MemHierarchy::MemNICBase::InitMemRtrEvent* ev);
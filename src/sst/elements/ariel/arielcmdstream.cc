@@ -0,0 +1,521 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "arielcmdstream.h"
+
+#include <string.h>
+
+#ifdef HAVE_LIBZ
+#include "zlib.h"
+#endif
+
+using namespace SST::ArielComponent;
+
+static void appendBytes(std::vector<uint8_t>& out, const void* src, const size_t length) {
+    const uint8_t* src_b = static_cast<const uint8_t*>(src);
+    out.insert(out.end(), src_b, src_b + length);
+}
+
+template<typename T>
+static void appendValue(std::vector<uint8_t>& out, const T value) {
+    appendBytes(out, &value, sizeof(T));
+}
+
+template<typename T>
+static bool extractValue(const std::vector<uint8_t>& in, size_t& position, T* value) {
+    if(position + sizeof(T) > in.size()) {
+        return false;
+    }
+
+    memcpy(value, &in[position], sizeof(T));
+    position += sizeof(T);
+    return true;
+}
+
+ArielCommandStreamWriter::ArielCommandStreamWriter() :
+    file(NULL), chunkBytes(0), keepPayloads(false), commandCount(0), storedBytes(0) {
+}
+
+ArielCommandStreamWriter::~ArielCommandStreamWriter() {
+    close();
+}
+
+bool ArielCommandStreamWriter::open(const std::string& path, const uint32_t coreCount,
+        const size_t chunkSize, const bool payloads) {
+
+    file = fopen(path.c_str(), "wb");
+
+    if(NULL == file) {
+        return false;
+    }
+
+    chunkBytes = (chunkSize < 4096) ? 4096 : chunkSize;
+    keepPayloads = payloads;
+    staging.resize(coreCount);
+    chunkOffsets.assign(coreCount, std::vector<uint64_t>());
+
+    for(uint32_t i = 0; i < coreCount; ++i) {
+        staging[i].reserve(chunkBytes + sizeof(ArielCommand) + 16);
+    }
+
+    ArielCommandStreamHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ARIEL_CMD_STREAM_MAGIC, sizeof(header.magic));
+    header.version = ARIEL_CMD_STREAM_VERSION;
+    header.coreCount = coreCount;
+    header.flags = keepPayloads ? ARIEL_CMD_STREAM_HAS_PAYLOADS : 0;
+
+    if(fwrite(&header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        file = NULL;
+        return false;
+    }
+
+    storedBytes = sizeof(header);
+    return true;
+}
+
+bool ArielCommandStreamWriter::record(const uint32_t core, const ArielCommand& ac) {
+    std::vector<uint8_t>& out = staging[core];
+
+    appendValue<uint8_t>(out, (uint8_t) ac.command);
+
+    switch(ac.command) {
+        case ARIEL_START_INSTRUCTION:
+            appendValue<uint64_t>(out, ac.instPtr);
+            appendValue<uint32_t>(out, ac.inst.instClass);
+            appendValue<uint32_t>(out, ac.inst.simdElemCount);
+            break;
+
+        case ARIEL_PERFORM_READ:
+            appendValue<uint64_t>(out, ac.inst.addr);
+            appendValue<uint32_t>(out, ac.inst.size);
+            break;
+
+        case ARIEL_PERFORM_WRITE:
+            appendValue<uint64_t>(out, ac.inst.addr);
+            appendValue<uint32_t>(out, ac.inst.size);
+
+            if(keepPayloads) {
+                const uint32_t payloadBytes = (ac.inst.size < ARIEL_MAX_PAYLOAD_SIZE) ?
+                    ac.inst.size : ARIEL_MAX_PAYLOAD_SIZE;
+                appendBytes(out, &ac.inst.payload[0], payloadBytes);
+            }
+            break;
+
+        case ARIEL_FLUSHLINE_INSTRUCTION:
+            appendValue<uint64_t>(out, ac.flushline.vaddr);
+            break;
+
+        case ARIEL_ISSUE_TLM_MMAP:
+            appendValue<uint64_t>(out, ac.instPtr);
+            appendValue<uint64_t>(out, ac.mlm_mmap.vaddr);
+            appendValue<uint64_t>(out, ac.mlm_mmap.alloc_len);
+            appendValue<uint32_t>(out, ac.mlm_mmap.alloc_level);
+            appendValue<uint32_t>(out, ac.mlm_mmap.fileID);
+            break;
+
+        case ARIEL_ISSUE_TLM_MAP:
+            appendValue<uint64_t>(out, ac.instPtr);
+            appendValue<uint64_t>(out, ac.mlm_map.vaddr);
+            appendValue<uint64_t>(out, ac.mlm_map.alloc_len);
+            appendValue<uint32_t>(out, ac.mlm_map.alloc_level);
+            break;
+
+        case ARIEL_ISSUE_TLM_FREE:
+            appendValue<uint64_t>(out, ac.mlm_free.vaddr);
+            break;
+
+        case ARIEL_SWITCH_POOL:
+            appendValue<uint32_t>(out, ac.switchPool.pool);
+            break;
+
+        case ARIEL_END_INSTRUCTION:
+        case ARIEL_NOOP:
+        case ARIEL_FENCE_INSTRUCTION:
+        case ARIEL_OUTPUT_STATS:
+        case ARIEL_PERFORM_EXIT:
+            break;
+
+        default:
+            // GPU commands carry host pointers and are not captured
+            out.pop_back();
+            return false;
+    }
+
+    commandCount++;
+
+    if(out.size() >= chunkBytes) {
+        return flushChunk(core);
+    }
+
+    return true;
+}
+
+bool ArielCommandStreamWriter::flushChunk(const uint32_t core) {
+    std::vector<uint8_t>& raw = staging[core];
+
+    if(raw.empty()) {
+        return true;
+    }
+
+    ArielCommandChunkHeader chunkHeader;
+    chunkHeader.core = core;
+    chunkHeader.compressed = 0;
+    chunkHeader.rawBytes = raw.size();
+    chunkHeader.storedBytes = raw.size();
+
+    const uint8_t* stored = &raw[0];
+
+#ifdef HAVE_LIBZ
+    uLongf compressedBytes = compressBound(raw.size());
+    compressBuffer.resize(compressedBytes);
+
+    // Favour speed, the streams are written while the application runs
+    if(Z_OK == compress2(&compressBuffer[0], &compressedBytes, &raw[0], raw.size(), 1) &&
+            compressedBytes < raw.size()) {
+        chunkHeader.compressed = 1;
+        chunkHeader.storedBytes = compressedBytes;
+        stored = &compressBuffer[0];
+    }
+#endif
+
+    raw.clear();
+    chunkOffsets[core].push_back(storedBytes);
+
+    if(fwrite(&chunkHeader, sizeof(chunkHeader), 1, file) != 1 ||
+            fwrite(stored, 1, chunkHeader.storedBytes, file) != chunkHeader.storedBytes) {
+        return false;
+    }
+
+    storedBytes += sizeof(chunkHeader) + chunkHeader.storedBytes;
+    return true;
+}
+
+void ArielCommandStreamWriter::close() {
+    if(NULL == file) {
+        return;
+    }
+
+    for(uint32_t i = 0; i < staging.size(); ++i) {
+        flushChunk(i);
+    }
+
+    std::vector<uint8_t> index;
+    for(uint32_t i = 0; i < chunkOffsets.size(); ++i) {
+        appendValue<uint64_t>(index, chunkOffsets[i].size());
+
+        for(uint64_t offset : chunkOffsets[i]) {
+            appendValue<uint64_t>(index, offset);
+        }
+    }
+
+    ArielCommandIndexTrailer trailer;
+    trailer.indexOffset = storedBytes;
+    trailer.indexBytes = index.size();
+    memcpy(trailer.magic, ARIEL_CMD_STREAM_INDEX_MAGIC, sizeof(trailer.magic));
+
+    if(fwrite(index.data(), 1, index.size(), file) == index.size() &&
+            fwrite(&trailer, sizeof(trailer), 1, file) == 1) {
+        storedBytes += index.size() + sizeof(trailer);
+    }
+
+    fclose(file);
+    file = NULL;
+}
+
+ArielCommandStreamReader::ArielCommandStreamReader() :
+    file(NULL), core(0), indexed(false), nextChunk(0), chunksEnd(0), position(0) {
+    memset(&header, 0, sizeof(header));
+}
+
+ArielCommandStreamReader::~ArielCommandStreamReader() {
+    close();
+}
+
+bool ArielCommandStreamReader::fail(const char* reason) {
+    error = reason;
+    return false;
+}
+
+bool ArielCommandStreamReader::open(const std::string& path, const uint32_t readCore) {
+    core = readCore;
+    file = fopen(path.c_str(), "rb");
+
+    if(NULL == file) {
+        return fail("unable to open the command stream");
+    }
+
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+            memcmp(header.magic, ARIEL_CMD_STREAM_MAGIC, sizeof(header.magic)) != 0) {
+        return fail("file is not an Ariel command stream");
+    }
+
+    if(header.version != ARIEL_CMD_STREAM_VERSION) {
+        return fail("unsupported command stream version");
+    }
+
+    if(core >= header.coreCount) {
+        return fail("command stream has no commands for this core");
+    }
+
+    if(!readIndex()) {
+        return false;
+    }
+
+    chunk.clear();
+    position = 0;
+    return true;
+}
+
+bool ArielCommandStreamReader::readIndex() {
+    indexed = false;
+    chunkOffsets.clear();
+    nextChunk = 0;
+
+    ArielCommandIndexTrailer trailer;
+
+    if(fseeko(file, 0, SEEK_END) != 0) {
+        return fail("unable to find the end of the command stream");
+    }
+
+    const off_t fileBytes = ftello(file);
+    chunksEnd = fileBytes;
+
+    // Without a trailer (the capture was not closed) the chunks are scanned
+    if(fileBytes < (off_t) (sizeof(header) + sizeof(trailer)) ||
+            fseeko(file, fileBytes - (off_t) sizeof(trailer), SEEK_SET) != 0 ||
+            fread(&trailer, sizeof(trailer), 1, file) != 1 ||
+            memcmp(trailer.magic, ARIEL_CMD_STREAM_INDEX_MAGIC, sizeof(trailer.magic)) != 0) {
+
+        if(fseeko(file, (off_t) sizeof(header), SEEK_SET) != 0) {
+            return fail("unable to rewind the command stream");
+        }
+
+        return true;
+    }
+
+    if(trailer.indexOffset < sizeof(header) ||
+            trailer.indexOffset + trailer.indexBytes + sizeof(trailer) != (uint64_t) fileBytes) {
+        return fail("command stream index does not match the file size");
+    }
+
+    chunksEnd = trailer.indexOffset;
+
+    std::vector<uint8_t> index(trailer.indexBytes);
+
+    if(fseeko(file, (off_t) trailer.indexOffset, SEEK_SET) != 0 ||
+            (trailer.indexBytes > 0 && fread(&index[0], 1, index.size(), file) != index.size())) {
+        return fail("unable to read the command stream index");
+    }
+
+    size_t indexPosition = 0;
+
+    for(uint32_t i = 0; i < header.coreCount; ++i) {
+        uint64_t count;
+
+        if(!extractValue<uint64_t>(index, indexPosition, &count) ||
+                count > (index.size() - indexPosition) / sizeof(uint64_t)) {
+            return fail("command stream index is truncated");
+        }
+
+        if(i != core) {
+            indexPosition += count * sizeof(uint64_t);
+            continue;
+        }
+
+        chunkOffsets.resize(count);
+
+        for(uint64_t j = 0; j < count; ++j) {
+            extractValue<uint64_t>(index, indexPosition, &chunkOffsets[j]);
+
+            if(chunkOffsets[j] < sizeof(header) || chunkOffsets[j] >= trailer.indexOffset) {
+                return fail("command stream index points outside the chunks");
+            }
+        }
+    }
+
+    indexed = true;
+    return true;
+}
+
+void ArielCommandStreamReader::close() {
+    if(NULL != file) {
+        fclose(file);
+        file = NULL;
+    }
+}
+
+bool ArielCommandStreamReader::loadChunk() {
+    ArielCommandChunkHeader chunkHeader;
+
+    if(indexed) {
+        if(nextChunk == chunkOffsets.size()) {
+            // End of the stream
+            return false;
+        }
+
+        if(fseeko(file, (off_t) chunkOffsets[nextChunk++], SEEK_SET) != 0 ||
+                fread(&chunkHeader, sizeof(chunkHeader), 1, file) != 1) {
+            return fail("command stream is truncated");
+        }
+
+        if(chunkHeader.core != core) {
+            return fail("command stream index points at a chunk of another core");
+        }
+    } else {
+        while(true) {
+            if(fread(&chunkHeader, sizeof(chunkHeader), 1, file) != 1) {
+                // End of the stream
+                return false;
+            }
+
+            if(chunkHeader.core == core) {
+                break;
+            }
+
+            if(fseeko(file, (off_t) chunkHeader.storedBytes, SEEK_CUR) != 0) {
+                return fail("unable to skip a chunk in the command stream");
+            }
+        }
+    }
+
+    // Check the sizes before allocating for them, zlib cannot expand data
+    // by more than about 1000 times
+    if((uint64_t) ftello(file) + chunkHeader.storedBytes > chunksEnd) {
+        return fail("command stream is truncated");
+    }
+
+    if(chunkHeader.compressed ? (chunkHeader.rawBytes / 1032 > chunkHeader.storedBytes) :
+            (chunkHeader.rawBytes != chunkHeader.storedBytes)) {
+        return fail("command stream chunk header is corrupt");
+    }
+
+    storedBuffer.resize(chunkHeader.storedBytes);
+
+    if(chunkHeader.storedBytes > 0 &&
+            fread(&storedBuffer[0], 1, chunkHeader.storedBytes, file) != chunkHeader.storedBytes) {
+        return fail("command stream is truncated");
+    }
+
+    if(chunkHeader.compressed) {
+#ifdef HAVE_LIBZ
+        uLongf rawBytes = chunkHeader.rawBytes;
+        chunk.resize(rawBytes);
+
+        if(Z_OK != uncompress(&chunk[0], &rawBytes, &storedBuffer[0], storedBuffer.size()) ||
+                rawBytes != chunkHeader.rawBytes) {
+            return fail("unable to decompress a command stream chunk");
+        }
+#else
+        return fail("command stream is compressed but Ariel was built without libz");
+#endif
+    } else {
+        chunk.swap(storedBuffer);
+    }
+
+    position = 0;
+    return true;
+}
+
+bool ArielCommandStreamReader::next(ArielCommand* ac) {
+    if(position >= chunk.size()) {
+        if(!loadChunk()) {
+            return false;
+        }
+    }
+
+    uint8_t command;
+    bool complete = extractValue<uint8_t>(chunk, position, &command);
+
+    ac->command = (ArielShmemCmd_t) command;
+
+    switch(ac->command) {
+        case ARIEL_START_INSTRUCTION:
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->instPtr);
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->inst.instClass);
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->inst.simdElemCount);
+            break;
+
+        case ARIEL_PERFORM_READ:
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->inst.addr);
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->inst.size);
+            break;
+
+        case ARIEL_PERFORM_WRITE:
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->inst.addr);
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->inst.size);
+
+            if(complete && (header.flags & ARIEL_CMD_STREAM_HAS_PAYLOADS)) {
+                const uint32_t payloadBytes = (ac->inst.size < ARIEL_MAX_PAYLOAD_SIZE) ?
+                    ac->inst.size : ARIEL_MAX_PAYLOAD_SIZE;
+
+                complete = (position + payloadBytes) <= chunk.size();
+
+                if(complete) {
+                    memcpy(&ac->inst.payload[0], &chunk[position], payloadBytes);
+                    position += payloadBytes;
+                }
+            } else {
+                memset(&ac->inst.payload[0], 0, ARIEL_MAX_PAYLOAD_SIZE);
+            }
+            break;
+
+        case ARIEL_FLUSHLINE_INSTRUCTION:
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->flushline.vaddr);
+            break;
+
+        case ARIEL_ISSUE_TLM_MMAP:
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->instPtr);
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->mlm_mmap.vaddr);
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->mlm_mmap.alloc_len);
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->mlm_mmap.alloc_level);
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->mlm_mmap.fileID);
+            break;
+
+        case ARIEL_ISSUE_TLM_MAP:
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->instPtr);
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->mlm_map.vaddr);
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->mlm_map.alloc_len);
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->mlm_map.alloc_level);
+            break;
+
+        case ARIEL_ISSUE_TLM_FREE:
+            complete = complete && extractValue<uint64_t>(chunk, position, &ac->mlm_free.vaddr);
+            break;
+
+        case ARIEL_SWITCH_POOL:
+            complete = complete && extractValue<uint32_t>(chunk, position, &ac->switchPool.pool);
+            break;
+
+        case ARIEL_END_INSTRUCTION:
+        case ARIEL_NOOP:
+        case ARIEL_FENCE_INSTRUCTION:
+        case ARIEL_OUTPUT_STATS:
+        case ARIEL_PERFORM_EXIT:
+            break;
+
+        default:
+            return fail("unknown command in the command stream");
+    }
+
+    if(!complete) {
+        return fail("command stream chunk ends inside a command");
+    }
+
+    return true;
+}
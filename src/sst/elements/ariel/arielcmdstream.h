@@ -0,0 +1,164 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_COMMAND_STREAM
+#define _H_SST_ARIEL_COMMAND_STREAM
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Captured ArielCommand streams.
+ *
+ * A command stream file holds the commands each core read from the tunnel
+ * so that they can be replayed later without running the traced
+ * application. The file starts with a header naming the core count and is
+ * followed by chunks, each holding the commands of a single core. Chunks
+ * of different cores are interleaved in the order they filled up, so a
+ * reader for one core skips over the chunks of the others. Each chunk is
+ * compressed with zlib when Ariel is built with libz (chunks which do not
+ * shrink are stored as they are).
+ *
+ * Inside a chunk every command is a one byte command code followed only by
+ * the fields that command uses, in host byte order. Write payloads are
+ * kept only when requested as they are rarely used and do not compress.
+ *
+ * Closing the writer appends an index giving the file offset of every
+ * chunk of each core, followed by a trailer locating the index, so a
+ * reader seeks straight to its own chunks. A capture that was never
+ * closed has no index and is read by skipping over the other cores'
+ * chunks instead.
+ */
+
+#define ARIEL_CMD_STREAM_MAGIC   "ARIELCMD"
+#define ARIEL_CMD_STREAM_VERSION 1
+
+struct ArielCommandStreamHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t coreCount;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+#define ARIEL_CMD_STREAM_HAS_PAYLOADS 1
+
+struct ArielCommandChunkHeader {
+    uint32_t core;
+    uint32_t compressed;
+    uint64_t rawBytes;
+    uint64_t storedBytes;
+};
+
+#define ARIEL_CMD_STREAM_INDEX_MAGIC "ARIELIDX"
+
+// The index is, for each core in turn, a uint64_t chunk count followed by
+// that many uint64_t chunk offsets
+struct ArielCommandIndexTrailer {
+    uint64_t indexOffset;
+    uint64_t indexBytes;
+    char magic[8];
+};
+
+class ArielCommandStreamWriter {
+
+    public:
+        ArielCommandStreamWriter();
+        ~ArielCommandStreamWriter();
+
+        // Returns false if the file could not be created
+        bool open(const std::string& path, const uint32_t coreCount,
+                const size_t chunkBytes, const bool keepPayloads);
+
+        // Returns false if the command cannot be captured (GPU commands) or
+        // the file could not be written
+        bool record(const uint32_t core, const ArielCommand& ac);
+
+        // Writes out the remaining partial chunks and the chunk index and
+        // closes the file
+        void close();
+
+        bool isOpen() const { return NULL != file; }
+        uint64_t getCommandCount() const { return commandCount; }
+        uint64_t getStoredBytes() const { return storedBytes; }
+
+    private:
+        bool flushChunk(const uint32_t core);
+
+        FILE* file;
+        size_t chunkBytes;
+        bool keepPayloads;
+        uint64_t commandCount;
+        uint64_t storedBytes;
+
+        std::vector< std::vector<uint8_t> > staging;
+        std::vector< std::vector<uint64_t> > chunkOffsets;
+        std::vector<uint8_t> compressBuffer;
+};
+
+class ArielCommandStreamReader {
+
+    public:
+        ArielCommandStreamReader();
+        ~ArielCommandStreamReader();
+
+        // Opens the file and reads the header, the reader only returns the
+        // commands of the given core. Returns false (with the reason in
+        // getError()) if the file is not a command stream.
+        bool open(const std::string& path, const uint32_t core);
+
+        // Decodes the next command for the core, returns false at the end
+        // of the stream or on error (getError() is empty at the end)
+        bool next(ArielCommand* ac);
+
+        void close();
+
+        uint32_t getCoreCount() const { return header.coreCount; }
+        bool isIndexed() const { return indexed; }
+        const std::string& getError() const { return error; }
+
+    private:
+        bool readIndex();
+        bool loadChunk();
+        bool fail(const char* reason);
+
+        FILE* file;
+        uint32_t core;
+        ArielCommandStreamHeader header;
+        std::string error;
+
+        bool indexed;
+        std::vector<uint64_t> chunkOffsets;
+        size_t nextChunk;
+        uint64_t chunksEnd;
+
+        std::vector<uint8_t> chunk;
+        std::vector<uint8_t> storedBuffer;
+        size_t position;
+};
+
+}
+}
+
+#endif
@@ -55,7 +55,8 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     memmgr = memMgr;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
+    // Room for a full queue plus the accesses of the instruction which filled it
+    coreQ = new ArielEventRing(maxQLen + 16);
     pendingTransactions = new std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>();
     pending_transaction_count = 0;
 
@@ -84,6 +85,7 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     statFlushRequests = registerStatistic<uint64_t>( "flush_requests", subID);
     statFenceRequests = registerStatistic<uint64_t>( "fence_requests", subID);
     statNoopCount     = registerStatistic<uint64_t>( "no_ops", subID );
+    statRefillBatchSize = registerStatistic<uint64_t>( "refill_batch_size", subID );
     statInstructionCount = registerStatistic<uint64_t>( "instruction_count", subID );
     statCycles = registerStatistic<uint64_t>( "cycles", subID );
     statActiveCycles = registerStatistic<uint64_t>( "active_cycles", subID );
@@ -121,6 +123,7 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
         traceGen->setCoreID(coreID);
     }
 
+    cmdRecorder = NULL;
     currentCycles = 0;
 }
 
@@ -134,6 +137,7 @@ ArielCore::~ArielCore() {
     }
 
     delete stdMemHandlers;
+    delete coreQ;
 }
 
 void ArielCore::setCacheLink(StandardMem* newLink) {
@@ -354,9 +358,7 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                         output->verbose(CALL_INFO, 16, 0, "\n");
                     }
 
-                    ArielWriteEvent* awe;
-                    awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                    handleWriteRequest(awe);
+                    handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                     setCurrentAddress(getCurrentAddress() + current_transfer);
                     setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                 }
@@ -453,17 +455,15 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                 // Still data left to read
                 pendingGpuTransactions->erase(pendingGpuTransactions->find(mev_id));
                 pending_transaction_count--;
-                ArielReadEvent *are;
                 while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
                     if(getRemainingTransfer() <= 64) {
-                        are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                        handleReadRequest(getCurrentAddress(), getRemainingTransfer());
                         setRemainingTransfer(0);
                     }else {
-                        are = new ArielReadEvent(getCurrentAddress(), 64);
+                        handleReadRequest(getCurrentAddress(), 64);
                         setRemainingTransfer(getRemainingTransfer()-64);
                         setCurrentAddress(getCurrentAddress() + 64);
                     }
-                    handleReadRequest(are);
                 }
             }
         }
@@ -648,79 +648,90 @@ void ArielCore::unfence()
 }
 
 
-void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
-    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, aSPE->getPool()));
-    memmgr->setDefaultPool(aSPE->getPool());
+void ArielCore::handleSwitchPoolEvent(const uint32_t pool) {
+    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, pool));
+    memmgr->setDefaultPool(pool);
 }
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
-    ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(SWITCH_POOL);
+    ev.switchPool.pool = newPool;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
 void ArielCore::createNoOpEvent() {
-    ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    coreQ->push(NOOP);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(READ_ADDRESS);
+    ev.access.address = address;
+    ev.access.length = length;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(MALLOC);
+    ev.alloc.vaddr = vAddr;
+    ev.alloc.length = length;
+    ev.alloc.level = level;
+    ev.alloc.instPtr = instPtr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(MMAP);
+    ev.alloc.vaddr = vAddr;
+    ev.alloc.length = length;
+    ev.alloc.level = level;
+    ev.alloc.instPtr = instPtr;
+    ev.alloc.fileID = fileID;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
-    ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(FREE);
+    ev.line.vaddr = vAddr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(WRITE_ADDRESS);
+    ev.access.address = address;
+    ev.access.length = length;
+
+    // The payload is only looked at when payloads are traced
+    if( writePayloads ) {
+        memcpy(ev.payload, payload, std::min(length, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE));
+    }
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
-    ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(FLUSH);
+    ev.line.vaddr = vAddr;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
-    ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    coreQ->push(FENCE);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
-    ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    coreQ->push(CORE_EXIT);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
@@ -735,8 +746,8 @@ bool ArielCore::isCoreStalled() const {
 
 #ifdef HAVE_CUDA
 void ArielCore::createGpuEvent(GpuApi_t API, CudaArguments CA) {
-    ArielGpuEvent* gEv = new ArielGpuEvent(API, CA);
-    coreQ->push(gEv);
+    ArielQueuedEvent& ev = coreQ->push(GPU);
+    ev.gpu = new ArielGpuEvent(API, CA);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
 }
@@ -814,6 +825,12 @@ bool ArielCore::hasDrainCompleted() const {
 bool ArielCore::refillQueue() {
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 "...\n", coreID));
 
+    // Keep reading until the tunnel is empty or the queue is full. Each
+    // command is still a separate readMessageNB(), which takes the tunnel
+    // buffer's lock, as the sst-core tunnel has no batched read. The count
+    // only reports how far ahead of the core the frontend is running.
+    uint64_t batchSize = 0;
+
     while(coreQ->size() < maxQLength) {
         ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Attempting to fill events for core: %" PRIu32 " current queue size=%" PRIu32 ", max length=%" PRIu32 "\n",
                             coreID, (uint32_t) coreQ->size(), (uint32_t) maxQLength));
@@ -823,11 +840,21 @@ bool ArielCore::refillQueue() {
 
         if ( !avail ) {
                 ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel claims no data on core: %" PRIu32 "\n", coreID));
+
+                if(batchSize > 0) {
+                    statRefillBatchSize->addData(batchSize);
+                }
                 return false;
         }
 
+        batchSize++;
+
         ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel reads data on core: %" PRIu32 "\n", coreID));
 
+        if(NULL != cmdRecorder) {
+            recordCommand(ac);
+        }
+
         // There is data on the pipe
         switch(ac.command) {
             case ARIEL_OUTPUT_STATS:
@@ -862,6 +889,11 @@ bool ArielCore::refillQueue() {
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
                         ac = tunnel->readMessage(coreID);
+                        batchSize++;
+
+                        if(NULL != cmdRecorder) {
+                            recordCommand(ac);
+                        }
 
                         switch(ac.command) {
                             case ARIEL_PERFORM_READ:
@@ -931,20 +963,26 @@ bool ArielCore::refillQueue() {
     }
 
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 " is complete\n", coreID));
+    statRefillBatchSize->addData(batchSize);
     return true;
 }
 
-void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
+void ArielCore::recordCommand(const ArielCommand& ac) {
+    if(!cmdRecorder->record(coreID, ac)) {
+        output->fatal(CALL_INFO, -1, "Error: core %" PRIu32 " was unable to record command (%d) to the command stream.\n", coreID, (int)(ac.command));
+    }
+}
 
-    memmgr->freeMalloc(rFE->getVirtualAddress());
+void ArielCore::handleFreeEvent(const uint64_t vAddr) {
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, vAddr));
+
+    memmgr->freeMalloc(vAddr);
 }
 
-void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
+void ArielCore::handleReadRequest(const uint64_t readAddress, const uint32_t length) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a read event...\n", coreID));
 
-    const uint64_t readAddress = rEv->getAddress();
-    const uint64_t readLength  = std::min((uint64_t) rEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t readLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     /* No longer neccessary due to trimming above
      * if(readLength > cacheLineSize) {
@@ -1014,11 +1052,10 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     statReadRequestSizes->addData(readLength);
 }
 
-void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
+void ArielCore::handleWriteRequest(const uint64_t writeAddress, const uint32_t length, const uint8_t* payload) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a write event...\n", coreID));
 
-    const uint64_t writeAddress = wEv->getAddress();
-    const uint64_t writeLength  = std::min((uint64_t) wEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t writeLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     // No longer neccessary due to trimming above
 /*    if(writeLength > cacheLineSize) {
@@ -1048,8 +1085,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
                             coreID, writeAddress, writeLength, physAddr));
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr);
+            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payload);
         } else {
             commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL);
         }
@@ -1088,9 +1124,8 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         }
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr);
-            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize]);
+            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payload);
+            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payload[leftSize]);
         } else {
             commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, NULL);
             commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, NULL);
@@ -1104,27 +1139,24 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
 
 
 
-void ArielCore::handleMmapEvent(ArielMmapEvent* aEv) {
-    memmgr->allocateMMAP(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(),
-            aEv->getInstructionPointer(), aEv->getFileID(), coreID);
+void ArielCore::handleMmapEvent(const ArielQueuedEvent& aEv) {
+    memmgr->allocateMMAP(aEv.alloc.length, aEv.alloc.level, aEv.alloc.vaddr,
+            aEv.alloc.instPtr, aEv.alloc.fileID, coreID);
 }
 
-void ArielCore::handleAllocationEvent(ArielAllocateEvent* aEv) {
+void ArielCore::handleAllocationEvent(const ArielQueuedEvent& aEv) {
     output->verbose(CALL_INFO, 2, 0, "Handling a memory allocation event, vAddr=%" PRIu64 ", length=%" PRIu64 ", at level=%" PRIu32 " with malloc ID=%" PRIu64 "\n",
-                aEv->getVirtualAddress(), aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getInstructionPointer());
+                aEv.alloc.vaddr, aEv.alloc.length, aEv.alloc.level, aEv.alloc.instPtr);
 
-    memmgr->allocateMalloc(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(), aEv->getInstructionPointer(), coreID);
+    memmgr->allocateMalloc(aEv.alloc.length, aEv.alloc.level, aEv.alloc.vaddr, aEv.alloc.instPtr, coreID);
 }
 
-void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
-    const uint64_t virtualAddress = (uint64_t) flEv->getVirtualAddress();
-    const uint64_t readLength = (uint64_t) flEv->getLength();
-
+void ArielCore::handleFlushEvent(const uint64_t virtualAddress) {
     const uint64_t physAddr = memmgr->translateAddress(virtualAddress);
-    commitFlushEvent(physAddr, virtualAddress, (uint32_t) readLength);
+    commitFlushEvent(physAddr, virtualAddress, (uint32_t) cacheLineSize);
 }
 
-void ArielCore::handleFenceEvent(ArielFenceEvent *fEv) {
+void ArielCore::handleFenceEvent() {
     /*  Todo: Should we treat this like the Flush event, and require that the Fence
     *  be put into a transaction queue?  */
     // Possibility A:
@@ -1196,9 +1228,7 @@ void ArielCore::handleGpuEvent(ArielGpuEvent* gEv){
                                 output->verbose(CALL_INFO, 16, 0, "\n");
                             }
 
-                            ArielWriteEvent* awe;
-                            awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                            handleWriteRequest(awe);
+                            handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                             setCurrentAddress(getCurrentAddress() + current_transfer);
                             setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                         }
@@ -1299,17 +1329,15 @@ void ArielCore::handleGpuAckEvent(SST::Event* e){
     if (ev->getType() == BalarComponent::EventType::RESPONSE){
         if((ev->API == GPU_MEMCPY_RET)&&(ev->CA.cuda_memcpy.kind == cudaMemcpyDeviceToHost)){
             // Device to Host still needs us to get the data for fesimple
-            ArielReadEvent *are;
             while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
                 if(getRemainingTransfer() <= 64) {
-                    are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                    handleReadRequest(getCurrentAddress(), getRemainingTransfer());
                     setRemainingTransfer(0);
                 }else {
-                    are = new ArielReadEvent(getCurrentAddress(), 64);
+                    handleReadRequest(getCurrentAddress(), 64);
                     setRemainingTransfer(getRemainingTransfer()-64);
                     setCurrentAddress(getCurrentAddress() + 64);
                 }
-                handleReadRequest(are);
             }
         } else {
             output->verbose(CALL_INFO, 16, 0, "CUDA: Ariel recieved ACK\n");
@@ -1360,10 +1388,10 @@ bool ArielCore::processNextEvent() {
 
     ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Processing next event in core %" PRIu32 "...\n", coreID));
 
-    ArielEvent* nextEvent = coreQ->front();
+    ArielQueuedEvent& nextEvent = coreQ->front();
     bool removeEvent = false;
 
-    switch(nextEvent->getEventType()) {
+    switch(nextEvent.type) {
         case NOOP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is NOOP\n", coreID));
                 statInstructionCount->addData(1);
@@ -1381,7 +1409,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    handleReadRequest(nextEvent.access.address, nextEvent.access.length);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1397,7 +1425,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                             removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    handleWriteRequest(nextEvent.access.address, nextEvent.access.length, nextEvent.payload);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1417,25 +1445,25 @@ bool ArielCore::processNextEvent() {
         case SWITCH_POOL:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a SWITCH_POOL\n", coreID));
                 removeEvent = true;
-                handleSwitchPoolEvent(dynamic_cast<ArielSwitchPoolEvent*>(nextEvent));
+                handleSwitchPoolEvent(nextEvent.switchPool.pool);
                 break;
 
         case FREE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is FREE\n", coreID));
                 removeEvent = true;
-                handleFreeEvent(dynamic_cast<ArielFreeEvent*>(nextEvent));
+                handleFreeEvent(nextEvent.line.vaddr);
                 break;
 
         case MALLOC:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MALLOC\n", coreID));
                 removeEvent = true;
-                handleAllocationEvent(dynamic_cast<ArielAllocateEvent*>(nextEvent));
+                handleAllocationEvent(nextEvent);
                 break;
 
         case MMAP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MMAP\n", coreID));
                 removeEvent = true;
-                handleMmapEvent(dynamic_cast<ArielMmapEvent*>(nextEvent));
+                handleMmapEvent(nextEvent);
                 break;
 
         case CORE_EXIT:
@@ -1451,7 +1479,7 @@ bool ArielCore::processNextEvent() {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a FLUSH event, fewer pending transactions than permitted so will process..\n"));
                     statInstructionCount->addData(1);
                     inst_count++;
-                    handleFlushEvent(dynamic_cast<ArielFlushEvent*>(nextEvent));
+                    handleFlushEvent(nextEvent.line.vaddr);
                     removeEvent = true;
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ",core will stall for new events\n", coreID));
@@ -1461,7 +1489,7 @@ bool ArielCore::processNextEvent() {
         case FENCE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FENCE\n", coreID));
                 if(!isCoreFenced()) {// If core is fenced, drop this fence - they can be merged
-                    handleFenceEvent(dynamic_cast<ArielFenceEvent*>(nextEvent));
+                    handleFenceEvent();
                 }
                 removeEvent = true;
                 break;
@@ -1471,7 +1499,8 @@ bool ArielCore::processNextEvent() {
             removeEvent = true;
             stall();
             gpu();
-            handleGpuEvent(dynamic_cast<ArielGpuEvent*>(nextEvent));
+            handleGpuEvent(nextEvent.gpu);
+            delete nextEvent.gpu;
             break;
 #endif
         default:
@@ -1484,8 +1513,6 @@ bool ArielCore::processNextEvent() {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Removing event from pending queue, there are %" PRIu32 " events in the queue before deletion.\n",
                             (uint32_t) coreQ->size()));
         coreQ->pop();
-
-        delete nextEvent;
         return true;
     } else {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Event removal was not requested, pending transaction queue length=%" PRIu32 ", maximum transactions: %" PRIu32 "\n",
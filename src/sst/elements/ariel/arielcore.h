@@ -29,6 +29,7 @@
 #include <sst/core/timeLord.h>
 
 #include <stdio.h>
+#include <string.h>
 #include <stdint.h>
 #include <poll.h>
 
@@ -37,23 +38,11 @@
 #include <unordered_map>
 
 #include "arielmemmgr.h"
-#include "arielevent.h"
-#include "arielreadev.h"
-#include "arielwriteev.h"
-#include "arielexitev.h"
-#include "arielallocev.h"
-#include "arielfreeev.h"
-#include "arielnoop.h"
-#include "arielflushev.h"
-#include "arielfenceev.h"
-#include "arielswitchpool.h"
+#include "arieleventring.h"
 
 #include "ariel_shmem.h"
 #include "arieltracegen.h"
-
-#ifdef HAVE_CUDA
-#include "arielgpuev.h"
-#endif
+#include "arielcmdstream.h"
 
 using namespace SST;
 using namespace SST::Interfaces;
@@ -144,14 +133,14 @@ class ArielCore : public ComponentExtension {
 #endif
 
         void handleEvent(StandardMem::Request* event);
-        void handleReadRequest(ArielReadEvent* wEv);
-        void handleWriteRequest(ArielWriteEvent* wEv);
-        void handleAllocationEvent(ArielAllocateEvent* aEv);
-        void handleMmapEvent(ArielMmapEvent* aEv);
-        void handleFreeEvent(ArielFreeEvent* aFE);
-        void handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE);
-        void handleFlushEvent(ArielFlushEvent *flEv);
-        void handleFenceEvent(ArielFenceEvent *fEv);
+        void handleReadRequest(const uint64_t readAddress, const uint32_t length);
+        void handleWriteRequest(const uint64_t writeAddress, const uint32_t length, const uint8_t* payload);
+        void handleAllocationEvent(const ArielQueuedEvent& aEv);
+        void handleMmapEvent(const ArielQueuedEvent& aEv);
+        void handleFreeEvent(const uint64_t vAddr);
+        void handleSwitchPoolEvent(const uint32_t pool);
+        void handleFlushEvent(const uint64_t vAddr);
+        void handleFenceEvent();
 
 #ifdef HAVE_CUDA
         void handleGpuEvent(ArielGpuEvent* gEv);
@@ -183,12 +172,16 @@ class ArielCore : public ComponentExtension {
         // Setting the max number of instructions to be simulated
         void setMaxInsts(uint64_t i){max_insts=i;}
 
+        // Capture every command read from the tunnel into a command stream
+        void setCommandRecorder(ArielCommandStreamWriter* recorder) { cmdRecorder = recorder; }
+
         void printCoreStatistics();
         void printTraceEntry(const bool isRead, const uint64_t address, const uint32_t length);
 
     private:
         bool processNextEvent();
         bool refillQueue();
+        void recordCommand(const ArielCommand& ac);
 
         bool writePayloads;
         uint32_t coreID;
@@ -213,7 +206,7 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielEventRing* coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
@@ -248,6 +241,7 @@ class ArielCore : public ComponentExtension {
         uint64_t max_insts;
 
         ArielTraceGenerator* traceGen;
+        ArielCommandStreamWriter* cmdRecorder;
 
         Statistic<uint64_t>* statReadRequests;
         Statistic<uint64_t>* statWriteRequests;
@@ -258,6 +252,7 @@ class ArielCore : public ComponentExtension {
         Statistic<uint64_t>* statSplitReadRequests;
         Statistic<uint64_t>* statSplitWriteRequests;
         Statistic<uint64_t>* statNoopCount;
+        Statistic<uint64_t>* statRefillBatchSize;
         Statistic<uint64_t>* statInstructionCount;
         Statistic<uint64_t>* statCycles;
         Statistic<uint64_t>* statActiveCycles;
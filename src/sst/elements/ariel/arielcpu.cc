@@ -190,6 +190,26 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
         cpu_cores[i]->setMaxInsts(max_insts);
     }
 
+    cmdRecorder = NULL;
+    std::string cmd_stream = params.find<std::string>("commandstream", "");
+
+    if("" != cmd_stream) {
+        const uint64_t chunk_size = params.find<uint64_t>("commandstreamchunk", 1048576);
+        const bool keep_payloads = params.find<int>("writepayloadtrace", 0) != 0;
+
+        cmdRecorder = new ArielCommandStreamWriter();
+
+        if(!cmdRecorder->open(cmd_stream, core_count, (size_t) chunk_size, keep_payloads)) {
+            output->fatal(CALL_INFO, -1, "%s, Error: unable to create command stream file: %s\n", getName().c_str(), cmd_stream.c_str());
+        }
+
+        output->verbose(CALL_INFO, 1, 0, "Recording the command stream of every core to %s\n", cmd_stream.c_str());
+
+        for(uint32_t i = 0; i < core_count; ++i) {
+            cpu_cores[i]->setCommandRecorder(cmdRecorder);
+        }
+    }
+
     // Find all the components loaded into the "memory" slot
     // Make sure all cores have a loaded subcomponent in their slot
     SubComponentSlotInfo* mem = getSubComponentSlotInfo("memory");
@@ -263,6 +283,12 @@ void ArielCPU::finish() {
 
     memmgr->printStats();
     frontend->finish();
+
+    if(NULL != cmdRecorder) {
+        cmdRecorder->close();
+        output->verbose(CALL_INFO, 1, 0, "Recorded %" PRIu64 " commands (%" PRIu64 " bytes) to the command stream.\n",
+                cmdRecorder->getCommandCount(), cmdRecorder->getStoredBytes());
+    }
 }
 
 bool ArielCPU::tick( SST::Cycle_t cycle) {
@@ -290,7 +316,9 @@ bool ArielCPU::tick( SST::Cycle_t cycle) {
     return stopTicking;
 }
 
-ArielCPU::~ArielCPU() { }
+ArielCPU::~ArielCPU() {
+    delete cmdRecorder;
+}
 
 void ArielCPU::emergencyShutdown() {
     /* Ask the cores to finish up.  This should flush logging */
@@ -298,5 +326,10 @@ void ArielCPU::emergencyShutdown() {
         cpu_cores[i]->finishCore();
     }
 
+    /* Keep what was captured so far usable */
+    if(NULL != cmdRecorder) {
+        cmdRecorder->close();
+    }
+
     frontend->emergencyShutdown();
 }
@@ -31,6 +31,7 @@
 #include "arielmemmgr.h"
 #include "arielcore.h"
 #include "arielfrontend.h"
+#include "arielcmdstream.h"
 #include "ariel_shmem.h"
 
 namespace SST {
@@ -74,7 +75,9 @@ class ArielCPU : public SST::Component {
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
-        {"gpu_enabled", "If enabled, gpu links will be set up", "0"})
+        {"gpu_enabled", "If enabled, gpu links will be set up", "0"},
+        {"commandstream", "If set, record the commands every core reads from the frontend to this file so they can be replayed with ariel.frontend.replay", ""},
+        {"commandstreamchunk", "Size in bytes of the per-core chunks the command stream is compressed in", "1048576"})
 
     SST_ELI_DOCUMENT_PORTS( {"cache_link_%(corecount)d", "Each core's link to its cache", {}},
        {"gpu_link_%(corecount)d", "Each core's link to the GPU", {}})
@@ -88,6 +91,7 @@ class ArielCPU : public SST::Component {
         { "split_read_requests",  "Statistic counts number of split read requests (requests which come from multiple lines)", "requests", 1},
         { "split_write_requests", "Statistic counts number of split write requests (requests which are split over multiple lines)", "requests", 1},
         { "no_ops",               "Statistic counts instructions which do not execute a memory operation", "instructions", 1},
+        { "refill_batch_size",    "Statistic for the number of commands a core reads from the frontend each time its event queue is refilled", "commands", 2},
 	    { "flush_requests",       "Statistic counts instructions which perform flushes", "requests", 1},
 	    { "fence_requests",       "Statistic counts instructions which perform fences", "requests", 1},
         { "instruction_count",    "Statistic for counting instructions", "instructions", 1 },
@@ -129,6 +133,7 @@ class ArielCPU : public SST::Component {
 
         ArielFrontend* frontend;
         ArielTunnel* tunnel;
+        ArielCommandStreamWriter* cmdRecorder;
         bool stopTicking;
 
 #ifdef HAVE_CUDA
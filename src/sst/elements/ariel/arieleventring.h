@@ -0,0 +1,146 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_EVENT_RING
+#define _H_SST_ARIEL_EVENT_RING
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "arielevent.h"
+#include "ariel_shmem.h"
+
+#ifdef HAVE_CUDA
+#include "arielgpuev.h"
+#endif
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * An event waiting in a core's queue, tagged with its type. Only the
+ * fields used by the type are valid.
+ */
+struct ArielQueuedEvent {
+    ArielEventType type;
+
+    union {
+        // READ_ADDRESS, WRITE_ADDRESS
+        struct {
+            uint64_t address;
+            uint32_t length;
+        } access;
+
+        // MALLOC, MMAP
+        struct {
+            uint64_t vaddr;
+            uint64_t length;
+            uint64_t instPtr;
+            uint32_t level;
+            uint32_t fileID;
+        } alloc;
+
+        // FREE, FLUSH
+        struct {
+            uint64_t vaddr;
+        } line;
+
+        // SWITCH_POOL
+        struct {
+            uint32_t pool;
+        } switchPool;
+
+#ifdef HAVE_CUDA
+        // GPU, the CUDA arguments are too large to keep inline
+        ArielGpuEvent* gpu;
+#endif
+    };
+
+    // Write payload, only filled in when payloads are traced
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+};
+
+/*
+ * Queue of events for one core, held by value in a power of two sized
+ * ring so that queueing an event does not allocate.
+ *
+ * The ring is sized for the core's maximum queue length plus the events
+ * a single instruction can add after that limit has been reached. Should
+ * an instruction ever need more, the ring doubles rather than drop events.
+ */
+class ArielEventRing {
+
+    public:
+        ArielEventRing(size_t minCapacity) : head(0), count(0) {
+            size_t capacity = 16;
+
+            while(capacity < minCapacity) {
+                capacity <<= 1;
+            }
+
+            slots.resize(capacity);
+            mask = capacity - 1;
+        }
+
+        bool empty() const { return 0 == count; }
+        size_t size() const { return count; }
+        size_t capacity() const { return slots.size(); }
+
+        ArielQueuedEvent& front() { return slots[head]; }
+
+        void pop() {
+            head = (head + 1) & mask;
+            count--;
+        }
+
+        // Appends an event and returns it for the caller to fill in
+        ArielQueuedEvent& push(const ArielEventType type) {
+            if(count == slots.size()) {
+                grow();
+            }
+
+            ArielQueuedEvent& ev = slots[(head + count) & mask];
+            ev.type = type;
+            count++;
+
+            return ev;
+        }
+
+    private:
+        void grow() {
+            std::vector<ArielQueuedEvent> larger(slots.size() * 2);
+
+            for(size_t i = 0; i < count; ++i) {
+                larger[i] = slots[(head + i) & mask];
+            }
+
+            slots.swap(larger);
+            head = 0;
+            mask = slots.size() - 1;
+        }
+
+        std::vector<ArielQueuedEvent> slots;
+        size_t head;
+        size_t count;
+        size_t mask;
+};
+
+}
+}
+
+#endif
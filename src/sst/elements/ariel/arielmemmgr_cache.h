@@ -23,9 +23,9 @@
 #include <stdint.h>
 #include <deque>
 #include <vector>
-#include <unordered_map>
 
 #include "arielmemmgr.h"
+#include "arielpagetable.h"
 
 using namespace SST;
 using namespace SST::RNG;
@@ -47,13 +47,15 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
     #define ARIEL_ELI_MEMMGR_CACHE_PARAMS {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},\
         {"vtop_translate",  "Set to yes to perform virt-phys translation (TLB) or no to disable", "yes"},\
         {"pagemappolicy",   "Select the page mapping policy for Ariel [LINEAR|RANDOMIZED]", "LINEAR"},\
-        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"}
+        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"},\
+        {"hugepagesize",    "With the LINEAR policy, map demand allocated memory in huge pages of this many bytes where enough contiguous pages are free (0 disables)", "0"}
 
     #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_hits", "Hits in the simple Ariel TLB", "hits", 2 },\
         { "tlb_evicts",           "Number of evictions in the simple Ariel TLB", "evictions", 2 },\
         { "tlb_translate_queries","Number of TLB translations performed", "translations", 2 },\
         { "tlb_shootdown",        "Number of TLB clears because of page-frees", "shootdowns", 2 },\
-        { "tlb_page_allocs",      "Number of pages allocated by the memory manager", "pages", 2 }
+        { "tlb_page_allocs",      "Number of pages allocated by the memory manager", "pages", 2 },\
+        { "tlb_huge_page_allocs", "Number of huge pages allocated by the memory manager", "pages", 2 }
 
         /* Constructor
             *  Supports multiple memory pools with independent page sizes/counts
@@ -69,6 +71,7 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             statTranslationQueries      = registerStatistic<uint64_t>("tlb_translate_queries");
             statTranslationShootdown    = registerStatistic<uint64_t>("tlb_shootdown");
             statPageAllocationCount     = registerStatistic<uint64_t>("tlb_page_allocs");
+            statHugePageAllocationCount = registerStatistic<uint64_t>("tlb_huge_page_allocs");
 
             /* Get page map policy */
             mapPolicy = ArielPageMappingPolicy::LINEAR;
@@ -82,14 +85,25 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown page mapping policy \"%s\"\n", mappingPolicy.c_str());
             }
 
-            // Set up translation cache
-            translationCache = new std::unordered_map<uint64_t, uint64_t>();
+            // Translation cache is created by the manager once its page sizes are known
+            translationCache = NULL;
             translationCacheEntries = (uint32_t) params.find<uint32_t>("translatecacheentries", 4096);
+            if (translationCacheEntries == 0) {
+                translationCacheEntries = 1;
+            }
+
+            hugePageSize = params.find<uint64_t>("hugepagesize", 0);
+            if (hugePageSize != 0 && mapPolicy != ArielPageMappingPolicy::LINEAR) {
+                output->verbose(CALL_INFO, 1, 0, "Huge pages are only used with the LINEAR page mapping policy, ignoring hugepagesize\n");
+                hugePageSize = 0;
+            }
 
             /* Statistics used by all memory managers; managers may also have their own */
         } // End constructor
 
-        ~ArielMemoryManagerCache() {};
+        ~ArielMemoryManagerCache() {
+            delete translationCache;
+        };
 
     protected:
         Statistic<uint64_t>* statTranslationCacheHits;
@@ -97,9 +111,11 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
         Statistic<uint64_t>* statTranslationQueries;
         Statistic<uint64_t>* statTranslationShootdown;
         Statistic<uint64_t>* statPageAllocationCount;
+        Statistic<uint64_t>* statHugePageAllocationCount;
 
-        std::unordered_map<uint64_t, uint64_t>* translationCache;
+        ArielTranslationCache* translationCache;
         uint32_t translationCacheEntries;
+        uint64_t hugePageSize;
         bool translationEnabled;
         ArielPageMappingPolicy mapPolicy;
 
@@ -145,7 +161,7 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             }
         }
 
-        void populatePageTable(std::string popFilePath, std::unordered_map<uint64_t, uint64_t> * pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
+        void populatePageTable(std::string popFilePath, ArielPageTable* pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
             FILE * popFile = fopen(popFilePath.c_str(), "rt");
             uint64_t pinAddr = 0;
 
@@ -169,21 +185,71 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
                 output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 "\n",
                             pinAddr, freePhysical);
 
-                pageTable->insert( std::pair<uint64_t, uint64_t>( pinAddr, freePhysical ) );
+                pageTable->map(pinAddr, freePhysical);
             }
 
             fclose(popFile);
         }
 
-        void cacheTranslation(uint64_t virtualA, uint64_t physicalA) {
-            // Remove the oldest entry if we do not have enough slots TODO is begin() really the oldest...?
-            if(translationCache->size() == translationCacheEntries) {
-            statTranslationCacheEvict->addData(1);
-            translationCache->erase(translationCache->begin());
+        /* Map the huge page holding virtualAddress if huge pages are enabled, none of it is
+         * mapped yet and the next free pages are contiguous and aligned. Returns false if the
+         * caller should fall back to mapping a single page.
+         */
+        bool allocateHugePage(ArielPageTable* pageTable, std::deque<uint64_t>* freePagePool, const uint64_t virtualAddress) {
+            const uint64_t hugeSize = pageTable->getHugePageSize();
+            if (hugeSize == 0 || freePagePool->empty()) {
+                return false;
+            }
+
+            const uint64_t pageSize = pageTable->getPageSize();
+            const uint64_t pagesPerHuge = hugeSize / pageSize;
+            const uint64_t physStart = freePagePool->front();
+
+            if (freePagePool->size() < pagesPerHuge || (physStart % hugeSize) != 0) {
+                return false;
             }
 
-            // Insert the translated entry into the cache
-            translationCache->insert(std::pair<uint64_t, uint64_t>(virtualA, physicalA));
+            for (uint64_t i = 1; i < pagesPerHuge; ++i) {
+                if ((*freePagePool)[i] != physStart + (i * pageSize)) {
+                    return false;
+                }
+            }
+
+            if (!pageTable->canMapHuge(virtualAddress)) {
+                return false;
+            }
+
+            freePagePool->erase(freePagePool->begin(), freePagePool->begin() + pagesPerHuge);
+            pageTable->mapHuge(virtualAddress, physStart);
+
+            output->verbose(CALL_INFO, 4, 0, "Allocating huge page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+                    physStart, virtualAddress - (virtualAddress % hugeSize));
+
+            statHugePageAllocationCount->addData(1);
+            return true;
+        }
+
+        bool lookupTranslationCache(const uint64_t virtualA, uint64_t* physicalA) {
+            if (translationCache->lookup(virtualA, physicalA)) {
+                statTranslationCacheHits->addData(1);
+                return true;
+            }
+
+            return false;
+        }
+
+        /* Cache a translation which holds linearly for virtual addresses [start, end) */
+        void cacheTranslation(uint64_t virtualA, uint64_t physicalA, uint64_t start, uint64_t end) {
+            if (translationCache->insert(virtualA, physicalA, start, end)) {
+                statTranslationCacheEvict->addData(1);
+            }
+        }
+
+        /* Drop cached translations for [start, end) after its mapping changed */
+        void shootdownTranslations(uint64_t start, uint64_t end) {
+            if (start < end && translationCache->invalidate(start, end) > 0) {
+                statTranslationShootdown->addData(1);
+            }
         }
 
 };
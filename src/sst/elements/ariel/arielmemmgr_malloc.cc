@@ -16,6 +16,8 @@
 #include <sst_config.h>
 #include <stdio.h>
 
+#include <algorithm>
+
 #include "arielmemmgr_malloc.h"
 
 using namespace SST::ArielComponent;
@@ -33,10 +35,9 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
 
     // PageAllocation and PageTable structures
     pageAllocations = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
-    pageTables = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
+    pageTables = (ArielPageTable**) malloc(sizeof(ArielPageTable*) * memoryLevels);
     for (uint32_t i = 0; i <memoryLevels; ++i) {
         pageAllocations[i] = new std::unordered_map<uint64_t, uint64_t>();
-        pageTables[i] = new std::unordered_map<uint64_t, uint64_t>();
     }
 
     // Initialize data structures
@@ -53,6 +54,12 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         uint64_t pageCount = (uint64_t) params.find<uint64_t>(level_buffer, 131072);
         output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " page count is %" PRIu64 "\n", i, pageCount);
 
+        // Demand page table, huge pages are only used where they are a power of two multiple of the page size
+        pageTables[i] = new ArielPageTable(pageSizes[i], hugePageSize);
+        if (hugePageSize != 0 && pageTables[i]->getHugePageSize() == 0) {
+            output->verbose(CALL_INFO, 1, 0, "Level %" PRIu32 " huge pages disabled, %" PRIu64 " is not a power of two multiple of the page size\n", i, hugePageSize);
+        }
+
         // Configure page pool
         freePages[i] = new std::deque<uint64_t>();
 
@@ -81,9 +88,22 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     }
 
     free(level_buffer);
+
+    // Translation cache works at the granularity of the smallest page
+    uint64_t minPageSize = pageSizes[0];
+    for (uint32_t i = 1; i < memoryLevels; ++i) {
+        minPageSize = std::min(minPageSize, pageSizes[i]);
+    }
+
+    translationCache = new ArielTranslationCache(translationCacheEntries, minPageSize);
 }
 
 ArielMemoryManagerMalloc::~ArielMemoryManagerMalloc() {
+    for (uint32_t i = 0; i < memoryLevels; ++i) {
+        delete pageTables[i];
+    }
+
+    free(pageTables);
 }
 
 
@@ -147,7 +167,7 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
         const uint64_t nextPhysPage = freePages[level]->front();
         freePages[level]->pop_front();
 
-        pageTables[level]->insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTables[level]->map(nextVirtPage, nextPhysPage);
 
         output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
                 nextPhysPage, nextVirtPage);
@@ -176,16 +196,10 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
     output->verbose(CALL_INFO, 4, 0, "Allocate malloc received. VA: %" PRIu64 ". Size: %" PRIu64 ". Level: %" PRIu32 ".\n", virtualAddress, size, level);
 
     // Check whether a malloc mapping already exists (i.e., we missed a free)
-    std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtualAddress);
-    if (it == mallocTranslations.begin()) it = mallocTranslations.end();
-    else if (!mallocTranslations.empty()) it--;
-
-    if (it != mallocTranslations.end() && it->first <= virtualAddress) {
-        uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-        if (virtualAddress < primaryAddr + (mallocInformation.find(primaryAddr)->second).size) {
-            output->verbose(CALL_INFO, 4, 0, "Found conflicting malloc, freeing address %" PRIu64 "\n", primaryAddr);
-            freeMalloc(primaryAddr);
-        }
+    std::map<uint64_t, mallocInfo>::iterator it = findMalloc(virtualAddress);
+    if (it != mallocInformation.end() && (virtualAddress == it->first || virtualAddress < it->first + it->second.size)) {
+        output->verbose(CALL_INFO, 4, 0, "Found conflicting malloc, freeing address %" PRIu64 "\n", it->first);
+        freeMalloc(it->first);
     }
 
     // Allocate new page(s). Round malloc to nearest whole page TODO fix so we can map partial pages -> needs a local VA->Ariel_VA mapping
@@ -198,25 +212,24 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
         return false;
     }
 
-    // Allocate the pages
-    std::unordered_set<uint64_t>* virtualPages = new std::unordered_set<uint64_t>;
-    uint64_t nextVirtPage = virtualAddress;
-    uint64_t firstPhysAddr, lastPhysAddr;
-    firstPhysAddr = freePages[level]->front();
+    // Allocate the pages, page i of the malloc starts at virtualAddress + i * pageSize
+    mallocInfo info(size, level);
+    info.physPages.reserve(pageCount);
     for (uint64_t i = 0; i != pageCount; i++) {
-        uint64_t nextPhysPage = freePages[level]->front();
-        mallocTranslations.insert(std::make_pair(nextVirtPage, nextPhysPage));
-        mallocPrimaryVAMap.insert(std::make_pair(nextVirtPage, virtualAddress));
+        info.physPages.push_back(freePages[level]->front());
         freePages[level]->pop_front();
-        virtualPages->insert(nextVirtPage);
-        nextVirtPage += pageSizes[level];
-        lastPhysAddr = nextPhysPage;
     }
 
-    output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress, firstPhysAddr, lastPhysAddr, pageCount);
+    output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress,
+            info.physPages.empty() ? 0 : info.physPages.front(), info.physPages.empty() ? 0 : info.physPages.back(), pageCount);
+
+    // Demand mapped translations for this range are now shadowed by the malloc
+    if (size > 0) {
+        translationCache->invalidate(virtualAddress, virtualAddress + size);
+    }
 
     // Record malloc
-    mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level, virtualPages)));
+    mallocInformation.insert(std::make_pair(virtualAddress, info));
 
     statBytesAlloc[level]->addData(size);
     return true;
@@ -232,17 +245,48 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
 
     statBytesFree[it->second.level]->addData(it->second.size);
 
-    // Free each VA in mallocInformation from mallocTranslations & mallocPrimaryVAMap TODO fix so that mapping stays but address is available for future mallocs
-    std::unordered_set<uint64_t>* myKeys = (it->second.VAKeys);
-    for (std::unordered_set<uint64_t>::iterator vaIt = myKeys->begin(); vaIt != myKeys->end(); vaIt++) {
-        mallocPrimaryVAMap.erase(*vaIt);
-        freePages[(it->second).level]->push_front(mallocTranslations.find(*vaIt)->second);
-        mallocTranslations.erase(*vaIt);
+    // Return the pages to the free pool in their original order TODO fix so that mapping stays but address is available for future mallocs
+    std::vector<uint64_t>& physPages = it->second.physPages;
+    for (std::vector<uint64_t>::reverse_iterator page = physPages.rbegin(); page != physPages.rend(); page++) {
+        freePages[it->second.level]->push_front(*page);
     }
 
+    shootdownTranslations(virtualAddress, virtualAddress + it->second.size);
+
     // Remove mallocInformation entry
-    delete myKeys;
-    mallocInformation.erase(virtualAddress);
+    mallocInformation.erase(it);
+}
+
+/*
+ *  Check whether another level maps any page inside the huge page holding virtAddr, in which
+ *  case a huge page in this level would shadow those translations
+ */
+bool ArielMemoryManagerMalloc::isMappedInOtherLevels(const uint32_t level, const uint64_t virtAddr) {
+    const uint64_t hugeSize = pageTables[level]->getHugePageSize();
+    if (hugeSize == 0) return false;
+
+    const uint64_t hugeStart = virtAddr - (virtAddr % hugeSize);
+
+    for (uint32_t i = 0; i < memoryLevels; ++i) {
+        if (i == level) continue;
+
+        for (uint64_t addr = hugeStart - (hugeStart % pageSizes[i]); addr < hugeStart + hugeSize; addr += pageSizes[i]) {
+            if (pageTables[i]->isMapped(addr)) return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ *  Find the malloc with the highest primary VA at or below virtAddr, the address is only
+ *  inside that malloc if it is below the end of the malloc
+ */
+std::map<uint64_t, ArielMemoryManagerMalloc::mallocInfo>::iterator ArielMemoryManagerMalloc::findMalloc(const uint64_t virtAddr) {
+    std::map<uint64_t, mallocInfo>::iterator it = mallocInformation.upper_bound(virtAddr);
+    if (it == mallocInformation.begin()) return mallocInformation.end();
+
+    return --it;
 }
 
 
@@ -256,94 +300,98 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
     statTranslationQueries->addData(1);
 
     uint64_t physAddr = (uint64_t) -1;
-    bool found = false;
 
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
+    if(lookupTranslationCache(virtAddr, &physAddr)) {
+        return physAddr;
     }
 
+    // Range around the address which no malloc covers, demand page translations are only cached within it
+    uint64_t unmallocedStart = 0;
+    uint64_t unmallocedEnd = (uint64_t) -1;
+
     // Check malloc mappings
-    if (!mallocTranslations.empty()) {
-        std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtAddr);
-        if (it == mallocTranslations.begin()) it = mallocTranslations.end();
-        else it--;
-
-        if (it != mallocTranslations.end() && (it->first <= virtAddr)) {
-            uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-            if (virtAddr < (primaryAddr + (mallocInformation.find(primaryAddr)->second).size)) {
-                uint64_t offset = virtAddr - it->first;
-                physAddr = offset + it->second;
-                found = true;
+    if (!mallocInformation.empty()) {
+        std::map<uint64_t, mallocInfo>::iterator it = mallocInformation.upper_bound(virtAddr);
+        if (it != mallocInformation.end()) {
+            unmallocedEnd = it->first;
+        }
+
+        if (it != mallocInformation.begin()) {
+            it--;
+
+            const uint64_t primaryAddr = it->first;
+            const uint64_t mallocEnd = primaryAddr + it->second.size;
+
+            if (virtAddr < mallocEnd) {
+                const uint64_t pageSize = pageSizes[it->second.level];
+                const uint64_t page = (virtAddr - primaryAddr) / pageSize;
+                const uint64_t pageStart = primaryAddr + (page * pageSize);
+
+                physAddr = it->second.physPages[page] + (virtAddr - pageStart);
+
+                cacheTranslation(virtAddr, physAddr, pageStart, std::min(pageStart + pageSize, mallocEnd));
+                return physAddr;
             }
+
+            unmallocedStart = mallocEnd;
         }
     }
 
     // We will have to search every memory level to find where the address lies
     for(uint32_t i = 0; i < memoryLevels; ++i) {
-        if (!found) {
-        std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-        const uint64_t pageSize = pageSizes[i];
-            const uint64_t page_offset = virtAddr % pageSize;
-        const uint64_t page_start = virtAddr - page_offset;
+        uint64_t virtStart, physStart, mapLength;
 
-        page_itr = pageTables[i]->find(page_start);
+        if (pageTables[i]->lookup(virtAddr, &virtStart, &physStart, &mapLength)) {
+            // Located
+            const uint64_t page_offset = virtAddr - virtStart;
+            physAddr = physStart + page_offset;
 
-            if (page_itr != pageTables[i]->end()) {
-                // Located
-            physAddr = page_itr->second + page_offset;
+            output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
+                virtAddr, i, virtStart, virtStart + mapLength, physStart, physAddr, page_offset);
 
-                output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                    virtAddr, i, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
-
-            found = true;
-            break;
-        }
-        } else {
-            break;
+            cacheTranslation(virtAddr, physAddr, std::max(virtStart, unmallocedStart), std::min(virtStart + mapLength, unmallocedEnd));
+            return physAddr;
         }
     }
 
-    if(found) {
-        cacheTranslation(virtAddr, physAddr);
-        return physAddr;
+    output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
+
+    // We did not find the address in memory, that means we should allocate it one from our default pool
+    uint64_t offset = virtAddr % pageSizes[defaultLevel];
+
+    output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
+            virtAddr, offset, (virtAddr - offset));
+
+    // Perform an allocation so we can then re-find the address
+    // Attempt defaultLevel but fall through to other levels if needed/available
+    if (canAllocateInLevel(8, defaultLevel)) {
+        if (!isMappedInOtherLevels(defaultLevel, virtAddr) && allocateHugePage(pageTables[defaultLevel], freePages[defaultLevel], virtAddr)) {
+            statDemandAllocs[defaultLevel]->addData(pageTables[defaultLevel]->getHugePageSize() / pageSizes[defaultLevel]);
+        } else {
+            allocate(8, defaultLevel, virtAddr - offset);
+        }
     } else {
-        output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
-
-        // We did not find the address in memory, that means we should allocate it one from our default pool
-        uint64_t offset = virtAddr % pageSizes[defaultLevel];
-
-        output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
-                virtAddr, offset, (virtAddr - offset));
-
-        // Perform an allocation so we can then re-find the address
-        // Attempt defaultLevel but fall through to other levels if needed/available
-            if (canAllocateInLevel(8, defaultLevel)) {
-                allocate(8, defaultLevel, virtAddr - offset);
-            } else {
-                bool allocated = false;
-                for (uint32_t i = 0; i < memoryLevels; i++) {
-                    if (canAllocateInLevel(8, i)) {
-                        offset = virtAddr % pageSizes[i];
-                        allocate(8, i, virtAddr - offset);
-                        allocated = true;
-                        break;
-                    }
-                }
-                if (!allocated) output->fatal(CALL_INFO, -1, "Attempted to allocate page for address %" PRIu64 " but no free pages are available\n", virtAddr);
+        bool allocated = false;
+        for (uint32_t i = 0; i < memoryLevels; i++) {
+            if (canAllocateInLevel(8, i)) {
+                offset = virtAddr % pageSizes[i];
+                allocate(8, i, virtAddr - offset);
+                allocated = true;
+                break;
             }
+        }
+        if (!allocated) output->fatal(CALL_INFO, -1, "Attempted to allocate page for address %" PRIu64 " but no free pages are available\n", virtAddr);
+    }
 
-        // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
+    // Now attempt to refind it
+    const uint64_t newPhysAddr = translateAddress(virtAddr);
 
-        output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
+    output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
 
-        return newPhysAddr;
-    }
+    return newPhysAddr;
 }
 
 void ArielMemoryManagerMalloc::printStats() {
@@ -354,13 +402,13 @@ void ArielMemoryManagerMalloc::printStats() {
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand map entries at level %" PRIu32 "         %" PRIu32 "\n",
-            i, (uint32_t) pageTables[i]->size());
+            i, (uint32_t) pageTables[i]->getMappedPageCount());
     }
 
     output->output("Page Table Coverages:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand bytes at level %" PRIu32 "              %" PRIu64 "\n",
-            i, ((uint64_t) pageTables[i]->size()) * ((uint64_t) pageSizes[i]));
+            i, pageTables[i]->getMappedPageCount() * pageSizes[i]);
     }
 }
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <deque>
+#include <map>
 #include <vector>
 #include <unordered_map>
 
@@ -69,17 +70,18 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
         bool canAllocateInLevel(const uint64_t size, const uint32_t level);
+        bool isMappedInOtherLevels(const uint32_t level, const uint64_t virtAddr);
 
         struct mallocInfo {
             uint64_t size;
             uint32_t level;
-            std::unordered_set<uint64_t>* VAKeys;
-            mallocInfo(uint64_t size, uint32_t level, std::unordered_set<uint64_t>* VAKeys) : size(size), level(level), VAKeys(VAKeys) {};
+            std::vector<uint64_t> physPages;    // Physical page backing each page of the malloc, starting at the primary VA
+            mallocInfo(uint64_t size, uint32_t level) : size(size), level(level) {};
         };
 
-        std::map<uint64_t, uint64_t> mallocPrimaryVAMap;    // Map VA of each PA to the primary VA of the malloc -> used to find the mallocInfo
-        std::map<uint64_t, uint64_t> mallocTranslations;    // Map VA to PA for mallocs -> primary lookup
-        std::map<uint64_t, mallocInfo> mallocInformation;   // Map mallocID to information about the malloc -> use for frees/allocs
+        std::map<uint64_t, mallocInfo>::iterator findMalloc(const uint64_t virtAddr);
+
+        std::map<uint64_t, mallocInfo> mallocInformation;   // Map primary VA of each malloc to its pages -> used for translation, frees and allocs
 
         uint32_t defaultLevel;
         uint32_t memoryLevels;
@@ -87,7 +89,7 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 
         std::deque<uint64_t>** freePages;
         std::unordered_map<uint64_t, uint64_t>** pageAllocations;
-        std::unordered_map<uint64_t, uint64_t>** pageTables;
+        ArielPageTable** pageTables;
 
         std::vector<Statistic<uint64_t>* > statBytesAlloc;
         std::vector<Statistic<uint64_t>* > statBytesFree;
@@ -29,6 +29,13 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
     output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
 
+    pageTable = new ArielPageTable(pageSize, hugePageSize);
+    translationCache = new ArielTranslationCache(translationCacheEntries, pageSize);
+
+    if (hugePageSize != 0 && pageTable->getHugePageSize() == 0) {
+        output->verbose(CALL_INFO, 1, 0, "Huge page size %" PRIu64 " is not a power of two multiple of the page size, huge pages disabled\n", hugePageSize);
+    }
+
     if (mapPolicy == ArielPageMappingPolicy::LINEAR) {
         mapPagesLinear(pageCount, pageSize, 0, &freePages);
     } else {
@@ -40,12 +47,13 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     std::string popFilePath = params.find<std::string>("page_populate_0", "");
     if (popFilePath != "") {
         output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
-        populatePageTable(popFilePath, &pageTable, &freePages, pageSize);
+        populatePageTable(popFilePath, pageTable, &freePages, pageSize);
     }
 
 }
 
 ArielMemoryManagerSimple::~ArielMemoryManagerSimple() {
+    delete pageTable;
 }
 
 
@@ -77,7 +85,7 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
         const uint64_t nextPhysPage = freePages.front();
         freePages.pop_front();
 
-        pageTable.insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTable->map(nextVirtPage, nextPhysPage);
 
         output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
                 nextPhysPage, nextVirtPage);
@@ -106,26 +114,22 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
+    uint64_t physAddr = 0;
+    if(lookupTranslationCache(virtAddr, &physAddr)) {
+        return physAddr;
     }
 
-    std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-    const uint64_t page_offset = virtAddr % pageSize;
-    const uint64_t page_start = virtAddr - page_offset;
+    uint64_t virtStart, physStart, mapLength;
 
-    page_itr = pageTable.find(page_start);
-
-    if(page_itr != pageTable.end()) {
+    if(pageTable->lookup(virtAddr, &virtStart, &physStart, &mapLength)) {
         // Located
-        uint64_t physAddr = page_itr->second + page_offset;
+        const uint64_t page_offset = virtAddr - virtStart;
+        physAddr = physStart + page_offset;
 
         output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                virtAddr, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
+                virtAddr, virtStart, virtStart + mapLength, physStart, physAddr, page_offset);
 
-        cacheTranslation(virtAddr, physAddr);
+        cacheTranslation(virtAddr, physAddr, virtStart, virtStart + mapLength);
         return physAddr;
 
     } else {
@@ -138,7 +142,9 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
                 virtAddr, offset, (virtAddr - offset));
 
         // Perform an allocation so we can then re-find the address
-        allocate(8, 0, virtAddr - offset);
+        if(!allocateHugePage(pageTable, &freePages, virtAddr)) {
+            allocate(8, 0, virtAddr - offset);
+        }
 
         // Now attempt to refind it
         const uint64_t newPhysAddr = translateAddress(virtAddr);
@@ -156,12 +162,17 @@ void ArielMemoryManagerSimple::printStats() {
     output->output("Page Table Sizes:\n");
 
     output->output("- Map entries         %" PRIu32 "\n",
-        (uint32_t) pageTable.size());
+        (uint32_t) pageTable->getMappedPageCount());
+
+    if(pageTable->getHugePageSize() != 0) {
+        output->output("- Huge pages          %" PRIu64 "\n",
+            pageTable->getHugePageCount());
+    }
 
     output->output("Page Table Coverages:\n");
 
     output->output("- Bytes               %" PRIu64 "\n",
-        ((uint64_t) pageTable.size()) * ((uint64_t) pageSize));
+        pageTable->getMappedPageCount() * pageSize);
 }
 
 void ArielMemoryManagerSimple::printTable() {
@@ -169,10 +180,10 @@ void ArielMemoryManagerSimple::printTable() {
     	output->output("---------------------------------------------------------------------\n");
 	output->verbose(CALL_INFO, 16, 0, "Page Table Map:\n");
 
-	for( auto table_itr : pageTable ) {
+	pageTable->forEach( [this](uint64_t virtStart, uint64_t physStart, uint64_t length) {
 		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 "\n",
-			table_itr.first, table_itr.second);
-	}
+			virtStart, physStart);
+	} );
 
     	output->output("---------------------------------------------------------------------\n");
 
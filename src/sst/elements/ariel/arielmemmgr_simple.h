@@ -22,7 +22,6 @@
 #include <stdint.h>
 #include <deque>
 #include <vector>
-#include <unordered_map>
 
 #include "arielmemmgr_cache.h"
 
@@ -60,7 +59,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         uint64_t pageSize;
         std::deque<uint64_t> freePages;
 
-        std::unordered_map<uint64_t, uint64_t> pageTable;
+        ArielPageTable* pageTable;
 };
 
 }
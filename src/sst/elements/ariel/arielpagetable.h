@@ -0,0 +1,373 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ARIEL_PAGE_TABLE
+#define _H_ARIEL_PAGE_TABLE
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vector>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Four level radix page table from virtual page to physical page.
+ *
+ * The virtual page number is split into a leaf index and three upper
+ * indices, so a translation is at most four dependent loads. Nodes are
+ * only allocated for the parts of the address space which are used.
+ *
+ * When a huge page size is given the leaves cover exactly one huge page,
+ * which lets a huge page be mapped with a single entry in the level above
+ * the leaves. Huge pages must be a power of two multiple of the page size.
+ *
+ * Entries hold (physical address << 1) | 1 so that zero means unmapped.
+ */
+class ArielPageTable {
+
+    public:
+        ArielPageTable(const uint64_t pageSz, const uint64_t hugePageSz = 0) :
+                pageSize(pageSz), hugePageSize(0), mappedPages(0), hugePages(0) {
+
+            pageShift = 0;
+            while((UINT64_C(1) << (pageShift + 1)) <= pageSize && pageShift < 62) {
+                pageShift++;
+            }
+            pageSizePow2 = ((UINT64_C(1) << pageShift) == pageSize);
+
+            leafBits = 9;
+            if(pageSizePow2 && hugePageSz > pageSize && (hugePageSz % pageSize) == 0) {
+                const uint64_t ratio = hugePageSz / pageSize;
+
+                if((ratio & (ratio - 1)) == 0) {
+                    hugePageSize = hugePageSz;
+                    leafBits = 0;
+                    while((UINT64_C(1) << leafBits) < ratio) {
+                        leafBits++;
+                    }
+                }
+            }
+
+            // Spread the remaining page number bits over the upper levels
+            const uint32_t pageNumberBits = 64 - pageShift;
+            upperBits = (pageNumberBits - leafBits + 2) / 3;
+
+            root = allocateNode(upperBits);
+        }
+
+        ~ArielPageTable() {
+            releaseNode(root, 0);
+        }
+
+        uint64_t getPageSize() const { return pageSize; }
+        uint64_t getHugePageSize() const { return hugePageSize; }
+
+        // Number of pages mapped, a huge page counts as all of the pages it covers
+        uint64_t getMappedPageCount() const { return mappedPages; }
+        uint64_t getHugePageCount() const { return hugePages; }
+
+        /*
+         * Find the mapping holding vAddr. On success the virtual and physical
+         * start of the (huge) page and its length are returned.
+         */
+        bool lookup(const uint64_t vAddr, uint64_t* vStart, uint64_t* pStart, uint64_t* length) const {
+            const uint64_t vpn = pageNumber(vAddr);
+
+            const uint64_t* mid = childOf(root[upperIndex(vpn, 2)]);
+            if(NULL == mid) return false;
+
+            const uint64_t* lower = childOf(mid[upperIndex(vpn, 1)]);
+            if(NULL == lower) return false;
+
+            const uint64_t lowerEntry = lower[upperIndex(vpn, 0)];
+            if(0 == lowerEntry) return false;
+
+            if(isHugeEntry(lowerEntry)) {
+                const uint64_t hugeVpn = vpn & ~((UINT64_C(1) << leafBits) - 1);
+
+                *vStart = hugeVpn * pageSize;
+                *pStart = lowerEntry >> 1;
+                *length = hugePageSize;
+                return true;
+            }
+
+            const uint64_t leafEntry = childOf(lowerEntry)[leafIndex(vpn)];
+            if(0 == leafEntry) return false;
+
+            *vStart = vpn * pageSize;
+            *pStart = leafEntry >> 1;
+            *length = pageSize;
+            return true;
+        }
+
+        bool isMapped(const uint64_t vAddr) const {
+            uint64_t vStart, pStart, length;
+            return lookup(vAddr, &vStart, &pStart, &length);
+        }
+
+        // Map the page starting at vPage (page aligned) to pPage
+        void map(const uint64_t vPage, const uint64_t pPage) {
+            const uint64_t vpn = pageNumber(vPage);
+            uint64_t& lowerEntry = lowerEntryFor(vpn);
+
+            if(0 == lowerEntry) {
+                lowerEntry = (uint64_t) (uintptr_t) allocateNode(leafBits);
+            } else if(isHugeEntry(lowerEntry)) {
+                // Already covered by a huge page
+                return;
+            }
+
+            uint64_t& leafEntry = childOf(lowerEntry)[leafIndex(vpn)];
+
+            if(0 == leafEntry) {
+                mappedPages++;
+            }
+
+            leafEntry = (pPage << 1) | 1;
+        }
+
+        // True if no part of the huge page holding vAddr is mapped yet
+        bool canMapHuge(const uint64_t vAddr) {
+            return (0 != hugePageSize) && (0 == lowerEntryFor(pageNumber(vAddr)));
+        }
+
+        // Map the huge page holding vAddr to the physically contiguous pages
+        // starting at pHuge, canMapHuge() must be true
+        void mapHuge(const uint64_t vAddr, const uint64_t pHuge) {
+            lowerEntryFor(pageNumber(vAddr)) = (pHuge << 1) | 1;
+
+            mappedPages += (UINT64_C(1) << leafBits);
+            hugePages++;
+        }
+
+        // Calls visit(vStart, pStart, length) for every mapping
+        template<typename F>
+        void forEach(F visit) const {
+            visitNode(root, 0, 0, visit);
+        }
+
+    private:
+        uint64_t pageNumber(const uint64_t vAddr) const {
+            return pageSizePow2 ? (vAddr >> pageShift) : (vAddr / pageSize);
+        }
+
+        // Index into level 2 (root), 1 or 0 (parent of the leaves)
+        uint64_t upperIndex(const uint64_t vpn, const uint32_t level) const {
+            const uint32_t shift = leafBits + (level * upperBits);
+            return (shift >= 64) ? 0 : ((vpn >> shift) & ((UINT64_C(1) << upperBits) - 1));
+        }
+
+        uint64_t leafIndex(const uint64_t vpn) const {
+            return vpn & ((UINT64_C(1) << leafBits) - 1);
+        }
+
+        static bool isHugeEntry(const uint64_t entry) { return (entry & 1) != 0; }
+
+        static uint64_t* childOf(const uint64_t entry) {
+            return (uint64_t*) (uintptr_t) entry;
+        }
+
+        uint64_t& lowerEntryFor(const uint64_t vpn) {
+            uint64_t& rootEntry = root[upperIndex(vpn, 2)];
+            if(0 == rootEntry) {
+                rootEntry = (uint64_t) (uintptr_t) allocateNode(upperBits);
+            }
+
+            uint64_t& midEntry = childOf(rootEntry)[upperIndex(vpn, 1)];
+            if(0 == midEntry) {
+                midEntry = (uint64_t) (uintptr_t) allocateNode(upperBits);
+            }
+
+            return childOf(midEntry)[upperIndex(vpn, 0)];
+        }
+
+        static uint64_t* allocateNode(const uint32_t bits) {
+            return (uint64_t*) calloc(UINT64_C(1) << bits, sizeof(uint64_t));
+        }
+
+        // Depth 0 is the root, depth 2 the parent of the leaves
+        void releaseNode(uint64_t* node, const uint32_t depth) {
+            if(depth < 2) {
+                for(uint64_t i = 0; i < (UINT64_C(1) << upperBits); ++i) {
+                    if(0 != node[i]) {
+                        releaseNode(childOf(node[i]), depth + 1);
+                    }
+                }
+            } else if(depth == 2) {
+                for(uint64_t i = 0; i < (UINT64_C(1) << upperBits); ++i) {
+                    if(0 != node[i] && !isHugeEntry(node[i])) {
+                        free(childOf(node[i]));
+                    }
+                }
+            }
+
+            free(node);
+        }
+
+        template<typename F>
+        void visitNode(const uint64_t* node, const uint32_t depth, const uint64_t prefix, F& visit) const {
+            for(uint64_t i = 0; i < (UINT64_C(1) << upperBits); ++i) {
+                if(0 == node[i]) {
+                    continue;
+                }
+
+                const uint64_t vpnPrefix = (prefix << upperBits) | i;
+
+                if(depth < 2) {
+                    visitNode(childOf(node[i]), depth + 1, vpnPrefix, visit);
+                } else if(isHugeEntry(node[i])) {
+                    visit((vpnPrefix << leafBits) * pageSize, node[i] >> 1, hugePageSize);
+                } else {
+                    const uint64_t* leaf = childOf(node[i]);
+
+                    for(uint64_t j = 0; j < (UINT64_C(1) << leafBits); ++j) {
+                        if(0 != leaf[j]) {
+                            visit(((vpnPrefix << leafBits) | j) * pageSize, leaf[j] >> 1, pageSize);
+                        }
+                    }
+                }
+            }
+        }
+
+        uint64_t pageSize;
+        uint64_t hugePageSize;
+        uint32_t pageShift;
+        bool pageSizePow2;
+        uint32_t leafBits;
+        uint32_t upperBits;
+
+        uint64_t mappedPages;
+        uint64_t hugePages;
+
+        uint64_t* root;
+};
+
+/*
+ * Direct mapped cache of recent translations, indexed by the virtual
+ * granule (the smallest page size in use) of the address.
+ *
+ * Each entry holds a virtual range inside one granule which translates
+ * linearly, so an entry can describe part of a page when a mapping does
+ * not start or end on a page boundary (as happens for malloc regions).
+ */
+class ArielTranslationCache {
+
+    public:
+        ArielTranslationCache(const uint64_t entryCount, const uint64_t granule) {
+            uint64_t count = 1;
+            while(count < entryCount) {
+                count <<= 1;
+            }
+
+            granuleShift = 0;
+            while((UINT64_C(1) << (granuleShift + 1)) <= granule && granuleShift < 62) {
+                granuleShift++;
+            }
+
+            entries.resize(count);
+            mask = count - 1;
+            clear();
+        }
+
+        bool lookup(const uint64_t vAddr, uint64_t* pAddr) const {
+            const Entry& entry = entries[(vAddr >> granuleShift) & mask];
+
+            if(vAddr >= entry.start && vAddr < entry.end) {
+                *pAddr = vAddr + entry.delta;
+                return true;
+            }
+
+            return false;
+        }
+
+        /*
+         * Cache the translation of vAddr to pAddr, which holds linearly for
+         * [start, end). Only the part of the range in the granule holding
+         * vAddr is kept. Returns true if a valid entry was replaced.
+         */
+        bool insert(const uint64_t vAddr, const uint64_t pAddr, const uint64_t start, const uint64_t end) {
+            const uint64_t granuleStart = (vAddr >> granuleShift) << granuleShift;
+            const uint64_t granuleEnd = granuleStart + (UINT64_C(1) << granuleShift);
+
+            Entry& entry = entries[(vAddr >> granuleShift) & mask];
+            const bool evicted = entry.start < entry.end;
+
+            entry.start = (start > granuleStart) ? start : granuleStart;
+            entry.end = (end < granuleEnd || granuleEnd < granuleStart) ? end : granuleEnd;
+            entry.delta = pAddr - vAddr;
+
+            return evicted;
+        }
+
+        // Drop every entry overlapping [start, end), returns the number dropped
+        uint64_t invalidate(const uint64_t start, const uint64_t end) {
+            uint64_t dropped = 0;
+
+            if(end <= start) {
+                return dropped;
+            }
+
+            const uint64_t granules = ((end - 1) >> granuleShift) - (start >> granuleShift) + 1;
+
+            if(granules >= entries.size()) {
+                for(size_t i = 0; i < entries.size(); ++i) {
+                    dropped += invalidateEntry(entries[i], start, end);
+                }
+            } else {
+                for(uint64_t g = (start >> granuleShift); g <= ((end - 1) >> granuleShift); ++g) {
+                    dropped += invalidateEntry(entries[g & mask], start, end);
+                }
+            }
+
+            return dropped;
+        }
+
+        void clear() {
+            for(size_t i = 0; i < entries.size(); ++i) {
+                entries[i].start = 0;
+                entries[i].end = 0;
+                entries[i].delta = 0;
+            }
+        }
+
+    private:
+        struct Entry {
+            uint64_t start;
+            uint64_t end;
+            uint64_t delta;
+        };
+
+        static uint64_t invalidateEntry(Entry& entry, const uint64_t start, const uint64_t end) {
+            if(entry.start < entry.end && entry.start < end && start < entry.end) {
+                entry.start = 0;
+                entry.end = 0;
+                return 1;
+            }
+
+            return 0;
+        }
+
+        std::vector<Entry> entries;
+        uint64_t mask;
+        uint32_t granuleShift;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,169 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "replayfrontend.h"
+
+using namespace SST::ArielComponent;
+
+ReplayFrontend::ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+            ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool),
+            reader_done(cores), stop_readers(false), reader_errors(cores), reader_failed(false) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ReplayFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    core_count = cores;
+
+    stream_path = params.find<std::string>("commandstream", "");
+    if("" == stream_path) {
+        output->fatal(CALL_INFO, -1, "The commandstream parameter specifying which command stream to replay was not specified\n");
+    }
+
+    // Check the file up front so errors are reported before the simulation starts
+    ArielCommandStreamReader check;
+    if(!check.open(stream_path, 0)) {
+        output->fatal(CALL_INFO, -1, "Error: %s: %s\n", stream_path.c_str(), check.getError().c_str());
+    }
+
+    stream_core_count = check.getCoreCount();
+    check.close();
+
+    if(stream_core_count > core_count) {
+        output->fatal(CALL_INFO, -1, "Error: command stream %s was recorded with %" PRIu32 " cores but only %" PRIu32 " cores are configured\n",
+                stream_path.c_str(), stream_core_count, core_count);
+    } else if(stream_core_count < core_count) {
+        output->verbose(CALL_INFO, 1, 0, "Command stream was recorded with %" PRIu32 " cores, the remaining cores will exit immediately\n",
+                stream_core_count);
+    }
+
+    for(uint32_t i = 0; i < core_count; ++i) {
+        reader_done[i] = false;
+    }
+
+    tunnelmgr = new SST::Core::Interprocess::MMAPParent<ArielTunnel>(id, core_count, maxCoreQueueLen);
+    tunnel = tunnelmgr->getTunnel();
+
+    registerClock(params.find<std::string>("reader_check_frequency", "1MHz"),
+            new Clock::Handler<ReplayFrontend>(this, &ReplayFrontend::checkReaders));
+
+    output->verbose(CALL_INFO, 1, 0, "Replaying command stream %s on %" PRIu32 " cores\n", stream_path.c_str(), core_count);
+}
+
+void ReplayFrontend::init(unsigned int phase)
+{
+    if ( phase == 0 ) {
+        output->verbose(CALL_INFO, 1, 0, "Starting %" PRIu32 " command stream readers...\n", core_count);
+
+        for(uint32_t i = 0; i < core_count; ++i) {
+            readers.push_back(std::thread(&ReplayFrontend::replayCore, this, i));
+        }
+    }
+
+    checkReaders(0);
+}
+
+bool ReplayFrontend::checkReaders(Cycle_t cycle) {
+    if(reader_failed.load(std::memory_order_acquire)) {
+        for(uint32_t i = 0; i < core_count; ++i) {
+            if(reader_done[i] && !reader_errors[i].empty()) {
+                output->fatal(CALL_INFO, -1, "Error: %s, core %" PRIu32 ": %s\n", stream_path.c_str(), i, reader_errors[i].c_str());
+            }
+        }
+    }
+
+    // Nothing left to check once every reader has finished cleanly
+    for(uint32_t i = 0; i < core_count; ++i) {
+        if(!reader_done[i]) {
+            return false;
+        }
+    }
+
+    return !readers.empty();
+}
+
+void ReplayFrontend::replayCore(uint32_t core) {
+    ArielCommand ac;
+    ac.command = ARIEL_NOOP;
+
+    if(core < stream_core_count) {
+        ArielCommandStreamReader reader;
+
+        if(reader.open(stream_path, core)) {
+            while(!stop_readers.load(std::memory_order_relaxed) && reader.next(&ac)) {
+                tunnel->writeMessage(core, ac);
+            }
+        }
+
+        // Leave the core waiting, the main thread reports the error
+        if(!reader.getError().empty()) {
+            reader_errors[core] = reader.getError();
+            reader_done[core] = true;
+            reader_failed.store(true, std::memory_order_release);
+            return;
+        }
+    }
+
+    // Captures cut short by an emergency shutdown have no exit command
+    if(!stop_readers.load(std::memory_order_relaxed) && ac.command != ARIEL_PERFORM_EXIT) {
+        ac.command = ARIEL_PERFORM_EXIT;
+        tunnel->writeMessage(core, ac);
+    }
+
+    reader_done[core] = true;
+}
+
+void ReplayFrontend::stopReaders() {
+    stop_readers = true;
+
+    for(uint32_t i = 0; i < readers.size(); ++i) {
+        // A reader may be blocked on a full buffer that nobody will drain
+        while(!reader_done[i]) {
+            tunnel->clearBuffer(i);
+            std::this_thread::yield();
+        }
+
+        readers[i].join();
+    }
+
+    readers.clear();
+}
+
+void ReplayFrontend::finish() {
+    stopReaders();
+    checkReaders(0);
+}
+
+ArielTunnel* ReplayFrontend::getTunnel() {
+    return tunnel;
+}
+
+ReplayFrontend::~ReplayFrontend() {
+    if(NULL != tunnelmgr) {
+        stopReaders();
+        delete tunnelmgr;
+    }
+
+    delete output;
+}
+
+void ReplayFrontend::emergencyShutdown() {
+    stopReaders();
+
+    delete tunnelmgr; // Clean up tmp file
+    tunnelmgr = NULL;
+}
@@ -0,0 +1,96 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_REPLAY_FRONTEND
+#define _H_REPLAY_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/component.h>
+#include <sst/core/params.h>
+#include <sst/core/interprocess/mmapparent.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "arielcmdstream.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Frontend which replays a command stream recorded by Ariel (see the
+ * commandstream parameter of the ariel component) instead of running an
+ * application under PIN. One reader thread per core decompresses that
+ * core's chunks and writes the commands into the tunnel as fast as the
+ * cores drain it, so the same capture can drive any number of timing runs.
+ * A reader which fails only records the error, the main thread reports it
+ * from init() or a low frequency clock.
+ */
+class ReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(ReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend which replays a recorded command stream without PIN", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"commandstream", "Command stream file recorded by Ariel to replay", ""},
+        {"reader_check_frequency", "How often the simulation checks the reader threads for errors", "1MHz"})
+
+        /* Ariel class */
+        ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+        ~ReplayFrontend();
+        virtual void emergencyShutdown();
+        virtual void init(unsigned int phase);
+        virtual void setup() {}
+        virtual void finish();
+        virtual ArielTunnel* getTunnel();
+
+    private:
+
+        void replayCore(uint32_t core);
+        void stopReaders();
+        bool checkReaders(Cycle_t cycle);
+
+        SST::Output* output;
+
+        uint32_t core_count;
+        uint32_t stream_core_count;
+        std::string stream_path;
+
+        SST::Core::Interprocess::MMAPParent<ArielTunnel>* tunnelmgr;
+        ArielTunnel* tunnel;
+
+        std::vector<std::thread> readers;
+        std::vector< std::atomic<bool> > reader_done;
+        std::atomic<bool> stop_readers;
+
+        // Written by a reader before it sets reader_failed
+        std::vector<std::string> reader_errors;
+        std::atomic<bool> reader_failed;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,357 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Round trips randomized command sequences through ArielCommandStreamWriter
+ * and ArielCommandStreamReader. Every capturable command type is recorded
+ * for several cores, with and without write payloads, and each core's
+ * reader must return exactly its own commands. The sequences mix runs of
+ * repetitive commands, which compress, with runs of writes with random
+ * addresses, sizes and payloads, which do not, so with libz and payloads
+ * the file holds both compressed and stored chunks.
+ * The file is also read back through its chunk index, without the index
+ * (as after a capture that was never closed) and truncated inside a chunk.
+ */
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sst/elements/ariel/arielcmdstream.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::ArielComponent;
+
+static const uint32_t coreCount = 3;
+
+enum CommandMix { REPETITIVE, MIXED, RANDOM_WRITES };
+
+static ArielCommand randomCommand(std::mt19937_64& rng, const CommandMix mix) {
+    static const ArielShmemCmd_t types[] = {
+        ARIEL_START_INSTRUCTION, ARIEL_END_INSTRUCTION, ARIEL_PERFORM_READ, ARIEL_PERFORM_WRITE,
+        ARIEL_FLUSHLINE_INSTRUCTION, ARIEL_FENCE_INSTRUCTION, ARIEL_ISSUE_TLM_MMAP, ARIEL_ISSUE_TLM_MAP,
+        ARIEL_ISSUE_TLM_FREE, ARIEL_SWITCH_POOL, ARIEL_NOOP, ARIEL_OUTPUT_STATS
+    };
+
+    ArielCommand ac;
+    memset(&ac, 0, sizeof(ac));
+
+    if(REPETITIVE == mix) {
+        // The same few instructions over and over
+        const uint64_t step = rng() % 4;
+        ac.command = (step == 0) ? ARIEL_START_INSTRUCTION : (step == 3) ? ARIEL_END_INSTRUCTION : ARIEL_PERFORM_READ;
+        ac.instPtr = 0x400000 + step * 4;
+        ac.inst.instClass = 1;
+        ac.inst.simdElemCount = 1;
+        ac.inst.addr = 0x10000 + step * 64;
+        ac.inst.size = 8;
+        return ac;
+    }
+
+    if(RANDOM_WRITES == mix) {
+        ac.command = ARIEL_PERFORM_WRITE;
+        ac.inst.addr = rng();
+        ac.inst.size = (uint32_t) rng();
+        for(uint32_t i = 0; i < ARIEL_MAX_PAYLOAD_SIZE; ++i) {
+            ac.inst.payload[i] = (uint8_t) rng();
+        }
+        return ac;
+    }
+
+    ac.command = types[rng() % (sizeof(types) / sizeof(types[0]))];
+    ac.instPtr = rng();
+
+    switch(ac.command) {
+        case ARIEL_START_INSTRUCTION:
+            ac.inst.instClass = rng() % 8;
+            ac.inst.simdElemCount = 1 + rng() % 16;
+            break;
+
+        case ARIEL_PERFORM_READ:
+        case ARIEL_PERFORM_WRITE:
+            ac.inst.addr = rng();
+            // Sizes past the payload limit check that the payload is cut
+            ac.inst.size = 1 + rng() % (ARIEL_MAX_PAYLOAD_SIZE + 32);
+            for(uint32_t i = 0; i < ARIEL_MAX_PAYLOAD_SIZE; ++i) {
+                ac.inst.payload[i] = (uint8_t) rng();
+            }
+            break;
+
+        case ARIEL_FLUSHLINE_INSTRUCTION:
+            ac.flushline.vaddr = rng();
+            break;
+
+        case ARIEL_ISSUE_TLM_MMAP:
+            ac.mlm_mmap.vaddr = rng();
+            ac.mlm_mmap.alloc_len = rng();
+            ac.mlm_mmap.alloc_level = rng() % 4;
+            ac.mlm_mmap.fileID = rng() % 100;
+            break;
+
+        case ARIEL_ISSUE_TLM_MAP:
+            ac.mlm_map.vaddr = rng();
+            ac.mlm_map.alloc_len = rng();
+            ac.mlm_map.alloc_level = rng() % 4;
+            break;
+
+        case ARIEL_ISSUE_TLM_FREE:
+            ac.mlm_free.vaddr = rng();
+            break;
+
+        case ARIEL_SWITCH_POOL:
+            ac.switchPool.pool = rng() % 4;
+            break;
+
+        default:
+            break;
+    }
+
+    return ac;
+}
+
+// Compares the fields the stream keeps for the command
+static bool sameCommand(const ArielCommand& expected, const ArielCommand& actual, const bool payloads) {
+    if(expected.command != actual.command) {
+        return false;
+    }
+
+    switch(expected.command) {
+        case ARIEL_START_INSTRUCTION:
+            return expected.instPtr == actual.instPtr && expected.inst.instClass == actual.inst.instClass &&
+                expected.inst.simdElemCount == actual.inst.simdElemCount;
+
+        case ARIEL_PERFORM_READ:
+            return expected.inst.addr == actual.inst.addr && expected.inst.size == actual.inst.size;
+
+        case ARIEL_PERFORM_WRITE:
+        {
+            if(expected.inst.addr != actual.inst.addr || expected.inst.size != actual.inst.size) {
+                return false;
+            }
+
+            const uint32_t kept = (expected.inst.size < ARIEL_MAX_PAYLOAD_SIZE) ?
+                expected.inst.size : ARIEL_MAX_PAYLOAD_SIZE;
+
+            if(payloads) {
+                return memcmp(expected.inst.payload, actual.inst.payload, kept) == 0;
+            }
+
+            for(uint32_t i = 0; i < ARIEL_MAX_PAYLOAD_SIZE; ++i) {
+                if(actual.inst.payload[i] != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        case ARIEL_FLUSHLINE_INSTRUCTION:
+            return expected.flushline.vaddr == actual.flushline.vaddr;
+
+        case ARIEL_ISSUE_TLM_MMAP:
+            return expected.instPtr == actual.instPtr && expected.mlm_mmap.vaddr == actual.mlm_mmap.vaddr &&
+                expected.mlm_mmap.alloc_len == actual.mlm_mmap.alloc_len &&
+                expected.mlm_mmap.alloc_level == actual.mlm_mmap.alloc_level &&
+                expected.mlm_mmap.fileID == actual.mlm_mmap.fileID;
+
+        case ARIEL_ISSUE_TLM_MAP:
+            return expected.instPtr == actual.instPtr && expected.mlm_map.vaddr == actual.mlm_map.vaddr &&
+                expected.mlm_map.alloc_len == actual.mlm_map.alloc_len &&
+                expected.mlm_map.alloc_level == actual.mlm_map.alloc_level;
+
+        case ARIEL_ISSUE_TLM_FREE:
+            return expected.mlm_free.vaddr == actual.mlm_free.vaddr;
+
+        case ARIEL_SWITCH_POOL:
+            return expected.switchPool.pool == actual.switchPool.pool;
+
+        default:
+            return true;
+    }
+}
+
+// Reads back every core and compares against what was recorded, returns
+// the number of readers which used the index
+static uint32_t readBack(const std::string& path, const std::vector< std::vector<ArielCommand> >& expected,
+        const bool payloads) {
+    uint32_t indexedReaders = 0;
+
+    for(uint32_t core = 0; core < coreCount; ++core) {
+        ArielCommandStreamReader reader;
+        CHECK(reader.open(path, core));
+        CHECK(reader.getCoreCount() == coreCount);
+
+        ArielCommand ac;
+        size_t count = 0;
+        bool match = true;
+
+        while(reader.next(&ac)) {
+            if(count >= expected[core].size() || !sameCommand(expected[core][count], ac, payloads)) {
+                match = false;
+            }
+            count++;
+        }
+
+        CHECK(reader.getError().empty());
+        CHECK(count == expected[core].size());
+        CHECK(match);
+
+        if(!match || count != expected[core].size()) {
+            fprintf(stderr, "core %" PRIu32 ": read %zu commands, recorded %zu\n", core, count, expected[core].size());
+        }
+
+        if(reader.isIndexed()) {
+            indexedReaders++;
+        }
+    }
+
+    return indexedReaders;
+}
+
+static void testRoundTrip(const bool payloads) {
+    const std::string path = "testCommandStream." + std::to_string(getpid()) + ".bin";
+
+    std::mt19937_64 rng(payloads ? 11 : 7);
+    std::vector< std::vector<ArielCommand> > expected(coreCount);
+
+    ArielCommandStreamWriter writer;
+    CHECK(writer.open(path, coreCount, 4096, payloads));
+
+    // Commands which cannot be captured are refused and leave no trace
+    ArielCommand refused;
+    memset(&refused, 0, sizeof(refused));
+    refused.command = ARIEL_START_DMA;
+    CHECK(!writer.record(0, refused));
+    refused.command = ARIEL_ISSUE_CUDA;
+    CHECK(!writer.record(1, refused));
+    CHECK(writer.getCommandCount() == 0);
+
+    // Cycle through the kinds of phase, interleaving the cores
+    static const CommandMix phases[] = { REPETITIVE, MIXED, RANDOM_WRITES };
+
+    for(uint32_t phase = 0; phase < 9; ++phase) {
+        for(uint32_t i = 0; i < 3000; ++i) {
+            const uint32_t core = rng() % coreCount;
+            const ArielCommand ac = randomCommand(rng, phases[phase % 3]);
+            CHECK(writer.record(core, ac));
+            expected[core].push_back(ac);
+        }
+    }
+
+    for(uint32_t core = 0; core < coreCount; ++core) {
+        ArielCommand ac;
+        memset(&ac, 0, sizeof(ac));
+        ac.command = ARIEL_PERFORM_EXIT;
+        CHECK(writer.record(core, ac));
+        expected[core].push_back(ac);
+    }
+
+    writer.close();
+
+    // Walk the chunks and count how they were stored
+    FILE* fp = fopen(path.c_str(), "rb");
+    CHECK(NULL != fp);
+
+    ArielCommandIndexTrailer trailer;
+    CHECK(0 == fseeko(fp, -(off_t) sizeof(trailer), SEEK_END));
+    CHECK(1 == fread(&trailer, sizeof(trailer), 1, fp));
+    CHECK(0 == memcmp(trailer.magic, ARIEL_CMD_STREAM_INDEX_MAGIC, sizeof(trailer.magic)));
+
+    uint32_t compressedChunks = 0;
+    uint32_t storedChunks = 0;
+    off_t offset = sizeof(ArielCommandStreamHeader);
+
+    while((uint64_t) offset < trailer.indexOffset) {
+        ArielCommandChunkHeader chunkHeader;
+        CHECK(0 == fseeko(fp, offset, SEEK_SET));
+        CHECK(1 == fread(&chunkHeader, sizeof(chunkHeader), 1, fp));
+        CHECK(chunkHeader.core < coreCount);
+
+        if(chunkHeader.compressed) {
+            compressedChunks++;
+            CHECK(chunkHeader.storedBytes < chunkHeader.rawBytes);
+        } else {
+            storedChunks++;
+            CHECK(chunkHeader.storedBytes == chunkHeader.rawBytes);
+        }
+
+        offset += sizeof(chunkHeader) + chunkHeader.storedBytes;
+    }
+
+    CHECK((uint64_t) offset == trailer.indexOffset);
+    fclose(fp);
+
+#ifdef HAVE_LIBZ
+    CHECK(compressedChunks > 0);
+    CHECK(storedChunks > 0 || !payloads);
+#else
+    CHECK(compressedChunks == 0);
+    CHECK(storedChunks > 0);
+#endif
+
+    // Through the index
+    CHECK(readBack(path, expected, payloads) == coreCount);
+
+    // Without the index every reader scans the chunks
+    CHECK(0 == truncate(path.c_str(), (off_t) trailer.indexOffset));
+    CHECK(readBack(path, expected, payloads) == 0);
+
+    // A chunk cut short is an error, not the end of the stream
+    CHECK(0 == truncate(path.c_str(), (off_t) trailer.indexOffset - 10));
+    bool sawError = false;
+
+    for(uint32_t core = 0; core < coreCount; ++core) {
+        ArielCommandStreamReader reader;
+        CHECK(reader.open(path, core));
+
+        ArielCommand ac;
+        while(reader.next(&ac)) {}
+
+        sawError = sawError || !reader.getError().empty();
+    }
+
+    CHECK(sawError);
+
+    unlink(path.c_str());
+}
+
+static void testNotAStream() {
+    const std::string path = "testCommandStream." + std::to_string(getpid()) + ".txt";
+
+    FILE* fp = fopen(path.c_str(), "wb");
+    CHECK(NULL != fp);
+    fprintf(fp, "this is not a command stream, but it is long enough to hold a header\n");
+    fclose(fp);
+
+    ArielCommandStreamReader reader;
+    CHECK(!reader.open(path, 0));
+    CHECK(!reader.getError().empty());
+
+    unlink(path.c_str());
+}
+
+int main() {
+    testRoundTrip(false);
+    testRoundTrip(true);
+    testNotAStream();
+
+    return SST::UnitTest::result("testCommandStream");
+}
@@ -0,0 +1,384 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Checks ArielPageTable against a std::map of mapped pages, for power of
+ * two and other page sizes, with pages scattered over the whole 64 bit
+ * address space. Huge pages must translate every address they cover,
+ * hide later small mappings inside them and only be allowed over an
+ * untouched region. ArielTranslationCache is driven with random inserts,
+ * lookups and invalidations against a list of the ranges it was given,
+ * including ranges which do not start or end on a granule and granules
+ * at the very top of the address space.
+ */
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <sst/elements/ariel/arielpagetable.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::ArielComponent;
+
+struct Mapping {
+    uint64_t pStart;
+    uint64_t length;
+};
+
+// Finds the reference mapping holding vAddr, mappings are keyed by their
+// virtual start and never overlap
+static bool referenceLookup(const std::map<uint64_t, Mapping>& reference, const uint64_t vAddr,
+        uint64_t* vStart, Mapping* mapping) {
+    std::map<uint64_t, Mapping>::const_iterator it = reference.upper_bound(vAddr);
+
+    if(it == reference.begin()) {
+        return false;
+    }
+
+    --it;
+
+    if(vAddr - it->first >= it->second.length) {
+        return false;
+    }
+
+    *vStart = it->first;
+    *mapping = it->second;
+    return true;
+}
+
+// Random virtual address, clustered so that many share upper table levels
+static uint64_t randomAddress(std::mt19937_64& rng) {
+    static const uint64_t bases[] = { 0, UINT64_C(0x400000), UINT64_C(0x7fff00000000),
+        UINT64_C(0xffffffffff000000) };
+
+    const uint64_t base = bases[rng() % 4];
+    return base + (rng() % (UINT64_C(1) << 24));
+}
+
+static void compareLookups(const ArielPageTable& table, const std::map<uint64_t, Mapping>& reference,
+        std::mt19937_64& rng) {
+    // Probe every mapping at a random offset and random addresses elsewhere
+    for(std::map<uint64_t, Mapping>::const_iterator it = reference.begin(); it != reference.end(); ++it) {
+        const uint64_t vAddr = it->first + rng() % it->second.length;
+        uint64_t vStart = 0, pStart = 0, length = 0;
+
+        CHECK(table.lookup(vAddr, &vStart, &pStart, &length));
+        CHECK(vStart == it->first);
+        CHECK(pStart == it->second.pStart);
+        CHECK(length == it->second.length);
+    }
+
+    for(uint32_t i = 0; i < 20000; ++i) {
+        const uint64_t vAddr = randomAddress(rng);
+        uint64_t vStart = 0, pStart = 0, length = 0;
+        uint64_t refStart = 0;
+        Mapping refMapping = { 0, 0 };
+
+        const bool found = table.lookup(vAddr, &vStart, &pStart, &length);
+        const bool refFound = referenceLookup(reference, vAddr, &refStart, &refMapping);
+
+        CHECK(found == refFound);
+        CHECK(table.isMapped(vAddr) == refFound);
+
+        if(found && refFound) {
+            CHECK(vStart == refStart);
+            CHECK(pStart == refMapping.pStart);
+            CHECK(length == refMapping.length);
+        }
+    }
+
+    // forEach visits exactly the mappings
+    std::map<uint64_t, Mapping> visited;
+    table.forEach([&visited](uint64_t vStart, uint64_t pStart, uint64_t length) {
+        Mapping mapping = { pStart, length };
+        visited[vStart] = mapping;
+    });
+
+    CHECK(visited.size() == reference.size());
+
+    bool same = visited.size() == reference.size();
+    for(std::map<uint64_t, Mapping>::const_iterator it = reference.begin(); same && it != reference.end(); ++it) {
+        std::map<uint64_t, Mapping>::const_iterator v = visited.find(it->first);
+        same = v != visited.end() && v->second.pStart == it->second.pStart && v->second.length == it->second.length;
+    }
+    CHECK(same);
+}
+
+static void testSmallPages(const uint64_t pageSize, const uint64_t seed) {
+    ArielPageTable table(pageSize);
+    std::map<uint64_t, Mapping> reference;
+    std::mt19937_64 rng(seed);
+
+    CHECK(table.getPageSize() == pageSize);
+    CHECK(table.getHugePageSize() == 0);
+    CHECK(!table.canMapHuge(0));
+
+    uint64_t nextPhysical = 0;
+
+    for(uint32_t i = 0; i < 5000; ++i) {
+        const uint64_t vPage = (randomAddress(rng) / pageSize) * pageSize;
+
+        // The top page may not be whole when the page size is not a power of two
+        if(vPage > UINT64_MAX - pageSize) {
+            continue;
+        }
+
+        // Remapping a page replaces its physical page
+        Mapping mapping = { nextPhysical, pageSize };
+        nextPhysical += pageSize;
+
+        table.map(vPage, mapping.pStart);
+        reference[vPage] = mapping;
+    }
+
+    CHECK(table.getMappedPageCount() == reference.size());
+    CHECK(table.getHugePageCount() == 0);
+
+    compareLookups(table, reference, rng);
+}
+
+static void testHugePages() {
+    const uint64_t pageSize = 4096;
+    const uint64_t hugeSize = UINT64_C(2) * 1024 * 1024;
+
+    ArielPageTable table(pageSize, hugeSize);
+    std::map<uint64_t, Mapping> reference;
+    std::mt19937_64 rng(3);
+
+    CHECK(table.getHugePageSize() == hugeSize);
+
+    uint64_t nextPhysical = 0;
+    uint64_t hugeCount = 0;
+
+    for(uint32_t i = 0; i < 3000; ++i) {
+        const uint64_t vAddr = randomAddress(rng);
+        const uint64_t hugeStart = vAddr & ~(hugeSize - 1);
+        uint64_t refStart = 0;
+        Mapping refMapping = { 0, 0 };
+
+        // Is any part of the huge region already mapped?
+        std::map<uint64_t, Mapping>::const_iterator it = reference.lower_bound(hugeStart);
+        const bool touched = (it != reference.end() && it->first - hugeStart < hugeSize) ||
+            referenceLookup(reference, hugeStart, &refStart, &refMapping);
+
+        CHECK(table.canMapHuge(vAddr) == !touched);
+
+        if(0 == rng() % 3) {
+            if(!touched) {
+                Mapping mapping = { nextPhysical, hugeSize };
+                nextPhysical += hugeSize;
+
+                table.mapHuge(vAddr, mapping.pStart);
+                reference[hugeStart] = mapping;
+                hugeCount++;
+            }
+        } else {
+            const uint64_t vPage = vAddr & ~(pageSize - 1);
+
+            // A page inside a huge page stays part of the huge page
+            table.map(vPage, nextPhysical);
+
+            if(!referenceLookup(reference, vPage, &refStart, &refMapping) || refMapping.length == pageSize) {
+                Mapping mapping = { nextPhysical, pageSize };
+                reference[vPage] = mapping;
+            }
+
+            nextPhysical += pageSize;
+        }
+    }
+
+    CHECK(hugeCount > 0);
+    CHECK(table.getHugePageCount() == hugeCount);
+    CHECK(table.getMappedPageCount() == (reference.size() - hugeCount) + hugeCount * (hugeSize / pageSize));
+
+    compareLookups(table, reference, rng);
+
+    // Sizes which are not a power of two multiple of the page disable huge pages
+    const uint64_t badSizes[] = { 3 * pageSize, pageSize, pageSize / 2, hugeSize + pageSize };
+    for(uint64_t badSize : badSizes) {
+        ArielPageTable noHuge(pageSize, badSize);
+        CHECK(noHuge.getHugePageSize() == 0);
+        CHECK(!noHuge.canMapHuge(0));
+    }
+
+    // As do page sizes which are not a power of two
+    ArielPageTable oddPages(6000, 6000 * 512);
+    CHECK(oddPages.getHugePageSize() == 0);
+}
+
+struct CachedRange {
+    uint64_t start;
+    uint64_t end;
+    uint64_t delta;
+};
+
+static void testTranslationCache() {
+    const uint64_t granule = 4096;
+    const uint64_t entryCount = 60;
+
+    ArielTranslationCache cache(entryCount, granule);
+    std::mt19937_64 rng(5);
+
+    // The last range inserted for each granule, which is all the direct
+    // mapped cache can hold
+    std::map<uint64_t, CachedRange> granules;
+    uint64_t evictions = 0;
+    uint64_t hits = 0;
+
+    for(uint32_t i = 0; i < 200000; ++i) {
+        // Addresses near the top of the address space make the last granule
+        // end past UINT64_MAX
+        const uint64_t vAddr = (0 == rng() % 10) ? (UINT64_MAX - rng() % (4 * granule)) :
+            (rng() % (512 * granule));
+        const uint64_t granuleStart = vAddr & ~(granule - 1);
+
+        switch(rng() % 4) {
+            case 0:
+            {
+                // A linear range around vAddr, often not granule aligned
+                const uint64_t before = rng() % (2 * granule);
+                const uint64_t after = 1 + rng() % (2 * granule);
+                const uint64_t start = (vAddr >= before) ? vAddr - before : 0;
+                const uint64_t end = (vAddr <= UINT64_MAX - after) ? vAddr + after : UINT64_MAX;
+                const uint64_t pAddr = (rng() % (UINT64_C(1) << 40)) & ~UINT64_C(7);
+
+                // Any granule in the same set is evicted
+                bool expectEvict = false;
+                for(std::map<uint64_t, CachedRange>::iterator it = granules.begin(); it != granules.end(); ) {
+                    if(((it->first / granule) & 63) == ((granuleStart / granule) & 63)) {
+                        expectEvict = true;
+                        it = granules.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                const bool evicted = cache.insert(vAddr, pAddr, start, end);
+                CHECK(evicted == expectEvict);
+                evictions += evicted ? 1 : 0;
+
+                const uint64_t granuleEnd = granuleStart + granule;
+                CachedRange range;
+                range.start = (start > granuleStart) ? start : granuleStart;
+                range.end = (granuleEnd < granuleStart || end < granuleEnd) ? end : granuleEnd;
+                range.delta = pAddr - vAddr;
+                granules[granuleStart] = range;
+                break;
+            }
+
+            case 1:
+            {
+                // Invalidate a range, sometimes one covering the whole cache
+                const uint64_t length = (0 == rng() % 20) ? (256 * granule) : (1 + rng() % (2 * granule));
+                const uint64_t start = vAddr;
+                const uint64_t end = (start <= UINT64_MAX - length) ? start + length : UINT64_MAX;
+
+                uint64_t expected = 0;
+                for(std::map<uint64_t, CachedRange>::iterator it = granules.begin(); it != granules.end(); ) {
+                    if(it->second.start < end && start < it->second.end) {
+                        expected++;
+                        it = granules.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                CHECK(cache.invalidate(start, end) == expected);
+                break;
+            }
+
+            default:
+            {
+                uint64_t pAddr = 0;
+                const bool hit = cache.lookup(vAddr, &pAddr);
+
+                std::map<uint64_t, CachedRange>::const_iterator it = granules.find(granuleStart);
+                const bool expectHit = it != granules.end() && vAddr >= it->second.start && vAddr < it->second.end;
+
+                CHECK(hit == expectHit);
+                if(hit && expectHit) {
+                    CHECK(pAddr == vAddr + it->second.delta);
+                    hits++;
+                }
+                break;
+            }
+        }
+    }
+
+    // The workload has to reach the interesting paths
+    CHECK(evictions > 0);
+    CHECK(hits > 0);
+
+    cache.clear();
+    uint64_t pAddr = 0;
+    CHECK(!cache.lookup(0, &pAddr));
+    CHECK(cache.invalidate(0, UINT64_MAX) == 0);
+}
+
+// Translations for a huge page are cached one granule at a time
+static void testHugePageTranslation() {
+    const uint64_t pageSize = 4096;
+    const uint64_t hugeSize = UINT64_C(2) * 1024 * 1024;
+
+    ArielPageTable table(pageSize, hugeSize);
+    ArielTranslationCache cache(4096, pageSize);
+
+    const uint64_t vHuge = UINT64_C(0x40000000);
+    const uint64_t pHuge = UINT64_C(0x200000) * 7;
+
+    CHECK(table.canMapHuge(vHuge + 12345));
+    table.mapHuge(vHuge + 12345, pHuge);
+    CHECK(!table.canMapHuge(vHuge));
+
+    for(uint64_t offset = 0; offset < hugeSize; offset += pageSize / 2 + 8) {
+        const uint64_t vAddr = vHuge + offset;
+        uint64_t vStart = 0, pStart = 0, length = 0, pAddr = 0;
+
+        CHECK(table.lookup(vAddr, &vStart, &pStart, &length));
+        CHECK(vStart == vHuge && pStart == pHuge && length == hugeSize);
+
+        if(!cache.lookup(vAddr, &pAddr)) {
+            cache.insert(vAddr, pStart + (vAddr - vStart), vStart, vStart + length);
+            CHECK(cache.lookup(vAddr, &pAddr));
+        }
+
+        CHECK(pAddr == pHuge + offset);
+    }
+
+    // Freeing part of the huge page drops only the overlapping granules
+    CHECK(cache.invalidate(vHuge + pageSize, vHuge + 3 * pageSize) == 2);
+
+    uint64_t pAddr = 0;
+    CHECK(cache.lookup(vHuge, &pAddr) && pAddr == pHuge);
+    CHECK(!cache.lookup(vHuge + pageSize, &pAddr));
+    CHECK(!cache.lookup(vHuge + 2 * pageSize + 100, &pAddr));
+    CHECK(cache.lookup(vHuge + 3 * pageSize, &pAddr) && pAddr == pHuge + 3 * pageSize);
+}
+
+int main() {
+    testSmallPages(4096, 1);
+    testSmallPages(UINT64_C(64) * 1024, 2);
+    testSmallPages(6000, 4);
+    testHugePages();
+    testTranslationCache();
+    testHugePageTranslation();
+
+    return SST::UnitTest::result("testPageTable");
+}
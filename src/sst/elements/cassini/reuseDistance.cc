@@ -0,0 +1,137 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "reuseDistance.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace SST::Cassini;
+
+/* ------------------------------------------------------------------------------------------
+ *  ReuseDistanceSampler
+ * ------------------------------------------------------------------------------------------*/
+
+ReuseDistanceSampler::ReuseDistanceSampler(uint64_t maxLines, double rate) : now_(0) {
+    maxLines_ = maxLines == 0 ? 1 : maxLines;
+    if (rate > 1.0) rate = 1.0;
+    threshold_ = (uint64_t)(rate * HASH_RANGE);
+    if (threshold_ == 0) threshold_ = 1;
+    tree_.resize(2 * maxLines_ + 1, 0);
+    histogram_.resize(BINS, 0.0);
+}
+
+void ReuseDistanceSampler::access(uint64_t line) {
+    uint64_t hash = mixLine(line);
+    if ((hash & (HASH_RANGE - 1)) >= threshold_)
+        return;
+
+    double weight = (double)HASH_RANGE / (double)threshold_;
+
+    if (now_ == tree_.size() - 1)
+        compact();
+
+    std::unordered_map<uint64_t, uint64_t>::iterator it = lastAccess_.find(line);
+    if (it == lastAccess_.end()) {
+        histogram_[0] += weight;
+        lastAccess_.insert(std::make_pair(line, now_));
+    } else {
+        uint64_t distance = prefix(now_) - prefix(it->second + 1);
+        uint64_t scaled = (uint64_t)(distance * weight);
+        histogram_[scaled == 0 ? 1 : 2 + (63 - __builtin_clzll(scaled))] += weight;
+        mark(it->second, -1);
+        it->second = now_;
+    }
+    mark(now_, 1);
+    now_++;
+
+    if (lastAccess_.size() > maxLines_)
+        shrink();
+}
+
+void ReuseDistanceSampler::mark(uint64_t time, int32_t delta) {
+    for (uint64_t i = time + 1; i < tree_.size(); i += i & (~i + 1))
+        tree_[i] += delta;
+}
+
+uint64_t ReuseDistanceSampler::prefix(uint64_t time) const {
+    uint64_t sum = 0;
+    for (uint64_t i = time; i > 0; i -= i & (~i + 1))
+        sum += tree_[i];
+    return sum;
+}
+
+/* Renumber the live access times 0..n-1 in order and rebuild the tree */
+void ReuseDistanceSampler::compact() {
+    std::vector<std::pair<uint64_t, uint64_t> > live;
+    live.reserve(lastAccess_.size());
+    for (std::unordered_map<uint64_t, uint64_t>::iterator it = lastAccess_.begin(); it != lastAccess_.end(); it++)
+        live.push_back(std::make_pair(it->second, it->first));
+    std::sort(live.begin(), live.end());
+
+    std::fill(tree_.begin(), tree_.end(), 0);
+    for (uint64_t i = 0; i < live.size(); i++) {
+        lastAccess_[live[i].second] = i;
+        tree_[i + 1] = 1;
+    }
+    // Linear-time Fenwick build
+    for (uint64_t i = 1; i < tree_.size(); i++) {
+        uint64_t parent = i + (i & (~i + 1));
+        if (parent < tree_.size())
+            tree_[parent] += tree_[i];
+    }
+    now_ = live.size();
+}
+
+/* Halve the sample rate until few enough lines are tracked */
+void ReuseDistanceSampler::shrink() {
+    while (lastAccess_.size() > maxLines_ && threshold_ > 1) {
+        threshold_ /= 2;
+        std::unordered_map<uint64_t, uint64_t>::iterator it = lastAccess_.begin();
+        while (it != lastAccess_.end()) {
+            if ((mixLine(it->first) & (HASH_RANGE - 1)) >= threshold_) {
+                mark(it->second, -1);
+                it = lastAccess_.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------------------------
+ *  DistinctLineCounter
+ * ------------------------------------------------------------------------------------------*/
+
+double DistinctLineCounter::estimate() const {
+    double m = (double)registers_.size();
+    double alpha;
+    if (registers_.size() <= 16) alpha = 0.673;
+    else if (registers_.size() == 32) alpha = 0.697;
+    else if (registers_.size() == 64) alpha = 0.709;
+    else alpha = 0.7213 / (1.0 + 1.079 / m);
+
+    double sum = 0.0;
+    uint64_t zeros = 0;
+    for (std::vector<uint8_t>::const_iterator it = registers_.begin(); it != registers_.end(); it++) {
+        sum += std::ldexp(1.0, -(int)*it);
+        if (*it == 0) zeros++;
+    }
+    double est = alpha * m * m / sum;
+    if (est <= 2.5 * m && zeros != 0)
+        est = m * std::log(m / (double)zeros);  // Linear counting for small sets
+    return est;
+}
@@ -0,0 +1,106 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_REUSE_DISTANCE
+#define _H_SST_REUSE_DISTANCE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Cassini {
+
+/* 64-bit mixing function (splitmix64 finalizer) */
+static inline uint64_t mixLine(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/*
+ * Online LRU stack (reuse) distance histogram over a spatially-sampled subset of lines
+ *
+ * A line is sampled if a hash of its address falls under a threshold, so every access
+ * to a sampled line is seen and its distance counts only sampled lines; scaling by the
+ * sampling rate estimates the distance over all lines. The most recent access time of
+ * each tracked line is marked in a Fenwick tree so the number of distinct lines touched
+ * since a line's previous access is a prefix-sum difference. When more than maxLines
+ * lines are tracked the threshold is halved and lines that no longer fall under it are
+ * dropped; when the time counter reaches the end of the tree, live times are renumbered.
+ *
+ * Histogram bin 0 counts first references, bin 1 distance 0, and bin k > 1 distances
+ * in [2^(k-2), 2^(k-1)). Counts are weighted by 1/rate so they estimate all accesses.
+ */
+class ReuseDistanceSampler {
+public:
+    static const uint32_t BINS = 66;
+
+    ReuseDistanceSampler(uint64_t maxLines, double rate);
+
+    void access(uint64_t line);
+
+    double getRate() const { return (double)threshold_ / (double)HASH_RANGE; }
+    const std::vector<double>& getHistogram() const { return histogram_; }
+    void clearHistogram() { histogram_.assign(BINS, 0.0); }
+
+private:
+    static const uint64_t HASH_RANGE = uint64_t(1) << 24;
+
+    void mark(uint64_t time, int32_t delta);
+    uint64_t prefix(uint64_t time) const; // Marks at times [0, time)
+    void compact();
+    void shrink();
+
+    uint64_t maxLines_;
+    uint64_t threshold_;
+    uint64_t now_;
+    std::vector<uint32_t> tree_;
+    std::unordered_map<uint64_t, uint64_t> lastAccess_;
+    std::vector<double> histogram_;
+};
+
+/*
+ * HyperLogLog distinct-line estimate with 2^precision one-byte registers
+ */
+class DistinctLineCounter {
+public:
+    DistinctLineCounter(uint32_t precision) : precision_(precision), registers_(size_t(1) << precision, 0) { }
+
+    void add(uint64_t hash) {
+        uint64_t index = hash >> (64 - precision_);
+        uint64_t rest = hash << precision_;
+        uint8_t rank = rest == 0 ? (64 - precision_ + 1) : __builtin_clzll(rest) + 1;
+        if (rank > registers_[index])
+            registers_[index] = rank;
+    }
+
+    double estimate() const;
+    void clear() { registers_.assign(registers_.size(), 0); }
+
+private:
+    uint32_t precision_;
+    std::vector<uint8_t> registers_;
+};
+
+}
+}
+
+#endif
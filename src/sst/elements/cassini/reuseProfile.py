@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Reader for cassini.ReuseProfiler output files
+#
+#   reuseProfile.py <file>            summarize every record
+#   reuseProfile.py --mrc <file>      miss-ratio curve over the whole run: the
+#                                     fraction of accesses that miss in a fully
+#                                     associative LRU cache of each size
+
+import struct
+import sys
+
+def read(fileName):
+    """Returns (header, records). header is a dict, records a list of dicts"""
+    with open(fileName, "rb") as f:
+        data = f.read()
+    if data[0:8] != b"CASSRDP1":
+        raise ValueError("%s is not a cassini.ReuseProfiler file" % fileName)
+    lineSize, numSets, bins, _ = struct.unpack_from("=IIII", data, 8)
+    header = { "line_size" : lineSize, "num_sets" : numSets, "bins" : bins }
+    pos = 24
+    records = []
+    while pos < len(data):
+        time, accesses, rate = struct.unpack_from("=QQd", data, pos)
+        pos += 24
+        hist = list(struct.unpack_from("=%dd" % bins, data, pos))
+        pos += 8 * bins
+        sets, = struct.unpack_from("=I", data, pos)
+        pos += 4
+        occupancy = list(struct.unpack_from("=%dI" % sets, data, pos))
+        pos += 4 * sets
+        count, = struct.unpack_from("=I", data, pos)
+        pos += 4
+        requestors = dict()
+        for i in range(count):
+            length, = struct.unpack_from("=I", data, pos)
+            pos += 4
+            name = data[pos:pos+length].decode()
+            pos += length
+            interval, total = struct.unpack_from("=dd", data, pos)
+            pos += 16
+            requestors[name] = (interval, total)
+        records.append({ "time_ns" : time, "accesses" : accesses, "sample_rate" : rate,
+                         "histogram" : hist, "occupancy" : occupancy, "requestors" : requestors })
+    return header, records
+
+def binRange(b):
+    """Range of reuse distances (in lines) counted in histogram bin b. Bin 0 is first references."""
+    if b == 0:
+        return None
+    if b == 1:
+        return (0, 1)
+    return (1 << (b - 2), 1 << (b - 1))
+
+def missRatioCurve(header, records):
+    """[(cache size in bytes, miss ratio)] for each power-of-two size, accesses with distance >= size miss"""
+    hist = [0.0] * header["bins"]
+    for r in records:
+        for b in range(header["bins"]):
+            hist[b] += r["histogram"][b]
+    total = sum(hist)
+    if total == 0:
+        return []
+    curve = []
+    for b in range(1, header["bins"]):
+        lines = binRange(b)[1]
+        misses = hist[0] + sum(hist[b+1:])
+        curve.append((lines * header["line_size"], misses / total))
+        if misses == hist[0]:
+            break
+    return curve
+
+def summarize(header, records):
+    print("line size %d B, %d sets, %d records" % (header["line_size"], header["num_sets"], len(records)))
+    for r in records:
+        print("t=%d ns  accesses=%d  sample_rate=%g" % (r["time_ns"], r["accesses"], r["sample_rate"]))
+        hist = r["histogram"]
+        total = sum(hist)
+        if total > 0:
+            print("  first references: %.1f%%" % (100.0 * hist[0] / total))
+            for b in range(1, len(hist)):
+                if hist[b] > 0:
+                    lo, hi = binRange(b)
+                    print("  distance [%d, %d) lines: %.1f%%" % (lo, hi, 100.0 * hist[b] / total))
+        if r["occupancy"]:
+            occ = r["occupancy"]
+            print("  set occupancy: min %d, mean %.1f, max %d" % (min(occ), float(sum(occ)) / len(occ), max(occ)))
+        for name in sorted(r["requestors"]):
+            interval, total = r["requestors"][name]
+            print("  %s: working set %.0f B this interval, %.0f B total" %
+                    (name if name else "(unknown)", interval * header["line_size"], total * header["line_size"]))
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    if len(args) == 2 and args[0] == "--mrc":
+        header, records = read(args[1])
+        for size, ratio in missRatioCurve(header, records):
+            print("%d %f" % (size, ratio))
+    elif len(args) == 1:
+        header, records = read(args[0])
+        summarize(header, records)
+    else:
+        print("usage: %s [--mrc] <file>" % sys.argv[0])
+        sys.exit(1)
@@ -0,0 +1,173 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "reuseProfiler.h"
+
+#include "sst/core/params.h"
+#include <sst/core/unitAlgebra.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+/* ------------------------------------------------------------------------------------------
+ *  ReuseProfiler
+ * ------------------------------------------------------------------------------------------*/
+
+ReuseProfiler::ReuseProfiler(ComponentId_t id, Params& params) : CacheListener(id, params),
+        accesses(0), done(false),
+        reuse(params.find<uint64_t>("max_lines", 65536), params.find<double>("sample_rate", 1.0)),
+        file(nullptr) {
+    Output out("", 1, 0, Output::STDOUT);
+
+    std::string cutoff_s = params.find<std::string>("addr_cutoff", "16GiB");
+    UnitAlgebra cutoff_u(cutoff_s);
+    cutoff = cutoff_u.getRoundedValue();
+
+    lineSize = params.find<uint64_t>("line_size", 64);
+    if (lineSize == 0 || (lineSize & (lineSize - 1)) != 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: line_size - must be a power of two. You specified %" PRIu64 "\n", getName().c_str(), lineSize);
+    lineShift = __builtin_ctzll(lineSize);
+
+    numSets = params.find<uint64_t>("num_sets", 0);
+    occupancy.resize(numSets, 0);
+
+    wssPrecision = params.find<uint32_t>("wss_precision", 10);
+    if (wssPrecision < 4 || wssPrecision > 16)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: wss_precision - must be between 4 and 16. You specified %" PRIu32 "\n", getName().c_str(), wssPrecision);
+
+    fileName = params.find<std::string>("output_file", "reuse-profile.bin");
+
+    UnitAlgebra interval = params.find<UnitAlgebra>("dump_interval", UnitAlgebra("0s"));
+    if (!interval.hasUnits("s"))
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: dump_interval - must be a time with units (SI units OK). You specified '%s'\n", getName().c_str(), interval.toString().c_str());
+    if (interval > UnitAlgebra("0s"))
+        registerClock(interval, new Clock::Handler<ReuseProfiler>(this, &ReuseProfiler::dumpTick));
+}
+
+ReuseProfiler::~ReuseProfiler() {
+    if (file)
+        fclose(file);
+}
+
+void ReuseProfiler::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const NotifyResultType notifyResType = notify.getResultType();
+
+    if (notify.getTargetAddress() >= cutoff) return;
+
+    Addr line = notify.getPhysicalAddress() >> lineShift;
+
+    if (notifyType == EVICT) {
+        if (numSets != 0 && resident.erase(line) && occupancy[line % numSets] > 0)
+            occupancy[line % numSets]--;
+        return;
+    }
+
+    if (numSets != 0 && notifyResType == MISS && resident.insert(line).second)
+        occupancy[line % numSets]++;
+
+    if (notifyType == PREFETCH) return;
+
+    accesses++;
+    reuse.access(line);
+
+    std::map<std::string, Requestor>::iterator it = requestors.find(notify.getRequestor());
+    if (it == requestors.end())
+        it = requestors.insert(std::make_pair(notify.getRequestor(), Requestor(wssPrecision))).first;
+    uint64_t hash = mixLine(line);
+    it->second.interval.add(hash);
+    it->second.total.add(hash);
+}
+
+void ReuseProfiler::registerResponseCallback(Event::HandlerBase *handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+bool ReuseProfiler::dumpTick(Cycle_t UNUSED(cycle)) {
+    if (!done)
+        writeRecord();
+    return false;
+}
+
+/* Called by the parent cache during finish() */
+void ReuseProfiler::printStats(Output &UNUSED(out)) {
+    finish();
+}
+
+void ReuseProfiler::finish() {
+    if (done)
+        return;
+    writeRecord();
+    done = true;
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+/*
+ * File layout (native byte order):
+ *  Header: char magic[8] = "CASSRDP1", uint32 line_size, uint32 num_sets, uint32 bins, uint32 reserved
+ *  Records, one per dump:
+ *      uint64 sim_time_ns, uint64 accesses since the previous record, double sample_rate,
+ *      double histogram[bins] since the previous record,
+ *      uint32 num_sets, uint32 occupancy[num_sets],
+ *      uint32 num_requestors, then for each: uint32 name_length, char name[name_length],
+ *          double distinct lines since the previous record, double distinct lines since the start
+ */
+void ReuseProfiler::writeRecord() {
+    if (!file) {
+        file = fopen(fileName.c_str(), "wb");
+        if (!file) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: unable to open output_file '%s'\n", getName().c_str(), fileName.c_str());
+        }
+        const char magic[8] = { 'C', 'A', 'S', 'S', 'R', 'D', 'P', '1' };
+        uint32_t header[4] = { (uint32_t)lineSize, (uint32_t)numSets, ReuseDistanceSampler::BINS, 0 };
+        fwrite(magic, 1, sizeof(magic), file);
+        fwrite(header, sizeof(uint32_t), 4, file);
+    }
+
+    uint64_t now = getCurrentSimTimeNano();
+    double rate = reuse.getRate();
+    fwrite(&now, sizeof(now), 1, file);
+    fwrite(&accesses, sizeof(accesses), 1, file);
+    fwrite(&rate, sizeof(rate), 1, file);
+    fwrite(reuse.getHistogram().data(), sizeof(double), ReuseDistanceSampler::BINS, file);
+
+    uint32_t sets = numSets;
+    fwrite(&sets, sizeof(sets), 1, file);
+    if (sets)
+        fwrite(occupancy.data(), sizeof(uint32_t), sets, file);
+
+    uint32_t count = requestors.size();
+    fwrite(&count, sizeof(count), 1, file);
+    for (std::map<std::string, Requestor>::iterator it = requestors.begin(); it != requestors.end(); it++) {
+        uint32_t length = it->first.size();
+        double interval = it->second.interval.estimate();
+        double total = it->second.total.estimate();
+        fwrite(&length, sizeof(length), 1, file);
+        fwrite(it->first.data(), 1, length, file);
+        fwrite(&interval, sizeof(interval), 1, file);
+        fwrite(&total, sizeof(total), 1, file);
+        it->second.interval.clear();
+    }
+    fflush(file);
+
+    accesses = 0;
+    reuse.clearHistogram();
+}
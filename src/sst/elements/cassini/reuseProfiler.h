@@ -0,0 +1,104 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_REUSE_PROFILER
+#define _H_SST_REUSE_PROFILER
+
+#include <cstdio>
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/timeConverter.h>
+#include <sst/core/output.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include "reuseDistance.h"
+
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+class ReuseProfiler : public SST::MemHierarchy::CacheListener {
+public:
+    ReuseProfiler(ComponentId_t, Params& params);
+    ~ReuseProfiler();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+    void finish();
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        ReuseProfiler,
+            "cassini",
+            "ReuseProfiler",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Reuse-distance, per-set occupancy and per-requestor working-set profiler with bounded memory",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "output_file",     "File to write binary profile records to. Read it with cassini/reuseProfile.py", "reuse-profile.bin" },
+        { "dump_interval",   "Write a record at this interval (e.g., '10us') as well as at the end of the run. '0s' writes only at the end", "0s" },
+        { "line_size",       "Cache line size in bytes", "64" },
+        { "num_sets",        "Number of sets in the cache for per-set occupancy; set index is line address modulo num_sets. 0 disables occupancy tracking", "0" },
+        { "sample_rate",     "Initial fraction of lines sampled for reuse distance", "1.0" },
+        { "max_lines",       "Maximum number of lines tracked for reuse distance; the sample rate is halved whenever it is exceeded", "65536" },
+        { "wss_precision",   "Per-requestor working-set estimates use 2^wss_precision bytes each (between 4 and 16)", "10" },
+        { "addr_cutoff",     "Addresses above this cutoff won't be recorded", "16GiB" }
+    )
+
+private:
+    struct Requestor {
+        Requestor(uint32_t precision) : interval(precision), total(precision) { }
+        DistinctLineCounter interval;
+        DistinctLineCounter total;
+    };
+
+    bool dumpTick(Cycle_t cycle);
+    void writeRecord();
+
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+    Addr cutoff;
+    uint64_t lineSize;
+    uint32_t lineShift;
+    uint64_t numSets;
+    uint32_t wssPrecision;
+    uint64_t accesses;
+    bool done;
+
+    ReuseDistanceSampler reuse;
+    std::unordered_set<Addr> resident;  // Bounded by the cache's own capacity
+    std::vector<uint32_t> occupancy;
+    std::map<std::string, Requestor> requestors;
+
+    std::string fileName;
+    FILE* file;
+};
+
+}
+}
+
+#endif
@@ -2,6 +2,9 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import os
+import re
+import sys
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -55,6 +58,10 @@ class testcase_cassini_prefetch(SSTTestCase):
     def test_cassini_prefetch_nextblock(self):
         self.cassini_prefetch_test_template("nbp")
 
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_reuse_profiler skipped if threads > 3")
+    def test_cassini_reuse_profiler(self):
+        self.cassini_reuse_profiler_test_template()
+
 #####
 
     def cassini_prefetch_test_template(self, testcase, testtimeout=180):
@@ -93,6 +100,70 @@ class testcase_cassini_prefetch(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+    # Runs streamcpu-reuse.py and checks the profile read back with reuseProfile.py
+    # against the L1's own statistics. Every line is sampled, so the histogram
+    # must count each access once.
+    def cassini_reuse_profiler_test_template(self, testtimeout=180):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_cassini_reuse_profiler"
+
+        sdlfile = "{0}/streamcpu-reuse.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        profile = "{0}/{1}.bin".format(outdir, testDataFileName)
+
+        otherargs = '--model-options="--output {0}"'.format(profile)
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("cassini_prefetch test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        def stat_count(stat):
+            with open(outfile, 'r') as fp:
+                for line in fp:
+                    match = re.match(r"\s*{0} : Accumulator : .*Count\.u64 = (\d+);".format(re.escape(stat)), line)
+                    if match:
+                        return int(match.group(1))
+            return None
+
+        hits = stat_count("l1cache.CacheHits")
+        misses = stat_count("l1cache.CacheMisses")
+        self.assertTrue(hits is not None and misses is not None, "Output file {0} has no L1 hit/miss statistics".format(outfile))
+
+        sys.path.insert(0, os.path.join(test_path, ".."))
+        import reuseProfile
+        header, records = reuseProfile.read(profile)
+
+        # Records every 1ms of an 11ms run and one at the end
+        self.assertTrue(len(records) > 2, "Profile {0} has only {1} records".format(profile, len(records)))
+        self.assertTrue(header["line_size"] == 64 and header["num_sets"] == 32, "Profile {0} has a bad header".format(profile))
+
+        accesses = sum(r["accesses"] for r in records)
+        self.assertTrue(accesses == hits + misses, "Profile {0} counts {1} accesses, the L1 {2}".format(profile, accesses, hits + misses))
+
+        counted = sum(sum(r["histogram"]) for r in records)
+        first = sum(r["histogram"][0] for r in records)
+        self.assertTrue(counted == accesses, "Profile {0} histograms count {1} accesses, expected {2}".format(profile, counted, accesses))
+        self.assertTrue(0 < first <= 8192, "Profile {0} counts {1} first references to 8192 lines".format(profile, first))
+
+        # A 4-way L1 never holds more than 4 lines in a set
+        for r in records:
+            self.assertTrue(len(r["occupancy"]) == 32 and max(r["occupancy"]) <= 4, "Profile {0} shows a set over 4 lines".format(profile))
+
+        # The CPU's working set is at most the 8192 lines it addresses
+        final = records[-1]["requestors"]
+        self.assertTrue(len(final) == 1, "Profile {0} shows {1} requestors".format(profile, len(final)))
+        for name, (interval, total) in final.items():
+            self.assertTrue(0 < total <= 8192 * 1.05, "Profile {0} estimates a working set of {1} lines".format(profile, total))
+
+        curve = reuseProfile.missRatioCurve(header, records)
+        ratios = [ratio for size, ratio in curve]
+        self.assertTrue(len(curve) > 0 and ratios == sorted(ratios, reverse=True) and 0 <= ratios[-1] <= ratios[0] <= 1,
+                "Profile {0} gives a bad miss-ratio curve".format(profile))
+
     def _prettyPrintDiffs(self, stat_diff, oth_diff):
         out = ""
         if len(stat_diff) != 0:
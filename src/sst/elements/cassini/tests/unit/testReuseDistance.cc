@@ -0,0 +1,156 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Unit checks for the estimators behind cassini.ReuseProfiler. With every
+ * line sampled, the reuse distance histogram must match a brute-force LRU
+ * stack bin for bin, including across renumbering of the access times.
+ * With the sample rate halving to stay under max_lines, a cyclic stream
+ * must still put every reuse in the bin of its real distance. The
+ * HyperLogLog working-set estimates must be close to the real count.
+ */
+
+#include <sst_config.h>
+
+#include <stdio.h>
+
+#include <cmath>
+#include <list>
+#include <random>
+#include <vector>
+
+#include <sst/elements/cassini/reuseDistance.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::Cassini;
+
+/* Histogram bin of a distance, as documented for ReuseDistanceSampler */
+static uint32_t distanceBin(uint64_t distance) {
+    return distance == 0 ? 1 : 2 + (63 - __builtin_clzll(distance));
+}
+
+/* Reference: the position of the line in an LRU stack */
+class LRUStack {
+public:
+    LRUStack() : histogram(ReuseDistanceSampler::BINS, 0.0) { }
+
+    void access(uint64_t line) {
+        uint64_t distance = 0;
+        std::list<uint64_t>::iterator it = stack.begin();
+        for (; it != stack.end() && *it != line; it++)
+            distance++;
+
+        if (it == stack.end()) {
+            histogram[0] += 1.0;
+        } else {
+            histogram[distanceBin(distance)] += 1.0;
+            stack.erase(it);
+        }
+        stack.push_front(line);
+    }
+
+    std::vector<double> histogram;
+
+private:
+    std::list<uint64_t> stack;
+};
+
+static void testExactHistogram() {
+    // 2*4096 access times fit before renumbering, so 20000 accesses renumber twice
+    ReuseDistanceSampler sampler(4096, 1.0);
+    LRUStack reference;
+    std::mt19937_64 rng(11);
+
+    for (uint32_t i = 0; i < 20000; i++) {
+        // Mix of a small hot set, a sweep and random lines, for a spread of distances
+        uint64_t line;
+        switch (rng() % 3) {
+            case 0: line = rng() % 16; break;
+            case 1: line = 1000 + (i % 1500); break;
+            default: line = 4000 + rng() % 2000; break;
+        }
+        sampler.access(line);
+        reference.access(line);
+    }
+
+    CHECK(sampler.getRate() == 1.0);
+    CHECK(sampler.getHistogram() == reference.histogram);
+
+    uint32_t usedBins = 0;
+    for (uint32_t b = 1; b < ReuseDistanceSampler::BINS; b++) {
+        if (reference.histogram[b] > 0)
+            usedBins++;
+    }
+    CHECK(usedBins >= 10);
+
+    sampler.clearHistogram();
+    CHECK(sampler.getHistogram() == std::vector<double>(ReuseDistanceSampler::BINS, 0.0));
+}
+
+static void testSampledCycle() {
+    // 100k lines cycled three times, far more than max_lines
+    const uint64_t lines = 100000;
+    ReuseDistanceSampler sampler(4096, 1.0);
+
+    for (uint32_t pass = 0; pass < 3; pass++) {
+        for (uint64_t line = 0; line < lines; line++)
+            sampler.access(line);
+    }
+
+    CHECK(sampler.getRate() < 4096.0 / lines);
+
+    // Every access is a first reference or a reuse at distance lines - 1,
+    // in [64Ki, 128Ki), and the weighted counts estimate the access counts
+    const std::vector<double>& histogram = sampler.getHistogram();
+    const uint32_t reuseBin = distanceBin(lines - 1);
+    double total = 0.0;
+    for (uint32_t b = 0; b < ReuseDistanceSampler::BINS; b++) {
+        total += histogram[b];
+        if (b != 0 && b != reuseBin)
+            CHECK(histogram[b] == 0.0);
+    }
+    CHECK(std::fabs(total - 3.0 * lines) < 0.1 * 3.0 * lines);
+    CHECK(std::fabs(histogram[reuseBin] - 2.0 * lines) < 0.1 * 2.0 * lines);
+}
+
+static void testDistinctLines() {
+    const uint64_t counts[] = { 300, 50000 };
+
+    for (uint64_t count : counts) {
+        DistinctLineCounter counter(10);
+
+        // Repeats must not change the estimate
+        for (uint32_t repeat = 0; repeat < 3; repeat++) {
+            for (uint64_t line = 0; line < count; line++)
+                counter.add(mixLine(line));
+        }
+
+        double error = std::fabs(counter.estimate() - count) / count;
+        if (error >= 0.02)
+            fprintf(stderr, "%llu lines estimated as %f\n", (unsigned long long)count, counter.estimate());
+        CHECK(error < 0.02);
+
+        counter.clear();
+        CHECK(counter.estimate() == 0.0);
+    }
+}
+
+int main() {
+    testExactHistogram();
+    testSampledCycle();
+    testDistinctLines();
+
+    return SST::UnitTest::result("testReuseDistance");
+}
@@ -74,16 +74,16 @@ class CacheArray {
 
         /** Function returns the cacheline if found, otherwise a null pointer.
             If updateReplacement is set, the replacement stats are updated */
-        T * lookup(Addr addr, bool updateReplacement);
+        virtual T * lookup(Addr addr, bool updateReplacement);
 
         /** Identify a replacement candidate using the replacement manager */
-        T * findReplacementCandidate(Addr addr);
+        virtual T * findReplacementCandidate(Addr addr);
 
         /** Replace a line with address 'addr' and update its replacement info */
-        void replace(Addr addr, T* candidate);
+        virtual void replace(Addr addr, T* candidate);
 
         /** Deallocate a line and notify replacement manager that it's been deallocated */
-        void deallocate(T* candidate);
+        virtual void deallocate(T* candidate);
 
     /**** Configuration and output */
         void setSliceAware(Addr size, Addr step);
@@ -97,16 +97,19 @@ void Cache::processPrefetchEvent(SST::Event * ev) {
 /* Clock handler */
 bool Cache::clockTick(Cycle_t time) {
     timestamp_++;
+    uint64_t bytesCopied = SharedPayload::getBytesCopied();
 
     // Drain any outgoing messages
     bool idle = coherenceMgr_->sendOutgoingEvents();
 
+    bool linksIdle = true;
     if (clockUpLink_) {
-        idle &= linkUp_->clock();
+        linksIdle &= linkUp_->clock();
     }
     if (clockDownLink_) {
-        idle &= linkDown_->clock();
+        linksIdle &= linkDown_->clock();
     }
+    idle &= linksIdle;
 
     // MSHR occupancy
     statMSHROccupancy->addData(mshr_->getSize());
@@ -188,12 +191,30 @@ bool Cache::clockTick(Cycle_t time) {
 
     idle &= coherenceMgr_->checkIdle();
 
+    bytesCopied = SharedPayload::getBytesCopied() - bytesCopied;
+    if (bytesCopied != 0)
+        statPayloadBytesCopied->addData(bytesCopied);
+
     // Disable lower-level cache clocks if they're idle
     if (eventBuffer_.empty() && retryBuffer_.empty() && idle) {
         turnClockOff();
         return true;
     }
 
+    // Event-driven: if nothing can happen next cycle, sleep until the next outgoing event is due.
+    // Buffered events that were all rejected can only make progress once another event arrives
+    // (which turns the clock back on); events left over after an accept may be accepted next cycle.
+    if (eventDriven_ && linksIdle && retryBuffer_.empty() && (eventBuffer_.empty() || accepted == 0)) {
+        uint64_t next = coherenceMgr_->getNextSendTime();
+        if (next > timestamp_ + 1) {
+            turnClockOff();
+            // Wake up the cycle before so that the clock handler runs at 'next' in its usual order
+            if (next != UINT64_MAX)
+                wakeSelfLink_->send(next - timestamp_ - 1, nullptr);
+            return true;
+        }
+    }
+
     // Keep the clock on
     return false;
 }
@@ -210,6 +231,12 @@ void Cache::turnClockOn() {
     clockIsOn_ = true;
 }
 
+/* Handler for wakeSelfLink_. Stale wakeups (clock already turned on by an event) are ignored */
+void Cache::wakeClock(SST::Event * ev) {
+    if (!clockIsOn_)
+        turnClockOn();
+}
+
 void Cache::turnClockOff() {
     //dbg_->debug(_L3_, "%s turning clock OFF at cycle %" PRIu64 ", timestamp %" PRIu64 ", ns %" PRIu64 "\n", this->getName().c_str(), getCurrentSimCycle(), timestamp_, getCurrentSimTimeNano());
     clockIsOn_ = false;
@@ -353,10 +380,7 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
 /* Arbitrate for access. Return whether successful */
 bool Cache::arbitrateAccess(Addr addr) {
     if (!banked_) {
-        if (addrsThisCycle_.find(addr) == addrsThisCycle_.end()) {
-            return true;
-        }
-        return false;
+        return !addrsThisCycle_.contains(addr);
     }
 
     Addr bank = coherenceMgr_->getBank(addr);
@@ -35,6 +35,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/cycleAddrFilter.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -69,6 +70,7 @@ public:
             {"noninclusive_directory_entries", "(uint) Number of entries in the directory. Must be at least 1 if the non-inclusive directory exists.", "0"},
             {"noninclusive_directory_associativity", "(uint) For a set-associative directory, number of ways.", "1"},
             {"mshr_num_entries",        "(int) Number of MSHR entries. Not valid for L1s because L1 MSHRs assumed to be sized for the CPU's load/store queue. Setting this to -1 will create a very large MSHR.", "-1"},
+            {"mshr_type",               "(string) MSHR implementation. Both produce identical results. Options: default, pooled[open-addressed index & pooled entries, compare the two with tests/benchMSHR.py]", "default"},
             {"tag_access_latency_cycles",
                 "(uint) Latency (in cycles) to access tag portion only of cache. Paid by misses and coherence requests that don't need data. If not specified, defaults to access_latency_cycles","access_latency_cycles"},
             {"mshr_latency_cycles",
@@ -89,6 +91,8 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"event_driven",            "(bool) Instead of ticking while waiting on a latency, turn the clock off and wake it at the cycle the next queued event can be sent. Produces identical results. Options: 0[off], 1[on]", "false"},
+            {"array_type",              "(string) Cache array implementation. Both produce identical results. Options: default, flat[contiguous per-set tag arrays, faster lookups for highly-associative caches]", "default"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
             {"network_bw",                  "MOVED - Now a member of the MemNIC subcomponent.", "80GiB/s"}, // Remove 9.0
@@ -116,6 +120,7 @@ public:
             {"TotalEventsReceived",     "Total number of events received by this cache", "events", 1},
             {"TotalEventsReplayed",     "Total number of events that were initially blocked and then were replayed", "events", 1},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle", "events", 1},
+            {"Payload_bytes_copied",    "Bytes of event/MSHR data copied while handling events (shared data that is not modified is not copied)", "bytes", 3},
             {"Bank_conflicts",          "Total number of bank conflicts detected", "count", 1},
             {"Prefetch_requests",       "Number of prefetches received from prefetcher at this cache", "events", 1},
             {"Prefetch_drops",          "Number of prefetches that were cancelled. Reasons: too many prefetches outstanding, cache can't handle prefetch this cycle, currently handling another event for the address.", "events", 1},
@@ -238,6 +243,7 @@ private:
     // Clock helpers - turn clock on & off
     void turnClockOn();
     void turnClockOff();
+    void wakeClock(SST::Event * ev);
 
     // Trigger timeouts if events sit in MSHR for too long
     void timeoutWakeup(SST::Event * ev);
@@ -257,6 +263,7 @@ private:
     MemLinkBase* linkDown_;                 // link manager down (towards memory)
     Link* prefetchSelfLink_;                // link to delay prefetch request receive
     Link* timeoutSelfLink_;                 // link to check for timeouts (possible deadlock)
+    Link* wakeSelfLink_;                    // link to turn the clock back on in event-driven mode
     MSHR* mshr_;                            // MSHR
     CoherenceController* coherenceMgr_;     // Coherence protocol - where most of the event handling happens
 
@@ -276,6 +283,7 @@ private:
     Clock::Handler<Cache>*  clockHandler_;
     TimeConverter*          defaultTimeBase_;
     bool                    clockIsOn_;     // Whether clock is on or off
+    bool                    eventDriven_;   // Whether to turn the clock off while waiting on latencies
     bool                    clockUpLink_;   // Whether link actually needs clock() called or not
     bool                    clockDownLink_; // Whether link actually needs clock() called or not
     SimTime_t               lastActiveClockCycle_;  // Cycle we turned the clock off at - for re-syncing stats
@@ -284,7 +292,7 @@ private:
     uint64_t                    timestamp_;
     int                         requestsThisCycle_;
     std::vector<bool>           bankStatus_;
-    std::set<Addr>              addrsThisCycle_;
+    CycleAddrFilter             addrsThisCycle_;
     std::list<MemEventBase*>    retryBuffer_;
     std::list<MemEventBase*>    eventBuffer_;
     std::queue<MemEventBase*>   prefetchBuffer_;
@@ -299,6 +307,7 @@ private:
     /** Statistics *************************************************************/
     Statistic<uint64_t>* statMSHROccupancy;
     Statistic<uint64_t>* statBankConflicts;
+    Statistic<uint64_t>* statPayloadBytesCopied;
 
     // Prefetch statistics
     Statistic<uint64_t>* statPrefetchRequest;
@@ -23,6 +23,7 @@
 #include "util.h"
 #include "cacheListener.h"
 #include "mshr.h"
+#include "pooledMSHR.h"
 #include "memLinkBase.h"
 
 using namespace SST::MemHierarchy;
@@ -76,6 +77,8 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
     if (maxRequestsPerCycle_ == 0) {
         maxRequestsPerCycle_ = -1;  // Simplify compare
     }
+    if (maxRequestsPerCycle_ > 0)
+        addrsThisCycle_ = CycleAddrFilter(maxRequestsPerCycle_);
     requestsThisCycle_ = 0;
 
     /* Configure links */
@@ -152,6 +155,7 @@ void Cache::createCoherenceManager(Params &params) {
     coherenceParams.insert("associativity", params.find<std::string>("associativity", "-1"));
     coherenceParams.insert("lines", params.find<std::string>("lines", "0"));
     coherenceParams.insert("replacement_policy", params.find<std::string>("replacement_policy", "lru"));
+    coherenceParams.insert("array_type", params.find<std::string>("array_type", "default"));
     coherenceParams.insert("dlines", params.find<std::string>("noninclusive_directory_entries", "0"));
     coherenceParams.insert("dassoc", params.find<std::string>("noninclusive_directory_associativity", "0"));
     coherenceParams.insert("drpolicy", params.find<std::string>("noninclusive_directory_repl", "lru"));
@@ -640,7 +644,14 @@ uint64_t Cache::createMSHR(Params &params, uint64_t accessLatency, bool L1) {
     if (mshrSize == 1 || mshrSize == 0)
         out_->fatal(CALL_INFO, -1, "Invalid param: mshr_num_entries - MSHR requires at least 2 entries to avoid deadlock. You specified %d\n", mshrSize);
 
-    mshr_ = new MSHR(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    std::string mshrType = params.find<std::string>("mshr_type", "default");
+    to_lower(mshrType);
+    if (mshrType == "pooled")
+        mshr_ = new PooledMSHR(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    else if (mshrType == "default")
+        mshr_ = new MSHR(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    else
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: mshr_type - must be 'default' or 'pooled'. You specified '%s'.\n", getName().c_str(), mshrType.c_str());
 
     if (mshrLatency > 0 && found)
         return mshrLatency;
@@ -728,6 +739,12 @@ void Cache::createClock(Params &params) {
     timestamp_ = 0;
     lastActiveClockCycle_ = 0;
 
+    // Event-driven mode: sleep through latencies and wake up when the next outgoing event is due
+    eventDriven_ = params.find<bool>("event_driven", false);
+    wakeSelfLink_ = nullptr;
+    if (eventDriven_)
+        wakeSelfLink_ = configureSelfLink("wakeup", frequency, new Event::Handler<Cache>(this, &Cache::wakeClock));
+
     // Deadlock timeout
     timeout_ = params.find<SimTime_t>("maxRequestDelay", 0);
     if (timeout_ > 0) {
@@ -794,4 +811,5 @@ void Cache::registerStatistics() {
 
     statMSHROccupancy               = registerStatistic<uint64_t>("MSHR_occupancy");
     statBankConflicts               = registerStatistic<uint64_t>("Bank_conflicts");
+    statPayloadBytesCopied          = registerStatistic<uint64_t>("Payload_bytes_copied");
 }
@@ -46,7 +46,7 @@ public:
                               NotifyAccessType accessT,
                               NotifyResultType resultT) :
         size(reqSize), targAddr(tAddr), physAddr(pAddr), virtAddr(vAddr), instPtr(iPtr),
-        access(accessT), result(resultT) {}
+        access(accessT), result(resultT), rqstr(nullptr) {}
 
     /** the target address is the underlying address from the
         LOAD/STORE, not the baseAddr (which is usually he cache line
@@ -58,7 +58,13 @@ public:
 	NotifyAccessType getAccessType() const { return access; }
 	NotifyResultType getResultType() const { return result; }
 	uint32_t getSize() const { return size; }
+	/** Component that originated the access, empty if unknown.
+	    Only valid for the duration of the notifyAccess() call. */
+	const std::string& getRequestor() const { return rqstr ? *rqstr : noRequestor(); }
+	void setRequestor(const std::string& r) { rqstr = &r; }
 private:
+	static const std::string& noRequestor() { static const std::string none; return none; }
+
 	uint32_t size;
         Addr targAddr;
 	Addr physAddr;
@@ -66,6 +72,7 @@ private:
 	Addr instPtr;
 	NotifyAccessType access;
 	NotifyResultType result;
+	const std::string* rqstr;
 };
 
 class CacheListener : public SubComponent {
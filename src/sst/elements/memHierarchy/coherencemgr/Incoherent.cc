@@ -84,7 +84,7 @@ bool Incoherent::handleGetS(MemEvent * event, bool inMSHR) {
             recordPrefetchResult(line, statPrefetchHit);
             recordLatencyType(event->getID(), LatType::HIT);
 
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
             if (is_debug_event(event))
                 eventDI.reason = "hit";
@@ -149,7 +149,7 @@ bool Incoherent::handleGetX(MemEvent * event, bool inMSHR) {
                 stat_hits->addData(1);
             }
             recordPrefetchResult(line, statPrefetchHit);
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
             recordLatencyType(event->getID(), LatType::HIT);
 
@@ -204,14 +204,14 @@ bool Incoherent::handleFlushLine(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), event->getSharedPayload(), event->getDirty(), 0);
                 mshr_->setInProgress(addr);
             }
             break;
         case E:
         case M:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, state == M, line->getData(), state == M, 0);
+                forwardFlush(event, state == M, SharedPayload(line->getData()), state == M, 0);
                 line->setState(S_B);
                 mshr_->setInProgress(addr);
             }
@@ -254,7 +254,7 @@ bool Incoherent::handleFlushLineInv(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), event->getSharedPayload(), event->getDirty(), 0);
                 mshr_->setInProgress(addr);
             }
             break;
@@ -262,7 +262,7 @@ bool Incoherent::handleFlushLineInv(MemEvent * event, bool inMSHR) {
         case M:
             if (status == MemEventStatus::OK) {
                 recordPrefetchResult(line, statPrefetchEvict);
-                forwardFlush(event, true, line->getData(), state == M, line->getTimestamp());
+                forwardFlush(event, true, SharedPayload(line->getData()), state == M, line->getTimestamp());
                 line->setState(I_B);
                 mshr_->setInProgress(addr);
             }
@@ -385,7 +385,7 @@ bool Incoherent::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    sendResponseUp(req, &event->getPayload(), true, 0);
+    sendResponseUp(req, event->getSharedPayload(), true, 0);
 
     if (line) {
         line->setState(E);
@@ -419,7 +419,7 @@ bool Incoherent::handleGetXResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    sendResponseUp(req, &event->getPayload(), true, 0);
+    sendResponseUp(req, event->getSharedPayload(), true, 0);
 
     cleanUpAfterResponse(event);
 
@@ -683,14 +683,14 @@ void Incoherent::doEvict(MemEvent * event, PrivateCacheLine * line) {
  * Event creation and send
  ***********************************************************************************************************/
 
-SimTime_t Incoherent::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
+SimTime_t Incoherent::sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size());
+        responseEvent->setPayload(data);
+        responseEvent->setSize(data.size());
     }
 
     if (!success)
@@ -729,13 +729,13 @@ void Incoherent::sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty)
 }
 
 
-void Incoherent::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+void Incoherent::forwardFlush(MemEvent * event, bool evict, const SharedPayload& data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
     if (evict) {
         flush->setEvict(true);
-        flush->setPayload(*data);
+        flush->setPayload(data);
         flush->setDirty(dirty);
         latency = accessLatency_;
     } else {
@@ -145,7 +145,7 @@ public:
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, true);
         HashFunction * ht = createHashFunction(params);
 
-        cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<PrivateCacheLine>(lines, assoc, rmgr, ht, params);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         stat_eventState[(int)Command::GetS][I] = registerStatistic<uint64_t>("stateEvent_GetS_I");
@@ -293,11 +293,11 @@ private:
 
     void doEvict(MemEvent * event, PrivateCacheLine * line);
 
-    SimTime_t sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = true);
+    SimTime_t sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = true);
 
     void sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty);
 
-    void forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t> * data, bool dirty, uint64_t time);
+    void forwardFlush(MemEvent * event, bool evict, const SharedPayload& data, bool dirty, uint64_t time);
 
     void sendWritebackAck(MemEvent * event);
 
@@ -76,7 +76,7 @@ bool IncoherentL1::handleGetS(MemEvent* event, bool inMSHR){
                 line->atomicStart();
 
             data.assign(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr() + event->getSize()));
-            sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(&data), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -207,7 +207,7 @@ bool IncoherentL1::handleGetSX(MemEvent* event, bool inMSHR) {
             // Handle
             line->incLock();
             std::copy(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr())  + event->getSize(), data.begin());
-            sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(&data), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -340,7 +340,7 @@ bool IncoherentL1::handleGetSResp(MemEvent * event, bool inMSHR) {
         req->setMemFlags(event->getMemFlags());
         Addr offset = req->getAddr() - req->getBaseAddr();
         vector<uint8_t> data(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
-        uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
+        uint64_t sendTime = sendResponseUp(req, SharedPayload(&data), true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
     }
     printLine(event->getBaseAddr());
@@ -398,7 +398,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
 
     // Return response
     data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
-    uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp(), success);
+    uint64_t sendTime = sendResponseUp(req, SharedPayload(&data), true, line->getTimestamp(), success);
     line->setTimestamp(sendTime-1);
 
     stat_eventState[(int)Command::GetXResp][state]->addData(1);
@@ -670,16 +670,16 @@ void IncoherentL1::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t IncoherentL1::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, bool success) {
+uint64_t IncoherentL1::sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t time, bool success) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
 
     /* Only return the desired word */
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
+        responseEvent->setPayload(data);
+        responseEvent->setSize(data.size()); // Return size that was written
         if (is_debug_event(event)) {
-            printDataValue(event->getAddr(), data, false);
+            printDataValue(event->getAddr(), &data.get(), false);
         }
     }
 
@@ -138,7 +138,7 @@ public:
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, true);
         HashFunction * ht = createHashFunction(params);
 
-        cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<L1CacheLine>(lines, assoc, rmgr, ht, params);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         stat_eventState[(int)Command::GetS][I] = registerStatistic<uint64_t>("stateEvent_GetS_I");
@@ -272,7 +272,7 @@ private:
     void forwardFlush(MemEvent * event, L1CacheLine * line, bool data);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, bool success = true);
+    uint64_t sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t baseTime, bool success = true);
 
     /** Send response down (towards memory) */
     void sendResponseDown(MemEvent * event, L1CacheLine * line, bool data);
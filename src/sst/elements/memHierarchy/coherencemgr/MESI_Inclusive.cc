@@ -101,7 +101,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
             recordPrefetchResult(line, statPrefetchHit);
             line->addSharer(event->getSrc());
 
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime - 1);
             cleanUpAfterRequest(event, inMSHR);
 
@@ -168,7 +168,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                 }
             }
 
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp(), respcmd);
+            sendTime = sendResponseUp(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp(), respcmd);
             line->setTimestamp(sendTime);
             cleanUpAfterRequest(event, inMSHR);
 
@@ -300,7 +300,7 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
             line->setOwner(event->getSrc());
             if (line->isSharer(event->getSrc()))
                 line->removeSharer(event->getSrc());
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
 
             if (is_debug_event(event))
@@ -1316,7 +1316,7 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     } else {
         line->addSharer(req->getSrc());
         Addr offset = req->getAddr() - req->getBaseAddr();
-        uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
+        uint64_t sendTime = sendResponseUp(req, SharedPayload(line->getData()), true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
 
     }
@@ -1371,11 +1371,11 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             } else {
                 if (protocol_ && line->getState() != S && mshr_->getSize(addr) == 1) {
                     line->setOwner(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetXResp);
+                    uint64_t sendTime = sendResponseUp(req, SharedPayload(line->getData()), true, line->getTimestamp(), Command::GetXResp);
                     line->setTimestamp(sendTime - 1);
                 } else {
                     line->addSharer(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetSResp);
+                    uint64_t sendTime = sendResponseUp(req, SharedPayload(line->getData()), true, line->getTimestamp(), Command::GetSResp);
                     line->setTimestamp(sendTime - 1);
                 }
             }
@@ -1393,7 +1393,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             if (line->isSharer(req->getSrc()))
                 line->removeSharer(req->getSrc());
 
-            uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
+            uint64_t sendTime = sendResponseUp(req, SharedPayload(line->getData()), true, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterResponse(event, inMSHR);
             break;
@@ -1974,17 +1974,17 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
  * Event creation and send
  ***********************************************************************************************************/
 
-SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
     /* Only return the desired word */
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
+        responseEvent->setPayload(data);
+        responseEvent->setSize(data.size()); // Return size that was written
         if (is_debug_event(event)) {
-            printDataValue(event->getBaseAddr(), data, false);
+            printDataValue(event->getBaseAddr(), &data.get(), false);
         }
     }
 
@@ -106,7 +106,7 @@ bool MESIL1::handleGetS(MemEvent * event, bool inMSHR) {
             if (event->isLoadLink())
                 line->atomicStart();
             data.assign(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr() + event->getSize()));
-            sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(&data), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime - 1);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -340,7 +340,7 @@ bool MESIL1::handleGetSX(MemEvent* event, bool inMSHR) {
             }
             line->incLock();
             std::copy(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr()) + event->getSize(), data.begin());
-            sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(&data), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterRequest(event, inMSHR);
             if (is_debug_addr(addr))
@@ -809,7 +809,7 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
         req->setMemFlags(event->getMemFlags());
         Addr offset = req->getAddr() - addr;
         vector<uint8_t> data(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
-        uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
+        uint64_t sendTime = sendResponseUp(req, SharedPayload(&data), true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
     }
 
@@ -863,7 +863,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
                     recordPrefetchLatency(req->getID(), LatType::MISS);
                 } else {
                     data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
-                    uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
+                    uint64_t sendTime = sendResponseUp(req, SharedPayload(&data), true, line->getTimestamp());
                     line->setTimestamp(sendTime - 1);
                 }
                 break;
@@ -894,7 +894,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
                     line->incLock();
                 }
                 data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
-                uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp(), success);
+                uint64_t sendTime = sendResponseUp(req, SharedPayload(&data), true, line->getTimestamp(), success);
                 line->setTimestamp(sendTime-1);
                 break;
             }
@@ -1273,16 +1273,16 @@ void MESIL1::retry(Addr addr) {
  *
  *  Return: time that the requested cacheline can again be accessed
  */
-uint64_t MESIL1::sendResponseUp(MemEvent* event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success) {
+uint64_t MESIL1::sendResponseUp(MemEvent* event, const SharedPayload& data, bool inMSHR, uint64_t time, bool success) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
     
     uint64_t latency = inMSHR ? mshrLatency_ : tagLatency_;
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size());
+        responseEvent->setPayload(data);
+        responseEvent->setSize(data.size());
         if (is_debug_event(event)) {
-            printDataValue(event->getAddr(), data, false);
+            printDataValue(event->getAddr(), &data.get(), false);
         }
         latency = accessLatency_;
     }
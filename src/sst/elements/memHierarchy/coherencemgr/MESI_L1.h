@@ -200,7 +200,7 @@ public:
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, true);
         HashFunction * ht = createHashFunction(params);
 
-        cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<L1CacheLine>(lines, assoc, rmgr, ht, params);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         // Register statistics
@@ -395,7 +395,7 @@ private:
     void retry(Addr addr);
 
     /** Event send */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success = true);
+    uint64_t sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t time, bool success = true);
     void sendResponseDown(MemEvent * event, L1CacheLine * line, bool data);
     void forwardFlush(MemEvent * event, L1CacheLine * line, bool evict);
     void sendWriteback(Command cmd, L1CacheLine * line, bool dirty);
@@ -79,7 +79,7 @@ bool MESIPrivNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
             }
             line->setShared(true);
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp());
             recordLatencyType(event->getID(), LatType::HIT);
             line->setTimestamp(sendTime);
             if (is_debug_event(event))
@@ -98,10 +98,10 @@ bool MESIPrivNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 eventDI.reason = "hit";
             if (protocol_) { // Transfer ownership of dirty block
                 line->setOwned(true);
-                sendTime = sendExclusiveResponse(event, line->getData(), inMSHR, line->getTimestamp(), state == M);
+                sendTime = sendExclusiveResponse(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp(), state == M);
             } else { // Will writeback dirty block if we evict
                 line->setShared(true);
-                sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp(), Command::GetSResp);
+                sendTime = sendResponseUp(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp(), Command::GetSResp);
             }
             recordLatencyType(event->getID(), LatType::HIT);
             line->setTimestamp(sendTime);
@@ -182,7 +182,7 @@ bool MESIPrivNoninclusive::handleGetX(MemEvent* event, bool inMSHR) {
             }
             line->setOwned(true);
             line->setShared(false);
-            sendTime = sendExclusiveResponse(event, line->getData(), inMSHR, line->getTimestamp(), true);
+            sendTime = sendExclusiveResponse(event, SharedPayload(line->getData()), inMSHR, line->getTimestamp(), true);
             line->setTimestamp(sendTime);
             recordLatencyType(event->getID(), LatType::HIT);
             if (is_debug_event(event))
@@ -233,7 +233,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), event->getSharedPayload(), event->getDirty(), 0);
                 event->setEvict(false);
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
@@ -241,7 +241,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                     mshr_->setProfiled(addr);
                 }
             } else if (mshr_->getAcksNeeded(addr) != 0 && event->getEvict()) {
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->getSharedPayload(), event->getDirty());
                 event->setEvict(false);
                 if ((static_cast<MemEvent*>(mshr_->getFrontEvent(addr)))->getCmd() == Command::FetchInvX) {
                     responses.erase(addr);
@@ -275,7 +275,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                     }
                     event->setEvict(false);
                 }
-                forwardFlush(event, true, line->getData(), (state == M || event->getDirty()), line->getTimestamp());
+                forwardFlush(event, true, SharedPayload(line->getData()), (state == M || event->getDirty()), line->getTimestamp());
                 line->setState(S_B);
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
@@ -352,7 +352,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
             if (inMSHR && mshr_->getInProgress(addr))
                 break; // Triggered an unneccessary retry
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0); // No need to evict since we didn't race
+                forwardFlush(event, event->getEvict(), event->getSharedPayload(), event->getDirty(), 0); // No need to evict since we didn't race
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::FlushLineInv][I]->addData(1);
@@ -375,7 +375,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                     break;
 
                 // Copy data in and update state to resolve race with conflicting event
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->getSharedPayload(), event->getDirty());
                 if (race->getCmd() == Command::FetchInvX) {
                     event->setDirty(false);
                 } else if (race->getCmd() != Command::Fetch) { // FetchInv, ForceInv, or Inv
@@ -392,7 +392,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                 if (event->getEvict())
                     line->setShared(false);
                 line->setState(I_B);
-                forwardFlush(event, true, line->getData(), false, line->getTimestamp());
+                forwardFlush(event, true, SharedPayload(line->getData()), false, line->getTimestamp());
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::FlushLineInv][S]->addData(1);
@@ -413,7 +413,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                             printDataValue(line->getAddr(), line->getData(), true);
                     }
                 }
-                forwardFlush(event, true, line->getData(), line->getState() == M, line->getTimestamp());
+                forwardFlush(event, true, SharedPayload(line->getData()), line->getState() == M, line->getTimestamp());
                 line->setState(I_B);
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
@@ -502,7 +502,7 @@ bool MESIPrivNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (!inMSHR && mshr_->exists(addr)) { // Raced with something; must be an Inv/Fetch since there can only be one cache above us
-                mshr_->setData(addr, event->getPayload(), false);
+                mshr_->setData(addr, event->getSharedPayload(), false);
                 responses.erase(addr);
                 mshr_->decrementAcksNeeded(addr);
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::Fetch) {
@@ -608,13 +608,13 @@ bool MESIPrivNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::FetchInvX) {
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
-                    mshr_->setData(addr, event->getPayload(), false);
+                    mshr_->setData(addr, event->getSharedPayload(), false);
                     event->setCmd(Command::PutS);
                     event->setDirty(false);
                     retry(addr);
                     status = allocateMSHR(event, false, 1, true);
                 } else {
-                    mshr_->setData(addr, event->getPayload(), false);
+                    mshr_->setData(addr, event->getSharedPayload(), false);
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
                     sendWritebackAck(event);
@@ -698,13 +698,13 @@ bool MESIPrivNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::FetchInvX) {
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
-                    mshr_->setData(addr, event->getPayload(), true);
+                    mshr_->setData(addr, event->getSharedPayload(), true);
                     event->setCmd(Command::PutS);
                     event->setDirty(false);
                     retry(addr);
                     status = allocateMSHR(event, false, 1);
                 } else { // Eviction or invalidation -> we won't need a line
-                    mshr_->setData(addr, event->getPayload(), true);
+                    mshr_->setData(addr, event->getSharedPayload(), true);
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
                     sendWritebackAck(event);
@@ -783,7 +783,7 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (mshr_->getAcksNeeded(addr)) {
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->getSharedPayload(), event->getDirty());
                 sendWritebackAck(event);
                 delete event;
 
@@ -885,7 +885,7 @@ bool MESIPrivNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (mshr_->hasData(addr)) {
-                sendResponseDown(event, event->getSize(), &(mshr_->getData(addr)), mshr_->getDataDirty(addr));
+                sendResponseDown(event, event->getSize(), mshr_->getSharedData(addr), mshr_->getDataDirty(addr));
                 cleanUpAfterRequest(event, inMSHR);
             } else if (!inMSHR && mshr_->exists(addr)) {
                 if (mshr_->getFrontType(addr) == MSHREntryType::Writeback || mshr_->getFrontEvent(addr)->getCmd() == Command::FlushLineInv) {  // Raced with eviction
@@ -896,7 +896,7 @@ bool MESIPrivNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                     delete event;
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutS) { // Raced with replacement
                     MemEvent* put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-                    sendResponseDown(event, event->getSize(), &(put->getPayload()), false);
+                    sendResponseDown(event, event->getSize(), put->getSharedPayload(), false);
                     delete event;
                 } else { // Raced with GetX or FlushLine
                     status = allocateMSHR(event, true, 0);
@@ -913,7 +913,7 @@ bool MESIPrivNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
         case SM:
         case S_B:
         case S_Inv:
-            sendResponseDown(event, event->getSize(), line->getData(), false);
+            sendResponseDown(event, event->getSize(), SharedPayload(line->getData()), false);
             cleanUpAfterRequest(event, inMSHR);
             break;
         case I_B:
@@ -1032,7 +1032,7 @@ bool MESIPrivNoninclusive::handleInv(MemEvent * event, bool inMSHR) {
                 line->setTimestamp(sendTime);
             }
         } else {
-            sendResponseDown(event, event->getSize(), line->getData(), false);
+            sendResponseDown(event, event->getSize(), SharedPayload(line->getData()), false);
             line->setState(state2);
             if (mshr_->hasData(addr))
                 mshr_->clearData(addr);
@@ -1105,7 +1105,7 @@ bool MESIPrivNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             } else if (mshr_->exists(addr) && mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) { // Drop PutX, Ack it, forward request up
                 MemEvent * put = static_cast<MemEvent*>(mshr_->swapFrontEvent(addr, event));
                 sendWritebackAck(put);
-                mshr_->setData(addr, put->getPayload(), put->getDirty());
+                mshr_->setData(addr, put->getSharedPayload(), put->getDirty());
                 delete put;
                 sendFwdRequest(event, Command::ForceInv, upperCacheName_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
@@ -1222,7 +1222,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
     switch (state) {
         case I:
             if (inMSHR && mshr_->hasData(addr)) { // Replay
-                sendResponseDown(event, event->getSize(), &(mshr_->getData(addr)), mshr_->getDataDirty(addr));
+                sendResponseDown(event, event->getSize(), mshr_->getSharedData(addr), mshr_->getDataDirty(addr));
                 mshr_->clearData(addr);
                 cleanUpAfterRequest(event, inMSHR);
             } else if (mshr_->pendingWritebackIsDowngrade(addr)) { // Resolve races with pending evictions from upper level caches
@@ -1236,7 +1236,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 if (entry) {
                     if (entry->getCmd() == Command::PutS) {
                         // Return AckInv
-                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->getPayload()), false);
+                        sendResponseDown(event, event->getSize(), static_cast<MemEvent*>(entry)->getSharedPayload(), false);
                         delete event;
                         // Drop PutS
                         if (mshr_->hasData(addr)) mshr_->clearData(addr);
@@ -1246,7 +1246,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                         break;
                     } else if (entry->getCmd() == Command::FlushLineInv) {
                         // Handle FetchInv
-                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->getPayload()), false);
+                        sendResponseDown(event, event->getSize(), static_cast<MemEvent*>(entry)->getSharedPayload(), false);
                         if (mshr_->hasData(addr)) mshr_->clearData(addr);
                         // Drop evict part of Flush if needed
                         MemEvent* flush = static_cast<MemEvent*>(entry);
@@ -1268,13 +1268,13 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
             } else if (mshr_->exists(addr) && mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) { // Drop PutX, Ack it, forward request up
                 MemEvent * put = static_cast<MemEvent*>(mshr_->swapFrontEvent(addr, event));
                 sendWritebackAck(put);
-                mshr_->setData(addr, put->getPayload(), put->getDirty());
+                mshr_->setData(addr, put->getSharedPayload(), put->getDirty());
                 delete put;
                 sendFwdRequest(event, Command::FetchInv, upperCacheName_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
                 MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                 sendWritebackAck(put);
-                sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                sendResponseDown(event, put->getSize(), put->getSharedPayload(), put->getDirty());
                 mshr_->removeFront(addr);
                 delete put;
                 cleanUpAfterRequest(event, inMSHR);
@@ -1332,7 +1332,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 line->setState(state1);
             }
         } else {
-            sendResponseDown(event, event->getSize(), line->getData(), state == M);
+            sendResponseDown(event, event->getSize(), SharedPayload(line->getData()), state == M);
             line->setState(state2);
             cleanUpAfterRequest(event, inMSHR);
         }
@@ -1368,7 +1368,7 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (inMSHR && mshr_->hasData(addr)) { // Replay
-                sendResponseDown(event, event->getSize(), &(mshr_->getData(addr)), mshr_->getDataDirty(addr));
+                sendResponseDown(event, event->getSize(), mshr_->getSharedData(addr), mshr_->getDataDirty(addr));
                 mshr_->clearData(addr);
                 cleanUpAfterRequest(event, inMSHR);
                 break;
@@ -1390,14 +1390,14 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) {
                     MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                     sendWritebackAck(put);
-                    sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                    sendResponseDown(event, put->getSize(), put->getSharedPayload(), put->getDirty());
                     delete put;
                     mshr_->removeFront(addr);
                     cleanUpAfterRequest(event, inMSHR);
                     break;
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutE || mshr_->getFrontEvent(addr)->getCmd() == Command::PutM) {
                     MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-                    sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                    sendResponseDown(event, put->getSize(), put->getSharedPayload(), put->getDirty());
                     put->setCmd(Command::PutS); // Make this a PutS so we only record the block in shared later
                     put->setDirty(false);
                     delete event;
@@ -1423,7 +1423,7 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 }
                 break;
             }
-            sendResponseDown(event, event->getSize(), line->getData(), state == M);
+            sendResponseDown(event, event->getSize(), SharedPayload(line->getData()), state == M);
             line->setState(S);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -1467,7 +1467,7 @@ bool MESIPrivNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, line ? line->getTimestamp() : 0);
+    uint64_t sendTime = sendResponseUp(req, event->getSharedPayload(), true, line ? line->getTimestamp() : 0);
 
     // Update line
     if (line) {
@@ -1508,7 +1508,7 @@ bool MESIPrivNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
         {
-            sendExclusiveResponse(req, &(event->getPayload()), true, 0, event->getDirty());
+            sendExclusiveResponse(req, event->getSharedPayload(), true, 0, event->getDirty());
             cleanUpAfterResponse(event, inMSHR);
             break;
         }
@@ -1519,7 +1519,7 @@ bool MESIPrivNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             if (line->getShared())
                 line->setShared(false);
 
-            uint64_t sendTime = sendExclusiveResponse(req, line->getData(), true, line->getTimestamp(), event->getDirty());
+            uint64_t sendTime = sendExclusiveResponse(req, SharedPayload(line->getData()), true, line->getTimestamp(), event->getDirty());
             line->setTimestamp(sendTime-1);
             cleanUpAfterResponse(event, inMSHR);
             break;
@@ -1598,7 +1598,7 @@ bool MESIPrivNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
 
     if (state == I) { // Fetch or FetchInv
         MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-        sendResponseDown(req, event->getSize(), &(event->getPayload()), event->getDirty());
+        sendResponseDown(req, event->getSize(), event->getSharedPayload(), event->getDirty());
         cleanUpAfterResponse(event, inMSHR);
     } else {    // FetchInv only
         if (event->getDirty()) {
@@ -1643,7 +1643,7 @@ bool MESIPrivNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
 
     if (state == I) {
         MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-        sendResponseDown(req, event->getSize(), &(event->getPayload()), event->getDirty());
+        sendResponseDown(req, event->getSize(), event->getSharedPayload(), event->getDirty());
         cleanUpAfterResponse(event, inMSHR);
     } else {
         line->setOwned(false);
@@ -1696,7 +1696,7 @@ bool MESIPrivNoninclusive::handleAckInv(MemEvent * event, bool inMSHR) {
             {
             MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
             if (mshr_->hasData(addr) && req->getCmd() == Command::FetchInv)
-                sendResponseDown(req, req->getSize(), &(mshr_->getData(addr)), mshr_->getDataDirty(addr));
+                sendResponseDown(req, req->getSize(), mshr_->getSharedData(addr), mshr_->getDataDirty(addr));
             else
                 sendResponseDown(req, req->getSize(), nullptr, false);
             cleanUpAfterResponse(event, inMSHR);
@@ -1932,7 +1932,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
         case S:
             if (!mshr_->getPendingRetries(line->getAddr())) {
                 if (!line->getShared() && !silentEvictClean_) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutS, line->getData(), false, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutS, SharedPayload(line->getData()), false, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), false);
                     if (is_debug_addr(line->getAddr()))
@@ -1951,7 +1951,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
         case E:
             if (!mshr_->getPendingRetries(line->getAddr())) {
                 if (line->getShared()) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, line->getData(), false, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, SharedPayload(line->getData()), false, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), true);
                     if (is_debug_addr(addr) || is_debug_addr(line->getAddr()))
@@ -1959,7 +1959,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
                     if (is_debug_addr(line->getAddr()))
                         printDebugAlloc(false, line->getAddr(), "Writeback");
                 } else if (!line->getOwned() && !silentEvictClean_) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutE, line->getData(), false, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutE, SharedPayload(line->getData()), false, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), false);
                     if (is_debug_addr(line->getAddr()))
@@ -1977,7 +1977,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
         case M:
             if (!mshr_->getPendingRetries(line->getAddr())) {
                 if (line->getShared()) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, line->getData(), true, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, SharedPayload(line->getData()), true, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), true);
                     if (is_debug_addr(addr) || is_debug_addr(line->getAddr()))
@@ -1985,7 +1985,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
                     if (is_debug_addr(line->getAddr()))
                         printDebugAlloc(false, line->getAddr(), "Writeback");
                 } else if (!line->getOwned()) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutM, line->getData(), true, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutM, SharedPayload(line->getData()), true, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), false);
                     if (is_debug_addr(addr) || is_debug_addr(line->getAddr())) {
@@ -2137,15 +2137,15 @@ void MESIPrivNoninclusive::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool dirty) {
+uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t time, bool dirty) {
     MemEvent * responseEvent = event->makeResponse();
     responseEvent->setCmd(Command::GetXResp);
 
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
+        responseEvent->setPayload(data);
+        responseEvent->setSize(data.size()); // Return size that was written
         if (is_debug_event(event)) {
-            printDataValue(event->getAddr(), data, false);
+            printDataValue(event->getAddr(), &data.get(), false);
         }
         responseEvent->setDirty(dirty);
     }
@@ -2165,16 +2165,16 @@ uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<ui
     return deliveryTime;
 }
 
-uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
+        responseEvent->setPayload(data);
+        responseEvent->setSize(data.size()); // Return size that was written
         if (is_debug_event(event)) {
-            printDataValue(event->getAddr(), data, false);
+            printDataValue(event->getAddr(), &data.get(), false);
         }
     }
 
@@ -2197,11 +2197,11 @@ uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
     return deliveryTime;
 }
 
-void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vector<uint8_t>* data, bool dirty) {
+void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, const SharedPayload& data, bool dirty) {
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
-        responseEvent->setPayload(*data);
+        responseEvent->setPayload(data);
         responseEvent->setDirty(dirty);
     }
 
@@ -2218,14 +2218,14 @@ void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vec
 }
 
 
-uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, const SharedPayload& data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
     if (evict) {
         flush->setEvict(true);
         // TODO only send payload when needed
-        flush->setPayload(*data);
+        flush->setPayload(data);
         flush->setDirty(dirty);
         latency = accessLatency_;
     } else {
@@ -2257,7 +2257,7 @@ uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::v
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
 
-uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, std::vector<uint8_t>* data, bool dirty, uint64_t startTime) {
+uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, const SharedPayload& data, bool dirty, uint64_t startTime) {
     MemEvent* writeback = new MemEvent(cachename_, addr, addr, cmd);
     writeback->setSize(size);
 
@@ -2265,11 +2265,11 @@ uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command c
 
     /* Writeback data */
     if (dirty || writebackCleanBlocks_) {
-        writeback->setPayload(*data);
+        writeback->setPayload(data);
         writeback->setDirty(dirty);
 
         if (is_debug_addr(addr)) {
-            printDataValue(addr, data, false);
+            printDataValue(addr, &data.get(), false);
         }
 
         latency = accessLatency_;
@@ -108,9 +108,9 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
             if (data || mshr_->hasData(addr)) {
                 tag->addSharer(event->getSrc());
                 if (mshr_->hasData(addr))
-                    sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp());
+                    sendTime = sendResponseUp(event, mshr_->getSharedData(addr), inMSHR, tag->getTimestamp());
                 else
-                    sendTime = sendResponseUp(event, data->getData(), inMSHR, tag->getTimestamp());
+                    sendTime = sendResponseUp(event, SharedPayload(data->getData()), inMSHR, tag->getTimestamp());
                 tag->setTimestamp(sendTime-1);
                 recordLatencyType(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
@@ -176,9 +176,9 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                     tag->setOwner(event->getSrc());
                 }
                 if (mshr_->hasData(addr))
-                    sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), respcmd);
+                    sendTime = sendResponseUp(event, mshr_->getSharedData(addr), inMSHR, tag->getTimestamp(), respcmd);
                 else
-                    sendTime = sendResponseUp(event, data->getData(), inMSHR, tag->getTimestamp(), respcmd);
+                    sendTime = sendResponseUp(event, SharedPayload(data->getData()), inMSHR, tag->getTimestamp(), respcmd);
                 tag->setTimestamp(sendTime - 1);
                 cleanUpAfterRequest(event, inMSHR);
             } else {
@@ -308,9 +308,9 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
                     tag->removeSharer(event->getSrc());
                     sendTime = sendResponseUp(event, nullptr, inMSHR, tag->getTimestamp(), Command::GetXResp);
                 } else if (mshr_->hasData(addr))
-                    sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), Command::GetXResp);
+                    sendTime = sendResponseUp(event, mshr_->getSharedData(addr), inMSHR, tag->getTimestamp(), Command::GetXResp);
                 else
-                    sendTime = sendResponseUp(event, data->getData(), inMSHR, tag->getTimestamp(), Command::GetXResp);
+                    sendTime = sendResponseUp(event, SharedPayload(data->getData()), inMSHR, tag->getTimestamp(), Command::GetXResp);
                 tag->setTimestamp(sendTime - 1);
                 recordLatencyType(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
@@ -432,9 +432,9 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
                     break;
                 }
                 if (data)
-                    forwardFlush(event, true, data->getData(), tag->getState() == M, tag->getTimestamp());
+                    forwardFlush(event, true, SharedPayload(data->getData()), tag->getState() == M, tag->getTimestamp());
                 else
-                    forwardFlush(event, true, &(mshr_->getData(addr)), tag->getState() == M, tag->getTimestamp());
+                    forwardFlush(event, true, mshr_->getSharedData(addr), tag->getState() == M, tag->getTimestamp());
                 tag->getState() == E ? tag->setState(E_B) : tag->setState(M_B);
                 mshr_->setInProgress(addr);
             }
@@ -524,9 +524,9 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool inMSHR) {
                 }
 
                 if (data)
-                    forwardFlush(event, true, data->getData(), false, tag->getTimestamp());
+                    forwardFlush(event, true, SharedPayload(data->getData()), false, tag->getTimestamp());
                 else
-                    forwardFlush(event, true, &(mshr_->getData(addr)), false, tag->getTimestamp());
+                    forwardFlush(event, true, mshr_->getSharedData(addr), false, tag->getTimestamp());
                 mshr_->setInProgress(addr);
                 tag->setState(I_B);
             }
@@ -554,9 +554,9 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool inMSHR) {
                     tag->getState() == E ? tag->setState(E_Inv) : tag->setState(M_Inv);
                 } else {
                     if (data)
-                        forwardFlush(event, true, data->getData(), tag->getState() == M, tag->getTimestamp());
+                        forwardFlush(event, true, SharedPayload(data->getData()), tag->getState() == M, tag->getTimestamp());
                     else
-                        forwardFlush(event, true, &(mshr_->getData(addr)), tag->getState() == M, tag->getTimestamp());
+                        forwardFlush(event, true, mshr_->getSharedData(addr), tag->getState() == M, tag->getTimestamp());
                     mshr_->setInProgress(addr);
                     tag->setState(I_B);
                 }
@@ -654,7 +654,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                 data = dataArray_->lookup(addr, true);
                 data->setData(event->getPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->getSharedPayload().get()), true);
                 inMSHR = true;
             }
             if (!inMSHR || !mshr_->getProfiled(addr)) {
@@ -698,7 +698,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
             if (event->getSrc() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
                 // Retry the pending fetch
                 mshr_->decrementAcksNeeded(addr);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty())
                     responses.erase(addr);
@@ -783,7 +783,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                 data = dataArray_->lookup(addr, true);
                 data->setData(event->getPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->getSharedPayload().get()), true);
                 inMSHR = true;
             }
             tag->removeOwner();
@@ -798,7 +798,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -828,7 +828,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -889,7 +889,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 data = dataArray_->lookup(addr, true);
                 data->setData(event->getPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->getSharedPayload().get()), true);
                 inMSHR = true;
             } else if (!inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutM][state]->addData(1);
@@ -918,13 +918,13 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 }
                 data->setData(event->getPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->getSharedPayload().get()), true);
                 sendWritebackAck(event);
                 cleanUpEvent(event, inMSHR);
             } else {
                 tag->addSharer(event->getSrc());
                 event->setCmd(Command::PutS);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
                 if (inMSHR)
                     mshr_->removeFront(addr); // Need to reinsert after the conflicting request
                 MemEventBase* entry = mshr_->getEntryEvent(addr, 1);
@@ -945,7 +945,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -1001,7 +1001,7 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             if (data) {
                 data->setData(event->getPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->getSharedPayload().get()), true);
             }
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -1015,10 +1015,10 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             if (data)
                 data->setData(event->getPayload(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
             
             if (is_debug_addr(addr))
-                printDataValue(addr, &(event->getPayload()), true);
+                printDataValue(addr, &(event->getSharedPayload().get()), true);
 
             mshr_->decrementAcksNeeded(addr);
 
@@ -1032,10 +1032,10 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             if (data)
                 data->setData(event->getPayload(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
             
             if (is_debug_addr(addr))
-                printDataValue(addr, &(event->getPayload()), true);
+                printDataValue(addr, &(event->getSharedPayload().get()), true);
 
             cleanUpEvent(event, inMSHR);
             break;
@@ -1084,10 +1084,10 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::Fetch][state]->addData(1);
             }
             if (data) {
-                sendResponseDown(event, data->getData(), false, false);
+                sendResponseDown(event, SharedPayload(data->getData()), false, false);
                 cleanUpEvent(event, inMSHR);
             } else if (mshr_->hasData(addr)) {
-                sendResponseDown(event, &(mshr_->getData(addr)), false, false);
+                sendResponseDown(event, mshr_->getSharedData(addr), false, false);
                 cleanUpEvent(event, inMSHR);
             } else {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
@@ -1102,7 +1102,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
         case SA:
             //Look for a PutS in the MSHR
             put = static_cast<MemEvent*>(mshr_->getFirstEventEntry(addr, Command::PutS));
-            sendResponseDown(event, &(put->getPayload()), false, false);
+            sendResponseDown(event, put->getSharedPayload(), false, false);
             stat_eventState[(int)Command::Fetch][state]->addData(1);
             cleanUpEvent(event, inMSHR);
             break;
@@ -1111,10 +1111,10 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::Fetch][state]->addData(1);
             }
             if (data) {
-                sendResponseDown(event, data->getData(), false, false);
+                sendResponseDown(event, SharedPayload(data->getData()), false, false);
                 cleanUpEvent(event, inMSHR);
             } else if (mshr_->hasData(addr)) {
-                sendResponseDown(event, &(mshr_->getData(addr)), false, false);
+                sendResponseDown(event, mshr_->getSharedData(addr), false, false);
                 cleanUpEvent(event, inMSHR);
             } else {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
@@ -1135,10 +1135,10 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::Fetch][state]->addData(1);
             }
             if (data) {
-                sendResponseDown(event, data->getData(), false, false);
+                sendResponseDown(event, SharedPayload(data->getData()), false, false);
                 cleanUpEvent(event, inMSHR);
             } else if (mshr_->hasData(addr)) {
-                sendResponseDown(event, &(mshr_->getData(addr)), false, false);
+                sendResponseDown(event, mshr_->getSharedData(addr), false, false);
                 cleanUpEvent(event, inMSHR);
             } else {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
@@ -1544,9 +1544,9 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                         invalidateSharers(event, tag, inMSHR, !(data || mshr_->hasData(addr)), Command::Inv);
                 } else {
                     if (data)
-                        sendResponseDown(event, data->getData(), false, true);
+                        sendResponseDown(event, SharedPayload(data->getData()), false, true);
                     else {
-                        sendResponseDown(event, &(mshr_->getData(addr)), false, true);
+                        sendResponseDown(event, mshr_->getSharedData(addr), false, true);
                         mshr_->clearData(addr);
                     }
                     dirArray_->deallocate(tag);
@@ -1578,9 +1578,9 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                     state == E ? tag->setState(E_Inv) : tag->setState(M_Inv);
                 } else {
                     if (data)
-                        sendResponseDown(event, data->getData(), state == M, true);
+                        sendResponseDown(event, SharedPayload(data->getData()), state == M, true);
                     else {
-                        sendResponseDown(event, &(mshr_->getData(addr)), state == M, true);
+                        sendResponseDown(event, mshr_->getSharedData(addr), state == M, true);
                         mshr_->clearData(addr);
                     }
                     dirArray_->deallocate(tag);
@@ -1607,10 +1607,10 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                     tag->setState(SB_Inv);
                 } else {
                     if (data) {
-                        sendResponseDown(event, data->getData(), false, true);
+                        sendResponseDown(event, SharedPayload(data->getData()), false, true);
                         dataArray_->deallocate(data);
                     } else {
-                        sendResponseDown(event, &(mshr_->getData(addr)), false, true);
+                        sendResponseDown(event, mshr_->getSharedData(addr), false, true);
                         mshr_->clearData(addr);
                     }
                     dirArray_->deallocate(tag);
@@ -1633,7 +1633,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
             // TODO make sure the pending eviction won't mess anything up when it tries to replay
             put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
             sendWritebackAck(put);
-            sendResponseDown(event, &(put->getPayload()), state == MA, true);
+            sendResponseDown(event, put->getSharedPayload(), state == MA, true);
             dirArray_->deallocate(tag);
             if (mshr_->hasData(addr))
                 mshr_->clearData(addr);
@@ -1647,9 +1647,9 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 }
                 tag->setState(IM);
                 if (data)
-                    sendResponseDown(event, data->getData(), false, true);
+                    sendResponseDown(event, SharedPayload(data->getData()), false, true);
                 else
-                    sendResponseDown(event, &(mshr_->getData(addr)), false, true);
+                    sendResponseDown(event, mshr_->getSharedData(addr), false, true);
                 tag->setState(IM);
                 if (mshr_->hasData(addr))
                     mshr_->clearData(addr);
@@ -1782,9 +1782,9 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
             } else {
                 tag->setState(S);
                 if (data)
-                    sendResponseDown(event, data->getData(), state == M, true); // TODO Double check that a downgrade counts as an evict
+                    sendResponseDown(event, SharedPayload(data->getData()), state == M, true); // TODO Double check that a downgrade counts as an evict
                 else {
-                    sendResponseDown(event, &(mshr_->getData(addr)), state == M, true);
+                    sendResponseDown(event, mshr_->getSharedData(addr), state == M, true);
                 }
                 cleanUpAfterRequest(event, inMSHR);
             }
@@ -1795,7 +1795,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::FetchInvX][state]->addData(1);
             }
             req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-            sendResponseDown(event, &(req->getPayload()), state == M, true); // TODO Double check that a downgrade counts as an evict
+            sendResponseDown(event, req->getSharedPayload(), state == M, true); // TODO Double check that a downgrade counts as an evict
             // Clean up so that when we replay the replacement we get the right downgraded state
             req->setCmd(Command::PutS);
             tag->removeOwner();
@@ -1852,7 +1852,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     if (data) {
         data->setData(event->getPayload(), 0);
         if (is_debug_addr(addr))
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->getSharedPayload().get()), true);
     }
 
     if (localPrefetch) {
@@ -1861,7 +1861,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
             eventDI.action = "Done";
     } else {
         tag->addSharer(req->getSrc());
-        uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
+        uint64_t sendTime = sendResponseUp(req, event->getSharedPayload(), true, tag->getTimestamp(), Command::GetSResp);
         tag->setTimestamp(sendTime-1);
     }
 
@@ -1897,7 +1897,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     if (data) {
         data->setData(event->getPayload(), 0);
         if (is_debug_addr(addr))
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->getSharedPayload().get()), true);
     }
 
     stat_eventState[(int)Command::GetXResp][state]->addData(1);
@@ -1918,11 +1918,11 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             } else {
                 if (tag->getState() == S || !protocol_ || mshr_->getSize(addr) > 1) {
                     tag->addSharer(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
+                    uint64_t sendTime = sendResponseUp(req, event->getSharedPayload(), true, tag->getTimestamp(), Command::GetSResp);
                     tag->setTimestamp(sendTime - 1);
                 } else {
                     tag->setOwner(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
+                    uint64_t sendTime = sendResponseUp(req, event->getSharedPayload(), true, tag->getTimestamp(), Command::GetXResp);
                     tag->setTimestamp(sendTime - 1);
                 }
             }
@@ -1940,9 +1940,9 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
                 tag->removeSharer(req->getSrc());
                 sendTime = sendResponseUp(req, nullptr, true, tag->getTimestamp(), Command::GetXResp);
             } else if (event->getPayloadSize() != 0) {
-                sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
+                sendTime = sendResponseUp(req, event->getSharedPayload(), true, tag->getTimestamp(), Command::GetXResp);
             } else {
-                sendTime = sendResponseUp(req, &(mshr_->getData(addr)), true, tag->getTimestamp(), Command::GetXResp);
+                sendTime = sendResponseUp(req, mshr_->getSharedData(addr), true, tag->getTimestamp(), Command::GetXResp);
             }
             tag->setTimestamp(sendTime - 1);
 
@@ -1956,7 +1956,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             tag->setState(M_Inv);
             mshr_->setInProgress(addr, false);
             if (!data && event->getPayloadSize() != 0)
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getSharedPayload());
             if (is_debug_event(event)) {
                 eventDI.action = "Stall";
                 eventDI.reason = "Acks needed";
@@ -2045,10 +2045,10 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
     if (data)
         data->setData(event->getPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getSharedPayload());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, &(event->getSharedPayload().get()), true);
 
     stat_eventState[(int)Command::FetchResp][state]->addData(1);
 
@@ -2149,10 +2149,10 @@ bool MESISharNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
     if (data)
         data->setData(event->getPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getSharedPayload());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, &(event->getSharedPayload().get()), true);
 
     // Clean up and retry
     retry(addr);
@@ -2783,17 +2783,17 @@ void MESISharNoninclusive::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
     /* Only return the desired word */
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
+        responseEvent->setPayload(data);
+        responseEvent->setSize(data.size()); // Return size that was written
         if (is_debug_event(event)) {
-            printDataValue(event->getBaseAddr(), data, false);
+            printDataValue(event->getBaseAddr(), &data.get(), false);
         }
     }
 
@@ -2811,11 +2811,11 @@ uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
     return deliveryTime;
 }
 
-void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_t> * data, bool dirty, bool evict) {
+void MESISharNoninclusive::sendResponseDown(MemEvent * event, const SharedPayload& data, bool dirty, bool evict) {
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
-        responseEvent->setPayload(*data);
+        responseEvent->setPayload(data);
         responseEvent->setDirty(dirty);
     }
 
@@ -2831,14 +2831,14 @@ void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_
 }
 
 
-uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, const SharedPayload& data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
     if (evict) {
         flush->setEvict(true);
         // TODO only send payload when needed
-        flush->setPayload(*data);
+        flush->setPayload(data);
         flush->setDirty(dirty);
         latency = accessLatency_;
     } else {
@@ -2902,11 +2902,11 @@ void MESISharNoninclusive::sendWritebackFromMSHR(Command cmd, DirectoryLine* tag
 
     /* Writeback data */
     if (dirty || writebackCleanBlocks_) {
-        writeback->setPayload(mshr_->getData(tag->getAddr()));
+        writeback->setPayload(mshr_->getSharedData(tag->getAddr()));
         writeback->setDirty(dirty);
 
         if (is_debug_addr(tag->getAddr())) {
-            printDataValue(tag->getAddr(), &(mshr_->getData(tag->getAddr())), false);
+            printDataValue(tag->getAddr(), &(mshr_->getSharedData(tag->getAddr()).get()), false);
         }
 
         latency = accessLatency_;
@@ -3139,7 +3139,7 @@ void MESISharNoninclusive::removeSharerViaInv(MemEvent * event, DirectoryLine *
     Addr addr = event->getBaseAddr();
     tag->removeSharer(event->getSrc());
     if (!data && !mshr_->hasData(addr))
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getSharedPayload());
 
     if (remove) {
         responses.find(addr)->second.erase(event->getSrc());
@@ -3154,10 +3154,10 @@ void MESISharNoninclusive::removeOwnerViaInv(MemEvent * event, DirectoryLine * t
     if (data) 
         data->setData(event->getPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getSharedPayload());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, &(event->getSharedPayload().get()), true);
 
     if (event->getDirty()) {
         if (tag->getState() == E)
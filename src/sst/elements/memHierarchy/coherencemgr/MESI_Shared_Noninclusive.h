@@ -277,14 +277,14 @@ public:
 
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        dataArray_ = new CacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        dataArray_ = createCacheArray<DataLine>(lines, assoc, rmgr, ht, params);
         dataArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         uint64_t dLines = params.find<uint64_t>("dlines");
         uint64_t dAssoc = params.find<uint64_t>("dassoc");
         params.insert("replacement_policy", params.find<std::string>("drpolicy", "lru"));
         ReplacementPolicy *drmgr = createReplacementPolicy(dLines, dAssoc, params, false, 1);
-        dirArray_ = new CacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht);
+        dirArray_ = createCacheArray<DirectoryLine>(dLines, dAssoc, drmgr, ht, params);
         dirArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         /* Statistics */
@@ -594,13 +594,13 @@ private:
     bool invalidateOwner(MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::FetchInv);
 
     /** Forward a flush line request, with or without data */
-    uint64_t forwardFlush(MemEvent* event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time);
+    uint64_t forwardFlush(MemEvent* event, bool evict, const SharedPayload& data, bool dirty, uint64_t time);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = true);
+    uint64_t sendResponseUp(MemEvent * event, const SharedPayload& data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = true);
 
     /** Send response down (towards memory) */
-    void sendResponseDown(MemEvent* event, std::vector<uint8_t>* data, bool dirty, bool evict);
+    void sendResponseDown(MemEvent* event, const SharedPayload& data, bool dirty, bool evict);
 
     /** Send writeback request to lower level caches */
     void sendWritebackFromCache(Command cmd, DirectoryLine* tag, DataLine* data, bool dirty);
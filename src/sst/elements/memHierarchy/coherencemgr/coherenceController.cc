@@ -331,8 +331,10 @@ bool CoherenceController::sendOutgoingEvents() {
     timestamp_++;
 
     // Check for ready events in outgoing 'down' queue
+    // A link with lookahead adds that many cycles of latency so its events are sent that many cycles early
     uint64_t bytesLeft = maxBytesDown;
-    while (!outgoingEventQueueDown_.empty() && outgoingEventQueueDown_.front().deliveryTime <= timestamp_) {
+    uint64_t sendTime = timestamp_ + linkDown_->getLookahead();
+    while (!outgoingEventQueueDown_.empty() && outgoingEventQueueDown_.front().deliveryTime <= sendTime) {
         MemEventBase *outgoingEvent = outgoingEventQueueDown_.front().event;
         if (maxBytesDown != 0) {
             if (bytesLeft == 0) break;
@@ -357,7 +359,8 @@ bool CoherenceController::sendOutgoingEvents() {
 
     // Check for ready events in outgoing 'up' queue
     bytesLeft = maxBytesUp;
-    while (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime <= timestamp_) {
+    sendTime = timestamp_ + linkUp_->getLookahead();
+    while (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime <= sendTime) {
         MemEventBase * outgoingEvent = outgoingEventQueueUp_.front().event;
         if (maxBytesUp != 0) {
             if (bytesLeft == 0) break;
@@ -392,6 +395,26 @@ bool CoherenceController::checkIdle() {
     return outgoingEventQueueDown_.empty() && outgoingEventQueueUp_.empty();
 }
 
+/* Queues are ordered by delivery time so only the fronts matter. A front that is already due
+ * (e.g., held back by link bandwidth) will be sent next cycle */
+uint64_t CoherenceController::getNextSendTime() {
+    uint64_t next = UINT64_MAX;
+    if (!outgoingEventQueueDown_.empty()) {
+        uint64_t send = outgoingEventQueueDown_.front().deliveryTime;
+        send = send > linkDown_->getLookahead() ? send - linkDown_->getLookahead() : 0;
+        next = send;
+    }
+    if (!outgoingEventQueueUp_.empty()) {
+        uint64_t send = outgoingEventQueueUp_.front().deliveryTime;
+        send = send > linkUp_->getLookahead() ? send - linkUp_->getLookahead() : 0;
+        if (send < next)
+            next = send;
+    }
+    if (next <= timestamp_)
+        next = timestamp_ + 1;
+    return next;
+}
+
 
 /* Forward an event using memory address to locate a destination. */
 void CoherenceController::forwardByAddress(MemEventBase * event) {
@@ -400,15 +423,11 @@ void CoherenceController::forwardByAddress(MemEventBase * event) {
 
 void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
     event->setSrc(cachename_);
-    std::string dst = linkDown_->findTargetDestination(event->getRoutingAddress());
-    if (dst != "") { /* Common case */
-        event->setDst(dst);
+    if (linkDown_->routeByAddress(event)) { /* Common case */
         Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
         addToOutgoingQueue(fwdReq);
     } else {
-        dst = linkUp_->findTargetDestination(event->getRoutingAddress());
-        if (dst != "") {
-            event->setDst(dst);
+        if (linkUp_->routeByAddress(event)) {
             Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
             addToOutgoingQueueUp(fwdReq);
         } else {
@@ -497,6 +516,7 @@ void CoherenceController::notifyListenerOfAccess(MemEvent * event, NotifyAccessT
 
     CacheListenerNotification notify(event->getAddr(), event->getBaseAddr(), event->getVirtualAddress(),
             event->getInstructionPointer(), event->getSize(), accessT, resultT);
+    notify.setRequestor(event->getRqstr());
 
     for (int i = 0; i < listeners_.size(); i++)
         listeners_[i]->notifyAccess(notify);
@@ -513,7 +533,7 @@ void CoherenceController::notifyListenerOfEvict(Addr addr, uint32_t size, Addr i
 
 
 /* Forward a message to a lower level (towards memory) in the hierarchy */
-uint64_t CoherenceController::forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data, Command fwdCmd) {
+uint64_t CoherenceController::forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, const SharedPayload& data, Command fwdCmd) {
     /* Create event to be forwarded */
     MemEvent* forwardEvent;
     forwardEvent = new MemEvent(*event);
@@ -522,11 +542,11 @@ uint64_t CoherenceController::forwardMessage(MemEvent * event, unsigned int requ
         forwardEvent->setCmd(fwdCmd);
     }
 
-    if (data == nullptr) forwardEvent->setPayload(0, nullptr);
+    if (!data) forwardEvent->setPayload(0, nullptr);
 
     forwardEvent->setSize(requestSize);
 
-    if (data != nullptr) forwardEvent->setPayload(*data);
+    if (data) forwardEvent->setPayload(data);
 
     /* Determine latency in cycles */
     uint64_t deliveryTime;
@@ -575,22 +595,22 @@ void CoherenceController::resendEvent(MemEvent * event, bool towardsCPU) {
 
 
 /* Send response up (towards CPU). L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, const SharedPayload& data, bool replay, uint64_t baseTime, bool success) {
     return sendResponseUp(event, CommandResponse[(int)event->getCmd()], data, false, replay, baseTime, success);
 }
 
 
 /* Send response up (towards CPU). L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, const SharedPayload& data, bool replay, uint64_t baseTime, bool success) {
     return sendResponseUp(event, cmd, data, false, replay, baseTime, success);
 }
 
 
 /* Send response towards the CPU. L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool success) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, const SharedPayload& data, bool dirty, bool replay, uint64_t baseTime, bool success) {
     MemEvent * responseEvent = event->makeResponse(cmd);
     responseEvent->setSize(event->getSize());
-    if (data != nullptr) responseEvent->setPayload(*data);
+    if (data) responseEvent->setPayload(data);
     responseEvent->setDirty(dirty);
 
     if (!success)
@@ -699,7 +719,7 @@ void CoherenceController::printDebugAlloc(bool alloc, Addr addr, std::string not
         debug->debug(_L5_, "\n");
 }
 
-void CoherenceController::printDataValue(Addr addr, vector<uint8_t> * data, bool set) {
+void CoherenceController::printDataValue(Addr addr, const vector<uint8_t> * data, bool set) {
     if (dlevel < 11)
         return;
 
@@ -32,6 +32,8 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/hash.h"
+#include "sst/elements/memHierarchy/cacheArray.h"
+#include "sst/elements/memHierarchy/flatCacheArray.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -110,6 +112,9 @@ public:
     /* Check whether the event queues are empty/subcomponent is doing anything */
     bool checkIdle();
 
+    /* Earliest cycle at which sendOutgoingEvents() can send something. Always later than the current cycle. UINT64_MAX if nothing is queued */
+    uint64_t getNextSendTime();
+
     /* Get which bank an address maps to (call through to cache array) */
     virtual Addr getBank(Addr addr) = 0;
 
@@ -192,7 +197,7 @@ protected:
     virtual void notifyListenerOfEvict(Addr addr, uint32_t size, uint64_t ip);
 
     /* Forward a message to a lower memory level (towards memory) */
-    uint64_t forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data, Command fwdCmd = Command::LAST_CMD);
+    uint64_t forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, const SharedPayload& data, Command fwdCmd = Command::LAST_CMD);
 
     /* Insert event into MSHR */
     MemEventStatus allocateMSHR(MemEvent * event, bool fwdReq, int pos = -1, bool stallEvict = false);
@@ -235,12 +240,24 @@ protected:
 
     virtual void printDebugInfo(dbgin * diStruct);
     virtual void printDebugAlloc(bool alloc, Addr addr, std::string note);
-    virtual void printDataValue(Addr addr, vector<uint8_t> * data, bool set);
+    virtual void printDataValue(Addr addr, const vector<uint8_t> * data, bool set);
 
     /* Initialization */
     ReplacementPolicy * createReplacementPolicy(uint64_t lines, uint64_t assoc, Params& params, bool L1, int slotnum = 0);
     HashFunction * createHashFunction(Params& params);
 
+    /* Create a cache array of the type selected by the 'array_type' parameter */
+    template <class T>
+    CacheArray<T> * createCacheArray(uint64_t lines, uint64_t assoc, ReplacementPolicy* rmgr, HashFunction* ht, Params& params) {
+        std::string type = params.find<std::string>("array_type", "default");
+        to_lower(type);
+        if (type == "flat")
+            return new FlatCacheArray<T>(debug, lines, assoc, lineSize_, rmgr, ht);
+        if (type != "default")
+            debug->fatal(CALL_INFO, -1, "%s, Invalid param: array_type - supported types are 'default' and 'flat'. You specified '%s'.\n", getName().c_str(), type.c_str());
+        return new CacheArray<T>(debug, lines, assoc, lineSize_, rmgr, ht);
+    }
+
     /*********************************************************************************
      * Data members
      *********************************************************************************/
@@ -308,9 +325,9 @@ protected:
     /* Add a new event to the outgoing command queue towards the CPU */
     virtual void addToOutgoingQueueUp(Response& resp);
 
-    virtual uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success = true);
-    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success = true);
-    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool success = true);
+    virtual uint64_t sendResponseUp(MemEvent * event, const SharedPayload& data, bool replay, uint64_t baseTime, bool success = true);
+    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, const SharedPayload& data, bool replay, uint64_t baseTime, bool success = true);
+    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, const SharedPayload& data, bool dirty, bool replay, uint64_t baseTime, bool success = true);
 
     std::string getSrc();
 
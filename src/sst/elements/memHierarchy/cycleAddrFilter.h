@@ -0,0 +1,99 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_CYCLEADDRFILTER_H_
+#define MEMHIERARCHY_CYCLEADDRFILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Set of addresses accessed in the current cycle
+ *
+ * Open-addressed (linear probing) table. Each slot is stamped with the cycle ("generation")
+ * it was written in, so clearing the set at the start of a cycle is a single increment.
+ * Sized from max_requests_per_cycle and grown if more addresses are accessed in one cycle.
+ */
+class CycleAddrFilter {
+public:
+    CycleAddrFilter(size_t expected = 8) : generation_(1), count_(0) { resize(expected); }
+
+    void clear() {
+        generation_++;
+        count_ = 0;
+    }
+
+    bool contains(uint64_t addr) const {
+        for (size_t i = slot(addr); slots_[i].generation == generation_; i = (i + 1) & mask_) {
+            if (slots_[i].addr == addr)
+                return true;
+        }
+        return false;
+    }
+
+    void insert(uint64_t addr) {
+        if (2 * (count_ + 1) > slots_.size())
+            grow();
+        size_t i = slot(addr);
+        for (; slots_[i].generation == generation_; i = (i + 1) & mask_) {
+            if (slots_[i].addr == addr)
+                return;
+        }
+        slots_[i].addr = addr;
+        slots_[i].generation = generation_;
+        count_++;
+    }
+
+private:
+    struct Slot {
+        uint64_t addr;
+        uint64_t generation;
+    };
+
+    inline size_t slot(uint64_t addr) const { return (size_t)((addr * 0x9E3779B97F4A7C15ULL) >> 32) & mask_; }
+
+    void resize(size_t expected) {
+        size_t size = 4;
+        while (size < 2 * expected)
+            size <<= 1;
+        slots_.assign(size, Slot{0, 0});
+        mask_ = size - 1;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        uint64_t generation = generation_;
+        resize(old.size());
+        generation_ = 1;
+        count_ = 0;
+        for (std::vector<Slot>::iterator it = old.begin(); it != old.end(); it++) {
+            if (it->generation == generation)
+                insert(it->addr);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+    uint64_t generation_;
+    size_t count_;
+};
+
+}}
+
+#endif
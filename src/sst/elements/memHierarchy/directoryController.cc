@@ -21,6 +21,7 @@
 #include <sst/core/simulation.h>
 
 #include "memNIC.h"
+#include "pooledMSHR.h"
 
 /* Debug macros */
 #ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
@@ -294,6 +295,7 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     stat_dirEntryReads              = registerStatistic<uint64_t>("eventSent_read_directory_entry");
     stat_dirEntryWrites             = registerStatistic<uint64_t>("eventSent_write_directory_entry");
     stat_MSHROccupancy              = registerStatistic<uint64_t>("MSHR_occupancy");
+    stat_payloadBytesCopied         = registerStatistic<uint64_t>("Payload_bytes_copied");
 
     // Coherence part
 
@@ -305,6 +307,28 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     entryCacheSize = 0;
     entrySize = 4; // Bytes, TODO parameterize
 
+    uint64_t sparseEntryCount = params.find<uint64_t>("sparse_entries", 0);
+    sparseAssoc = 0;
+    sparseSets = 0;
+    sparseUseCount = 0;
+    if (sparseEntryCount != 0) {
+        sparseAssoc = params.find<uint32_t>("sparse_associativity", 8);
+        if (sparseAssoc == 0 || sparseEntryCount % sparseAssoc != 0)
+            out.fatal(CALL_INFO, -1, "Invalid param(%s): sparse_associativity - must be at least 1 and divide sparse_entries evenly. You specified: sparse_entries = %" PRIu64 ", sparse_associativity = %" PRIu32 "\n",
+                    getName().c_str(), sparseEntryCount, sparseAssoc);
+        sparseSets = sparseEntryCount / sparseAssoc;
+        sparseEntries.assign(sparseEntryCount, DirEntry(0, &sharerIds));
+        for (std::vector<DirEntry>::iterator it = sparseEntries.begin(); it != sparseEntries.end(); it++) {
+            it->setState(NP); // Empty
+            it->cacheIter = entryCache.end();
+        }
+
+        stat_dirAllocations     = registerStatistic<uint64_t>("directory_entry_allocations");
+        stat_dirEvictions       = registerStatistic<uint64_t>("directory_evictions");
+        stat_dirEvictionInvs    = registerStatistic<uint64_t>("directory_eviction_invalidations");
+        stat_dirSetConflicts    = registerStatistic<uint64_t>("directory_set_conflicts");
+    }
+
     string protstr  = params.find<std::string>("coherence_protocol", "MESI");
     if (protstr == "mesi" || protstr == "MESI") protocol = CoherenceProtocol::MESI;
     else if (protstr == "msi" || protstr == "MSI") protocol = CoherenceProtocol::MSI;
@@ -312,7 +336,14 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
 
     int mshrSize    = params.find<int>("mshr_num_entries",-1);
     if (mshrSize == 0) dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_num_entries - must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
-    mshr                = new MSHR(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    std::string mshrType = params.find<std::string>("mshr_type", "default");
+    to_lower(mshrType);
+    if (mshrType == "pooled")
+        mshr            = new PooledMSHR(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    else if (mshrType == "default")
+        mshr            = new MSHR(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    else
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_type - must be 'default' or 'pooled'. You specified: %s\n", getName().c_str(), mshrType.c_str());
 
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
@@ -365,6 +396,7 @@ void DirectoryController::handlePacket(SST::Event *event){
 bool DirectoryController::clock(SST::Cycle_t cycle){
     timestamp = cycle;
     stat_MSHROccupancy->addData(mshr->getSize());
+    uint64_t bytesCopied = SharedPayload::getBytesCopied();
 
     sendOutgoingEvents();
 
@@ -415,6 +447,13 @@ bool DirectoryController::clock(SST::Cycle_t cycle){
     idle &= (eventBuffer.empty() && retryBuffer.empty());
     idle &= (cpuMsgQueue.empty() && memMsgQueue.empty());
 
+    if (sparseAssoc && !directory.empty())
+        releaseSparseEntries();
+
+    bytesCopied = SharedPayload::getBytesCopied() - bytesCopied;
+    if (bytesCopied != 0)
+        stat_payloadBytesCopied->addData(bytesCopied);
+
    if (idle && clockOn) {
         clockOn = false;
         lastActiveClockCycle = timestamp;
@@ -462,6 +501,9 @@ bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
         return true;
     }
 
+    if (sparseAssoc)
+        prepareSparseEntry(addr, cmd);
+
     switch (cmd) {
         case Command::GetS:
             retval = handleGetS(ev, replay);
@@ -600,6 +642,13 @@ void DirectoryController::printStatus(Output &statusOut) {
     for (std::unordered_map<Addr, DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
         statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString().c_str());
     }
+    if (sparseAssoc) {
+        statusOut.output("  Sparse directory entries (%" PRIu64 " sets, %" PRIu32 " ways):\n", sparseSets, sparseAssoc);
+        for (size_t i = 0; i < sparseEntries.size(); i++) {
+            if (sparseEntries[i].getState() != NP)
+                statusOut.output("    %zu: 0x%" PRIx64 " %s\n", i, sparseEntries[i].getBaseAddr(), sparseEntries[i].getString().c_str());
+        }
+    }
     statusOut.output("End MemHierarchy::DirectoryController\n\n");
 }
 
@@ -712,6 +761,14 @@ void DirectoryController::setup(void){
     cpuLink->setup();
     if (cpuLink != memLink)
         memLink->setup();
+
+    // Number the known sources in name order so that sharers are visited in the same order as before
+    std::set<std::string> names;
+    std::set<MemLinkBase::EndpointInfo>* sources = cpuLink->getSources();
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = sources->begin(); it != sources->end(); it++)
+        names.insert(it->name);
+    for (std::set<std::string>::iterator it = names.begin(); it != names.end(); it++)
+        sharerIds.getId(*it);
     //MemLinkBase * mem = memLink ? memLink : network;
 }
 
@@ -753,16 +810,16 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                     out.output("ALERT (%s): mshr should NOT have data for 0x%" PRIx64 " but it does...\n", getName().c_str(), addr);
                 else {
                     if (incoherentSrc.find(event->getSrc()) != incoherentSrc.end()) {
-                        sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
+                        sendDataResponse(event, entry, mshr->getSharedData(addr), Command::GetSResp);
                     } else if (protocol == CoherenceProtocol::MESI) {
                         entry->setState(M);
                         entry->setOwner(event->getSrc());
-                        sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
+                        sendDataResponse(event, entry, mshr->getSharedData(addr), Command::GetXResp);
                         mshr->clearData(addr);
                     } else {
                         entry->setState(S);
                         entry->addSharer(event->getSrc());
-                        sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
+                        sendDataResponse(event, entry, mshr->getSharedData(addr), Command::GetSResp);
                     }
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -786,7 +843,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                 if (incoherentSrc.find(event->getSrc()) == incoherentSrc.end()) {
                     entry->addSharer(event->getSrc());
                 }
-                sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
+                sendDataResponse(event, entry, mshr->getSharedData(addr), Command::GetSResp);
                 if (is_debug_event(event)) {
                     eventDI.reason = "hit";
                     eventDI.action = "Done";
@@ -868,7 +925,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
                         entry->setState(M);
                         entry->setOwner(event->getSrc());
                     }
-                    sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
+                    sendDataResponse(event, entry, mshr->getSharedData(addr), Command::GetXResp);
                     mshr->clearData(addr);
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -1090,7 +1147,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
                 if (event->getEvict()) {
                     entry->removeOwner();
                     entry->addSharer(event->getSrc());
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    mshr->setData(addr, event->getSharedPayload(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
                     issueFetch(event, entry, Command::FetchInvX);
@@ -1105,7 +1162,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeOwner();
                 entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->getSharedPayload(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
             }
@@ -1114,7 +1171,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeOwner();
                 entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->getSharedPayload(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
                 responses.find(addr)->second.erase(event->getSrc());
@@ -1187,7 +1244,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    mshr->setData(addr, event->getSharedPayload(), event->getDirty());
                     event->setEvict(false);
                 }
 
@@ -1219,7 +1276,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->getSharedPayload(), event->getDirty());
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1409,14 +1466,14 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
             update = true;
             break;
         case M_Inv:
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getSharedPayload(), event->getDirty());
             entry->setState(S_Inv);
             break;
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getSharedPayload(), event->getDirty());
             entry->setState(S);
             break;
         default:
@@ -1471,7 +1528,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getSharedPayload(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1527,7 +1584,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getSharedPayload(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1571,6 +1628,19 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
 
     switch (state) {
         case I:
+            if (sparseEvictions.find(event->getID()) != sparseEvictions.end()) { // Our own eviction is done
+                if (mshr->hasData(addr) && mshr->getDataDirty(addr))
+                    writebackDataFromMSHR(addr);
+                if (mshr->hasData(addr))
+                    mshr->clearData(addr);
+                if (is_debug_event(event)) {
+                    eventDI.action = "Done";
+                    eventDI.reason = "sparse evict";
+                }
+                finishSparseEviction(event);
+                cleanUpAfterRequest(event, inMSHR);
+                break;
+            }
             if (!(mshr->pendingWriteback(addr) || (mshr->exists(addr) && mshr->getFrontEvent(addr)->getCmd() == Command::FlushLineInv))) {
                 if (mshr->hasData(addr) && mshr->getDataDirty(addr))
                     sendFetchResponse(event);
@@ -1792,8 +1862,8 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
         entry->setState(S);
     }
 
-    sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-    mshr->setData(addr, event->getPayload(), false); // Save data for a subsequent GetS
+    sendDataResponse(reqEv, entry, event->getSharedPayload(), Command::GetSResp);
+    mshr->setData(addr, event->getSharedPayload(), false); // Save data for a subsequent GetS
     cleanUpAfterResponse(event, inMSHR);
 
     if (is_debug_addr(addr)) {
@@ -1818,12 +1888,12 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         case IS:
             if (incoherentSrc.find(reqEv->getSrc()) != incoherentSrc.end()) {
                 entry->setState(I);
-                sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
+                sendDataResponse(reqEv, entry, event->getSharedPayload(), Command::GetSResp);
                 break;
             } else if (protocol == CoherenceProtocol::MESI) {
                 entry->setState(M);
                 entry->setOwner(reqEv->getSrc());
-                sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
+                sendDataResponse(reqEv, entry, event->getSharedPayload(), Command::GetXResp);
                 break;
             }
         case S_D:
@@ -1831,8 +1901,8 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
                 entry->addSharer(reqEv->getSrc());
             }
-            sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-            mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
+            sendDataResponse(reqEv, entry, event->getSharedPayload(), Command::GetSResp);
+            mshr->setData(addr, event->getSharedPayload(), false); // So subsequent GetS can get data
             break;
         case IM:
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
@@ -1841,11 +1911,11 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
             } else {
                 entry->setState(I);
             }
-            sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
+            sendDataResponse(reqEv, entry, event->getSharedPayload(), Command::GetXResp);
             break;
         case SM_Inv:
             entry->setState(S_Inv);
-            mshr->setData(addr, event->getPayload(), false); // Save data for when the invalidations finish
+            mshr->setData(addr, event->getSharedPayload(), false); // Save data for when the invalidations finish
             if (is_debug_addr(addr)) {
                 eventDI.newst = entry->getState();
                 eventDI.verboseline = entry->getString();
@@ -2019,7 +2089,7 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
     responses.find(addr)->second.erase(event->getSrc());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    mshr->setData(addr, event->getSharedPayload(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
     entry->addSharer(event->getSrc());
@@ -2054,7 +2124,7 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
     responses.find(addr)->second.erase(event->getSrc());
     if (responses.find(addr)->second.empty())
         responses.erase(addr);
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    mshr->setData(addr, event->getSharedPayload(), event->getDirty());       // Save data for retry
 
     entry->setState(I);
 
@@ -2162,10 +2232,13 @@ bool DirectoryController::handleDirEntryResponse(MemEvent* event) {
  * Manage data structures
  ****************************/
 DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
+    if (sparseAssoc)
+        return getSparseDirEntry(addr);
+
     std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
 
     if (directory.end() == i) {
-        directory[addr] = new DirEntry(addr);
+        directory[addr] = new DirEntry(addr, &sharerIds);
         i = directory.find(addr);
         i->second->cacheIter = entryCache.end();
         i->second->setCached(true);
@@ -2175,6 +2248,9 @@ DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
 }
 
 bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR) {
+    if (sparseAssoc)
+        return allocateSparseEntry(entry, event, inMSHR);
+
     MemEventStatus status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false);
     if (status == MemEventStatus::Reject)
         return false;
@@ -2248,6 +2324,8 @@ void DirectoryController::cleanUpAfterRequest(MemEvent * event, bool inMSHR) {
         if (!mshr->getInProgress(addr) && mshr->getAcksNeeded(addr) == 0) {
             retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
         }
+    } else if (sparseAssoc && !mshr->exists(addr)) {
+        wakeSparseWaiters(addr);
     }
 }
 
@@ -2268,11 +2346,15 @@ void DirectoryController::cleanUpAfterResponse(MemEvent * event, bool inMSHR) {
         if (!mshr->getInProgress(addr) && mshr->getAcksNeeded(addr) == 0) {
             retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
         }
+    } else if (sparseAssoc && !mshr->exists(addr)) {
+        wakeSparseWaiters(addr);
     }
 }
 
 void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a proper cache!
-    if (0 == entryCacheMaxSize) {
+    if (sparseAssoc) { // Entries are not backed by memory, invalid entries are reused when another line needs one
+        return;
+    } else if (0 == entryCacheMaxSize) {
         sendEntryToMemory(entry);
     } else {
         if (entry->cacheIter != entryCache.end()) {
@@ -2316,6 +2398,192 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
     memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
 }
 
+/****************************
+ * Sparse directory
+ ****************************/
+uint64_t DirectoryController::getSparseSet(Addr addr) {
+    uint64_t line = addr / lineSize;
+    return ((line * 0x9E3779B97F4A7C15ULL) >> 32) % sparseSets; // Hash so that interleaved directories use every set
+}
+
+/* Return the line's entry. A line without one is given a free entry if there is one
+ * and otherwise a temporary entry which is marked not-cached if the line needs an entry */
+DirectoryController::DirEntry* DirectoryController::getSparseDirEntry(Addr addr) {
+    DirEntry* ways = &sparseEntries[getSparseSet(addr) * sparseAssoc];
+    for (uint32_t i = 0; i < sparseAssoc; i++) {
+        if (ways[i].getState() != NP && ways[i].getBaseAddr() == addr) {
+            ways[i].lastUse = ++sparseUseCount;
+            return &ways[i];
+        }
+    }
+
+    std::unordered_map<Addr,DirEntry*>::iterator it = directory.find(addr);
+    if (it != directory.end() && it->second->isCached())
+        return it->second;
+
+    for (uint32_t i = 0; i < sparseAssoc; i++) {
+        State state = ways[i].getState();
+        if (state == NP || ((state == I || (state == S && !ways[i].hasSharers())) && !mshr->exists(ways[i].getBaseAddr()))) {
+            ways[i].clearEntry();
+            ways[i].addr = addr;
+            ways[i].setState(I);
+            ways[i].lastUse = ++sparseUseCount;
+            if (it != directory.end()) {
+                delete it->second;
+                directory.erase(it);
+            }
+            stat_dirAllocations->addData(1);
+            return &ways[i];
+        }
+    }
+
+    if (it != directory.end())
+        return it->second;
+
+    DirEntry* entry = new DirEntry(addr, &sharerIds); // Not cached
+    directory.insert(std::make_pair(addr, entry));
+    return entry;
+}
+
+/* Called before handling an event. Only GetS/GetX/GetSX need an entry, other events for
+ * lines without an entry are handled on a temporary entry since the line is not cached above */
+void DirectoryController::prepareSparseEntry(Addr addr, Command cmd) {
+    DirEntry* ways = &sparseEntries[getSparseSet(addr) * sparseAssoc];
+    for (uint32_t i = 0; i < sparseAssoc; i++) {
+        if (ways[i].getState() != NP && ways[i].getBaseAddr() == addr)
+            return;
+    }
+
+    bool allocate = (cmd == Command::GetS || cmd == Command::GetX || cmd == Command::GetSX);
+    std::unordered_map<Addr,DirEntry*>::iterator it = directory.find(addr);
+    if (it == directory.end()) {
+        if (!allocate) {
+            DirEntry* entry = new DirEntry(addr, &sharerIds);
+            entry->setCached(true);
+            directory.insert(std::make_pair(addr, entry));
+        }
+    } else if (allocate) {
+        if (it->second->isCached() && it->second->getState() == I)
+            it->second->setCached(false);
+    } else if (!it->second->isCached() && !mshr->exists(addr)) {
+        it->second->setCached(true);
+    }
+}
+
+/* Line needs an entry and there is no free one in its set. Evict the least recently used stable entry
+ * or wait for one to become available */
+bool DirectoryController::allocateSparseEntry(DirEntry* entry, MemEvent* event, bool inMSHR) {
+    MemEventStatus status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false);
+    if (status == MemEventStatus::Reject)
+        return false;
+    else if (status == MemEventStatus::Stall)
+        return true;
+
+    Command cmd = event->getCmd();
+    if (cmd != Command::GetS && cmd != Command::GetX && cmd != Command::GetSX) { // Does not need an entry after all
+        entry->setCached(true);
+        retryBuffer.push_back(event);
+        return true;
+    }
+
+    if (entry->getState() == I_d) // Already evicting an entry for this line
+        return true;
+
+    Addr addr = entry->getBaseAddr();
+    uint64_t set = getSparseSet(addr);
+    DirEntry* ways = &sparseEntries[set * sparseAssoc];
+    DirEntry* victim = nullptr;
+    for (uint32_t i = 0; i < sparseAssoc; i++) {
+        State state = ways[i].getState();
+        if ((state == S || state == M) && !mshr->exists(ways[i].getBaseAddr()) && (!victim || ways[i].lastUse < victim->lastUse))
+            victim = &ways[i];
+    }
+
+    if (victim && evictSparseEntry(victim, addr)) {
+        entry->setState(I_d);
+        if (is_debug_event(event))
+            eventDI.reason = "sparse evict";
+    } else {
+        // Every entry is busy (or the MSHR is full): retry when a line in this set (or any line) finishes
+        sparseWaiters[victim ? sparseSets : set].insert(addr);
+        stat_dirSetConflicts->addData(1);
+        if (is_debug_event(event))
+            eventDI.reason = "sparse set full";
+    }
+    return true;
+}
+
+/* Invalidate the victim's sharers or owner. Handled like a FetchInv from memory except that
+ * the directory is the requestor, see handleFetchInv() */
+bool DirectoryController::evictSparseEntry(DirEntry* victim, Addr addr) {
+    Addr victimAddr = victim->getBaseAddr();
+    MemEvent* ev = new MemEvent(getName(), victimAddr, victimAddr, Command::FetchInv, lineSize);
+    ev->setRqstr(getName());
+    if (mshr->insertEvent(victimAddr, ev, -1, true, false) == -1) {
+        delete ev;
+        return false;
+    }
+    sparseEvictions.insert(std::make_pair(ev->getID(), addr));
+    stat_dirEvictions->addData(1);
+
+    if (victim->getState() == S) {
+        stat_dirEvictionInvs->addData(victim->getSharerCount());
+        issueInvalidations(ev, victim, Command::Inv);
+        victim->setState(S_Inv);
+    } else {
+        stat_dirEvictionInvs->addData(1);
+        issueFetch(ev, victim, Command::FetchInv);
+        victim->setState(M_Inv);
+    }
+    return true;
+}
+
+/* Eviction is done, retry the line that needed the entry. Must be called before the eviction is removed from the MSHR
+ * so that this line gets the entry ahead of any requests for the evicted line */
+void DirectoryController::finishSparseEviction(MemEvent* event) {
+    std::map<SST::Event::id_type, Addr>::iterator it = sparseEvictions.find(event->getID());
+    Addr addr = it->second;
+    sparseEvictions.erase(it);
+
+    std::unordered_map<Addr,DirEntry*>::iterator entry = directory.find(addr);
+    if (entry != directory.end() && entry->second->getState() == I_d)
+        entry->second->setState(I);
+
+    if (mshr->exists(addr) && mshr->getFrontType(addr) == MSHREntryType::Event)
+        retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
+}
+
+/* No more events for addr. Its entry may now be free or evictable, so retry lines waiting on its set */
+void DirectoryController::wakeSparseWaiters(Addr addr) {
+    if (sparseWaiters.empty())
+        return;
+
+    uint64_t keys[2] = { getSparseSet(addr), sparseSets };
+    for (int k = 0; k < 2; k++) {
+        std::map<uint64_t, std::set<Addr> >::iterator it = sparseWaiters.find(keys[k]);
+        if (it == sparseWaiters.end())
+            continue;
+        for (std::set<Addr>::iterator wt = it->second.begin(); wt != it->second.end(); wt++) {
+            if (mshr->exists(*wt) && mshr->getFrontType(*wt) == MSHREntryType::Event)
+                retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(*wt)));
+        }
+        sparseWaiters.erase(it);
+    }
+}
+
+/* Delete temporary entries that are no longer in use */
+void DirectoryController::releaseSparseEntries() {
+    std::unordered_map<Addr,DirEntry*>::iterator it = directory.begin();
+    while (it != directory.end()) {
+        if (it->second->getState() == I && !mshr->exists(it->first)) {
+            delete it->second;
+            it = directory.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
 /****************************
  * Send events
  ****************************/
@@ -2339,7 +2607,7 @@ void DirectoryController::issueFlush(MemEvent* event) {
 
     if (mshr->hasData(addr) && mshr->getDataDirty(addr)) { // also writeback dirty data
         flush->setEvict(true);
-        flush->setPayload(mshr->getData(addr));
+        flush->setPayload(mshr->getSharedData(addr));
         flush->setDirty(true);
         mshr->clearData(addr); // Don't retain data
     } else {
@@ -2371,11 +2639,12 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
-    std::string rqstr = (event->getSrc());
+    uint32_t rqstr = sharerIds.findId(event->getSrc());
+    const SharerSet& sharers = entry->getSharers();
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
-        issueInvalidation(*it, event, entry, cmd);
+    for (uint32_t id = sharers.first(); id != SharerIdMap::NONE; id = sharers.next(id)) {
+        if (id == rqstr) continue;
+        issueInvalidation(sharerIds.getName(id), event, entry, cmd);
     }
 }
 
@@ -2404,7 +2673,7 @@ void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, Di
     forwardByDestination(inv, deliveryTime);
 }
 
-void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags) {
+void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, const SharedPayload& data, Command cmd, uint32_t flags) {
     MemEvent * respEv = event->makeResponse(cmd);
     respEv->setSize(lineSize);
     respEv->setPayload(data);
@@ -2424,7 +2693,7 @@ void DirectoryController::writebackData(MemEvent* event) {
     MemEvent * wb = new MemEvent(getName(), event->getBaseAddr(), event->getBaseAddr(), Command::PutM, lineSize);
     wb->copyMetadata(event);
     wb->setRqstr(event->getRqstr());
-    wb->setPayload(event->getPayload());
+    wb->setPayload(event->getSharedPayload());
     wb->setDirty(event->getDirty());
 
     if (waitWBAck)
@@ -2436,7 +2705,7 @@ void DirectoryController::writebackData(MemEvent* event) {
 
 void DirectoryController::writebackDataFromMSHR(Addr addr) {
     MemEvent * wb = new MemEvent(getName(), addr, addr, Command::PutM, lineSize);
-    wb->setPayload(mshr->getData(addr));
+    wb->setPayload(mshr->getSharedData(addr));
     wb->setDirty(mshr->getDataDirty(addr));
     mshr->setDataDirty(addr, false);
     
@@ -2451,7 +2720,7 @@ void DirectoryController::sendFetchResponse(MemEvent * event) {
     Addr addr = event->getBaseAddr();
     MemEvent * ack = event->makeResponse();
 
-    ack->setPayload(mshr->getData(addr));
+    ack->setPayload(mshr->getSharedData(addr));
     ack->setDirty(mshr->getDataDirty(addr));
 
     mshr->clearData(addr);
@@ -2489,7 +2758,9 @@ void DirectoryController::sendNACK(MemEvent * event) {
 void DirectoryController::sendOutgoingEvents() {
 
     bool debugLine = false;
-    while (!cpuMsgQueue.empty() && cpuMsgQueue.begin()->first <= timestamp) {
+    // A link with lookahead adds that many cycles of latency so its events are sent that many cycles early
+    uint64_t sendTime = timestamp + cpuLink->getLookahead();
+    while (!cpuMsgQueue.empty() && cpuMsgQueue.begin()->first <= sendTime) {
         MemEventBase * ev = cpuMsgQueue.begin()->second;
 
         if (is_debug_event(ev)) {
@@ -2508,7 +2779,8 @@ void DirectoryController::sendOutgoingEvents() {
         cpuMsgQueue.erase(cpuMsgQueue.begin());
     }
 
-    while (!memMsgQueue.empty() && memMsgQueue.begin()->first <= timestamp) {
+    sendTime = timestamp + memLink->getLookahead();
+    while (!memMsgQueue.empty() && memMsgQueue.begin()->first <= sendTime) {
         MemEventBase * ev = memMsgQueue.begin()->second.event;
 
         if (is_debug_event(ev)) {
@@ -2534,14 +2806,10 @@ void DirectoryController::sendOutgoingEvents() {
  * dirAccess has default value of false
  */
 void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool dirAccess) {
-    std::string dst = memLink->findTargetDestination(ev->getRoutingAddress());
-    if (dst != "") { /* Common case */
-        ev->setDst(dst);
+    if (memLink->routeByAddress(ev)) { /* Common case */
         memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
     } else {
-        dst = cpuLink->findTargetDestination(ev->getRoutingAddress());
-        if (dst != "") {
-            ev->setDst(dst);
+        if (cpuLink->routeByAddress(ev)) {
             cpuMsgQueue.insert(std::make_pair(ts, ev));
         } else {
             std::string availableDests = "cpulink:\n" + cpuLink->getAvailableDestinationsAsString();
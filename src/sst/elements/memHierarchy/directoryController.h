@@ -36,6 +36,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
 #include "sst/elements/memHierarchy/mshr.h"
 
 using namespace std;
@@ -51,6 +52,8 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
             {"clock",                   "Clock rate of controller.", "1GHz"},
             {"entry_cache_size",        "Size (in # of entries) the controller will cache.", "0"},
+            {"sparse_entries",          "Number of entries in a sparse directory. Lines without an entry are not cached above and allocating an entry in a full set invalidates the line it evicts. 0: full directory (entries not cached are kept in memory)", "0"},
+            {"sparse_associativity",    "Associativity of the sparse directory", "8"},
             {"debug",                   "Where to send debug output. 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
             {"debug_level",             "Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},
             {"debug_addr",              "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},
@@ -58,6 +61,7 @@ public:
             {"cache_line_size",         "Size of a cache line [aka cache block] in bytes.", "64"},
             {"coherence_protocol",      "Coherence protocol.  Supported --MESI, MSI--", "MESI"},
             {"mshr_num_entries",        "Number of MSHRs. Set to -1 for almost unlimited number.", "-1"},
+            {"mshr_type",               "MSHR implementation. Both behave identically. Options: default, pooled[open-addressed index & pooled entries]", "default"},
             {"net_memory_name",         "For directories connected to a memory over the network: name of the memory this directory owns", ""},
             {"access_latency_cycles",   "Latency of directory access in cycles", "0"},
             {"mshr_latency_cycles",     "Latency of mshr access in cycles", "0"},
@@ -139,6 +143,11 @@ public:
             {"eventSent_FlushLineInv",  "Event sent: FlushLineInv", "count", 2},
             {"eventSent_FlushLineResp", "Event sent: FlushLineResp", "count", 2},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle",  "events",       1},
+            {"directory_entry_allocations",     "Sparse directory: Number of lines that were allocated an entry", "count", 1},
+            {"directory_evictions",             "Sparse directory: Number of entries evicted to make room for another line", "count", 1},
+            {"directory_eviction_invalidations","Sparse directory: Number of invalidations/fetches sent to caches because a directory entry was evicted", "count", 1},
+            {"directory_set_conflicts",         "Sparse directory: Number of times a request found every entry in its set busy and had to wait", "count", 1},
+            {"Payload_bytes_copied",    "Bytes of event/MSHR data copied while handling events (shared data that is not modified is not copied)", "bytes", 3},
             {"default_stat",            "Default statistic. If not 0 then a statistic is missing", "", 1})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -183,6 +192,12 @@ private:
     Statistic<uint64_t> * stat_dirEntryWrites;
 
     Statistic<uint64_t> * stat_MSHROccupancy;
+    Statistic<uint64_t> * stat_payloadBytesCopied;
+    // Sparse directory
+    Statistic<uint64_t> * stat_dirAllocations;
+    Statistic<uint64_t> * stat_dirEvictions;
+    Statistic<uint64_t> * stat_dirEvictionInvs;
+    Statistic<uint64_t> * stat_dirSetConflicts;
 
     /* Queue of packets to work on */
     std::list<MemEvent*> eventBuffer;
@@ -296,21 +311,25 @@ private:
         Addr                addr;           // block address
         State               state;          // state
         std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
-        std::string         owner;          // Owner of block
+        SharerIdMap*        ids;            // Sharer name <-> id mapping, shared by all entries
+        SharerSet           sharers;        // set of sharers for block
+        uint32_t            owner;          // Owner of block
+        uint64_t            lastUse;        // For sparse directory replacement
 
-        DirEntry(Addr a) {
+        DirEntry(Addr a, SharerIdMap* idMap) {
+            ids = idMap;
             clearEntry();
             addr = a;
             state = I;
             cached = false;
+            lastUse = 0;
         }
 
         void clearEntry(){
             cached = true;
             addr = 0;
             sharers.clear();
-            owner = "";
+            owner = SharerIdMap::NONE;
         }
 
         std::string getString() {
@@ -318,13 +337,13 @@ private:
             str << "State: " << StateString[state];
             str << " Sharers: [";
             bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
+            for (uint32_t id = sharers.first(); id != SharerIdMap::NONE; id = sharers.next(id)) {
                 if (comma)
                     str << ",";
-                str << *it;
+                str << ids->getName(id);
                 comma = true;
             }
-            str << "] Owner: " << owner;
+            str << "] Owner: " << getOwner();
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
         }
@@ -339,23 +358,30 @@ private:
 
         void clearSharers() { sharers.clear(); }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        void addSharer(std::string shr) { sharers.add(ids->getId(shr)); }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(std::string shr) {
+            uint32_t id = ids->findId(shr);
+            return id != SharerIdMap::NONE && sharers.contains(id);
+        }
 
         bool hasSharers() { return !(sharers.empty()); }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        const SharerSet& getSharers() { return sharers; }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        void removeSharer(std::string shr) {
+            uint32_t id = ids->findId(shr);
+            if (id != SharerIdMap::NONE)
+                sharers.remove(id);
+        }
 
-        std::string getOwner() { return owner; }
+        std::string getOwner() { return owner == SharerIdMap::NONE ? "" : ids->getName(owner); }
 
-        bool hasOwner() { return owner != ""; }
+        bool hasOwner() { return owner != SharerIdMap::NONE; }
 
-        void removeOwner() { owner = ""; }
+        void removeOwner() { owner = SharerIdMap::NONE; }
 
-        void setOwner(std::string own) { owner = own; }
+        void setOwner(std::string own) { owner = own == "" ? SharerIdMap::NONE : ids->getId(own); }
 
         void setState(State nState) { state = nState; }
 
@@ -381,7 +407,7 @@ private:
     void issueFetch(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd);
-    void sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags = 0);
+    void sendDataResponse(MemEvent* event, DirEntry* entry, const SharedPayload& data, Command cmd, uint32_t flags = 0);
     void sendResponse(MemEvent* event, uint32_t flags = 0, uint32_t memflags = 0);
     void writebackData(MemEvent* event);
     void writebackDataFromMSHR(Addr addr);
@@ -391,7 +417,29 @@ private:
     void sendNACK(MemEvent* event);
     
     MSHR * mshr;
-    std::unordered_map<Addr, DirEntry*> directory; // Master list of all directory entries, including noncached ones
+    std::unordered_map<Addr, DirEntry*> directory; // Master list of all directory entries, including noncached ones. Sparse: only lines without an entry
+    SharerIdMap sharerIds;
+
+    /* Sparse directory
+     * Entries live in a set-associative array. A line without an entry is not cached above, so GetS/GetX/GetSX
+     * must allocate one, evicting (and invalidating the sharers/owner of) a stable entry if the set is full.
+     * Other requests for such lines are handled on a temporary entry in 'directory'.
+     */
+    uint64_t    sparseSets;
+    uint32_t    sparseAssoc;    // 0 if not a sparse directory
+    uint64_t    sparseUseCount;
+    std::vector<DirEntry> sparseEntries;
+    std::map<SST::Event::id_type, Addr> sparseEvictions;       // Eviction event -> line that is waiting for the entry
+    std::map<uint64_t, std::set<Addr> > sparseWaiters;          // Set -> lines waiting for an entry to become free or evictable
+
+    uint64_t getSparseSet(Addr addr);
+    DirEntry* getSparseDirEntry(Addr addr);
+    void prepareSparseEntry(Addr addr, Command cmd);
+    bool allocateSparseEntry(DirEntry* entry, MemEvent* event, bool inMSHR);
+    bool evictSparseEntry(DirEntry* victim, Addr addr);
+    void finishSparseEviction(MemEvent* event);
+    void wakeSparseWaiters(Addr addr);
+    void releaseSparseEntries();
 
 
     struct MemMsg {
@@ -0,0 +1,158 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_FLATCACHEARRAY_H
+#define MEMHIERARCHY_FLATCACHEARRAY_H
+
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#include "sst/elements/memHierarchy/cacheArray.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Cache array variant optimized for lookup speed in highly-associative caches
+ *
+ * Tags are kept in a separate, contiguous array (one run of 'associativity' tags per set)
+ * so that a lookup scans a single cache-friendly block instead of dereferencing each line.
+ * When compiled with SSE4.1/AVX2 the tag compare is vectorized.
+ * Replacement info is indexed directly by set instead of through a map.
+ *
+ * Results are identical to CacheArray: the same line objects, replacement
+ * manager and hash function are used; only the search structures differ.
+ * Line addresses must only be changed through replace() (this is already true for
+ * all users of CacheArray) so that the tag array stays in sync with the lines.
+ */
+template <class T>
+class FlatCacheArray : public CacheArray<T> {
+    public:
+        FlatCacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
+
+        virtual ~FlatCacheArray() { }
+
+        T * lookup(Addr addr, bool updateReplacement) override;
+
+        T * findReplacementCandidate(Addr addr) override;
+
+        void replace(Addr addr, T* candidate) override;
+
+    private:
+        /** Compute set index, skipping the hash/divide when they are no-ops */
+        inline unsigned int getSet(Addr addr);
+
+        /** Return the first way in the set whose tag matches, or -1 */
+        inline int findWay(const Addr* tags, Addr addr);
+
+        std::vector<Addr> tags_;                                // numSets_ x associativity_ tags, contiguous per set
+        std::vector<std::vector<ReplacementInfo*> > setInfo_;   // Replacement info indexed by set
+        bool identityHash_;                                     // Hash function is hash.none
+        Addr setMask_;                                          // numSets_ - 1 if numSets_ is a power of two, otherwise 0
+};
+
+/************* Function definitions *****************/
+
+template <class T>
+FlatCacheArray<T>::FlatCacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
+    CacheArray<T>(dbg, numLines, associativity, lineSize, replacementMgr, hash) {
+
+    tags_.resize(this->numLines_);
+    for (unsigned int i = 0; i < this->numLines_; i++)
+        tags_[i] = this->lines_[i]->getAddr();
+
+    // Move replacement info from the map into a flat per-set vector
+    setInfo_.resize(this->numSets_);
+    for (unsigned int i = 0; i < this->numSets_; i++)
+        setInfo_[i].swap(this->rInfo[i]);
+    this->rInfo.clear();
+
+    identityHash_ = (dynamic_cast<NoHashFunction*>(hash) != nullptr);
+    setMask_ = isPowerOfTwo(this->numSets_) ? (Addr)(this->numSets_ - 1) : 0;
+}
+
+template <class T>
+unsigned int FlatCacheArray<T>::getSet(Addr addr) {
+    Addr laddr;
+    if (this->sliceStep_ == 1 && this->sliceSize_ == 1)
+        laddr = addr >> this->lineOffset_;
+    else
+        laddr = this->toLineAddr(addr);
+
+    if (!identityHash_)
+        laddr = this->hash_->hash(0, laddr);
+
+    return setMask_ ? (laddr & setMask_) : (laddr % this->numSets_);
+}
+
+template <class T>
+int FlatCacheArray<T>::findWay(const Addr* tags, Addr addr) {
+    int way = 0;
+    int assoc = this->associativity_;
+#if defined(__AVX2__)
+    __m256i key = _mm256_set1_epi64x(addr);
+    for (; way + 4 <= assoc; way += 4) {
+        __m256i cmp = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + way)), key);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+        if (mask)
+            return way + __builtin_ctz(mask);
+    }
+#elif defined(__SSE4_1__)
+    __m128i key = _mm_set1_epi64x(addr);
+    for (; way + 2 <= assoc; way += 2) {
+        __m128i cmp = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)(tags + way)), key);
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(cmp));
+        if (mask)
+            return way + __builtin_ctz(mask);
+    }
+#endif
+    for (; way < assoc; way++) {
+        if (tags[way] == addr)
+            return way;
+    }
+    return -1;
+}
+
+template <class T>
+T* FlatCacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
+    unsigned int setBegin = getSet(addr) * this->associativity_;
+
+    int way = findWay(&tags_[setBegin], addr);
+    if (way < 0)
+        return nullptr; // Not found
+
+    unsigned int index = setBegin + way;
+    T* line = this->lines_[index];
+    if (updateReplacement)
+        this->replacementMgr_->update(index, line->getReplacementInfo());
+    return line;
+}
+
+template <class T>
+T * FlatCacheArray<T>::findReplacementCandidate(Addr addr) {
+    unsigned int id = this->replacementMgr_->findBestCandidate(setInfo_[getSet(addr)]);
+    return this->lines_[id];
+}
+
+template <class T>
+void FlatCacheArray<T>::replace(Addr addr, T* candidate) {
+    CacheArray<T>::replace(addr, candidate);
+    tags_[candidate->getIndex()] = addr;
+}
+
+}}
+#endif /* MEMHIERARCHY_FLATCACHEARRAY_H */
@@ -24,6 +24,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/sharedPayload.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -191,18 +192,47 @@ public:
     void setSuccess(bool b) { b ? clearFlag(MemEventBase::F_FAIL) : setFlag(MemEventBase::F_FAIL); }
     bool success() { return !queryFlag(MemEventBase::F_FAIL); }
 
-    /** @return  the data payload. */
+    /** @return  the data payload. Copies the payload first if it is shared with another event */
     dataVec& getPayload(void) {
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
+        dataVec& payload = payload_.getMutable();
+        if ( payload.size() < size_ )  payload.resize(size_);
+        return payload;
+    }
+
+    /** @return  the data payload as a shared buffer. Never copies */
+    const SharedPayload& getSharedPayload(void) {
+        if ( payload_.size() < size_ )  payload_.getMutable().resize(size_);
         return payload_;
     }
 
 
+    /** @return  the data payload, leaving this event without one. Moves rather than copies if the payload is not shared */
+    dataVec releasePayload(void) {
+        if ( payload_.size() < size_ )  payload_.getMutable().resize(size_);
+        return payload_.release();
+    }
+
     /** Sets the data payload and payload size.
      * @param[in] data  Vector from which to copy data
      */
     void setPayload(std::vector<uint8_t>& data) {
+        setSize(data.size());
+        payload_.assign(data);
+    }
+
+    /** Sets the data payload and payload size.
+     * @param[in] data  Vector to take the data from
+     */
+    void setPayload(std::vector<uint8_t>&& data) {
+        setSize(data.size());
+        payload_.assign(std::move(data));
+    }
+
+    /** Sets the data payload and payload size.
+     * @param[in] data  Buffer to share as payload
+     */
+    void setPayload(const SharedPayload& data) {
         setSize(data.size());
         payload_ = data;
     }
@@ -213,16 +243,16 @@ public:
      */
     void setPayload(uint32_t size, uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
+        if (size == 0) {
+            payload_.clear();
+            return;
         }
+        payload_.assign(data, size);
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
-        payload_.clear();
-        payload_.resize(size, 0);
+        payload_.assign(dataVec(size, 0));
     }
 
     size_t getPayloadSize() override {
@@ -266,8 +296,9 @@ public:
         else {
             std::stringstream value;
             value << std::hex << std::setfill('0');
-            for (unsigned int i = 0; i < payload_.size(); i++)
-                value << std::hex << std::setw(2) << (int)payload_[i];
+            const dataVec& payload = payload_.get();
+            for (unsigned int i = 0; i < payload.size(); i++)
+                value << std::hex << std::setw(2) << (int)payload[i];
             str << " Data: 0x" << value.str();
         }
         str << " VA: 0x" << vAddr_ << " IP: 0x" << instPtr_;
@@ -303,7 +334,7 @@ private:
     bool            addrGlobal_;        // Whether address is a local or global address
     MemEvent*       NACKedEvent_;       // For a NACK, pointer to the NACKed event
     int             retries_;           // For NACKed events, how many times a retry has been sent
-    dataVec         payload_;           // Data
+    SharedPayload   payload_;           // Data, shared with copies of this event until written
     bool            prefetch_;          // Whether this request came from a prefetcher
     bool            dirty_;             // For a replacement, whether the data is dirty or not
     bool            isEvict_;           // Whether an event is an eviction
@@ -321,7 +352,13 @@ public:
         ser & addrGlobal_;
         ser & NACKedEvent_;
         ser & retries_;
-        ser & payload_;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            dataVec payload;
+            ser & payload;
+            payload_.assign(std::move(payload));
+        } else {
+            ser & const_cast<dataVec&>(payload_.get());
+        }
         ser & prefetch_;
         ser & dirty_;
         ser & isEvict_;
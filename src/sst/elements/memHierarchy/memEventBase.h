@@ -43,6 +43,9 @@ public:
     static const uint32_t F_FAIL            = 0x00001000;
     static const uint32_t F_NORESPONSE      = 0x00010000;
 
+    // Destination route id when none is known
+    static const uint64_t NO_ROUTE          = ~uint64_t(0);
+
 
     /** Creates a new MemEventBase */
     MemEventBase(std::string src, Command cmd) : SST::Event() {
@@ -55,6 +58,7 @@ public:
         eventID_        = generateUniqueId();  // Defined in SST::Event
         responseToID_   = NO_ID;
         dst_            = NONE;
+        dstRoute_       = NO_ROUTE;
         src_            = NONE;
         rqstr_          = NONE;
         cmd_            = Command::NULLCMD;
@@ -72,6 +76,7 @@ public:
         responseToID_ = event->eventID_;
         cmd_ = CommandResponse[(int)cmd_];
         dst_ = event->src_;
+        dstRoute_ = NO_ROUTE;
         src_ = event->dst_;
         rqstr_ = event->rqstr_;
         flags_ = event->flags_;
@@ -103,7 +108,17 @@ public:
     /** @return the destination string - who receives this MemEvent */
     const std::string& getDst(void) const { return dst_; }
     /** Sets the destination string - who received this MemEvent */
-    void setDst(const std::string& dst) { dst_ = dst; }
+    void setDst(const std::string& dst) {
+        dst_ = dst;
+        dstRoute_ = NO_ROUTE;
+    }
+    /** Sets the destination along with the id of the route to it, see RegionRoutingTable */
+    void setDst(const std::string& dst, uint64_t route) {
+        dst_ = dst;
+        dstRoute_ = route;
+    }
+    /** @return the route id given with the destination, NO_ROUTE if none */
+    uint64_t getDstRoute(void) const { return dstRoute_; }
 
     /** @return the requestor string - whose original request caused this MemEvent */
     const std::string& getRqstr(void) const { return rqstr_; }
@@ -206,12 +221,13 @@ protected:
     id_type         responseToID_;      // For responses, holds the ID to which this event matches
     string          src_;               // Source ID
     string          dst_;               // Destination ID
+    uint64_t        dstRoute_;          // Route to dst_ in the sending link's routing table, not serialized
     string          rqstr_;             // Cache that originated this request
     Command         cmd_;               // Command
     uint32_t        flags_;
     uint32_t        memFlags_;
 
-    MemEventBase() {} // For serialization only
+    MemEventBase() : dstRoute_(NO_ROUTE) {} // For serialization only
 
 public:
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
@@ -38,6 +38,17 @@ MemLink::MemLink(ComponentId_t id, Params &params, TimeConverter* tc) : MemLinkB
     if (!link)
         dbg.fatal(CALL_INFO, -1, "%s, Error: unable to configure link on port '%s'\n", getName().c_str(), port.c_str());
 
+    UnitAlgebra lookaheadUA = params.find<UnitAlgebra>("lookahead", UnitAlgebra("0ps"));
+    if (!lookaheadUA.hasUnits("s"))
+        dbg.fatal(CALL_INFO, -1, "%s, Invalid param: lookahead - must be a time with units (SI units OK). For example, '1ns'. You specified '%s'\n", getName().c_str(), lookaheadUA.toString().c_str());
+    if (lookaheadUA > UnitAlgebra("0ps")) {
+        // Events are released whole parent cycles early, any remainder would add latency that is never made up
+        SimTime_t lookaheadFactor = getTimeConverter(lookaheadUA)->getFactor();
+        if (lookaheadFactor % tc->getFactor() != 0)
+            dbg.fatal(CALL_INFO, -1, "%s, Invalid param: lookahead - must be a whole number of the parent's clock periods. You specified '%s'\n", getName().c_str(), lookaheadUA.toString().c_str());
+        lookahead = lookaheadFactor / tc->getFactor();
+    }
+
     dbg.debug(_L10_, "%s memLink info is: Name: %s, addr: %" PRIu64 ", id: %" PRIu32 "\n",
             getName().c_str(), info.name.c_str(), info.addr, info.id);
 }
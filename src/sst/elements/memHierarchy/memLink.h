@@ -49,6 +49,7 @@ public:
     /* Define params, inherit from base class */
 #define MEMLINK_ELI_PARAMS MEMLINKBASE_ELI_PARAMS, \
     { "latency",            "(string) Additional link latency.", "0ps"},\
+    { "lookahead",          "(string) Send events this long before their delivery time. The link's latency in the input configuration must include this much extra latency, which lets the partitioner place the two ends on different threads/ranks without changing timing. Must be a whole number of the parent's clock periods.", "0ps"},\
     { "port",               "(string) Set by parent component. Name of port this memLink sits on.", "port"}
 
     SST_ELI_DOCUMENT_PARAMS( { MEMLINK_ELI_PARAMS }  )
@@ -74,7 +74,7 @@ public:
     };
 
     /* Constructor */
-    MemLinkBase(ComponentId_t id, Params &params, TimeConverter* tc) : SubComponent(id) {
+    MemLinkBase(ComponentId_t id, Params &params, TimeConverter* tc) : SubComponent(id), lookahead(0) {
         /* Create debug output */
         dlevel = params.find<int>("debug_level", 0);
         int debugLoc = params.find<int>("debug", 0);
@@ -150,6 +150,11 @@ public:
     virtual MemEventInit* recvInitData() =0;
     virtual void send(MemEventBase * ev) =0;
 
+    /* Number of cycles (of the parent's time base) before an event's delivery time that the parent
+     * should pass it to send(). Links with a lookahead carry that much extra latency so that events
+     * sent early still arrive on time. */
+    SimTime_t getLookahead() { return lookahead; }
+
     /*
      * Extra functions for MemLink derivatives
      */
@@ -161,6 +166,15 @@ public:
     /* Functions for managing communication according to address */
     virtual std::string findTargetDestination(Addr addr) =0;    /* Return destination and return "" if none found */
     virtual std::string getTargetDestination(Addr addr) =0;     /* Return destination and error if none found */
+
+    /* Set the event's destination from its routing address, return false if none found */
+    virtual bool routeByAddress(MemEventBase * ev) {
+        std::string dst = findTargetDestination(ev->getRoutingAddress());
+        if (dst == "")
+            return false;
+        ev->setDst(dst);
+        return true;
+    }
     
     /* Check if a request address maps to our region */
     virtual bool isRequestAddressValid(Addr addr) { return info.region.contains(addr); }
@@ -197,6 +211,9 @@ protected:
     // Local EndpointInfo
     EndpointInfo info;
 
+    // Lookahead in cycles of the parent's time base
+    SimTime_t lookahead;
+
     // Handlers
     SST::Event::HandlerBase * recvHandler; // Event handler to call when an event is received
 
@@ -28,6 +28,7 @@
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/regionRoutingTable.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -113,14 +114,10 @@ class MemNICBase : public MemLinkBase {
 
         // Init functions
         virtual void sendInitData(MemEventInit * ev, bool broadcast = true) {
-            if (!broadcast) {
-                std::string dst = findTargetDestination(ev->getRoutingAddress());
-                if (dst == "") {
-                    // Hold this request until we know the right address
-                    initWaitForDst.insert(ev);
-                    return;
-                }
-                ev->setDst(dst);
+            if (!broadcast && !routeByAddress(ev)) {
+                // Hold this request until we know the right address
+                initWaitForDst.insert(ev);
+                return;
             }
             MemRtrEvent * mre = new MemRtrEvent(ev);
             SST::Interfaces::SimpleNetwork::Request* req = new SST::Interfaces::SimpleNetwork::Request();
@@ -160,12 +157,28 @@ class MemNICBase : public MemLinkBase {
         virtual std::set<EndpointInfo>* getDests() { return &destEndpointInfo; }
         
         virtual std::string findTargetDestination(Addr addr) {
+            if (routingTable.isBuilt()) {
+                const RegionRoutingTable::Route* route = routingTable.find(addr);
+                return route ? route->name : "";
+            }
+            /* Routing table is not built until setup() */
             for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
                 if (it->region.contains(addr)) return it->name;
             }
             return "";
         }
 
+        /* Tag the event with its route so that lookupNetworkAddress() does not need to look it up again */
+        virtual bool routeByAddress(MemEventBase * ev) {
+            if (!routingTable.isBuilt())
+                return MemLinkBase::routeByAddress(ev);
+            uint64_t id = routingTable.findId(ev->getRoutingAddress());
+            if (id == RegionRoutingTable::NO_ROUTE)
+                return false;
+            ev->setDst(routingTable.getRoute(id)->name, id);
+            return true;
+        }
+
         virtual std::string getTargetDestination(Addr addr) {
             std::string dst = findTargetDestination(addr);
             if (dst != "") {
@@ -203,6 +216,8 @@ class MemNICBase : public MemLinkBase {
         virtual void addDest(EndpointInfo info) { 
             destEndpointInfo.insert(info); 
             reachableNames.insert(info.name);
+            if (routingTable.isBuilt()) /* Destination arrived after setup() */
+                buildRoutingTable();
         }
 
         virtual void addEndpoint(EndpointInfo info) { endpointInfo.insert(info); }
@@ -237,9 +252,7 @@ class MemNICBase : public MemLinkBase {
                 }
 
                 for (auto it = initWaitForDst.begin(); it != initWaitForDst.end();) {
-                    std::string dst = findTargetDestination((*it)->getRoutingAddress());
-                    if (dst != "") {
-                        (*it)->setDst(dst);
+                    if (routeByAddress(*it)) {
                         MemRtrEvent * mre = new MemRtrEvent(*it);
                         SST::Interfaces::SimpleNetwork::Request* req = new SST::Interfaces::SimpleNetwork::Request();
                         req->dest = SST::Interfaces::SimpleNetwork::INIT_BROADCAST_ADDR;
@@ -398,6 +411,18 @@ class MemNICBase : public MemLinkBase {
                 dbg.fatal(CALL_INFO, -1, "%s, Error: Unable to find destination for init event %s\n",
                         getName().c_str(), (*initWaitForDst.begin())->getVerboseString(dlevel).c_str());
             }
+
+            buildRoutingTable();
+        }
+
+        // Compile destEndpointInfo into the routing table used by findTargetDestination() and lookupNetworkAddress(MemEventBase*)
+        void buildRoutingTable() {
+            routingTable.clear();
+            for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
+                std::unordered_map<std::string,uint64_t>::const_iterator nt = networkAddressMap.find(it->name);
+                routingTable.addRoute(it->region, it->name, nt == networkAddressMap.end() ? it->addr : nt->second);
+            }
+            routingTable.build();
         }
 
         // Lookup the network address for a given endpoint
@@ -409,6 +434,15 @@ class MemNICBase : public MemLinkBase {
             return it->second;
         }
 
+        // Lookup the network address for an event's destination
+        // Events routed by routeByAddress() carry their route id, others (e.g., responses) resolve through networkAddressMap
+        uint64_t lookupNetworkAddress(MemEventBase* ev) const {
+            const RegionRoutingTable::Route* route = routingTable.getRoute(ev->getDstRoute());
+            if (route)
+                return route->netAddr;
+            return lookupNetworkAddress(ev->getDst());
+        }
+
         /*
          * Some helper functions to avoid needing to repeat code everywhere
          */
@@ -482,6 +516,7 @@ class MemNICBase : public MemLinkBase {
         std::set<EndpointInfo> destEndpointInfo;
         std::set<EndpointInfo> endpointInfo;
         std::set<std::string> reachableNames;
+        RegionRoutingTable routingTable; // Compiled from destEndpointInfo during setup()
 
         // Init queues
         std::queue<MemRtrEvent*> initQueue; // Queue for received init events
@@ -49,6 +49,9 @@ void MemNetBridge::setup(void)
         for ( auto a : net.map ) {
             dbg.debug(CALL_INFO, 2, 0, "\t%s -> %" PRIu64 "\n", a.first.c_str(), a.second);
         }
+        for ( auto &r : net.routes ) {
+            r.second.build();
+        }
     }
 }
 
@@ -65,6 +68,7 @@ SimpleNetwork::Request* MemNetBridge::initTranslate(SimpleNetwork::Request *req,
     MemNIC::InitMemRtrEvent *imre = dynamic_cast<MemNIC::InitMemRtrEvent*>(payload);
     if ( imre ) {
         networks[fromNet].map[imre->info.name] = imre->info.addr;
+        networks[fromNet].routes[imre->info.id].addRoute(imre->info.region, imre->info.name, imre->info.addr);
         imre->info.addr = getAddrForNetwork(fromNet^1);
     } else if ( req->dest != SimpleNetwork::INIT_BROADCAST_ADDR ) {
         /* TODO */
@@ -86,7 +90,7 @@ SimpleNetwork::Request* MemNetBridge::translate(SimpleNetwork::Request *req, uin
 
     SimpleNetwork::nid_t tgt;
     if ( mre->hasClientData() ) {
-        tgt = getAddrFor(outNet, mre->event->getDst());
+        tgt = getAddrFor(outNet, mre->event);
     } else {
         MemNIC::InitMemRtrEvent *imre = static_cast<MemNIC::InitMemRtrEvent*>(mre);
         imre->info.addr = getAddrForNetwork(fromNet^1);
@@ -110,3 +114,17 @@ SimpleNetwork::nid_t MemNetBridge::getAddrFor(Net_t &net, const std::string &tgt
     return i->second;
 }
 
+/* Address-routed events resolve through the routing tables, others (e.g., responses) by name */
+SimpleNetwork::nid_t MemNetBridge::getAddrFor(Net_t &net, MemEventBase *ev)
+{
+    Addr addr = ev->getRoutingAddress();
+    for ( auto &r : net.routes ) {
+        if ( !r.second.isBuilt() ) break;
+        const RegionRoutingTable::Route *route = r.second.find(addr);
+        if ( route && route->name == ev->getDst() ) {
+            return route->netAddr;
+        }
+    }
+    return getAddrFor(net, ev->getDst());
+}
+
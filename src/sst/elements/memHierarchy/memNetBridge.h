@@ -26,6 +26,10 @@
 #include <sst/elements/merlin/bridge.h>
 
 #include <map>
+#include <unordered_map>
+
+#include "sst/elements/memHierarchy/memEventBase.h"
+#include "sst/elements/memHierarchy/regionRoutingTable.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -60,17 +64,20 @@ public:
 private:
     Output dbg;
 
-    typedef std::map<std::string, SimpleNetwork::nid_t> addrMap_t;
+    typedef std::unordered_map<std::string, SimpleNetwork::nid_t> addrMap_t;
     typedef std::map<std::string, uint64_t> imreMap_t;
+    typedef std::map<uint32_t, RegionRoutingTable> routeMap_t;
 
     struct Net_t {
         addrMap_t map;
         imreMap_t imreMap;
+        routeMap_t routes;  // Address routing for each group (MemNIC group ID) on the network, built during setup()
     };
 
     Net_t networks[2];
 
     SimpleNetwork::nid_t getAddrFor(Net_t &nic, const std::string &tgt);
+    SimpleNetwork::nid_t getAddrFor(Net_t &nic, MemEventBase* ev);
 
 };
 
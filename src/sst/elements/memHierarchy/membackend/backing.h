@@ -18,6 +18,12 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -30,10 +36,79 @@ public:
     virtual ~Backing() { }
 
     virtual void set( Addr addr, uint8_t value ) = 0;
-    virtual void set( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void set( Addr addr, size_t size, const std::vector<uint8_t>& data) = 0;
 
     virtual uint8_t get( Addr addr) = 0;
     virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+
+    /*
+     * Sparse dump/restore of backing contents
+     * File format: 8-byte magic, 8-byte page size, then one record per populated page:
+     *  8-byte page address followed by page size bytes of data
+     * A last page that extends past the end of memory is zero-padded
+     * Addresses are the backing's (i.e., memory-local) addresses
+     */
+    virtual void dump( std::string file ) = 0;
+
+    /* Restore a dump into a backing holding 'size' bytes of memory-local addresses */
+    void restore( std::string file, uint64_t size ) {
+        Output out("", 1, 0, Output::STDOUT);
+        FILE* fp = fopen(file.c_str(), "rb");
+        if (!fp)
+            out.fatal(CALL_INFO, -1, "Backing: Error - unable to open '%s' for restore.\n", file.c_str());
+
+        uint64_t header[2];
+        if (fread(header, sizeof(uint64_t), 2, fp) != 2 || header[0] != dumpMagic || header[1] == 0)
+            out.fatal(CALL_INFO, -1, "Backing: Error - '%s' is not a backing store dump.\n", file.c_str());
+
+        std::vector<uint8_t> page(header[1]);
+        uint64_t pageAddr;
+        while (fread(&pageAddr, sizeof(uint64_t), 1, fp) == 1) {
+            if (fread(page.data(), 1, page.size(), fp) != page.size())
+                out.fatal(CALL_INFO, -1, "Backing: Error - '%s' is truncated at page 0x%" PRIx64 ".\n", file.c_str(), pageAddr);
+            if (pageAddr >= size)
+                out.fatal(CALL_INFO, -1, "Backing: Error - '%s' has a page at 0x%" PRIx64 " beyond the end of the %" PRIu64 "B backing store.\n",
+                        file.c_str(), pageAddr, size);
+            /* The last page may extend past the end of memory, its padding is dropped */
+            set(pageAddr, std::min(page.size(), (size_t)(size - pageAddr)), page);
+        }
+        fclose(fp);
+    }
+
+protected:
+    static const uint64_t dumpMagic = 0x31424d454d545353ULL; // "SSTMEMB1"
+
+    FILE* openDump( std::string file, uint64_t pageSize ) {
+        FILE* fp = fopen(file.c_str(), "wb");
+        if (!fp) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "Backing: Error - unable to open '%s' for dump.\n", file.c_str());
+        }
+        uint64_t header[2] = { dumpMagic, pageSize };
+        if (fwrite(header, sizeof(uint64_t), 2, fp) != 2)
+            dumpFailed(file);
+        return fp;
+    }
+
+    void dumpPage( FILE* fp, std::string file, uint64_t pageAddr, const uint8_t* data, size_t pageSize ) {
+        if (fwrite(&pageAddr, sizeof(uint64_t), 1, fp) != 1 || fwrite(data, 1, pageSize, fp) != pageSize)
+            dumpFailed(file);
+    }
+
+    /* Buffered writes can still fail when the file is closed */
+    void closeDump( FILE* fp, std::string file ) {
+        if (fclose(fp) != 0)
+            dumpFailed(file);
+    }
+
+    void dumpFailed( std::string file ) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.fatal(CALL_INFO, -1, "Backing: Error - unable to write dump to '%s'.\n", file.c_str());
+    }
+
+    static bool isZero( const uint8_t* data, size_t size ) {
+        return data[0] == 0 && memcmp(data, data + 1, size - 1) == 0;
+    }
 };
 
 class BackingMMAP : public Backing {
@@ -66,9 +141,8 @@ public:
         m_buffer[addr - m_offset ] = value;
     }
 
-    void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            m_buffer[addr + i] = data[i];
+    void set (Addr addr, size_t size, const std::vector<uint8_t> &data) {
+        memcpy(m_buffer + (addr - m_offset), data.data(), size);
     }
 
     uint8_t get( Addr addr ) {
@@ -76,20 +150,41 @@ public:
     }
 
     void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+        memcpy(data.data(), m_buffer + (addr - m_offset), size);
+    }
+
+    /* Dumps every non-zero 4KiB page, including a partial last page */
+    void dump( std::string file ) {
+        const size_t pageSize = 4096;
+        FILE* fp = openDump(file, pageSize);
+        size_t offset = 0;
+        for (; offset + pageSize <= m_size; offset += pageSize) {
+            if (!isZero(m_buffer + offset, pageSize))
+                dumpPage(fp, file, offset + m_offset, m_buffer + offset, pageSize);
+        }
+        if (offset < m_size && !isZero(m_buffer + offset, m_size - offset)) {
+            std::vector<uint8_t> tail(pageSize, 0);
+            memcpy(tail.data(), m_buffer + offset, m_size - offset);
+            dumpPage(fp, file, offset + m_offset, tail.data(), pageSize);
+        }
+        closeDump(fp, file);
     }
 
 private:
     uint8_t* m_buffer;
     int m_fd;
-    int m_size;
+    size_t m_size;
     size_t m_offset;
 };
 
+/*
+ * Sparse backing store allocated in power-of-two units on first write
+ * Accesses are copied a unit at a time and the most recently used unit is cached
+ * to skip the map lookup for consecutive accesses. Unwritten memory reads as zero.
+ */
 class BackingMalloc : public Backing {
 public:
-    BackingMalloc(size_t size) {
+    BackingMalloc(size_t size) : m_lastAddr(0), m_lastData(nullptr) {
         m_allocUnit = size;
         /* Alloc unit needs to be pwr-2 */
         if (!isPowerOfTwo(m_allocUnit)) {
@@ -99,31 +194,29 @@ public:
         m_shift = log2Of(m_allocUnit);
     }
 
+    ~BackingMalloc() {
+        for (std::unordered_map<Addr,uint8_t*>::iterator it = m_buffer.begin(); it != m_buffer.end(); it++)
+            free(it->second);
+    }
+
     void set( Addr addr, uint8_t value ) {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        m_buffer[bAddr][offset] = value;
+        getUnit(bAddr, true)[offset] = value;
     }
 
-    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+    void set( Addr addr, size_t size, const std::vector<uint8_t> &data ) {
         /* Account for size exceeding alloc unit size */
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
-
         while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
-            offset++;
-            dataOffset++;
-
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+            size_t bytes = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            memcpy(getUnit(bAddr, true) + offset, data.data() + dataOffset, bytes);
+            dataOffset += bytes;
+            offset = 0;
+            bAddr++;
         }
     }
 
@@ -132,42 +225,69 @@ public:
         Addr offset = addr - (bAddr << m_shift);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
-
         while (dataOffset != size) {
-            data[dataOffset] = m_buffer[bAddr][offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
+            size_t bytes = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            uint8_t* unit = getUnit(bAddr, false);
+            if (unit)
+                memcpy(data.data() + dataOffset, unit + offset, bytes);
+            else
+                memset(data.data() + dataOffset, 0, bytes);
+            dataOffset += bytes;
+            offset = 0;
+            bAddr++;
         }
     }
 
     uint8_t get( Addr addr ) {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        return m_buffer[bAddr][offset];
+        uint8_t* unit = getUnit(bAddr, false);
+        return unit ? unit[offset] : 0;
+    }
+
+    /* Dumps allocated units in address order */
+    void dump( std::string file ) {
+        std::vector<Addr> units;
+        for (std::unordered_map<Addr,uint8_t*>::iterator it = m_buffer.begin(); it != m_buffer.end(); it++)
+            units.push_back(it->first);
+        std::sort(units.begin(), units.end());
+
+        FILE* fp = openDump(file, m_allocUnit);
+        for (std::vector<Addr>::iterator it = units.begin(); it != units.end(); it++) {
+            uint8_t* data = m_buffer[*it];
+            if (!isZero(data, m_allocUnit))
+                dumpPage(fp, file, *it << m_shift, data, m_allocUnit);
+        }
+        closeDump(fp, file);
     }
 
 private:
-    void allocIfNeeded(Addr bAddr) {
-        if (m_buffer.find(bAddr) == m_buffer.end()) {
-            uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
+    /* Return the unit, allocating it if 'alloc' is set; otherwise nullptr if not allocated */
+    inline uint8_t* getUnit(Addr bAddr, bool alloc) {
+        if (m_lastData && m_lastAddr == bAddr)
+            return m_lastData;
+
+        std::unordered_map<Addr,uint8_t*>::iterator it = m_buffer.find(bAddr);
+        if (it == m_buffer.end()) {
+            if (!alloc)
+                return nullptr;
+            uint8_t* data = (uint8_t*) calloc(m_allocUnit, sizeof(uint8_t));
             if (!data) {
                 Output out("", 1, 0, Output::STDOUT);
                 out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
             }
-            m_buffer[bAddr] = data;
+            it = m_buffer.insert(std::make_pair(bAddr, data)).first;
         }
+        m_lastAddr = bAddr;
+        m_lastData = it->second;
+        return m_lastData;
     }
 
     std::unordered_map<Addr,uint8_t*> m_buffer;
     unsigned int m_allocUnit;
     unsigned int m_shift;
+    Addr m_lastAddr;        // Most recently accessed unit
+    uint8_t* m_lastData;
 };
 
 }
@@ -376,7 +376,7 @@ void MemCacheController::handleDataResponse(MemEvent* event) {
     it->second.reqev->setAddr(cacheIndex);
     it->second.reqev->setBaseAddr(cacheIndex);
     it->second.reqev->setCmd(Command::PutM);
-    it->second.reqev->setPayload(event->getPayload());
+    it->second.reqev->setPayload(event->getSharedPayload());
     it->second.reqev->clearFlag();
     it->second.reqev->setFlag(MemEvent::F_NORESPONSE);
     it->second.status = AccessStatus::FIN;
@@ -599,7 +599,7 @@ void MemCacheController::writeData(MemEvent* event) {
     if (event->getCmd() == Command::PutM) { /* Write request to memory */
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->getSharedPayload().get());
 
         return;
     }
@@ -607,7 +607,7 @@ void MemCacheController::writeData(MemEvent* event) {
     if (event->getCmd() == Command::Write) {
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->getSharedPayload().get());
 
         return;
     }
@@ -635,8 +635,7 @@ void MemCacheController::readData(MemEvent* event) {
 void MemCacheController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++)
-        backing_->set(addr + i, data->at(i));
+    backing_->set(addr, data->size(), *data);
 }
 
 
@@ -645,8 +644,7 @@ void MemCacheController::readData(Addr addr, size_t bytes, std::vector<uint8_t>
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
+    backing_->get(addr, bytes, data);
 }
 
 
@@ -127,6 +127,7 @@ protected:
             // AFR: should this pass the base Addr?
             CacheListenerNotification notify(ev->getAddr(), ev->getAddr(), ev->getVirtualAddress(),
                         ev->getInstructionPointer(), ev->getSize(), READ, HIT);
+            notify.setRequestor(ev->getRqstr());
 
             for (unsigned long int i = 0; i < listeners_.size(); ++i) {
                 listeners_[i]->notifyAccess(notify);
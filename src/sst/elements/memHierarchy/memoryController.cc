@@ -311,6 +311,13 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         backing_ = new Backend::BackingMalloc(sizeBytes);
     }
 
+    backingInFile_ = params.find<std::string>("backing_in_file", "");
+    backingOutFile_ = params.find<std::string>("backing_out_file", "");
+    if (!backing_ && (backingInFile_ != "" || backingOutFile_ != "")) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_in_file/backing_out_file require a backing store but 'backing' is 'none'.\n",
+                getName().c_str());
+    }
+
     /* Custom command handler */
     using std::placeholders::_3;
     customCommandHandler_ = loadUserSubComponent<CustomCmdMemHandler>("customCmdHandler", ComponentInfo::SHARE_NONE,
@@ -569,6 +576,10 @@ void MemController::init(unsigned int phase) {
 void MemController::setup(void) {
     memBackendConvertor_->setup();
     link_->setup();
+
+    /* Restore after init() so that the saved state overrides any init-time writes */
+    if (backingInFile_ != "")
+        backing_->restore(backingInFile_, memBackendConvertor_->getMemSize());
 }
 
 
@@ -579,6 +590,9 @@ void MemController::finish(void) {
     }
     memBackendConvertor_->finish();
     link_->finish();
+
+    if (backingOutFile_ != "")
+        backing_->dump(backingOutFile_);
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -586,10 +600,10 @@ void MemController::writeData(MemEvent* event) {
         Addr addr = event->queryFlag(MemEvent::F_NONCACHEABLE) ? event->getAddr() : event->getBaseAddr();
         if (is_debug_event(event)) { 
             Debug(_L8_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); 
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->getSharedPayload().get()), true);
         }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->getSharedPayload().get());
 
         return;
     }
@@ -598,10 +612,10 @@ void MemController::writeData(MemEvent* event) {
         Addr addr = event->getAddr();
         if (is_debug_event(event)) { 
             Debug(_L8_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); 
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->getSharedPayload().get()), true);
         }
         
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->getSharedPayload().get());
 
         return;
     }
@@ -630,9 +644,7 @@ void MemController::readData(MemEvent* event) {
 void MemController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++) {
-        backing_->set(addr + i, data->at(i));
-    }
+    backing_->set(addr, data->size(), *data);
 
     if (is_debug_addr(addr))
         printDataValue(addr, data, true);
@@ -644,9 +656,8 @@ void MemController::readData(Addr addr, size_t bytes, std::vector<uint8_t> &data
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
-    
+    backing_->get(addr, bytes, data);
+
     if (is_debug_addr(addr))
         printDataValue(addr, &data, false);
 }
@@ -774,7 +785,7 @@ void MemController::emergencyShutdown() {
     }
 }
 
-void MemController::printDataValue(Addr addr, std::vector<uint8_t>* data, bool set) {
+void MemController::printDataValue(Addr addr, const std::vector<uint8_t>* data, bool set) {
     if (dlevel < 11) return;
 
     std::string action = set ? "WRITE" : "READ";
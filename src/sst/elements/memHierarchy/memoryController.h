@@ -53,6 +53,8 @@ public:
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_in_file",     "(string) Optional file written by 'backing_out_file' to restore memory contents from at the start of simulation (after init). Must use the same memory configuration.", ""},\
+            {"backing_out_file",    "(string) Optional file to write the populated portion of the backing store to at the end of simulation", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
@@ -106,6 +108,7 @@ protected:
             // AFR: should this pass the base Addr?
             CacheListenerNotification notify(ev->getAddr(), ev->getAddr(), ev->getVirtualAddress(),
                         ev->getInstructionPointer(), ev->getSize(), READ, HIT);
+            notify.setRequestor(ev->getRqstr());
 
             for (unsigned long int i = 0; i < listeners_.size(); ++i) {
                 listeners_[i]->notifyAccess(notify);
@@ -127,6 +130,8 @@ protected:
 
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    std::string             backingInFile_;     // Restore backing store from this file during setup()
+    std::string             backingOutFile_;    // Dump backing store to this file during finish()
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
@@ -158,7 +163,7 @@ protected:
     virtual void printStatus(Output &out);
     virtual void emergencyShutdown();
     
-    void printDataValue(Addr addr, std::vector<uint8_t>* data, bool set);
+    void printDataValue(Addr addr, const std::vector<uint8_t>* data, bool set);
 
 private:
 
@@ -53,7 +53,7 @@ bool MSHR::exists(Addr addr) {
     return mshr_.find(addr) != mshr_.end();
 }
 
-MSHREntry MSHR::getEntry(Addr addr, size_t index) {
+MSHREntry& MSHR::getEntry(Addr addr, size_t index) {
     if (mshr_.find(addr) == mshr_.end()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
@@ -65,7 +65,7 @@ MSHREntry MSHR::getEntry(Addr addr, size_t index) {
     return *it;
 }
 
-MSHREntry MSHR::getFront(Addr addr) {
+MSHREntry& MSHR::getFront(Addr addr) {
     if (mshr_.find(addr) == mshr_.end()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
@@ -516,6 +516,7 @@ MSHREntry* MSHR::getOldestEntry() {
         for (list<MSHREntry>::iterator jt = it->second.entries.begin(); jt != it->second.entries.end(); jt++) {
             if (jt->getType() == MSHREntryType::Event) {
                 if (!first) {
+                    first = true;
                     entry = &(*jt);
                     time = jt->getStartTime();
                 } else if (jt->getStartTime() < time) {
@@ -574,7 +575,7 @@ uint32_t MSHR::getAcksNeeded(Addr addr) {
     return (mshr_.find(addr)->second.acksNeeded);
 }
 
-void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
+void MSHR::setData(Addr addr, const SharedPayload& data, bool dirty) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
     if (mshr_.find(addr) == mshr_.end()) {
@@ -604,6 +605,13 @@ vector<uint8_t>& MSHR::getData(Addr addr) {
     if (mshr_.find(addr) == mshr_.end()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
+    return mshr_.find(addr)->second.dataBuffer.getMutable();
+}
+
+const SharedPayload& MSHR::getSharedData(Addr addr) {
+    if (mshr_.find(addr) == mshr_.end()) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getSharedData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
+    }
     return mshr_.find(addr)->second.dataBuffer;
 }
 
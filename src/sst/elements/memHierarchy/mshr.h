@@ -45,6 +45,10 @@ enum class MSHREntryType { Event, Evict, Writeback };
 
 class MSHREntry {
     public:
+        // Unused entry (e.g., pre-allocated storage)
+        MSHREntry() : type(MSHREntryType::Event), evictPtrs(nullptr), event(nullptr), time(0),
+            needEvict(false), inProgress(false), profiled(false), downgrade(false) { }
+
         // Event entry
         MSHREntry(MemEventBase* ev, bool stallEvict) {
             type = MSHREntryType::Event;
@@ -70,6 +74,20 @@ class MSHREntry {
             downgrade = downgr;
         }
 
+        // Evict entry, pointer list stored in caller-provided storage
+        MSHREntry(Addr addr, std::list<Addr>* ptrs) {
+            type = MSHREntryType::Evict;
+            event = nullptr;
+            evictPtrs = ptrs;
+            evictPtrs->clear();
+            evictPtrs->push_back(addr);
+            time = Simulation::getSimulation()->getCurrentSimCycle();
+            inProgress = false;
+            needEvict = false;
+            profiled = false;
+            downgrade = false;
+        }
+
         // Evict entry
         MSHREntry(Addr addr) {
             type = MSHREntryType::Evict;
@@ -95,6 +113,8 @@ class MSHREntry {
             downgrade = entry.downgrade;
         }
 
+        MSHREntry& operator=(const MSHREntry& entry) = default;
+
         MSHREntryType getType() { return type; }
 
         bool getInProgress() { return inProgress; }
@@ -167,7 +187,7 @@ struct MSHRRegister {
     MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0) { }
     list<MSHREntry> entries;
     uint32_t acksNeeded;
-    vector<uint8_t> dataBuffer;
+    SharedPayload dataBuffer;
     bool dataDirty;
     uint32_t pendingRetries;
 
@@ -186,78 +206,79 @@ public:
 
     // used externally
     MSHR(Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr);
+    virtual ~MSHR() { }
 
     int getMaxSize();
     int getSize();
-    unsigned int getSize(Addr addr);
-    bool exists(Addr addr);
+    virtual unsigned int getSize(Addr addr);
+    virtual bool exists(Addr addr);
 
     // Accessors for first event since that's most common
-    MSHREntry getFront(Addr addr);
-    void removeFront(Addr addr);
+    virtual MSHREntry& getFront(Addr addr);
+    virtual void removeFront(Addr addr);
 
-    MSHREntryType getFrontType(Addr addr);
+    virtual MSHREntryType getFrontType(Addr addr);
 
-    MemEventBase* getFrontEvent(Addr addr);
-    std::list<Addr>* getEvictPointers(Addr addr);
-    bool removeEvictPointer(Addr addr, Addr ptrAddr);
+    virtual MemEventBase* getFrontEvent(Addr addr);
+    virtual std::list<Addr>* getEvictPointers(Addr addr);
+    virtual bool removeEvictPointer(Addr addr, Addr ptrAddr);
 
     // Special move accessor
-    void moveEntryToFront(Addr addr, unsigned int index);
+    virtual void moveEntryToFront(Addr addr, unsigned int index);
 
     // Generic accessors
-    MSHREntry getEntry(Addr addr, size_t index);
-    void removeEntry(Addr addr, size_t index);
+    virtual MSHREntry& getEntry(Addr addr, size_t index);
+    virtual void removeEntry(Addr addr, size_t index);
 
-    MSHREntryType getEntryType(Addr addr, size_t index);
-    MemEventBase* getEntryEvent(Addr addr, size_t index);
+    virtual MSHREntryType getEntryType(Addr addr, size_t index);
+    virtual MemEventBase* getEntryEvent(Addr addr, size_t index);
 
-    MemEventBase* swapFrontEvent(Addr addr, MemEventBase* event);
+    virtual MemEventBase* swapFrontEvent(Addr addr, MemEventBase* event);
 
-    bool pendingWriteback(Addr addr);
-    bool pendingWritebackIsDowngrade(Addr addr);
+    virtual bool pendingWriteback(Addr addr);
+    virtual bool pendingWritebackIsDowngrade(Addr addr);
 
-    int insertEvent(Addr addr, MemEventBase* event, int position, bool fwdRequest, bool stallEvict);
-    bool insertWriteback(Addr addr, bool downgrade);
-    bool insertEviction(Addr evictAddr, Addr newAddr);
+    virtual int insertEvent(Addr addr, MemEventBase* event, int position, bool fwdRequest, bool stallEvict);
+    virtual bool insertWriteback(Addr addr, bool downgrade);
+    virtual bool insertEviction(Addr evictAddr, Addr newAddr);
 
-    void setInProgress(Addr addr, bool value = true);
-    bool getInProgress(Addr addr);
+    virtual void setInProgress(Addr addr, bool value = true);
+    virtual bool getInProgress(Addr addr);
 
-    void addPendingRetry(Addr addr);
-    void removePendingRetry(Addr addr);
-    uint32_t getPendingRetries(Addr addr);
+    virtual void addPendingRetry(Addr addr);
+    virtual void removePendingRetry(Addr addr);
+    virtual uint32_t getPendingRetries(Addr addr);
 
-    void setStalledForEvict(Addr addr, bool set);
-    bool getStalledForEvict(Addr addr);
+    virtual void setStalledForEvict(Addr addr, bool set);
+    virtual bool getStalledForEvict(Addr addr);
 
-    void setProfiled(Addr addr);
-    bool getProfiled(Addr addr);
+    virtual void setProfiled(Addr addr);
+    virtual bool getProfiled(Addr addr);
 
-    void setProfiled(Addr addr, SST::Event::id_type id);
-    bool getProfiled(Addr addr, SST::Event::id_type id);
+    virtual void setProfiled(Addr addr, SST::Event::id_type id);
+    virtual bool getProfiled(Addr addr, SST::Event::id_type id);
 
-    MemEventBase* getFirstEventEntry(Addr addr, Command cmd);
-    MSHREntry* getOldestEntry();
+    virtual MemEventBase* getFirstEventEntry(Addr addr, Command cmd);
+    virtual MSHREntry* getOldestEntry();
 
-    void incrementAcksNeeded(Addr addr);
-    bool decrementAcksNeeded(Addr addr);
-    uint32_t getAcksNeeded(Addr addr);
+    virtual void incrementAcksNeeded(Addr addr);
+    virtual bool decrementAcksNeeded(Addr addr);
+    virtual uint32_t getAcksNeeded(Addr addr);
 
-    void setData(Addr addr, vector<uint8_t>& data, bool dirty = false);
-    void clearData(Addr addr);
-    vector<uint8_t>& getData(Addr addr);
-    bool hasData(Addr addr);
-    bool getDataDirty(Addr addr);
-    void setDataDirty(Addr addr, bool dirty);
+    virtual void setData(Addr addr, const SharedPayload& data, bool dirty = false);
+    virtual void clearData(Addr addr);
+    virtual vector<uint8_t>& getData(Addr addr);                // Copies the data first if it is shared
+    virtual const SharedPayload& getSharedData(Addr addr);      // Never copies
+    virtual bool hasData(Addr addr);
+    virtual bool getDataDirty(Addr addr);
+    virtual void setDataDirty(Addr addr, bool dirty);
 
-    void printStatus(Output &out);
+    virtual void printStatus(Output &out);
 
-private:
+protected:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
-    MSHRBlock mshr_;
     Output* d_;
     Output* d2_;
     int size_;
@@ -265,6 +286,9 @@ private:
     int prefetchCount_;
     string ownerName_;
     std::set<Addr> DEBUG_ADDR;
+
+private:
+    MSHRBlock mshr_;
 };
 }}
 #endif
@@ -0,0 +1,662 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "pooledMSHR.h"
+
+#include <algorithm>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+const uint32_t PooledMSHR::NIL;
+
+PooledMSHR::PooledMSHR(Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr) :
+    MSHR(debug, maxSize, cacheName, debugAddr) {
+
+    // Size the index for 2x the expected number of addresses (events plus a few evictions/writebacks)
+    uint32_t expected = (maxSize > 0) ? maxSize + 16 : 256;
+    uint32_t slots = 16;
+    while (slots < 2 * expected)
+        slots <<= 1;
+
+    indexKeys_.resize(slots, 0);
+    indexVals_.resize(slots, NIL);
+    indexMask_ = slots - 1;
+    indexCount_ = 0;
+
+    registers_.reserve(expected);
+    entries_.reserve(expected);
+}
+
+/***********************************************************************************************************
+ * Index and chain management
+ ***********************************************************************************************************/
+
+PooledMSHR::Register* PooledMSHR::lookup(Addr addr) {
+    uint32_t i = slot(addr);
+    while (indexVals_[i] != NIL) {
+        if (indexKeys_[i] == addr)
+            return &registers_[indexVals_[i]];
+        i = (i + 1) & indexMask_;
+    }
+    return nullptr;
+}
+
+PooledMSHR::Register* PooledMSHR::lookupOrFatal(Addr addr, const char* func) {
+    Register* reg = lookup(addr);
+    if (!reg)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::%s(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), func, addr);
+    return reg;
+}
+
+PooledMSHR::Register* PooledMSHR::allocateRegister(Addr addr) {
+    if (2 * (indexCount_ + 1) > indexVals_.size())
+        growIndex();
+
+    uint32_t id = registers_.allocate();
+    Register* reg = &registers_[id];
+    reg->addr = addr;
+    reg->head = NIL;
+    reg->tail = NIL;
+    reg->count = 0;
+    reg->acksNeeded = 0;
+    reg->dataBuffer.clear();
+    reg->dataDirty = false;
+    reg->pendingRetries = 0;
+
+    uint32_t i = slot(addr);
+    while (indexVals_[i] != NIL)
+        i = (i + 1) & indexMask_;
+    indexKeys_[i] = addr;
+    indexVals_[i] = id;
+    indexCount_++;
+    return reg;
+}
+
+/* Remove from index using backward-shift deletion so no tombstones are needed */
+void PooledMSHR::eraseRegister(Register* reg) {
+    uint32_t i = slot(reg->addr);
+    while (indexKeys_[i] != reg->addr || indexVals_[i] == NIL)
+        i = (i + 1) & indexMask_;
+
+    registers_.release(indexVals_[i]);
+    indexVals_[i] = NIL;
+    indexCount_--;
+
+    uint32_t j = i;
+    while (true) {
+        j = (j + 1) & indexMask_;
+        if (indexVals_[j] == NIL)
+            break;
+        uint32_t home = slot(indexKeys_[j]);
+        // Move j into the hole at i if j's home slot is not in (i, j]
+        if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j))) {
+            indexKeys_[i] = indexKeys_[j];
+            indexVals_[i] = indexVals_[j];
+            indexVals_[j] = NIL;
+            i = j;
+        }
+    }
+}
+
+void PooledMSHR::growIndex() {
+    std::vector<Addr> oldKeys;
+    std::vector<uint32_t> oldVals;
+    oldKeys.swap(indexKeys_);
+    oldVals.swap(indexVals_);
+
+    indexKeys_.resize(oldKeys.size() * 2, 0);
+    indexVals_.resize(oldVals.size() * 2, NIL);
+    indexMask_ = indexVals_.size() - 1;
+
+    for (size_t j = 0; j < oldVals.size(); j++) {
+        if (oldVals[j] == NIL)
+            continue;
+        uint32_t i = slot(oldKeys[j]);
+        while (indexVals_[i] != NIL)
+            i = (i + 1) & indexMask_;
+        indexKeys_[i] = oldKeys[j];
+        indexVals_[i] = oldVals[j];
+    }
+}
+
+PooledMSHR::Entry& PooledMSHR::entryAt(Register* reg, size_t index) {
+    uint32_t node = reg->head;
+    for (size_t i = 0; i < index; i++)
+        node = entries_[node].next;
+    return entries_[node];
+}
+
+uint32_t PooledMSHR::allocateEntry() {
+    return entries_.allocate();
+}
+
+void PooledMSHR::linkBefore(Register* reg, uint32_t node, uint32_t before) {
+    Entry& entry = entries_[node];
+    if (before == NIL) {
+        entry.prev = reg->tail;
+        entry.next = NIL;
+        if (reg->tail != NIL)
+            entries_[reg->tail].next = node;
+        else
+            reg->head = node;
+        reg->tail = node;
+    } else {
+        entry.next = before;
+        entry.prev = entries_[before].prev;
+        if (entry.prev != NIL)
+            entries_[entry.prev].next = node;
+        else
+            reg->head = node;
+        entries_[before].prev = node;
+    }
+    reg->count++;
+}
+
+void PooledMSHR::unlink(Register* reg, uint32_t node) {
+    Entry& entry = entries_[node];
+    if (entry.prev != NIL)
+        entries_[entry.prev].next = entry.next;
+    else
+        reg->head = entry.next;
+    if (entry.next != NIL)
+        entries_[entry.next].prev = entry.prev;
+    else
+        reg->tail = entry.prev;
+    reg->count--;
+}
+
+/* Common path for removeFront/removeEntry */
+void PooledMSHR::removeNode(Register* reg, uint32_t node, const char* action) {
+    Addr addr = reg->addr;
+    MSHREntry& entry = entries_[node].entry;
+
+    if (entry.getType() == MSHREntryType::Event)
+        size_--;
+
+    if (is_debug_addr(addr))
+        printDebug(10, action, addr, entry.getString().c_str());
+
+    unlink(reg, node);
+    entries_.release(node);
+
+    if (reg->count == 0) {
+        if (is_debug_addr(addr))
+            printDebug(10, "Erase", addr, "");
+        eraseRegister(reg);
+    }
+}
+
+/***********************************************************************************************************
+ * MSHR API
+ ***********************************************************************************************************/
+
+unsigned int PooledMSHR::getSize(Addr addr) {
+    Register* reg = lookup(addr);
+    return reg ? reg->count : 0;
+}
+
+bool PooledMSHR::exists(Addr addr) {
+    return lookup(addr) != nullptr;
+}
+
+MSHREntry& PooledMSHR::getEntry(Addr addr, size_t index) {
+    Register* reg = lookupOrFatal(addr, "getEntry");
+    if (reg->count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %u.\n", ownerName_.c_str(), addr, index, reg->count);
+    }
+    return entryAt(reg, index).entry;
+}
+
+MSHREntry& PooledMSHR::getFront(Addr addr) {
+    Register* reg = lookupOrFatal(addr, "getFront");
+    if (reg->count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    return entries_[reg->head].entry;
+}
+
+void PooledMSHR::removeEntry(Addr addr, size_t index) {
+    Register* reg = lookupOrFatal(addr, "removeEntry");
+    if (reg->count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
+    }
+    uint32_t node = reg->head;
+    for (size_t i = 0; i < index; i++)
+        node = entries_[node].next;
+    removeNode(reg, node, "Remove");
+}
+
+void PooledMSHR::removeFront(Addr addr) {
+    Register* reg = lookupOrFatal(addr, "removeFront");
+    if (reg->count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    removeNode(reg, reg->head, "RemFr");
+}
+
+MSHREntryType PooledMSHR::getEntryType(Addr addr, size_t index) {
+    Register* reg = lookupOrFatal(addr, "getEntryType");
+    if (reg->count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shoerter than index.\n", ownerName_.c_str(), addr, index);
+    }
+    return entryAt(reg, index).entry.getType();
+}
+
+MSHREntryType PooledMSHR::getFrontType(Addr addr) {
+    return getFront(addr).getType();
+}
+
+MemEventBase* PooledMSHR::getEntryEvent(Addr addr, size_t index) {
+    Register* reg = lookup(addr);
+    if (!reg || reg->count <= index)
+        return nullptr;
+
+    MSHREntry& entry = entryAt(reg, index).entry;
+    if (entry.getType() != MSHREntryType::Event)
+        return nullptr;
+    return entry.getEvent();
+}
+
+MemEventBase* PooledMSHR::getFrontEvent(Addr addr) {
+    MSHREntry& entry = getFront(addr);
+    if (entry.getType() != MSHREntryType::Event)
+        return nullptr;
+    return entry.getEvent();
+}
+
+MemEventBase* PooledMSHR::getFirstEventEntry(Addr addr, Command cmd) {
+    Register* reg = lookup(addr);
+    if (!reg)
+        return nullptr;
+
+    for (uint32_t node = reg->head; node != NIL; node = entries_[node].next) {
+        MSHREntry& entry = entries_[node].entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getCmd() == cmd)
+            return entry.getEvent();
+    }
+    return nullptr;
+}
+
+std::list<Addr>* PooledMSHR::getEvictPointers(Addr addr) {
+    MSHREntry& entry = getFront(addr);
+    if (entry.getType() != MSHREntryType::Evict)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr);
+
+    return entry.getPointers();
+}
+
+// Return whether we should retry a new event or not
+bool PooledMSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
+    MSHREntryType frontType = getFrontType(addr);
+    if (frontType == MSHREntryType::Event)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Front entry type is not Evict or Writeback.\n", ownerName_.c_str(), addr, addrPtr);
+
+    if (is_debug_addr(addr) || is_debug_addr(addrPtr)) {
+        stringstream reason;
+        reason << "to 0x" << std::hex << addrPtr;
+        printDebug(10, "RemPtr", addr, reason.str());
+    }
+
+    Register* reg = lookup(addr);
+
+    // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
+    if (frontType == MSHREntryType::Evict) {
+        uint32_t node = reg->head;
+        MSHREntry& entry = entries_[node].entry;
+        entry.getPointers()->remove(addrPtr);
+        if (entry.getPointers()->empty()) {
+            removeNode(reg, node, "RemFr");
+            return true;
+        }
+    } else {
+        uint32_t node = entries_[reg->head].next;
+        if (node == NIL || entries_[node].entry.getType() != MSHREntryType::Evict)
+            d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr, addrPtr);
+        MSHREntry& entry = entries_[node].entry;
+        entry.getPointers()->remove(addrPtr);
+        if (entry.getPointers()->empty()) {
+            removeNode(reg, node, "Remove");
+        }
+    }
+    return false;
+}
+
+bool PooledMSHR::pendingWriteback(Addr addr) {
+    Register* reg = lookup(addr);
+    return reg && reg->count != 0 && entries_[reg->head].entry.getType() == MSHREntryType::Writeback;
+}
+
+bool PooledMSHR::pendingWritebackIsDowngrade(Addr addr) {
+    if (pendingWriteback(addr))
+        return getFront(addr).getDowngrade();
+    return false;
+}
+
+int PooledMSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest, bool stallEvict) {
+    if ((size_ == maxSize_) || (!fwdRequest && (size_ == maxSize_-1))) {
+        if (is_debug_addr(addr)) {
+            stringstream reason;
+            reason << "<" << event->getID().first << "," << event->getID().second << "> FAILED " << (fwdRequest ? "fwd, " : "") << "maxsz: " << maxSize_;
+            printDebug(10, "InsEv", addr, reason.str());
+        }
+        return -1;
+    }
+
+    // Success
+    size_++;
+
+    Register* reg = lookup(addr);
+    if (!reg)
+        reg = allocateRegister(addr);
+
+    uint32_t node = allocateEntry();
+    entries_[node].entry = MSHREntry(event, stallEvict);
+
+    int insertPos;
+    if (pos == -1 || pos >= (int)reg->count) {
+        insertPos = reg->count;
+        linkBefore(reg, node, NIL);
+    } else {
+        insertPos = pos;
+        uint32_t before = reg->head;
+        for (int i = 0; i < pos; i++)
+            before = entries_[before].next;
+        linkBefore(reg, node, before);
+    }
+
+    if (is_debug_addr(addr)) {
+        stringstream reason;
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << insertPos;
+        printDebug(10, "InsEv", addr, reason.str());
+    }
+    return insertPos;
+}
+
+MemEventBase* PooledMSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
+    if (is_debug_addr(addr))
+        printDebug(10, "SwpEv", addr, "");
+
+    Register* reg = lookup(addr);
+    if (!reg || reg->count == 0)
+        return nullptr;
+
+    return entries_[reg->head].entry.swapEvent(event);
+}
+
+void PooledMSHR::moveEntryToFront(Addr addr, unsigned int index) {
+    Register* reg = lookupOrFatal(addr, "moveEntryToFront");
+    if (reg->count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
+    }
+
+    uint32_t node = reg->head;
+    for (unsigned int i = 0; i < index; i++)
+        node = entries_[node].next;
+
+    if (is_debug_addr(addr))
+        printDebug(10, "MvEnt", addr, entries_[node].entry.getString());
+
+    unlink(reg, node);
+    linkBefore(reg, node, reg->head);
+}
+
+bool PooledMSHR::insertWriteback(Addr addr, bool downgrade) {
+    if (is_debug_addr(addr)) {
+        stringstream reason;
+        reason << "Downgrade: " << (downgrade ? "T" : "F");
+        printDebug(10, "InsWB", addr, reason.str());
+    }
+
+    Register* reg = lookup(addr);
+    if (!reg)
+        reg = allocateRegister(addr);
+
+    uint32_t node = allocateEntry();
+    entries_[node].entry = MSHREntry(downgrade);
+    linkBefore(reg, node, reg->head);
+    return true;
+}
+
+bool PooledMSHR::insertEviction(Addr oldAddr, Addr newAddr) {
+    if (is_debug_addr(oldAddr) || is_debug_addr(newAddr)) {
+        stringstream reason;
+        reason << "to 0x" << std::hex << newAddr;
+        printDebug(10, "InsPtr", oldAddr, reason.str());
+    }
+
+    Register* reg = lookup(oldAddr);
+    if (!reg)
+        reg = allocateRegister(oldAddr);
+
+    if (reg->tail != NIL && entries_[reg->tail].entry.getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
+        entries_[reg->tail].entry.getPointers()->push_back(newAddr);
+    } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
+        uint32_t node = allocateEntry();
+        entries_[node].entry = MSHREntry(newAddr, &(entries_[node].evictPtrs));
+        linkBefore(reg, node, NIL);
+    }
+    return true;
+}
+
+void PooledMSHR::addPendingRetry(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(20, "IncRetry", addr, "");
+
+    lookupOrFatal(addr, "addPendingRetry")->pendingRetries++;
+}
+
+void PooledMSHR::removePendingRetry(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(20, "DecRetry", addr, "");
+
+    lookupOrFatal(addr, "removePendingRetry")->pendingRetries--;
+}
+
+uint32_t PooledMSHR::getPendingRetries(Addr addr) {
+    Register* reg = lookup(addr);
+    return reg ? reg->pendingRetries : 0;
+}
+
+void PooledMSHR::setInProgress(Addr addr, bool value) {
+    if (is_debug_addr(addr))
+        printDebug(20, "InProg", addr, "");
+
+    getFront(addr).setInProgress(value);
+}
+
+bool PooledMSHR::getInProgress(Addr addr) {
+    Register* reg = lookup(addr);
+    if (!reg || reg->count == 0)
+        return false;
+    return entries_[reg->head].entry.getInProgress();
+}
+
+void PooledMSHR::setStalledForEvict(Addr addr, bool set) {
+    if (is_debug_addr(addr)) {
+        if (set)
+            printDebug(20, "Stall", addr, "");
+        else
+            printDebug(20, "Unstall", addr, "");
+    }
+
+    getFront(addr).setStalledForEvict(set);
+}
+
+bool PooledMSHR::getStalledForEvict(Addr addr) {
+    Register* reg = lookup(addr);
+    if (!reg || reg->count == 0)
+        return false;
+    return entries_[reg->head].entry.getStalledForEvict();
+}
+
+void PooledMSHR::setProfiled(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(20, "Profile", addr, "");
+
+    getFront(addr).setProfiled();
+}
+
+bool PooledMSHR::getProfiled(Addr addr) {
+    return getFront(addr).getProfiled();
+}
+
+bool PooledMSHR::getProfiled(Addr addr, SST::Event::id_type id) {
+    Register* reg = lookupOrFatal(addr, "getProfiled");
+    for (uint32_t node = reg->head; node != NIL; node = entries_[node].next) {
+        MSHREntry& entry = entries_[node].entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id)
+            return entry.getProfiled();
+    }
+    return true; // default so we don't attempt to profile what isn't there
+}
+
+void PooledMSHR::setProfiled(Addr addr, SST::Event::id_type id) {
+    if (is_debug_addr(addr))
+        printDebug(20, "Profile", addr, "");
+
+    Register* reg = lookupOrFatal(addr, "setProfiled");
+    for (uint32_t node = reg->head; node != NIL; node = entries_[node].next) {
+        MSHREntry& entry = entries_[node].entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id) {
+            entry.setProfiled();
+            return;
+        }
+    }
+}
+
+/* Ties go to the lowest address, as in MSHR where the map is walked in address order */
+MSHREntry* PooledMSHR::getOldestEntry() {
+    MSHREntry* oldest = nullptr;
+    Addr oldestAddr = 0;
+
+    for (size_t i = 0; i < indexVals_.size(); i++) {
+        if (indexVals_[i] == NIL)
+            continue;
+        Register* reg = &registers_[indexVals_[i]];
+        for (uint32_t node = reg->head; node != NIL; node = entries_[node].next) {
+            MSHREntry& entry = entries_[node].entry;
+            if (entry.getType() != MSHREntryType::Event)
+                continue;
+            if (!oldest || entry.getStartTime() < oldest->getStartTime() ||
+                    (entry.getStartTime() == oldest->getStartTime() && reg->addr < oldestAddr)) {
+                oldest = &entry;
+                oldestAddr = reg->addr;
+            }
+        }
+    }
+    return oldest;
+}
+
+void PooledMSHR::incrementAcksNeeded(Addr addr) {
+    Register* reg = lookup(addr);
+    if (!reg)
+        reg = allocateRegister(addr);
+    reg->acksNeeded++;
+
+    if (is_debug_addr(addr)) {
+        std::stringstream reason;
+        reason << reg->acksNeeded << " acks";
+        printDebug(10, "IncAck", addr, reason.str());
+    }
+}
+
+/* Decrement acks needed and return if we're done waiting (acksNeeded == 0) */
+bool PooledMSHR::decrementAcksNeeded(Addr addr) {
+    Register* reg = lookupOrFatal(addr, "decrementAcksNeeded");
+    if (reg->acksNeeded == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", ownerName_.c_str(), addr);
+    }
+    reg->acksNeeded--;
+
+    if (is_debug_addr(addr)) {
+        std::stringstream reason;
+        reason << reg->acksNeeded << " acks";
+        printDebug(10, "DecAck", addr, reason.str());
+    }
+
+    return (reg->acksNeeded == 0);
+}
+
+uint32_t PooledMSHR::getAcksNeeded(Addr addr) {
+    Register* reg = lookup(addr);
+    return reg ? reg->acksNeeded : 0;
+}
+
+void PooledMSHR::setData(Addr addr, const SharedPayload& data, bool dirty) {
+    Register* reg = lookupOrFatal(addr, "setData");
+
+    if (is_debug_addr(addr))
+        printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
+
+    reg->dataBuffer = data;
+    reg->dataDirty = dirty;
+}
+
+void PooledMSHR::clearData(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(10, "ClrData", addr, "");
+
+    Register* reg = lookupOrFatal(addr, "clearData");
+    reg->dataBuffer.clear();
+    reg->dataDirty = false;
+}
+
+vector<uint8_t>& PooledMSHR::getData(Addr addr) {
+    return lookupOrFatal(addr, "getData")->dataBuffer.getMutable();
+}
+
+const SharedPayload& PooledMSHR::getSharedData(Addr addr) {
+    return lookupOrFatal(addr, "getSharedData")->dataBuffer;
+}
+
+bool PooledMSHR::hasData(Addr addr) {
+    Register* reg = lookup(addr);
+    return reg && !reg->dataBuffer.empty();
+}
+
+bool PooledMSHR::getDataDirty(Addr addr) {
+    return lookupOrFatal(addr, "getDataDirty")->dataDirty;
+}
+
+void PooledMSHR::setDataDirty(Addr addr, bool dirty) {
+    if (is_debug_addr(addr))
+        printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
+
+    lookupOrFatal(addr, "setDataDirty")->dataDirty = dirty;
+}
+
+// Print status. Called by cache controller on EmergencyShutdown and printStatus()
+void PooledMSHR::printStatus(Output &out) {
+    out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\n", ownerName_.c_str(), size_, prefetchCount_);
+
+    // Sort by address so output matches the map-based MSHR
+    std::vector<Addr> addrs;
+    for (size_t i = 0; i < indexVals_.size(); i++) {
+        if (indexVals_[i] != NIL)
+            addrs.push_back(indexKeys_[i]);
+    }
+    std::sort(addrs.begin(), addrs.end());
+
+    for (std::vector<Addr>::iterator it = addrs.begin(); it != addrs.end(); it++) {
+        out.output("      Entry: Addr = 0x%" PRIx64 "\n", *it);
+        Register* reg = lookup(*it);
+        for (uint32_t node = reg->head; node != NIL; node = entries_[node].next) {
+            out.output("        %s\n", entries_[node].entry.getString().c_str());
+        }
+    }
+    out.output("    End MSHR Status for %s\n", ownerName_.c_str());
+}
@@ -0,0 +1,176 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _POOLEDMSHR_H_
+#define _POOLEDMSHR_H_
+
+#include <memory>
+#include <vector>
+
+#include "sst/elements/memHierarchy/mshr.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * MSHR with the same interface & behavior as MSHR but without per-miss allocation
+ *
+ *  - Address -> register lookup is an open-addressed (linear probing) hash table
+ *    sized from the MSHR size. It grows only if more addresses are tracked than
+ *    expected (evictions and writebacks do not count towards the MSHR size).
+ *  - Registers and entries come from slabs that are allocated in chunks and reused.
+ *  - The entries for an address form an intrusive doubly-linked chain through the entry slab.
+ *  - Evict entries keep their pointer lists inside the slab entry, so the list
+ *    storage is reused as well.
+ */
+class PooledMSHR : public MSHR {
+public:
+    PooledMSHR(Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr);
+    ~PooledMSHR() { }
+
+    using MSHR::getSize;
+    unsigned int getSize(Addr addr) override;
+    bool exists(Addr addr) override;
+
+    MSHREntry& getFront(Addr addr) override;
+    void removeFront(Addr addr) override;
+
+    MSHREntryType getFrontType(Addr addr) override;
+
+    MemEventBase* getFrontEvent(Addr addr) override;
+    std::list<Addr>* getEvictPointers(Addr addr) override;
+    bool removeEvictPointer(Addr addr, Addr ptrAddr) override;
+
+    void moveEntryToFront(Addr addr, unsigned int index) override;
+
+    MSHREntry& getEntry(Addr addr, size_t index) override;
+    void removeEntry(Addr addr, size_t index) override;
+
+    MSHREntryType getEntryType(Addr addr, size_t index) override;
+    MemEventBase* getEntryEvent(Addr addr, size_t index) override;
+
+    MemEventBase* swapFrontEvent(Addr addr, MemEventBase* event) override;
+
+    bool pendingWriteback(Addr addr) override;
+    bool pendingWritebackIsDowngrade(Addr addr) override;
+
+    int insertEvent(Addr addr, MemEventBase* event, int position, bool fwdRequest, bool stallEvict) override;
+    bool insertWriteback(Addr addr, bool downgrade) override;
+    bool insertEviction(Addr evictAddr, Addr newAddr) override;
+
+    void setInProgress(Addr addr, bool value = true) override;
+    bool getInProgress(Addr addr) override;
+
+    void addPendingRetry(Addr addr) override;
+    void removePendingRetry(Addr addr) override;
+    uint32_t getPendingRetries(Addr addr) override;
+
+    void setStalledForEvict(Addr addr, bool set) override;
+    bool getStalledForEvict(Addr addr) override;
+
+    void setProfiled(Addr addr) override;
+    bool getProfiled(Addr addr) override;
+
+    void setProfiled(Addr addr, SST::Event::id_type id) override;
+    bool getProfiled(Addr addr, SST::Event::id_type id) override;
+
+    MemEventBase* getFirstEventEntry(Addr addr, Command cmd) override;
+    MSHREntry* getOldestEntry() override;
+
+    void incrementAcksNeeded(Addr addr) override;
+    bool decrementAcksNeeded(Addr addr) override;
+    uint32_t getAcksNeeded(Addr addr) override;
+
+    void setData(Addr addr, const SharedPayload& data, bool dirty = false) override;
+    void clearData(Addr addr) override;
+    vector<uint8_t>& getData(Addr addr) override;
+    const SharedPayload& getSharedData(Addr addr) override;
+    bool hasData(Addr addr) override;
+    bool getDataDirty(Addr addr) override;
+    void setDataDirty(Addr addr, bool dirty) override;
+
+    void printStatus(Output &out) override;
+
+private:
+    static const uint32_t NIL = 0xFFFFFFFF;
+
+    /* Fixed-size chunks so that element addresses never change once allocated */
+    template <class T>
+    class Slab {
+    public:
+        uint32_t allocate() {
+            if (free_.empty()) grow();
+            uint32_t index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+        void release(uint32_t index) { free_.push_back(index); }
+        void reserve(size_t count) { while (chunks_.size() * chunkSize < count) grow(); }
+        T& operator[](uint32_t index) { return chunks_[index / chunkSize][index % chunkSize]; }
+    private:
+        static const uint32_t chunkSize = 64;
+        void grow() {
+            uint32_t base = chunks_.size() * chunkSize;
+            chunks_.emplace_back(new T[chunkSize]);
+            for (uint32_t i = chunkSize; i > 0; i--)
+                free_.push_back(base + i - 1);
+        }
+        std::vector<std::unique_ptr<T[]> > chunks_;
+        std::vector<uint32_t> free_;
+    };
+
+    struct Entry {
+        MSHREntry entry;
+        std::list<Addr> evictPtrs;  // Storage for Evict entries' pointer list
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    struct Register {
+        Addr addr;
+        uint32_t head;
+        uint32_t tail;
+        uint32_t count;
+        uint32_t acksNeeded;
+        SharedPayload dataBuffer;
+        bool dataDirty;
+        uint32_t pendingRetries;
+    };
+
+    /* Index */
+    inline uint32_t slot(Addr addr) { return (uint32_t)((addr * 0x9E3779B97F4A7C15ULL) >> 32) & indexMask_; }
+    Register* lookup(Addr addr);
+    Register* lookupOrFatal(Addr addr, const char* func);
+    Register* allocateRegister(Addr addr);
+    void eraseRegister(Register* reg);
+    void growIndex();
+
+    /* Chains */
+    Entry& entryAt(Register* reg, size_t index);
+    uint32_t allocateEntry();
+    void linkBefore(Register* reg, uint32_t node, uint32_t before); // before == NIL -> append
+    void unlink(Register* reg, uint32_t node);
+    void removeNode(Register* reg, uint32_t node, const char* action);
+
+    std::vector<Addr> indexKeys_;
+    std::vector<uint32_t> indexVals_;    // Register id or NIL if slot is empty
+    uint32_t indexMask_;
+    uint32_t indexCount_;
+
+    Slab<Register> registers_;
+    Slab<Entry> entries_;
+};
+
+}}
+#endif
@@ -0,0 +1,48 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+/*
+  Install the python library
+ */
+#include <sst/core/model/element_python.h>
+
+namespace SST {
+namespace MemHierarchy {
+
+char pymemhierarchy[] = {
+#include "pymemHierarchy.inc"
+    0x00};
+
+class MemHierarchyPyModule : public SSTElementPythonModule {
+public:
+    MemHierarchyPyModule(std::string library) :
+        SSTElementPythonModule(library)
+    {
+        createPrimaryModule(pymemhierarchy, "pymemHierarchy.py");
+    }
+
+    SST_ELI_REGISTER_PYTHON_MODULE(
+        SST::MemHierarchy::MemHierarchyPyModule,
+        "memHierarchy",
+        SST_ELI_ELEMENT_VERSION(1,0,0)
+    )
+
+    SST_ELI_EXPORT(SST::MemHierarchy::MemHierarchyPyModule)
+};
+
+}
+}
@@ -0,0 +1,127 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+import re
+
+_time_units = { "s" : 1e12, "ms" : 1e9, "us" : 1e6, "ns" : 1e3, "ps" : 1.0, "fs" : 1e-3 }
+
+def _toPs(time):
+    m = re.match(r"^\s*([0-9]*\.?[0-9]+)\s*([munpf]?s)\s*$", time)
+    if not m:
+        raise ValueError("memHierarchy: cannot parse time '%s', expected a number and a unit (s, ms, us, ns, ps, fs)" % time)
+    return float(m.group(1)) * _time_units[m.group(2)]
+
+def _fromPs(ps):
+    return "%gps" % ps
+
+
+class PartitionHints:
+    """Place memHierarchy components on threads/ranks and report the resulting lookahead
+
+    The SST partitioner can only split components across threads/ranks along links with
+    latency, and the smallest latency on a split link bounds how far the partitions can run
+    ahead of each other. Links between memHierarchy components are often zero or near-zero
+    latency with the component adding its own access latency, so large hierarchies tend to
+    end up serialized on one thread.
+
+    Usage:
+      - addGroup() for each set of components that should stay together, for example an
+        L1/L2 pair with its core, or a directory with its memory controller. Components
+        that are not in a group are placed by the partitioner. List subcomponents whose
+        ports are connected, such as a CPU's memory interface, with their component so
+        that their links count as inside the group.
+      - connect() for every link. Links between groups get 'lookahead' of extra latency.
+        If both endpoints name their link manager ('cpulink' or 'memlink' for caches,
+        'memlink' for a directory's memory port), the manager is given the same lookahead
+        and sends events that much earlier, so timing does not change as long as the
+        component's latency toward that link is at least the lookahead. The lookahead must
+        be a whole number of each manager's clock periods, the managers reject it otherwise.
+        Endpoints that cannot send early (memory controllers, buses, CPUs) see the extra
+        latency, so keep them in the same group as their neighbors.
+      - apply() assigns each group a rank/thread and selects the 'sst.self' partitioner.
+      - getMinLatency()/report() give the minimum latency across groups.
+    """
+
+    def __init__(self, lookahead="0ps"):
+        self._lookahead = _toPs(lookahead)
+        self._groups = []
+        self._groupOf = dict()
+        self._minLatency = None
+
+    def addGroup(self, components):
+        """Keep components (and subcomponents) on the same rank/thread. Returns the group's index."""
+        group = len(self._groups)
+        self._groups.append(list(components))
+        for comp in components:
+            self._groupOf[id(comp)] = group
+        return group
+
+    def getGroup(self, component):
+        return self._groupOf.get(id(component))
+
+    def connect(self, name, endpointA, endpointB, latency="0ps"):
+        """Create and connect a link
+
+        endpointA/B: (component, port) or (component, port, linkManager) where linkManager is
+        the component's param scope for the link on that port, e.g., 'cpulink' or 'memlink'.
+        """
+        compA, portA, scopeA = self._endpoint(endpointA)
+        compB, portB, scopeB = self._endpoint(endpointB)
+        latencyPs = _toPs(latency)
+
+        groupA = self.getGroup(compA)
+        groupB = self.getGroup(compB)
+        if groupA is None or groupB is None or groupA != groupB:
+            if scopeA is not None and scopeB is not None and self._lookahead > 0:
+                latencyPs += self._lookahead
+                compA.addParam(scopeA + ".lookahead", _fromPs(self._lookahead))
+                compB.addParam(scopeB + ".lookahead", _fromPs(self._lookahead))
+            if self._minLatency is None or latencyPs < self._minLatency:
+                self._minLatency = latencyPs
+
+        link = sst.Link(name)
+        link.connect( (compA, portA, _fromPs(latencyPs)), (compB, portB, _fromPs(latencyPs)) )
+        return link
+
+    def getMinLatency(self):
+        """Smallest latency on a link between groups, or None if there are no such links"""
+        if self._minLatency is None:
+            return None
+        return _fromPs(self._minLatency)
+
+    def apply(self, ranks=1, threads=1, partitioner="sst.self"):
+        """Assign groups round-robin to rank/thread pairs"""
+        slots = ranks * threads
+        for group, components in enumerate(self._groups):
+            slot = group % slots
+            for comp in components:
+                # Subcomponents are placed with their parent
+                if hasattr(comp, "setRank"):
+                    comp.setRank(slot // threads, slot % threads)
+        if partitioner is not None:
+            sst.setProgramOption("partitioner", partitioner)
+
+    def report(self):
+        minLatency = self.getMinLatency()
+        print("memHierarchy: %d partition groups, minimum latency between groups: %s" %
+                (len(self._groups), minLatency if minLatency is not None else "n/a"))
+
+    def _endpoint(self, endpoint):
+        if len(endpoint) == 2:
+            return (endpoint[0], endpoint[1], None)
+        return (endpoint[0], endpoint[1], endpoint[2])
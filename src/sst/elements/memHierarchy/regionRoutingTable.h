@@ -0,0 +1,318 @@
+// Copyright 2013-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_REGIONROUTINGTABLE_H_
+#define _MEMHIERARCHY_REGIONROUTINGTABLE_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+class MemRegion;
+
+/*
+ * Compiled address -> destination map
+ *
+ * Built once from a list of (region, destination) pairs and then queried on every send.
+ * Returns the same destination as walking the list in order and returning the first
+ * region that contains the address.
+ *
+ *  - The address space is split into segments at every region start/end so that each
+ *    segment is either fully inside or fully outside each region's [start, end].
+ *    Segments are found by binary search.
+ *  - A segment covered by one region (or only non-interleaved regions) resolves directly.
+ *  - A segment covered by interleaved regions with a common step is flattened into a table
+ *    indexed by (offset % step) / granularity, so 256 interleaved slices still cost one lookup.
+ *  - Anything else (e.g., mixed interleave steps) falls back to checking the segment's regions in order.
+ *
+ * findId() returns an id for the route instead, so that callers can tag an event with its
+ * destination and resolve the route again without comparing names. Ids hold a serial number
+ * that is unique to each build() of each table, so an id from another table or an earlier
+ * build is rejected by getRoute().
+ *
+ * Region is MemRegion (see the RegionRoutingTable typedef below). It is a parameter so that
+ * the table can be unit tested without SST-Core; any type with MemRegion's start, end,
+ * interleaveSize, interleaveStep, REGION_MAX and contains() works.
+ */
+template <typename Region>
+class RegionRoutingTableT {
+public:
+    typedef uint64_t Addr;
+
+    struct Route {
+        std::string name;   /* Destination name */
+        uint64_t netAddr;   /* Destination network address (if applicable) */
+    };
+
+    static const uint64_t NO_ROUTE = ~uint64_t(0);
+
+    RegionRoutingTableT() : built(false), serial(0) { }
+
+    /* Regions added first take priority if regions overlap */
+    void addRoute(const Region &region, const std::string &name, uint64_t netAddr = 0) {
+        RouteRegion rr;
+        rr.region = region;
+        rr.route = routes.size();
+        routes.push_back({name, netAddr});
+        regions.push_back(rr);
+        built = false;
+    }
+
+    void clear() {
+        routes.clear();
+        regions.clear();
+        segStart.clear();
+        segments.clear();
+        built = false;
+    }
+
+    bool isBuilt() const { return built; }
+    size_t size() const { return routes.size(); }
+
+    /* Return route for address or nullptr if none */
+    const Route* find(Addr addr) const {
+        uint32_t route = findIndex(addr);
+        return route == NONE ? nullptr : &routes[route];
+    }
+
+    /* Return the id of the route for address or NO_ROUTE if none */
+    uint64_t findId(Addr addr) const {
+        uint32_t route = findIndex(addr);
+        return route == NONE ? NO_ROUTE : ((uint64_t(serial) << 32) | route);
+    }
+
+    /* Return route for an id returned by findId() since the last build(), otherwise nullptr */
+    const Route* getRoute(uint64_t id) const {
+        if (!built || (id >> 32) != serial || uint32_t(id) >= routes.size())
+            return nullptr;
+        return &routes[uint32_t(id)];
+    }
+
+    /* Compile the table. Must be called after the last addRoute() and before find() */
+    void build() {
+        segStart.clear();
+        segments.clear();
+
+        // Segment boundaries
+        std::vector<Addr> bounds;
+        for (typename std::vector<RouteRegion>::iterator it = regions.begin(); it != regions.end(); it++) {
+            if (it->region.end < it->region.start)
+                continue;
+            bounds.push_back(it->region.start);
+            if (it->region.end != Region::REGION_MAX)
+                bounds.push_back(it->region.end + 1);
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        std::vector<uint32_t> covering;
+        for (size_t i = 0; i < bounds.size(); i++) {
+            Addr start = bounds[i];
+            Addr end = (i + 1 < bounds.size()) ? bounds[i+1] - 1 : Region::REGION_MAX;
+
+            covering.clear();
+            for (uint32_t r = 0; r < regions.size(); r++) {
+                if (regions[r].region.start <= start && regions[r].region.end >= end)
+                    covering.push_back(r);
+            }
+            if (covering.empty())
+                continue;
+
+            Segment seg;
+            seg.start = start;
+            seg.end = end;
+            compileSegment(seg, covering);
+
+            // Merge with previous segment if it routes the same way
+            if (!segments.empty() && seg.type == SegmentType::Direct && segments.back().type == SegmentType::Direct &&
+                    segments.back().route == seg.route && segments.back().end + 1 == seg.start) {
+                segments.back().end = seg.end;
+                continue;
+            }
+            segStart.push_back(seg.start);
+            segments.push_back(seg);
+        }
+        serial = nextSerial();
+        built = true;
+    }
+
+private:
+    static const uint32_t NONE = 0xFFFFFFFF;
+    static const uint64_t maxTableSize = 1 << 16;
+
+    enum class SegmentType { Direct, Table, Scan };
+
+    struct RouteRegion {
+        Region region;
+        uint32_t route;
+    };
+
+    struct Segment {
+        Addr start;
+        Addr end;
+        SegmentType type;
+        uint32_t route;                 // Direct: route
+        Addr step;                      // Table: interleave step
+        Addr stepMask;                  // Table: step - 1 if step is a power of two, else 0
+        uint32_t granShift;             // Table: log2(granularity)
+        std::vector<uint32_t> table;    // Table: route per chunk, Scan: candidate regions in priority order
+    };
+
+    static Addr gcd(Addr a, Addr b) {
+        while (b != 0) {
+            Addr t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    /* Serials start at 1 so that no id matches an unbuilt table */
+    static uint32_t nextSerial() {
+        static std::atomic<uint32_t> count(0);
+        return ++count;
+    }
+
+    /* Return index of the route for address or NONE */
+    uint32_t findIndex(Addr addr) const {
+        // Last segment starting at or below addr
+        std::vector<Addr>::const_iterator it = std::upper_bound(segStart.begin(), segStart.end(), addr);
+        if (it == segStart.begin())
+            return NONE;
+        const Segment &seg = segments[(it - segStart.begin()) - 1];
+        if (addr > seg.end)
+            return NONE;
+
+        uint32_t route = NONE;
+        switch (seg.type) {
+            case SegmentType::Direct:
+                route = seg.route;
+                break;
+            case SegmentType::Table: {
+                Addr offset = addr - seg.start;
+                offset = seg.stepMask ? (offset & seg.stepMask) : (offset % seg.step);
+                route = seg.table[offset >> seg.granShift];
+                break;
+            }
+            case SegmentType::Scan:
+                for (std::vector<uint32_t>::const_iterator rt = seg.table.begin(); rt != seg.table.end(); rt++) {
+                    if (regions[*rt].region.contains(addr)) {
+                        route = regions[*rt].route;
+                        break;
+                    }
+                }
+                break;
+        }
+        return route;
+    }
+
+    static bool isPow2(Addr x) { return x != 0 && (x & (x - 1)) == 0; }
+
+    static bool isInterleaved(const Region &reg) {
+        return reg.interleaveSize != 0 && reg.interleaveStep != 0 && reg.interleaveSize < reg.interleaveStep;
+    }
+
+    /* Pick the cheapest representation for a segment given the regions covering it (in priority order) */
+    void compileSegment(Segment &seg, const std::vector<uint32_t> &covering) {
+        seg.route = NONE;
+        seg.step = 0;
+        seg.stepMask = 0;
+        seg.granShift = 0;
+
+        // Common case: first region covers the entire segment
+        const Region &first = regions[covering.front()].region;
+        if (!isInterleaved(first) && (first.interleaveSize == 0 || first.interleaveStep != 0)) {
+            seg.type = SegmentType::Direct;
+            seg.route = regions[covering.front()].route;
+            return;
+        }
+
+        // Interleaved: find a common step and the granularity at which routing changes
+        Addr step = 0;
+        Addr gran = 0;
+        bool flatten = true;
+        for (std::vector<uint32_t>::const_iterator it = covering.begin(); it != covering.end(); it++) {
+            const Region &reg = regions[*it].region;
+            if (!isInterleaved(reg)) {
+                if (reg.interleaveSize != 0 && reg.interleaveStep == 0)
+                    flatten = false; // Malformed region, let contains() decide
+                break; // Covers everything that is left
+            }
+            if (step == 0)
+                step = reg.interleaveStep;
+            if (reg.interleaveStep != step) {
+                flatten = false;
+                break;
+            }
+            Addr offset = (step - (seg.start - reg.start) % step) % step;
+            gran = gcd(gcd(gran, reg.interleaveSize), offset);
+        }
+        if (flatten) {
+            gran = gcd(gran, step);
+            flatten = isPow2(gran) && (step / gran) <= maxTableSize;
+        }
+
+        if (!flatten) {
+            seg.type = SegmentType::Scan;
+            seg.table = covering;
+            return;
+        }
+
+        seg.type = SegmentType::Table;
+        seg.step = step;
+        seg.stepMask = isPow2(step) ? step - 1 : 0;
+        while ((Addr(1) << seg.granShift) < gran)
+            seg.granShift++;
+        seg.table.assign(step / gran, uint32_t(NONE));
+
+        uint64_t chunks = step / gran;
+        for (std::vector<uint32_t>::const_iterator it = covering.begin(); it != covering.end(); it++) {
+            const Region &reg = regions[*it].region;
+            uint32_t route = regions[*it].route;
+            if (!isInterleaved(reg)) { // Fills whatever is left
+                for (uint64_t c = 0; c < chunks; c++) {
+                    if (seg.table[c] == NONE)
+                        seg.table[c] = route;
+                }
+                break;
+            }
+            uint64_t chunk = ((step - (seg.start - reg.start) % step) % step) / gran;
+            for (uint64_t c = 0; c < reg.interleaveSize / gran; c++) {
+                if (seg.table[chunk] == NONE)
+                    seg.table[chunk] = route;
+                chunk = (chunk + 1 == chunks) ? 0 : chunk + 1;
+            }
+        }
+    }
+
+    std::vector<Route> routes;
+    std::vector<RouteRegion> regions;   // In priority order
+    std::vector<Addr> segStart;         // Start address of each segment, for binary search
+    std::vector<Segment> segments;
+    bool built;
+    uint32_t serial;                    // Unique to each build(), part of every route id
+};
+
+typedef RegionRoutingTableT<MemRegion> RegionRoutingTable;
+
+} //namespace memHierarchy
+} //namespace SST
+
+#endif
@@ -20,6 +20,7 @@
 #include "sst/core/rng/marsaglia.h"
 
 #include "memEvent.h"
+#include "replacementState.h"
 
 using namespace std;
 
@@ -705,6 +706,221 @@ public:
 };
 
 
+
+/* ------------------------------------------------------------------------------------------
+ *  Tree pseudo-LRU (tree-plru)
+ *  - One bit per internal node of a binary tree over the ways of a set; each bit points
+ *    towards the less recently used half. See TreePLRUState.
+ *  - Replacement algorithm assumes indices are contiguous for the set
+ * ------------------------------------------------------------------------------------------*/
+class TreePLRU : public ReplacementPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(TreePLRU, "memHierarchy", "replacement.tree-plru", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "tree pseudo-least-recently-used replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    TreePLRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity),
+        bestCandidate(0), ways(associativity), tree(lines, associativity) { }
+
+    virtual ~TreePLRU() {}
+
+    /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    void update(uint64_t id, ReplacementInfo * rInfo) { tree.update(id); }
+
+    void replaced(uint64_t id) { }
+
+    /* Return an empty slot if one exists, otherwise follow the tree bits to the pseudo-LRU line */
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        for (uint64_t i = 0; i < ways; i++) {
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = rInfo[i]->getIndex();
+                return bestCandidate;
+            }
+        }
+        bestCandidate = tree.victim(rInfo[0]->getIndex());
+        return bestCandidate;
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+private:
+    uint64_t bestCandidate;
+    uint64_t ways;
+    TreePLRUState tree;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Re-reference interval prediction (RRIP) family
+ *  - Each line has an M-bit re-reference prediction value (RRPV), see RRIPState.
+ *    Hits predict near re-reference (RRPV = 0); the victim is the first line predicted to be
+ *    re-referenced in the distant future (RRPV = max), aging the set until one exists.
+ *  - The policies differ only in the RRPV given to newly inserted lines.
+ *  - The cache array calls replaced() and then update() when a line is filled, so a line that has
+ *    been replaced takes the insertion RRPV on its next update and the hit RRPV afterwards.
+ *  - Replacement algorithm assumes indices are contiguous for the set
+ * ------------------------------------------------------------------------------------------*/
+class RRIPBase : public ReplacementPolicy {
+public:
+    RRIPBase(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        uint32_t rrpvBits = params.find<uint32_t>("rrpv_bits", 2);
+        if (rrpvBits == 0 || rrpvBits > 8) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: rrpv_bits - must be between 1 and 8. You specified '%" PRIu32 "'.\n", getName().c_str(), rrpvBits);
+        }
+        maxRRPV = (1 << rrpvBits) - 1;
+        state.resize(lines, ways, maxRRPV);
+    }
+
+    virtual ~RRIPBase() {}
+
+    /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        if (state.isInserting(id))
+            state.insert(id, insertionRRPV(id / ways));
+        else
+            state.hit(id);
+    }
+
+    void replaced(uint64_t id) { state.replaced(id); }
+
+    /* Return an empty slot if one exists, otherwise the first line with the largest RRPV, aging the set if needed */
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        for (uint64_t i = 0; i < ways; i++) {
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = rInfo[i]->getIndex();
+                return bestCandidate;
+            }
+        }
+        bestCandidate = state.victim(rInfo[0]->getIndex());
+        return bestCandidate;
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+protected:
+    /* RRPV for a line newly inserted into set */
+    virtual uint8_t insertionRRPV(uint64_t set) = 0;
+
+    uint64_t bestCandidate;
+    uint64_t ways;
+    uint8_t maxRRPV;
+    RRIPState state;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Static RRIP (srrip)
+ *  - Inserts lines with a long re-reference prediction (max - 1)
+ * ------------------------------------------------------------------------------------------*/
+class SRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction replacement policy, scan resistant", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits", "Bits per re-reference prediction value", "2"} )
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) { }
+
+    virtual ~SRRIP() {}
+
+protected:
+    uint8_t insertionRRPV(uint64_t set) { return maxRRPV - 1; }
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Bimodal RRIP (brrip)
+ *  - Inserts lines with a distant re-reference prediction (max) and, infrequently, a long one (max - 1)
+ * ------------------------------------------------------------------------------------------*/
+class BRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction replacement policy, thrash resistant", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Bits per re-reference prediction value", "2"},
+            {"throttle",    "On average, one in every 'throttle' insertions is given a long instead of a distant re-reference prediction", "32"},
+            {"seed_a",      "Seed for random number generator", "1"},
+            {"seed_b",      "Seed for random number generator", "1"} )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) {
+        throttle = params.find<uint32_t>("throttle", 32);
+        if (throttle == 0) throttle = 1;
+        uint64_t seeda = params.find<uint64_t>("seed_a", 1);
+        uint64_t seedb = params.find<uint64_t>("seed_b", 1);
+        gen = new SST::RNG::MarsagliaRNG(seeda, seedb);
+    }
+
+    virtual ~BRRIP() {
+        delete gen;
+    }
+
+protected:
+    uint8_t insertionRRPV(uint64_t set) { return (gen->generateNextUInt32() % throttle == 0) ? maxRRPV - 1 : maxRRPV; }
+
+    uint32_t throttle;
+    SST::RNG::MarsagliaRNG* gen;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Dynamic RRIP (drrip)
+ *  - Set dueling between SRRIP and BRRIP. A few leader sets always use SRRIP and a few always use
+ *    BRRIP. Fills (i.e., misses) in SRRIP leaders increment a saturating policy selector and fills in
+ *    BRRIP leaders decrement it. The remaining follower sets use BRRIP while the selector is in its
+ *    upper half and SRRIP otherwise.
+ * ------------------------------------------------------------------------------------------*/
+class DRRIP : public BRRIP {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction replacement policy, set dueling between srrip and brrip", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Bits per re-reference prediction value", "2"},
+            {"throttle",    "On average, one in every 'throttle' BRRIP insertions is given a long instead of a distant re-reference prediction", "32"},
+            {"leader_sets", "Number of leader sets for each of SRRIP and BRRIP", "32"},
+            {"psel_bits",   "Bits in the saturating policy selector", "10"},
+            {"seed_a",      "Seed for random number generator", "1"},
+            {"seed_b",      "Seed for random number generator", "1"} )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : BRRIP(id, params, lines, associativity) {
+        uint64_t sets = lines / associativity;
+        uint64_t leaders = params.find<uint64_t>("leader_sets", 32);
+        if (leaders == 0) leaders = 1;
+        // One SRRIP and one BRRIP leader in each constituency of 'stride' sets
+        stride = sets / leaders;
+        if (stride < 2) stride = 2;
+        uint32_t pselBits = params.find<uint32_t>("psel_bits", 10);
+        if (pselBits == 0 || pselBits > 31) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: psel_bits - must be between 1 and 31. You specified '%" PRIu32 "'.\n", getName().c_str(), pselBits);
+        }
+        pselMax = (1u << pselBits) - 1;
+        psel = (pselMax + 1) / 2;
+    }
+
+    virtual ~DRRIP() {}
+
+protected:
+    uint8_t insertionRRPV(uint64_t set) {
+        uint64_t member = set % stride;
+        if (member == 0) {          // SRRIP leader
+            if (psel < pselMax) psel++;
+            return maxRRPV - 1;
+        } else if (member == 1) {   // BRRIP leader
+            if (psel > 0) psel--;
+            return BRRIP::insertionRRPV(set);
+        }
+        return (psel > pselMax / 2) ? BRRIP::insertionRRPV(set) : maxRRPV - 1;
+    }
+
+    uint64_t stride;
+    uint32_t psel;
+    uint32_t pselMax;
+};
+
 }}
 
 
@@ -0,0 +1,147 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_REPLACEMENTSTATE_H
+#define MEMHIERARCHY_REPLACEMENTSTATE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Per-line state of the tree-plru and RRIP replacement policies in replacementManager.h.
+ * Lines are indexed as in the cache array, with each set's ways contiguous.
+ * Victims are chosen among valid lines only; the policies prefer invalid lines before asking.
+ */
+
+/*
+ * One bit per internal node of a binary tree over the ways of a set; each bit points
+ * towards the less recently used half. Bits for a set are packed into contiguous words.
+ * Associativities that are not a power of two use the next larger tree and never descend
+ * into a subtree that has no ways.
+ */
+class TreePLRUState {
+public:
+    TreePLRUState(uint64_t lines, uint64_t associativity) : ways(associativity), levels(0) {
+        while ((uint64_t(1) << levels) < ways)
+            levels++;
+        // Nodes are heap-indexed from 1 so a set needs 2^levels bits
+        wordsPerSet = ((uint64_t(1) << levels) + 63) / 64;
+        bits.resize((lines / ways) * wordsPerSet, 0);
+    }
+
+    /* Point every node on the path to this line away from it */
+    void update(uint64_t id) {
+        uint64_t* set = &bits[(id / ways) * wordsPerSet];
+        uint64_t way = id % ways;
+        uint64_t node = 1;
+        for (int level = levels - 1; level >= 0; level--) {
+            uint64_t dir = (way >> level) & 1;
+            if (dir)
+                set[node >> 6] &= ~(uint64_t(1) << (node & 63));
+            else
+                set[node >> 6] |= uint64_t(1) << (node & 63);
+            node = (node << 1) | dir;
+        }
+    }
+
+    /* Follow the tree bits of the set starting at line setBegin to its pseudo-LRU line */
+    uint64_t victim(uint64_t setBegin) const {
+        const uint64_t* set = &bits[(setBegin / ways) * wordsPerSet];
+        uint64_t way = 0;
+        uint64_t node = 1;
+        for (int level = levels - 1; level >= 0; level--) {
+            uint64_t dir = (set[node >> 6] >> (node & 63)) & 1;
+            if (dir && ((((way << 1) | 1) << level) >= ways))
+                dir = 0;
+            way = (way << 1) | dir;
+            node = (node << 1) | dir;
+        }
+        return setBegin + way;
+    }
+
+private:
+    uint64_t ways;
+    int levels;
+    uint64_t wordsPerSet;
+    std::vector<uint64_t> bits;
+};
+
+/*
+ * An M-bit re-reference prediction value (RRPV) per line, stored contiguously by line index.
+ * A replaced line is marked as inserting so that its next update is an insertion, which the
+ * policy gives its own RRPV; later updates are hits and predict near re-reference (RRPV = 0).
+ * Not usable until resize() has been called.
+ */
+class RRIPState {
+public:
+    RRIPState() : ways(1), maxRRPV(0) { }
+
+    void resize(uint64_t lines, uint64_t associativity, uint8_t max) {
+        ways = associativity;
+        maxRRPV = max;
+        rrpv.assign(lines, maxRRPV);
+        inserting.assign(lines, true);
+    }
+
+    bool isInserting(uint64_t id) const { return inserting[id]; }
+
+    void insert(uint64_t id, uint8_t value) {
+        inserting[id] = false;
+        rrpv[id] = value;
+    }
+
+    void hit(uint64_t id) { rrpv[id] = 0; }
+
+    void replaced(uint64_t id) {
+        rrpv[id] = maxRRPV;
+        inserting[id] = true;
+    }
+
+    uint8_t getRRPV(uint64_t id) const { return rrpv[id]; }
+    uint8_t getMaxRRPV() const { return maxRRPV; }
+
+    /* Return the first line with the largest RRPV in the set starting at line setBegin.
+     * Aging the set by the difference between max and the largest RRPV is the same as repeatedly
+     * incrementing every RRPV until one reaches max. */
+    uint64_t victim(uint64_t setBegin) {
+        uint8_t* set = &rrpv[setBegin];
+        uint64_t way = 0;
+        uint8_t oldest = set[0];
+        for (uint64_t i = 1; i < ways && oldest != maxRRPV; i++) {
+            if (set[i] > oldest) {
+                oldest = set[i];
+                way = i;
+            }
+        }
+        if (oldest != maxRRPV) {
+            uint8_t age = maxRRPV - oldest;
+            for (uint64_t i = 0; i < ways; i++)
+                set[i] += age;
+        }
+        return setBegin + way;
+    }
+
+private:
+    uint64_t ways;
+    uint8_t maxRRPV;
+    std::vector<uint8_t> rrpv;
+    std::vector<bool> inserting;
+};
+
+}}
+
+#endif
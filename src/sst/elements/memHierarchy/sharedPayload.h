@@ -0,0 +1,152 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SHAREDPAYLOAD_H
+#define MEMHIERARCHY_SHAREDPAYLOAD_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Reference-counted, copy-on-write data buffer
+ *
+ * Copying a SharedPayload shares the underlying buffer, so events, responses
+ * and MSHR entries can hand the same line data along without copying it.
+ * The buffer is copied only when a holder asks for mutable access while it is shared.
+ *
+ * Every byte that is actually copied (detach on write or copy from a plain vector)
+ * is added to a per-thread counter which components can sample for statistics.
+ *
+ * A payload constructed from nullptr or a null 'vector<uint8_t>*' tests false so that it can stand in
+ * for the pointer; all other payloads (including empty ones) test true.
+ */
+class SharedPayload {
+public:
+    typedef std::vector<uint8_t> dataVec;
+
+    SharedPayload() : null_(false) { }
+
+    /* A null payload, for callers that have no data to pass */
+    SharedPayload(std::nullptr_t) : null_(true) { }
+
+    /* Copy from a plain vector; nullptr gives a null payload.
+     * Explicit so that every copy from a vector shows at the call site. */
+    explicit SharedPayload(const dataVec* data) : null_(data == nullptr) {
+        if (data != nullptr) assign(*data);
+    }
+
+    /* Copy & assignment share the buffer */
+    SharedPayload(const SharedPayload&) = default;
+    SharedPayload(SharedPayload&&) = default;
+    SharedPayload& operator=(const SharedPayload&) = default;
+    SharedPayload& operator=(SharedPayload&&) = default;
+
+    /* Read-only access, never copies */
+    const dataVec& get() const { return buf_ ? *buf_ : emptyBuffer(); }
+
+    /* Write access, copies the buffer first if it is shared */
+    dataVec& getMutable() {
+        null_ = false;
+        if (!buf_) {
+            buf_ = std::make_shared<dataVec>();
+        } else if (buf_.use_count() > 1) {
+            countCopy(buf_->size());
+            buf_ = std::make_shared<dataVec>(*buf_);
+        }
+        return *buf_;
+    }
+
+    /* Replace contents with a copy of data, reusing our buffer if we are its only holder */
+    void assign(const dataVec& data) {
+        null_ = false;
+        countCopy(data.size());
+        if (buf_ && buf_.use_count() == 1)
+            buf_->assign(data.begin(), data.end());
+        else
+            buf_ = std::make_shared<dataVec>(data);
+    }
+
+    /* Replace contents with a copy of size bytes from data */
+    void assign(const uint8_t* data, size_t size) {
+        null_ = false;
+        countCopy(size);
+        if (buf_ && buf_.use_count() == 1)
+            buf_->assign(data, data + size);
+        else
+            buf_ = std::make_shared<dataVec>(data, data + size);
+    }
+
+    /* Replace contents by taking over data */
+    void assign(dataVec&& data) {
+        null_ = false;
+        buf_ = std::make_shared<dataVec>(std::move(data));
+    }
+
+    /* Copy size bytes starting at offset into out */
+    void copyOut(size_t offset, size_t size, dataVec& out) const {
+        countCopy(size);
+        const dataVec& data = get();
+        out.assign(data.begin() + offset, data.begin() + offset + size);
+    }
+
+    /* Hand the contents over to a plain vector and drop our reference.
+     * Moves if we are the only holder, otherwise copies. */
+    dataVec release() {
+        dataVec data;
+        if (buf_ && buf_.use_count() == 1) {
+            data.swap(*buf_);
+        } else if (buf_) {
+            countCopy(buf_->size());
+            data = *buf_;
+        }
+        buf_.reset();
+        return data;
+    }
+
+    /* Drop our reference */
+    void clear() { buf_.reset(); }
+
+    size_t size() const { return buf_ ? buf_->size() : 0; }
+    bool empty() const { return size() == 0; }
+    explicit operator bool() const { return !null_; }
+    bool isShared() const { return buf_ && buf_.use_count() > 1; }
+
+    /* Bytes copied by SharedPayloads on this thread */
+    static uint64_t getBytesCopied() { return bytesCopied(); }
+
+private:
+    static uint64_t& bytesCopied() {
+        static thread_local uint64_t count = 0;
+        return count;
+    }
+
+    static void countCopy(size_t bytes) { bytesCopied() += bytes; }
+
+    static const dataVec& emptyBuffer() {
+        static const dataVec emptyVec;
+        return emptyVec;
+    }
+
+    std::shared_ptr<dataVec> buf_;
+    bool null_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_SHAREDPAYLOAD_H */
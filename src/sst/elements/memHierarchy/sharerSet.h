@@ -0,0 +1,136 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SHARERSET_H
+#define MEMHIERARCHY_SHARERSET_H
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Maps component names to small integer ids so that directory entries can
+ * track sharers and owners as bits instead of strings.
+ * Ids are handed out in the order names are added; adding names in sorted order
+ * makes id order match name order.
+ */
+class SharerIdMap {
+public:
+    static const uint32_t NONE = 0xFFFFFFFF;
+
+    /* Return id for name, assigning a new one if needed */
+    uint32_t getId(const std::string &name) {
+        std::unordered_map<std::string, uint32_t>::iterator it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second;
+        uint32_t id = names_.size();
+        ids_.insert(std::make_pair(name, id));
+        names_.push_back(name);
+        return id;
+    }
+
+    /* Return id for name or NONE if it has not been assigned one */
+    uint32_t findId(const std::string &name) const {
+        std::unordered_map<std::string, uint32_t>::const_iterator it = ids_.find(name);
+        return it == ids_.end() ? NONE : it->second;
+    }
+
+    const std::string& getName(uint32_t id) const { return names_[id]; }
+
+    size_t size() const { return names_.size(); }
+
+private:
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<std::string> names_;
+};
+
+/*
+ * Set of sharer ids packed into a bit-vector
+ * Iterate with: for (uint32_t id = set.first(); id != SharerIdMap::NONE; id = set.next(id))
+ */
+class SharerSet {
+public:
+    SharerSet() : count_(0) { }
+
+    void add(uint32_t id) {
+        size_t word = id >> 6;
+        if (word >= bits_.size())
+            bits_.resize(word + 1, 0);
+        uint64_t mask = uint64_t(1) << (id & 63);
+        if (!(bits_[word] & mask)) {
+            bits_[word] |= mask;
+            count_++;
+        }
+    }
+
+    void remove(uint32_t id) {
+        size_t word = id >> 6;
+        if (word >= bits_.size())
+            return;
+        uint64_t mask = uint64_t(1) << (id & 63);
+        if (bits_[word] & mask) {
+            bits_[word] &= ~mask;
+            count_--;
+        }
+    }
+
+    bool contains(uint32_t id) const {
+        size_t word = id >> 6;
+        return word < bits_.size() && (bits_[word] & (uint64_t(1) << (id & 63)));
+    }
+
+    void clear() {
+        if (count_ == 0)
+            return;
+        for (std::vector<uint64_t>::iterator it = bits_.begin(); it != bits_.end(); it++)
+            *it = 0;
+        count_ = 0;
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    /* Lowest id in the set */
+    uint32_t first() const { return scan(0); }
+
+    /* Lowest id in the set greater than id */
+    uint32_t next(uint32_t id) const { return scan(id + 1); }
+
+private:
+    uint32_t scan(uint32_t from) const {
+        if (count_ == 0)
+            return SharerIdMap::NONE;
+        size_t word = from >> 6;
+        if (word >= bits_.size())
+            return SharerIdMap::NONE;
+        uint64_t bits = bits_[word] & (~uint64_t(0) << (from & 63));
+        while (bits == 0) {
+            if (++word == bits_.size())
+                return SharerIdMap::NONE;
+            bits = bits_[word];
+        }
+        return (word << 6) + __builtin_ctzll(bits);
+    }
+
+    std::vector<uint64_t> bits_;
+    uint32_t count_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_SHARERSET_H */
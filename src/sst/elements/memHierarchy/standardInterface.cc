@@ -521,7 +521,7 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::ReadResp*
     MemEvent* mereq = static_cast<MemEvent*>(it->second); // Matching memEvent req
     iface->responses_.erase(it);
     MemEvent* meresp = mereq->makeResponse();
-    meresp->setPayload(resp->data);
+    meresp->setPayload(std::move(resp->data)); // 'resp' is deleted once converted
     if (!resp->getSuccess()) {
         meresp->setFail();
     }
@@ -562,11 +562,10 @@ StandardMem::Request* StandardInterface::convertResponseGetSResp(StandardMem::Re
     MemEvent* me = static_cast<MemEvent*>(meb);
     StandardMem::ReadResp* resp = static_cast<StandardMem::ReadResp*>(req->makeResponse());
     if (resp->size == me->getSize()) {
-        resp->data = me->getPayload();
+        resp->data = me->releasePayload(); // 'me' is deleted once converted
     } else { // Need to extract just the relevant bit of the payload
         Addr offset = me->getAddr() - me->getBaseAddr();
-        auto payload = me->getPayload();
-        resp->data.assign(payload.begin() + offset, payload.begin() + offset + resp->size);
+        me->getSharedPayload().copyOut(offset, resp->size, resp->data);
     }
     if (!me->success()) {
         resp->setFail();
@@ -624,7 +623,7 @@ StandardMem::Request* StandardInterface::convertRequestGetS(MemEventBase* ev) {
 
 StandardMem::Request* StandardInterface::convertRequestWrite(MemEventBase* ev) {
     MemEvent* event = static_cast<MemEvent*>(ev);
-    StandardMem::Write* req = new StandardMem::Write(event->getAddr(), event->getSize(), event->getPayload(),
+    StandardMem::Write* req = new StandardMem::Write(event->getAddr(), event->getSize(), event->getSharedPayload().get(),
         event->queryFlag(MemEventBase::F_NORESPONSE), 0, event->getVirtualAddress(), 
         event->getInstructionPointer(), 0);
     return req;
@@ -638,7 +637,7 @@ StandardMem::Request* StandardInterface::convertRequestLL(MemEventBase* ev) {
 
 StandardMem::Request* StandardInterface::convertRequestSC(MemEventBase* ev) {
     MemEvent* event = static_cast<MemEvent*>(ev);
-    return new StandardMem::StoreConditional(event->getAddr(), event->getSize(), event->getPayload(), 0, 
+    return new StandardMem::StoreConditional(event->getAddr(), event->getSize(), event->getSharedPayload().get(), 0, 
         event->getVirtualAddress(), event->getInstructionPointer(), 0);
 }
 
@@ -650,7 +649,7 @@ StandardMem::Request* StandardInterface::convertRequestLock(MemEventBase* ev) {
 
 StandardMem::Request* StandardInterface::convertRequestUnlock(MemEventBase* ev) {
     MemEvent* event = static_cast<MemEvent*>(ev);
-    return new StandardMem::WriteUnlock(event->getAddr(), event->getSize(), event->getPayload(), event->queryFlag(MemEventBase::F_NORESPONSE),
+    return new StandardMem::WriteUnlock(event->getAddr(), event->getSize(), event->getSharedPayload().get(), event->queryFlag(MemEventBase::F_NORESPONSE),
         0, event->getVirtualAddress(), event->getInstructionPointer(), 0);
 }
 
@@ -0,0 +1,81 @@
+# MSHR benchmark
+#
+# A CPU keeping hundreds of random misses outstanding over a footprint far
+# larger than its caches, so that nearly every access allocates, looks up and
+# frees MSHR entries at both levels. Run it once per MSHR implementation and
+# compare the wall-clock times reported by --print-timing-info, e.g.:
+#
+#   for m in default pooled; do
+#       sst --print-timing-info benchMSHR.py --model-options="--mshr $m"
+#   done
+#
+# Both runs must print the same statistics.
+import sst
+import argparse
+from mhlib import componentlist
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--mshr", help="MSHR implementation for both caches, default or pooled", default="default")
+parser.add_argument("--outstanding", help="maximum outstanding CPU requests", type=int, default=256)
+parser.add_argument("--ops", help="number of CPU accesses", type=int, default=1000000)
+args = parser.parse_args()
+
+cpu = sst.Component("cpu", "memHierarchy.standardCPU")
+cpu.addParams({
+    "memFreq" : 1,
+    "memSize" : "1GiB",
+    "clock" : "2GHz",
+    "maxOutstanding" : args.outstanding,
+    "opCount" : args.ops,
+    "write_freq" : 25,
+    "read_freq" : 75,
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "2",
+    "cache_frequency" : "2GHz",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "L1" : "1",
+    "cache_size" : "32KiB",
+    "mshr_num_entries" : args.outstanding,
+    "mshr_type" : args.mshr,
+})
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2GHz",
+    "coherence_protocol" : "MESI",
+    "associativity" : "16",
+    "cache_line_size" : "64",
+    "cache_size" : "1MiB",
+    "mshr_num_entries" : args.outstanding,
+    "mshr_type" : args.mshr,
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_end" : 1024*1024*1024-1,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "1GiB"
+})
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+link_l1_l2 = sst.Link("link_l1_l2")
+link_l1_l2.connect( (l1cache, "low_network_0", "500ps"), (l2cache, "high_network_0", "500ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
@@ -0,0 +1,80 @@
+# Replacement policy benchmark
+#
+# A CPU issuing random accesses over a footprint a few times larger than a
+# high-associativity LLC, so that nearly every access looks up a full set and
+# most misses evict. Run it once per policy and compare the wall-clock times
+# reported by --print-timing-info, e.g.:
+#
+#   for p in lru tree-plru srrip brrip drrip; do
+#       sst --print-timing-info benchReplacement.py --model-options="--policy $p"
+#   done
+#
+# Hit rates for each run are in the CacheHits/CacheMisses statistics.
+import sst
+import argparse
+from mhlib import componentlist
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--policy", help="replacement policy for the LLC, e.g., lru, tree-plru, srrip, brrip, drrip", default="lru")
+parser.add_argument("--assoc", help="LLC associativity", type=int, default=32)
+parser.add_argument("--ops", help="number of CPU accesses", type=int, default=1000000)
+args = parser.parse_args()
+
+cpu = sst.Component("cpu", "memHierarchy.standardCPU")
+cpu.addParams({
+    "memFreq" : 1,
+    "memSize" : "16MiB",
+    "clock" : "2GHz",
+    "maxOutstanding" : 16,
+    "opCount" : args.ops,
+    "write_freq" : 25,
+    "read_freq" : 75,
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "2",
+    "cache_frequency" : "2GHz",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "L1" : "1",
+    "cache_size" : "32KiB"
+})
+l1cache.setSubComponent("replacement", "memHierarchy.replacement.lru")
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2GHz",
+    "coherence_protocol" : "MESI",
+    "associativity" : args.assoc,
+    "cache_line_size" : "64",
+    "cache_size" : "4MiB",
+    "mshr_num_entries" : 32,
+})
+l2cache.setSubComponent("replacement", "memHierarchy.replacement." + args.policy)
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_end" : 16*1024*1024-1,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50ns",
+    "mem_size" : "16MiB"
+})
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+link_l1_l2 = sst.Link("link_l1_l2")
+link_l1_l2.connect( (l1cache, "low_network_0", "500ps"), (l2cache, "high_network_0", "500ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
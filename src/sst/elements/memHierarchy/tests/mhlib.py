@@ -39,11 +39,15 @@ componentlist = (
     "memHierarchy.reorderByRow",
     "memHierarchy.reorderSimple",
     "memHierarchy.reorderTransactionQ",
+    "memHierarchy.replacement.brrip",
+    "memHierarchy.replacement.drrip",
     "memHierarchy.replacement.lfu",
     "memHierarchy.replacement.lru",
     "memHierarchy.replacement.mru",
     "memHierarchy.replacement.nmru",
     "memHierarchy.replacement.rand",
+    "memHierarchy.replacement.srrip",
+    "memHierarchy.replacement.tree-plru",
     "memHierarchy.scratchInterface",
     "memHierarchy.simpleDRAM",
     "memHierarchy.simpleMem",
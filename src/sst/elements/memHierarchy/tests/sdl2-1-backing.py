@@ -0,0 +1,88 @@
+# Simple CPU + 2 levels cache + Memory that saves and restores memory contents.
+# Memory is 6KiB so the backing store's last 4KiB dump page is a partial one.
+#   --out FILE   dump the memory contents to FILE at the end of simulation
+#   --in FILE    restore the memory contents from FILE at the start of simulation
+#   --no-write   only issue reads, so memory ends up holding what was restored
+import sst
+import argparse
+from mhlib import componentlist
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--out", help="backing_out_file for the memory", default="")
+parser.add_argument("--in", dest="infile", help="backing_in_file for the memory", default="")
+parser.add_argument("--no-write", dest="write", help="CPU only issues reads", action="store_false")
+args = parser.parse_args()
+
+DEBUG_L1 = 0
+DEBUG_L2 = 0
+DEBUG_MEM = 0
+verbose = 2
+
+# Define the simulation components
+cpu = sst.Component("cpu", "memHierarchy.trivialCPU")
+cpu.addParams({
+      "memSize" : "0x1800",
+      "num_loadstore" : "1000",
+      "commFreq" : "100",
+      "do_write" : "1" if args.write else "0"
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "4",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+    "associativity" : "4",
+    "cache_line_size" : "64",
+    "cache_size" : "2 KiB",
+    "L1" : "1",
+    "verbose" : verbose,
+    "debug" : DEBUG_L1,
+    "debug_level" : "10"
+})
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "16 KiB",
+    "verbose" : verbose,
+    "debug" : DEBUG_L2,
+    "debug_level" : "10"
+})
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+    "debug" : DEBUG_MEM,
+    "debug_level" : "10",
+    "addr_range_end" : 6*1024-1,
+    "backing" : "mmap",
+    "backing_out_file" : args.out,
+    "backing_in_file" : args.infile,
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100 ns",
+    "mem_size" : "6KiB",
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+
+# Define the simulation links
+link_cpu_l1cache = sst.Link("link_cpu_l1cache_link")
+link_cpu_l1cache.connect( (iface, "port", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+link_l1cache_l2cache = sst.Link("link_l1cache_l2cache_link")
+link_l1cache_l2cache.connect( (l1cache, "low_network_0", "10000ps"), (l2cache, "high_network_0", "1000ps") )
+link_mem_bus = sst.Link("link_mem_bus_link")
+link_mem_bus.connect( (l2cache, "low_network_0", "10000ps"), (memctrl, "direct_link", "10000ps") )
@@ -0,0 +1,94 @@
+# Simple CPU + 2 levels cache + Memory, split into two partition groups with
+# sst.memHierarchy.PartitionHints: the CPU and L1 in one, the L2 and memory in
+# the other. The L1/L2 link carries --lookahead ps of extra latency and both
+# caches send that much earlier, so as long as the lookahead is no more than
+# the smallest cache latency (the L1's one cycle MSHR latency) the output must
+# not depend on it. Both caches run at 2GHz, so the lookahead must be a multiple
+# of 500ps.
+import sst
+import argparse
+from sst.memHierarchy import PartitionHints
+from mhlib import componentlist
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--lookahead", help="lookahead on the L1/L2 link in ps", type=int, default=500)
+args = parser.parse_args()
+
+DEBUG_L1 = 0
+DEBUG_L2 = 0
+DEBUG_MEM = 0
+verbose = 2
+
+# Define the simulation components
+cpu = sst.Component("cpu", "memHierarchy.trivialCPU")
+cpu.addParams({
+      "memSize" : "0x1000",
+      "num_loadstore" : "1000",
+      "commFreq" : "100",
+      "do_write" : "1"
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.memInterface")
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "4",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+    "associativity" : "4",
+    "cache_line_size" : "64",
+    "cache_size" : "2 KiB",
+    "L1" : "1",
+    "verbose" : verbose,
+    "debug" : DEBUG_L1,
+    "debug_level" : "10"
+})
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+    "associativity" : "8",
+    "cache_size" : "16 KiB",
+    "cache_line_size" : "64",
+    "verbose" : verbose,
+    "debug" : DEBUG_L2,
+    "debug_level" : "10"
+})
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+    "debug" : DEBUG_MEM,
+    "debug_level" : "10",
+    "addr_range_end" : 512*1024*1024-1,
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100 ns",
+    "mem_size" : "512MiB",
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+# Define the partition groups and the simulation links
+hints = PartitionHints("%dps" % args.lookahead)
+hints.addGroup([cpu, iface, l1cache])
+hints.addGroup([l2cache, memctrl])
+
+hints.connect("link_cpu_l1cache_link", (iface, "port"), (l1cache, "high_network_0", "cpulink"), "1000ps")
+hints.connect("link_l1cache_l2cache_link", (l1cache, "low_network_0", "memlink"), (l2cache, "high_network_0", "cpulink"), "1000ps")
+hints.connect("link_mem_bus_link", (l2cache, "low_network_0", "memlink"), (memctrl, "direct_link"), "10000ps")
+
+# Only the L1/L2 link is between groups
+expected = "%dps" % (1000 + args.lookahead)
+if hints.getMinLatency() != expected:
+    raise RuntimeError("PartitionHints: minimum latency between groups is %s, expected %s" % (hints.getMinLatency(), expected))
+
+hints.apply(sst.getMPIRankCount(), sst.getThreadCount())
+hints.report()
@@ -3,6 +3,7 @@
 from sst_unittest import *
 from sst_unittest_support import *
 import os.path
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -66,6 +67,10 @@ class testcase_memHierarchy_sdl(SSTTestCase):
         #  sdl3-1  2 Simple CPUs + 2 levels cache + Memory
         self.memHierarchy_Template("sdl3-1")
 
+    def test_memHierarchy_sdl3_1_flat(self):
+        #  sdl3-1-flat  Same as sdl3-1 using the flat cache array, output must match sdl3-1
+        self.memHierarchy_Template("sdl3-1-flat", refcase="sdl3_1")
+
     def test_memHierarchy_sdl3_2(self):
         #  sdl3-2  2 Simple CPUs + 2 levels cache + DRAMSim Memory
         self.memHierarchy_Template("sdl3-2")
@@ -76,6 +81,10 @@ class testcase_memHierarchy_sdl(SSTTestCase):
     def test_memHierarchy_sdl4_1(self):
         self.memHierarchy_Template("sdl4-1")
 
+    def test_memHierarchy_sdl4_1_eventdriven(self):
+        #  sdl4-1-eventdriven  Same as sdl4-1 with event-driven caches, output must match sdl4-1
+        self.memHierarchy_Template("sdl4-1-eventdriven", refcase="sdl4_1")
+
     @skip_on_sstsimulator_conf_empty_str("DRAMSIM", "LIBDIR", "DRAMSIM is not included as part of this build")
     def test_memHierarchy_sdl4_2_dramsim(self):
         self.memHierarchy_Template("sdl4-2", ignore_err_file=True)
@@ -95,12 +104,46 @@ class testcase_memHierarchy_sdl(SSTTestCase):
         else:
             self.memHierarchy_Template("sdl5-1-ramulator")
 
+    def test_memHierarchy_sdl2_1_lookahead(self):
+        #  sdl2-1-lookahead  sdl2-1 split into two PartitionHints groups, output must not change with the L1/L2 link lookahead
+        self.memHierarchy_Lookahead_Template("sdl2-1-lookahead", 500)
+
+    def test_memHierarchy_sdl2_1_backing(self):
+        #  sdl2-1-backing  sdl2-1 with 6KiB of memory, dumped by one run and restored by a second
+        self.memHierarchy_Backing_Template("sdl2-1-backing")
+
     def test_memHierarchy_sdl8_1(self):
         self.memHierarchy_Template("sdl8-1")
 
+    def test_memHierarchy_sdl8_1_pooledmshr(self):
+        #  sdl8-1-pooledmshr  Same as sdl8-1 using the pooled MSHR, output must match sdl8-1
+        self.memHierarchy_Template("sdl8-1-pooledmshr", refcase="sdl8_1")
+
     def test_memHierarchy_sdl8_3(self):
         self.memHierarchy_Template("sdl8-3")
 
+    def test_memHierarchy_sdl8_3_sparse(self):
+        #  sdl8-3-sparse  Same as sdl8-3 with a sparse directory large enough that it never evicts, output must match sdl8-3
+        self.memHierarchy_Template("sdl8-3-sparse", refcase="sdl8_3")
+
+    def test_memHierarchy_sdl8_3_sparse_evict(self):
+        #  sdl8-3-sparse-evict  sdl8-3 with a 32-entry sparse directory, every access must complete and the directory must evict
+        self.memHierarchy_Completion_Template("sdl8-3-sparse-evict", 4, 1000,
+                ["dirctrl.directory_evictions", "dirctrl.directory_eviction_invalidations"])
+
+    def test_memHierarchy_replacement_tree_plru(self):
+        #  replacement  benchReplacement.py with a short run of the tree-PLRU LLC
+        self.memHierarchy_Replacement_Template("tree-plru")
+
+    def test_memHierarchy_replacement_srrip(self):
+        self.memHierarchy_Replacement_Template("srrip")
+
+    def test_memHierarchy_replacement_brrip(self):
+        self.memHierarchy_Replacement_Template("brrip")
+
+    def test_memHierarchy_replacement_drrip(self):
+        self.memHierarchy_Replacement_Template("drrip")
+
     def test_memHierarchy_sdl8_4(self):
         self.memHierarchy_Template("sdl8-4")
 
@@ -112,7 +155,7 @@ class testcase_memHierarchy_sdl(SSTTestCase):
 
 #####
 
-    def memHierarchy_Template(self, testcase, ignore_err_file=False):
+    def memHierarchy_Template(self, testcase, ignore_err_file=False, refcase=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -125,7 +168,8 @@ class testcase_memHierarchy_sdl(SSTTestCase):
         # Set the various file paths
         testDataFileName=("test_memHierarchy_{0}".format(testcasename_out))
         sdlfile = "{0}/{1}.py".format(test_path, testcasename_sdl)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        refDataFileName = testDataFileName if refcase is None else "test_memHierarchy_{0}".format(refcase)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, refDataFileName)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
@@ -172,6 +216,153 @@ class testcase_memHierarchy_sdl(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+    # For configurations whose timing has no reference: every trivialCPU must
+    # finish with all of its accesses returned and each of 'nonzero_stats' must
+    # have counted something
+    def memHierarchy_Completion_Template(self, testcase, num_cpus, num_accesses, nonzero_stats):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName=("test_memHierarchy_{0}".format(testcase.replace("-", "_")))
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("memHierarchy SDL test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        with open(outfile, 'r') as fp:
+            lines = fp.readlines()
+
+        finished = "Finished after {0} issued reads, {0} returned".format(num_accesses)
+        for cpu in range(num_cpus):
+            prefix = "TrivialCPU cpu{0} ".format(cpu)
+            done = [line for line in lines if line.startswith(prefix) and finished in line]
+            self.assertTrue(len(done) == 1, "Output file {0} does not show cpu{1} finishing {2} accesses".format(outfile, cpu, num_accesses))
+
+        for stat in nonzero_stats:
+            count = None
+            for line in lines:
+                match = re.match(r"\s*{0} : Accumulator : .*Count\.u64 = (\d+);".format(re.escape(stat)), line)
+                if match:
+                    count = int(match.group(1))
+            self.assertTrue(count is not None and count > 0, "Output file {0} shows no {1}".format(outfile, stat))
+
+    # Runs the testcase without and with lookahead. Timing must not change, so the
+    # CPU's completion line, the statistics and the simulated time must match.
+    def memHierarchy_Lookahead_Template(self, testcase, lookahead_ps):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+
+        results = []
+        for lookahead in [0, lookahead_ps]:
+            testDataFileName=("test_memHierarchy_{0}_{1}ps".format(testcase.replace("-", "_"), lookahead))
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+            otherargs = '--model-options="--lookahead {0}"'.format(lookahead)
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("memHierarchy SDL test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            with open(outfile, 'r') as fp:
+                lines = fp.readlines()
+
+            minimum = "minimum latency between groups: {0}ps".format(1000 + lookahead)
+            self.assertTrue(any(minimum in line for line in lines), "Output file {0} does not report {1}".format(outfile, minimum))
+
+            finished = [line for line in lines if "Finished after 1000 issued reads, 1000 returned" in line]
+            self.assertTrue(len(finished) == 1, "Output file {0} does not show the CPU finishing".format(outfile))
+
+            kept = [line.strip() for line in lines if " : Accumulator : " in line or "Finished after" in line or "Simulation is complete" in line]
+            results.append((outfile, sorted(kept)))
+
+        self.assertTrue(results[0][1] == results[1][1], "Output files {0} and {1} differ".format(results[0][0], results[1][0]))
+
+    # Runs the testcase twice. The first run writes memory and dumps it with
+    # backing_out_file. The second restores that dump with backing_in_file, only
+    # reads, and dumps again. The dumps must match, and the first must hold the
+    # partial page at the end of memory.
+    def memHierarchy_Backing_Template(self, testcase):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+
+        pageSize = 4096
+        dumps = []
+        for run, args in [("dump", "--out {0}"), ("restore", "--in {1} --out {0} --no-write")]:
+            testDataFileName=("test_memHierarchy_{0}_{1}".format(testcase.replace("-", "_"), run))
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+            dumpfile = "{0}/{1}.backing".format(tmpdir, testDataFileName)
+
+            otherargs = '--model-options="{0}"'.format(args.format(dumpfile, dumps[0] if dumps else ""))
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("memHierarchy SDL test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            self.assertTrue(os_test_file(dumpfile, "-e"), "Run {0} did not write {1}".format(testDataFileName, dumpfile))
+            dumps.append(dumpfile)
+
+        with open(dumps[0], 'rb') as fp:
+            saved = fp.read()
+        with open(dumps[1], 'rb') as fp:
+            restored = fp.read()
+
+        # Header is 8B magic and 8B page size, then 8B address + page size data per page
+        recordSize = 8 + pageSize
+        pages = [int.from_bytes(saved[i:i+8], "little") for i in range(16, len(saved), recordSize)]
+        self.assertTrue(pageSize in pages, "Dump {0} does not hold the partial last page, pages are {1}".format(dumps[0], pages))
+        self.assertTrue(saved == restored, "Dump {0} of the restored memory differs from {1}".format(dumps[1], dumps[0]))
+
+    # Runs benchReplacement.py with the given LLC policy. Hit counts depend on the
+    # policy and have no reference, so check that the CPU issued and completed
+    # all of its accesses and that the LLC both hit and missed.
+    def memHierarchy_Replacement_Template(self, policy, num_ops=20000):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName=("test_memHierarchy_replacement_{0}".format(policy.replace("-", "_")))
+        sdlfile = "{0}/benchReplacement.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        otherargs = '--model-options="--policy {0} --ops {1}"'.format(policy, num_ops)
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("memHierarchy replacement test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        with open(outfile, 'r') as fp:
+            lines = fp.readlines()
+
+        completed = [line for line in lines if "StandardCPU: Test Completed Successfuly" in line]
+        self.assertTrue(len(completed) == 1, "Output file {0} does not show the CPU completing".format(outfile))
+
+        def stat_count(stat):
+            for line in lines:
+                match = re.match(r"\s*{0} : Accumulator : .*Count\.u64 = (\d+);".format(re.escape(stat)), line)
+                if match:
+                    return int(match.group(1))
+            return None
+
+        issued = (stat_count("cpu.reads") or 0) + (stat_count("cpu.writes") or 0)
+        self.assertTrue(issued == num_ops, "Output file {0} shows {1} CPU accesses, expected {2}".format(outfile, issued, num_ops))
+
+        for stat in ["l2cache.CacheHits", "l2cache.CacheMisses"]:
+            count = stat_count(stat)
+            self.assertTrue(count is not None and count > 0, "Output file {0} shows no {1}".format(outfile, stat))
+
 ###
 
     # Remove lines containing any string found in 'remove_strs' from in_file
@@ -0,0 +1,96 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Unit checks for CycleAddrFilter, the cache's set of addresses accessed
+ * in the current cycle: random cycles of inserts and lookups are mirrored
+ * in a std::set that is cleared with the filter. Cycles range from empty
+ * to many times the expected size, so growing the table mid-cycle and
+ * probing past stale slots from earlier cycles are covered.
+ */
+
+#include <sst_config.h>
+
+#include <random>
+#include <set>
+
+#include <sst/elements/memHierarchy/cycleAddrFilter.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::MemHierarchy;
+
+static void testAgainstSet() {
+    const size_t expectedSizes[] = { 0, 1, 2, 8, 64 };
+
+    for (size_t expected : expectedSizes) {
+        std::mt19937_64 rng(expected + 1);
+        CycleAddrFilter filter(expected);
+        uint64_t mismatches = 0;
+
+        for (uint32_t cycle = 0; cycle < 2000; cycle++) {
+            filter.clear();
+            std::set<uint64_t> model;
+
+            // Mostly a few accesses per cycle, sometimes far more than expected
+            uint32_t accesses = (rng() % 10 == 0) ? rng() % 200 : rng() % 4;
+            for (uint32_t i = 0; i < accesses; i++) {
+                // Line addresses from a small range so they repeat within and across cycles
+                uint64_t addr = (rng() % 256) * 64;
+
+                if (filter.contains(addr) != (model.count(addr) != 0))
+                    mismatches++;
+
+                if (rng() % 2) {
+                    filter.insert(addr);
+                    model.insert(addr);
+                }
+            }
+
+            for (uint64_t addr = 0; addr < 256 * 64; addr += 64) {
+                if (filter.contains(addr) != (model.count(addr) != 0))
+                    mismatches++;
+            }
+        }
+
+        CHECK(mismatches == 0);
+    }
+}
+
+static void testClear() {
+    CycleAddrFilter filter(4);
+
+    filter.insert(0x40);
+    filter.insert(0x80);
+    CHECK(filter.contains(0x40));
+    CHECK(filter.contains(0x80));
+    CHECK(!filter.contains(0xc0));
+
+    filter.clear();
+    CHECK(!filter.contains(0x40));
+    CHECK(!filter.contains(0x80));
+
+    // Address 0 is not special
+    filter.insert(0);
+    CHECK(filter.contains(0));
+    filter.clear();
+    CHECK(!filter.contains(0));
+}
+
+int main() {
+    testAgainstSet();
+    testClear();
+
+    return SST::UnitTest::result("testCycleAddrFilter");
+}
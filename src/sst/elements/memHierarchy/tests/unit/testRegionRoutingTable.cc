@@ -0,0 +1,233 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Unit checks for RegionRoutingTable: for overlapping, interleaved and
+ * randomly generated region lists, the compiled table must route every
+ * checked address to the same destination as walking the list in order
+ * and taking the first region that contains it. Addresses are taken at
+ * and around each region and interleave chunk boundary plus at random.
+ * Route ids must resolve to the same route and only on the table build
+ * that produced them.
+ */
+
+#include <sst_config.h>
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sst/elements/memHierarchy/regionRoutingTable.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::MemHierarchy;
+
+/* Same fields and contains() as MemRegion, which needs SST-Core to link */
+struct Region {
+    uint64_t start;
+    uint64_t end;
+    uint64_t interleaveSize;
+    uint64_t interleaveStep;
+    static const uint64_t REGION_MAX = ~uint64_t(0);
+
+    bool contains(uint64_t addr) const {
+        if (addr >= start && addr <= end) {
+            if (interleaveSize == 0) return true;
+            uint64_t offset = (addr - start) % interleaveStep;
+            return (offset < interleaveSize);
+        }
+        return false;
+    }
+};
+
+typedef RegionRoutingTableT<Region> Table;
+
+static Region region(uint64_t start, uint64_t end, uint64_t size = 0, uint64_t step = 0) {
+    Region reg = { start, end, size, step };
+    return reg;
+}
+
+/* The first-match walk the table replaces */
+static std::string firstMatch(const std::vector<Region> &regions, uint64_t addr) {
+    for (size_t i = 0; i < regions.size(); i++) {
+        if (regions[i].contains(addr))
+            return "dst" + std::to_string(i);
+    }
+    return "";
+}
+
+static void build(Table &table, const std::vector<Region> &regions) {
+    table.clear();
+    for (size_t i = 0; i < regions.size(); i++)
+        table.addRoute(regions[i], "dst" + std::to_string(i), 100 + i);
+    table.build();
+}
+
+static bool routesMatch(const Table &table, const std::vector<Region> &regions, uint64_t addr) {
+    std::string expect = firstMatch(regions, addr);
+    const Table::Route* route = table.find(addr);
+    uint64_t id = table.findId(addr);
+
+    if (expect == "")
+        return route == nullptr && id == Table::NO_ROUTE;
+    if (route == nullptr || route->name != expect || route->netAddr != 100 + std::stoull(expect.substr(3)))
+        return false;
+    return table.getRoute(id) == route;
+}
+
+/* Addresses at and next to every region and chunk boundary, plus random ones in range */
+static std::vector<uint64_t> addresses(const std::vector<Region> &regions, std::mt19937_64 &rng, uint64_t range) {
+    std::vector<uint64_t> addrs = { 0, 1, Region::REGION_MAX - 1, Region::REGION_MAX };
+    for (const Region &reg : regions) {
+        const uint64_t edges[] = { reg.start, reg.end, reg.end + 1 };
+        for (uint64_t edge : edges) {
+            addrs.push_back(edge - 1);
+            addrs.push_back(edge);
+        }
+        if (reg.interleaveStep == 0)
+            continue;
+        for (uint64_t chunk = reg.start; chunk <= reg.end && chunk < reg.start + 8 * reg.interleaveStep; chunk += reg.interleaveStep) {
+            addrs.push_back(chunk);
+            addrs.push_back(chunk + reg.interleaveSize - 1);
+            addrs.push_back(chunk + reg.interleaveSize);
+        }
+    }
+    for (int i = 0; i < 2000; i++)
+        addrs.push_back(rng() % range);
+    return addrs;
+}
+
+static void checkAll(const std::vector<Region> &regions, std::mt19937_64 &rng, uint64_t range) {
+    Table table;
+    build(table, regions);
+    CHECK(table.isBuilt());
+    CHECK(table.size() == regions.size());
+
+    int mismatches = 0;
+    for (uint64_t addr : addresses(regions, rng, range)) {
+        if (!routesMatch(table, regions, addr))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+
+static void testOverlapping(std::mt19937_64 &rng) {
+    // Earlier regions win where they overlap later ones
+    std::vector<Region> regions = {
+        region(0x1000, 0x1fff),
+        region(0x0, 0x3fff),
+        region(0x1800, 0x27ff),
+        region(0x3000, Region::REGION_MAX),
+    };
+    checkAll(regions, rng, 0x10000);
+
+    // Nested regions and a gap
+    regions = {
+        region(0x2000, 0x20ff),
+        region(0x1000, 0x2fff),
+        region(0x0, 0x3fff),
+        region(0x8000, 0x8fff),
+    };
+    checkAll(regions, rng, 0x10000);
+}
+
+static void testInterleaved(std::mt19937_64 &rng) {
+    // 8 memories interleaved 64B at a time
+    std::vector<Region> regions;
+    for (uint64_t i = 0; i < 8; i++)
+        regions.push_back(region(i * 64, 0xfffff, 64, 512));
+    checkAll(regions, rng, 0x110000);
+
+    // Interleaved slices over a default route, with a non-power-of-two step
+    regions.clear();
+    for (uint64_t i = 0; i < 3; i++)
+        regions.push_back(region(0x10000 + i * 256, 0x1ffff, 256, 768));
+    regions.push_back(region(0x0, Region::REGION_MAX));
+    checkAll(regions, rng, 0x30000);
+
+    // Slices covering only part of each step, starting at unaligned addresses
+    regions = {
+        region(0x1040, 0x9fff, 64, 1024),
+        region(0x1100, 0x9fff, 128, 1024),
+        region(0x1000, 0xffff),
+    };
+    checkAll(regions, rng, 0x20000);
+
+    // Interleaved regions overlapping each other, with mixed steps
+    regions = {
+        region(0x0, 0xffff, 64, 256),
+        region(0x40, 0xffff, 128, 384),
+        region(0x4000, 0x7fff, 256, 512),
+        region(0x0, 0x1ffff),
+    };
+    checkAll(regions, rng, 0x30000);
+}
+
+static void testRandom(std::mt19937_64 &rng) {
+    const uint64_t range = 1 << 20;
+    for (int trial = 0; trial < 200; trial++) {
+        std::vector<Region> regions;
+        int count = 1 + rng() % 12;
+        uint64_t step = uint64_t(64) << (rng() % 4);
+        for (int i = 0; i < count; i++) {
+            uint64_t start = rng() % range;
+            uint64_t end = start + rng() % (range - start);
+            if (rng() % 3) {
+                regions.push_back(region(start, end));
+            } else {
+                // Usually a shared step so that segments can be flattened
+                uint64_t regStep = (rng() % 4) ? step : uint64_t(48) << (rng() % 4);
+                uint64_t size = 16 * (1 + rng() % (regStep / 16 - 1));
+                regions.push_back(region(start, end, size, regStep));
+            }
+        }
+        checkAll(regions, rng, range);
+    }
+}
+
+static void testRouteIds() {
+    std::vector<Region> regions = { region(0x0, 0xfff), region(0x1000, 0x1fff) };
+    Table table, other;
+    build(table, regions);
+    build(other, regions);
+
+    uint64_t id = table.findId(0x1800);
+    CHECK(id != Table::NO_ROUTE);
+    CHECK(table.getRoute(id) != nullptr && table.getRoute(id)->name == "dst1");
+    CHECK(table.findId(0x2000) == Table::NO_ROUTE);
+    CHECK(table.getRoute(Table::NO_ROUTE) == nullptr);
+
+    // Ids only resolve on the table and build that produced them
+    CHECK(other.getRoute(id) == nullptr);
+    table.build();
+    CHECK(table.getRoute(id) == nullptr);
+    CHECK(table.getRoute(table.findId(0x1800)) == table.find(0x1800));
+
+    table.clear();
+    CHECK(!table.isBuilt());
+    CHECK(table.getRoute(other.findId(0x0)) == nullptr);
+}
+
+int main() {
+    std::mt19937_64 rng(7);
+
+    testOverlapping(rng);
+    testInterleaved(rng);
+    testRandom(rng);
+    testRouteIds();
+
+    return SST::UnitTest::result("testRegionRoutingTable");
+}
@@ -0,0 +1,144 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Unit checks for TreePLRUState and RRIPState: short access sequences on
+ * full sets whose victims were worked out by hand. A fill is replaced()
+ * then update(), as the cache arrays do it.
+ */
+
+#include <sst_config.h>
+
+#include <stdint.h>
+
+#include <sst/elements/memHierarchy/replacementState.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::MemHierarchy;
+
+/* 4 ways, 2 sets. Bits: node 1 picks a half, nodes 2 and 3 a way in it */
+static void testTreePLRU() {
+    TreePLRUState tree(8, 4);
+
+    // No accesses, every bit points left
+    CHECK(tree.victim(0) == 0);
+    CHECK(tree.victim(4) == 4);
+
+    for (uint64_t way = 0; way < 4; way++)
+        tree.update(way);
+    CHECK(tree.victim(0) == 0);     // Same as LRU
+
+    tree.update(0);
+    CHECK(tree.victim(0) == 2);     // LRU would pick 1, but node 1 now points right and node 3 at 2
+    tree.update(2);
+    CHECK(tree.victim(0) == 1);
+    tree.update(1);
+    CHECK(tree.victim(0) == 3);
+    tree.update(3);
+    CHECK(tree.victim(0) == 0);
+
+    // The other set was not touched
+    CHECK(tree.victim(4) == 4);
+    tree.update(5);
+    CHECK(tree.victim(4) == 6);
+    CHECK(tree.victim(0) == 0);
+}
+
+/* 3 ways use a 4 way tree, the missing way 3 must never be picked */
+static void testTreePLRUNotPowerOfTwo() {
+    TreePLRUState tree(6, 3);
+
+    CHECK(tree.victim(0) == 0);
+    tree.update(0);
+    CHECK(tree.victim(0) == 2);     // Node 1 points right, only way 2 is there
+    tree.update(2);
+    CHECK(tree.victim(0) == 1);
+    tree.update(1);
+    CHECK(tree.victim(0) == 2);     // Node 3 points at the missing way 3
+
+    CHECK(tree.victim(3) == 3);
+    tree.update(3);
+    tree.update(4);
+    CHECK(tree.victim(3) == 5);
+    tree.update(5);
+    CHECK(tree.victim(3) == 3);
+}
+
+static void fill(RRIPState &state, uint64_t id, uint8_t insertion) {
+    state.replaced(id);
+    CHECK(state.isInserting(id));
+    state.insert(id, insertion);
+    CHECK(!state.isInserting(id));
+}
+
+static bool rrpvs(const RRIPState &state, uint64_t setBegin, const uint8_t (&expect)[4]) {
+    for (uint64_t i = 0; i < 4; i++) {
+        if (state.getRRPV(setBegin + i) != expect[i])
+            return false;
+    }
+    return true;
+}
+
+/* 2-bit SRRIP, 4 ways, 2 sets. Fills insert at max - 1 = 2, hits set 0 */
+static void testSRRIP() {
+    RRIPState state;
+    state.resize(8, 4, 3);
+    const uint8_t insertion = 2;
+    CHECK(state.getMaxRRPV() == 3);
+
+    for (uint64_t way = 0; way < 4; way++)
+        fill(state, way, insertion);
+    state.hit(1);
+    CHECK(rrpvs(state, 0, { 2, 0, 2, 2 }));
+
+    // No line is at max, age by one and pick the first
+    CHECK(state.victim(0) == 0);
+    CHECK(rrpvs(state, 0, { 3, 1, 3, 3 }));
+
+    // A line at max is taken without aging
+    fill(state, 0, insertion);
+    CHECK(state.victim(0) == 2);
+    CHECK(rrpvs(state, 0, { 2, 1, 3, 3 }));
+    fill(state, 2, insertion);
+    CHECK(state.victim(0) == 3);
+    fill(state, 3, insertion);
+    CHECK(rrpvs(state, 0, { 2, 1, 2, 2 }));
+
+    // New lines through ways 0 and 2 are evicted before the hit lines 1 and 3
+    state.hit(3);
+    CHECK(state.victim(0) == 0);
+    CHECK(rrpvs(state, 0, { 3, 2, 3, 1 }));
+    fill(state, 0, insertion);
+    CHECK(state.victim(0) == 2);
+    fill(state, 2, insertion);
+    CHECK(rrpvs(state, 0, { 2, 2, 2, 1 }));
+    CHECK(state.victim(0) == 0);
+    CHECK(rrpvs(state, 0, { 3, 3, 3, 2 }));
+    fill(state, 0, insertion);
+    CHECK(state.victim(0) == 1);    // Line 1 has now aged to max
+
+    // The other set was not aged
+    uint8_t untouched[4] = { 3, 3, 3, 3 };
+    CHECK(rrpvs(state, 4, untouched));
+    CHECK(state.victim(4) == 4);
+}
+
+int main() {
+    testTreePLRU();
+    testTreePLRUNotPowerOfTwo();
+    testSRRIP();
+
+    return SST::UnitTest::result("testReplacementState");
+}
@@ -0,0 +1,104 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Unit checks for SharerSet and SharerIdMap: random adds, removes and
+ * clears are mirrored in a std::set and after each one the two must hold
+ * the same ids, visited in the same order. Ids span several words so
+ * that growing the bit-vector and scanning across words are covered.
+ */
+
+#include <sst_config.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sst/elements/memHierarchy/sharerSet.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::MemHierarchy;
+
+static bool sameContents(const SharerSet &set, const std::set<uint32_t> &model) {
+    if (set.size() != model.size() || set.empty() != model.empty())
+        return false;
+
+    std::vector<uint32_t> ids;
+    for (uint32_t id = set.first(); id != SharerIdMap::NONE; id = set.next(id))
+        ids.push_back(id);
+    return ids == std::vector<uint32_t>(model.begin(), model.end());
+}
+
+static void testAgainstSet() {
+    const uint32_t maxIds[] = { 1, 63, 64, 65, 200, 1000 };
+
+    for (uint32_t maxId : maxIds) {
+        std::mt19937 rng(maxId);
+        SharerSet set;
+        std::set<uint32_t> model;
+        int mismatches = 0;
+
+        for (int i = 0; i < 20000; i++) {
+            uint32_t id = rng() % maxId;
+            uint32_t op = rng() % 100;
+
+            if (op < 55) {
+                set.add(id);
+                model.insert(id);
+            } else if (op < 98) {
+                set.remove(id);
+                model.erase(id);
+            } else {
+                set.clear();
+                model.clear();
+            }
+
+            if (!sameContents(set, model))
+                mismatches++;
+            if (set.contains(id) != (model.count(id) != 0))
+                mismatches++;
+        }
+
+        // Removing ids beyond the end of the vector must not grow or change it
+        set.remove(maxId + 1000);
+        if (!sameContents(set, model) || set.contains(maxId + 1000))
+            mismatches++;
+
+        CHECK(0 == mismatches);
+    }
+}
+
+static void testIdMap() {
+    SharerIdMap map;
+    const char* names[] = { "c0.l1cache", "c1.l1cache", "n0.l2cache", "n1.l2cache" };
+
+    for (uint32_t i = 0; i < 4; i++)
+        CHECK(i == map.getId(names[i]));
+
+    CHECK(1 == map.getId("c1.l1cache"));
+    CHECK(4 == map.size());
+    CHECK(2 == map.findId("n0.l2cache"));
+    CHECK(SharerIdMap::NONE == map.findId("l3cache"));
+    CHECK(std::string("n1.l2cache") == map.getName(3));
+    CHECK(4 == map.size());
+}
+
+int main() {
+    testAgainstSet();
+    testIdMap();
+
+    return SST::UnitTest::result("testSharerSet");
+}
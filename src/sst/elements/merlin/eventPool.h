@@ -0,0 +1,92 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_EVENTPOOL_H
+#define COMPONENTS_MERLIN_EVENTPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Thread-local free lists backing operator new/delete for the router
+ * events (BaseRtrEvent and everything derived from it, including the
+ * topology specific internal_router_events).
+ *
+ * Blocks are recycled by size class, so all event types of similar
+ * size share a pool and allocation is a vector pop on the calling
+ * thread with no locking or searching.  An event deleted on a
+ * different thread than it was allocated on (e.g. when crossing a
+ * partition boundary) simply joins the free list of the deleting
+ * thread.  Each free list is capped so that one-way traffic between
+ * threads cannot grow it without bound.
+ */
+class RtrEventPool {
+public:
+    static inline void* allocate(std::size_t size) {
+        std::size_t cls = (size + granularity - 1) / granularity;
+        if ( cls >= num_classes ) return ::operator new(size);
+        std::vector<void*>& list = lists().free[cls];
+        if ( list.empty() ) return ::operator new(cls * granularity);
+        void* ptr = list.back();
+        list.pop_back();
+        return ptr;
+    }
+
+    static inline void release(void* ptr, std::size_t size) {
+        std::size_t cls = (size + granularity - 1) / granularity;
+        if ( cls >= num_classes ) {
+            ::operator delete(ptr);
+            return;
+        }
+        std::vector<void*>& list = lists().free[cls];
+        if ( list.size() >= max_free ) {
+            ::operator delete(ptr);
+            return;
+        }
+        list.push_back(ptr);
+    }
+
+private:
+    static const std::size_t granularity = 16;
+    static const std::size_t num_classes = 32;
+    static const std::size_t max_free = 16384;
+
+    struct FreeLists {
+        std::vector<void*> free[num_classes];
+
+        ~FreeLists() {
+            for ( std::size_t i = 0; i < num_classes; ++i ) {
+                for ( void* ptr : free[i] ) ::operator delete(ptr);
+            }
+        }
+    };
+
+    static inline FreeLists& lists() {
+        static thread_local FreeLists free_lists;
+        return free_lists;
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_EVENTPOOL_H
@@ -287,6 +287,19 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     xbar_tc = registerClock( xbar_clock, my_clock_handler);
     num_routers++;
 
+    event_driven = params.find<bool>("event_driven", false);
+    stalled = false;
+    wakeup_link = NULL;
+#if VERIFY_DECLOCKING
+    event_driven = false;
+#endif
+    if ( event_driven ) {
+        if ( !arb->canSkipStalledCycles() ) {
+            merlin_abort.fatal(CALL_INFO, -1, "hr_router: event_driven is not supported by xbar_arb %s\n", xbar_arb.c_str());
+        }
+        wakeup_link = configureSelfLink("xbar_wakeup", xbar_tc, new Event::Handler<hr_router>(this,&hr_router::handle_wakeup));
+    }
+
 #if VERIFY_DECLOCKING
     clocking = true;
 #endif
@@ -325,6 +338,22 @@ hr_router::notifyEvent()
 
     int64_t elapsed_cycles = next_cycle - unclocked_cycle;
 
+    if ( stalled ) {
+        // Every skipped cycle would have arbitrated just like the
+        // last one, so the same ports stalled
+        setRequestNotifyOnCredit(false);
+        stalled = false;
+        if ( elapsed_cycles > 0 ) {
+            for ( int i = 0; i < num_ports; i++ ) {
+                if ( progress_vcs[i] == -2 ) xbar_stalls[i]->addDataNTimes(elapsed_cycles, 1);
+            }
+            arb->reportSkippedStalledCycles(elapsed_cycles, in_port_busy);
+        }
+    }
+    else {
+        // Report skipped cycles to arbitration unit.
+        arb->reportSkippedCycles(elapsed_cycles);
+    }
 
 #if !VERIFY_DECLOCKING
     // Fix up the busy variables
@@ -339,8 +368,14 @@ hr_router::notifyEvent()
         else out_port_busy[i] = tmp;
     }
 #endif
-    // Report skipped cycles to arbitration unit.
-    arb->reportSkippedCycles(elapsed_cycles);
+}
+
+void
+hr_router::handle_wakeup(Event* ev)
+{
+    // Wakeups can be stale (the router already woke up for some other
+    // reason), but waking up early is always safe
+    if ( stalled ) notifyEvent();
 }
 
 void
@@ -408,9 +443,13 @@ hr_router::clock_handler(Cycle_t cycle)
 #endif
 
     // Move the events and decrement the busy values
+    bool progressed = false;
+    bool freed = false;
+    int next_free = 0;
     for ( int i = 0; i < num_ports; i++ ) {
         // if ( progress_vcs[i] != -1 ) {
         if ( progress_vcs[i] > -1 ) {
+            progressed = true;
             internal_router_event* ev = ports[i]->recv(progress_vcs[i]);
             ports[ev->getNextPort()]->send(ev,ev->getVC());
 
@@ -437,8 +476,26 @@ hr_router::clock_handler(Cycle_t cycle)
 
         // Should stop at zero, need to find a clean way to do this
         // with no branch.  For now it should work.
+        if ( in_port_busy[i] == 1 || out_port_busy[i] == 1 ) freed = true;
         if ( in_port_busy[i] != 0 ) in_port_busy[i]--;
         if ( out_port_busy[i] != 0 ) out_port_busy[i]--;
+
+        if ( in_port_busy[i] > 0 && (next_free == 0 || in_port_busy[i] < next_free) ) next_free = in_port_busy[i];
+        if ( out_port_busy[i] > 0 && (next_free == 0 || out_port_busy[i] < next_free) ) next_free = out_port_busy[i];
+    }
+
+    // Nothing moved, so if no port frees up for the next cycle nothing
+    // can move until a busy port frees up, credits are returned or a
+    // new event reaches a VC head.  Stop the clock until one of those
+    // happens.  A port that is busy for next_free more cycles is free
+    // in the cycle after that, so wake up in time for that clock.
+    if ( event_driven && !progressed && !freed ) {
+        stalled = true;
+        unclocked_cycle = cycle + 1;
+        setRequestNotifyOnEvent(true);
+        setRequestNotifyOnCredit(true);
+        if ( next_free > 0 ) wakeup_link->send(next_free, NULL);
+        return true;
     }
 
     return false;
@@ -616,6 +673,8 @@ hr_router::init_vcs()
     // Now that we have the number of VCs we can finish initializing
     // arbitration logic
     arb->setPorts(num_ports,num_vcs);
+    initVCHeadMasks(num_ports,num_vcs);
+    arb->setRouterState(vc_heads,xbar_in_credits,vc_head_masks.data(),port_data_mask.data());
 
 
 }
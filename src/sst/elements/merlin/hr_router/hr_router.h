@@ -68,7 +68,9 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
-        {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
+        {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"},
+        {"event_driven",       "Stop clocking the crossbar while events are waiting but none can move, until a busy port frees up, credits return or a new event arrives.  "
+                               "Gives the same results as clocking every cycle.  Not supported by all xbar_arb units.", "false"}
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -121,6 +123,12 @@ private:
     UnitAlgebra output_buf_size;
 
     Cycle_t unclocked_cycle;
+
+    // Event driven mode: stalled is true while the clock is off with
+    // events waiting
+    bool event_driven;
+    bool stalled;
+    Link* wakeup_link;
     std::string xbar_bw;
     TimeConverter* xbar_tc;
     Clock::Handler<hr_router>* my_clock_handler;
@@ -128,6 +136,7 @@ private:
     std::vector<std::string> inspector_names;
 
     bool clock_handler(Cycle_t cycle);
+    void handle_wakeup(Event* ev);
     static void sigHandler(int signal);
 
     void init_vcs();
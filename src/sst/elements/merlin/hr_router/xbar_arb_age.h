@@ -237,6 +237,10 @@ public:
     void reportSkippedCycles(Cycle_t cycles) {
     }
 
+    // Priority comes from packet injection times, so skipping cycles
+    // changes nothing
+    bool canSkipStalledCycles() { return true; }
+
     void dumpState(std::ostream& stream) {
         /* stream << "Current round robin port: " << rr_port << std::endl; */
         /* stream << "  Current round robin VC by port:" << std::endl; */
@@ -0,0 +1,237 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_HR_ROUTER_XBAR_ARB_LRU_MASK_H
+#define COMPONENTS_HR_ROUTER_XBAR_ARB_LRU_MASK_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+using namespace SST;
+
+namespace SST {
+namespace Merlin {
+
+// Makes the same grants as xbar_arb_lru while only visiting the
+// (port, vc) entries that have an event.
+//
+// In xbar_arb_lru, entries granted in a cycle move to the bottom of
+// the list (the first one granted ends up last) and everything else
+// keeps its order.  So the list is always sorted by a key of (cycle
+// last granted, reverse order granted in that cycle), with entries
+// that were never granted in their initial order ahead of all of
+// them.  This keeps the entries with an event in that order: each
+// cycle, entries whose VC emptied are dropped, entries that just got
+// an event (found by masking the router's occupancy bits against the
+// ones already held) are sorted by key and merged in, and granted
+// entries are moved to the end.
+class xbar_arb_lru_mask : public XbarArbitration {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        xbar_arb_lru_mask,
+        "merlin",
+        "xbar_arb_lru_mask",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Least recently used arbitration unit for hr_router using occupancy bit masks.  Grants match xbar_arb_lru",
+        SST::Merlin::XbarArbitration)
+
+
+private:
+    int num_ports;
+    int num_vcs;
+    int vc_mask_words;
+    int total_entries;
+
+    // Priority key for each (port, vc), lower goes first
+    std::vector<int64_t> key;
+    int64_t cycle;
+
+    // Entries (port * num_vcs + vc) with an event, in priority order,
+    // and the matching bits in the router's mask layout
+    std::vector<int> order;
+    std::vector<uint64_t> in_order;
+
+    // Scratch lists
+    std::vector<int> fresh;
+    std::vector<int> merged;
+    std::vector<int> granted;
+
+    internal_router_event** vc_heads;
+    int const* xbar_in_credits;
+    const uint64_t* vc_head_masks;
+    const uint64_t* port_data_mask;
+
+public:
+
+    xbar_arb_lru_mask(ComponentId_t cid, Params& params) :
+        XbarArbitration(cid),
+        cycle(0),
+        vc_heads(NULL),
+        xbar_in_credits(NULL),
+        vc_head_masks(NULL),
+        port_data_mask(NULL)
+    {
+    }
+
+    ~xbar_arb_lru_mask() {
+    }
+
+    void setPorts(int num_ports_s, int num_vcs_s) {
+        num_ports = num_ports_s;
+        num_vcs = num_vcs_s;
+        vc_mask_words = (num_vcs + 63) / 64;
+        total_entries = num_ports * num_vcs;
+
+        // Initial order is by port, then vc, ahead of anything granted
+        key.resize(total_entries);
+        for ( int i = 0; i < total_entries; i++ ) {
+            key[i] = i - total_entries;
+        }
+        in_order.assign(num_ports * vc_mask_words, 0);
+        order.reserve(total_entries);
+        fresh.reserve(total_entries);
+        merged.reserve(total_entries);
+        granted.reserve(num_ports);
+    }
+
+    void setRouterState(internal_router_event** vc_heads_s, int const* xbar_in_credits_s,
+                        const uint64_t* vc_head_masks_s, const uint64_t* port_data_mask_s) {
+        vc_heads = vc_heads_s;
+        xbar_in_credits = xbar_in_credits_s;
+        vc_head_masks = vc_head_masks_s;
+        port_data_mask = port_data_mask_s;
+    }
+
+    // Naming convention is from point of view of the xbar.  So,
+    // in_port_busy is >0 if someone is writing to that xbar port and
+    // out_port_busy is >0 if that xbar port being read.
+    void arbitrate(
+#if VERIFY_DECLOCKING
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc, bool clocking
+#else
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc
+#endif
+                   )
+    {
+        for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
+
+        // Drop entries whose VC has emptied
+        size_t kept = 0;
+        for ( size_t i = 0; i < order.size(); i++ ) {
+            int entry = order[i];
+            int port = entry / num_vcs;
+            int vc = entry - port * num_vcs;
+            int word = port * vc_mask_words + (vc >> 6);
+            uint64_t bit = (uint64_t)1 << (vc & 63);
+            if ( vc_head_masks[word] & bit ) order[kept++] = entry;
+            else in_order[word] &= ~bit;
+        }
+        order.resize(kept);
+
+        // Merge in entries that have gained an event
+        fresh.clear();
+        for ( int word = 0; word < num_ports * vc_mask_words; word++ ) {
+            uint64_t bits = vc_head_masks[word] & ~in_order[word];
+            if ( bits == 0 ) continue;
+            in_order[word] |= bits;
+            int port = word / vc_mask_words;
+            int vc_base = (word - port * vc_mask_words) << 6;
+            for ( ; bits != 0; bits &= bits - 1 ) {
+                fresh.push_back(port * num_vcs + vc_base + __builtin_ctzll(bits));
+            }
+        }
+        if ( !fresh.empty() ) {
+            const int64_t* keys = key.data();
+            auto by_key = [keys](int a, int b) { return keys[a] < keys[b]; };
+            std::sort(fresh.begin(), fresh.end(), by_key);
+            merged.clear();
+            std::merge(order.begin(), order.end(), fresh.begin(), fresh.end(),
+                       std::back_inserter(merged), by_key);
+            order.swap(merged);
+        }
+
+        granted.clear();
+        kept = 0;
+        for ( size_t i = 0; i < order.size(); i++ ) {
+            int entry = order[i];
+            int port = entry / num_vcs;
+
+            if ( in_port_busy[port] > 0 ) {
+                order[kept++] = entry;
+                continue;
+            }
+
+            // Have an event, see if it can be progressed
+            internal_router_event* src_event = vc_heads[entry];
+            int next_port = src_event->getNextPort();
+            int flits = src_event->getFlitCount();
+
+            // We can progress if the next port's input is not
+            // busy and there are enough credits.
+            if ( out_port_busy[next_port] <= 0 &&
+                 xbar_in_credits[next_port * num_vcs + src_event->getVC()] >= flits ) {
+
+                // Tell the router what to move
+                progress_vc[port] = entry - port * num_vcs;
+
+                // Need to set the busy values
+                in_port_busy[port] = flits;
+                out_port_busy[next_port] = flits;
+
+                granted.push_back(entry);
+            }
+            else {
+                order[kept++] = entry;
+                progress_vc[port] = -2;
+            }
+        }
+
+        // Granted entries go to the bottom, the first one granted last
+        for ( int i = granted.size() - 1; i >= 0; i-- ) {
+            int entry = granted[i];
+            key[entry] = cycle * total_entries + (total_entries - 1 - i);
+            order[kept++] = entry;
+        }
+        cycle++;
+        return;
+    }
+
+    void reportSkippedCycles(Cycle_t cycles) {
+    }
+
+    // Nothing changes in a cycle without grants
+    bool canSkipStalledCycles() { return true; }
+
+    void dumpState(std::ostream& stream) {
+        stream << "Arbitration cycles: " << cycle << std::endl;
+    }
+
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_XBAR_ARB_LRU_MASK_H
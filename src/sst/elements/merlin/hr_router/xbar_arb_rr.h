@@ -165,6 +165,18 @@ public:
 #endif
     }
 
+    bool canSkipStalledCycles() { return true; }
+
+    void reportSkippedStalledCycles(Cycle_t cycles, int const* in_port_busy) {
+        // Each skipped cycle would have advanced the VC of every port
+        // that wasn't busy
+        int vc_steps = cycles % num_vcs;
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( in_port_busy[i] <= 0 ) rr_vcs[i] = (rr_vcs[i] + vc_steps) % num_vcs;
+        }
+        rr_port = (rr_port + cycles) % num_ports;
+    }
+
     void dumpState(std::ostream& stream) {
         stream << "Current round robin port: " << rr_port << std::endl;
         stream << "  Current round robin VC by port:" << std::endl;
@@ -0,0 +1,231 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_HR_ROUTER_XBAR_ARB_RR_MASK_H
+#define COMPONENTS_HR_ROUTER_XBAR_ARB_RR_MASK_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+using namespace SST;
+
+namespace SST {
+namespace Merlin {
+
+// Calls func(bit) for each set bit in [from, limit) of a multi-word
+// mask in increasing order, stopping early if func returns true.
+// Returns true if it stopped early.
+template<typename F>
+static inline bool xbar_mask_for_each(const uint64_t* mask, int from, int limit, F func)
+{
+    if ( from >= limit ) return false;
+    int first_word = from >> 6;
+    int last_word = (limit - 1) >> 6;
+    for ( int word = first_word; word <= last_word; word++ ) {
+        uint64_t bits = mask[word];
+        if ( word == first_word ) bits &= ~(uint64_t)0 << (from & 63);
+        if ( word == last_word && (limit & 63) != 0 ) bits &= ((uint64_t)1 << (limit & 63)) - 1;
+        while ( bits != 0 ) {
+            if ( func((word << 6) + __builtin_ctzll(bits)) ) return true;
+            bits &= bits - 1;
+        }
+    }
+    return false;
+}
+
+// Makes the same grants as xbar_arb_rr, but only visits ports and VCs
+// that have an event waiting.  The router keeps the masks of occupied
+// VCs up to date as events reach and leave the VC heads, and credits
+// are read directly from the router's array rather than through each
+// PortControl.  Round robin order over the set bits is found with
+// find-first-set starting at the round robin pointer, then wrapping.
+class xbar_arb_rr_mask : public XbarArbitration {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        xbar_arb_rr_mask,
+        "merlin",
+        "xbar_arb_rr_mask",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Round robin arbitration unit for hr_router using occupancy bit masks.  Grants match xbar_arb_rr",
+        SST::Merlin::XbarArbitration)
+
+
+private:
+    int num_ports;
+    int num_vcs;
+    int vc_mask_words;
+
+    std::vector<int> rr_vcs;
+    int rr_port;
+
+#if VERIFY_DECLOCKING
+    int rr_port_shadow;
+#endif
+
+    internal_router_event** vc_heads;
+    int const* xbar_in_credits;
+    const uint64_t* vc_head_masks;
+    const uint64_t* port_data_mask;
+
+public:
+
+    xbar_arb_rr_mask(ComponentId_t cid, Params& params) :
+        XbarArbitration(cid),
+        vc_heads(NULL),
+        xbar_in_credits(NULL),
+        vc_head_masks(NULL),
+        port_data_mask(NULL)
+    {
+    }
+
+    ~xbar_arb_rr_mask() {
+    }
+
+    void setPorts(int num_ports_s, int num_vcs_s) {
+        num_ports = num_ports_s;
+        num_vcs = num_vcs_s;
+        vc_mask_words = (num_vcs + 63) / 64;
+
+        rr_vcs.assign(num_ports, 0);
+
+        rr_port = 0;
+#if VERIFY_DECLOCKING
+        rr_port_shadow = 0;
+#endif
+    }
+
+    void setRouterState(internal_router_event** vc_heads_s, int const* xbar_in_credits_s,
+                        const uint64_t* vc_head_masks_s, const uint64_t* port_data_mask_s) {
+        vc_heads = vc_heads_s;
+        xbar_in_credits = xbar_in_credits_s;
+        vc_head_masks = vc_head_masks_s;
+        port_data_mask = port_data_mask_s;
+    }
+
+    // Naming convention is from point of view of the xbar.  So,
+    // in_port_busy is >0 if someone is writing to that xbar port and
+    // out_port_busy is >0 if that xbar port being read.
+    void arbitrate(
+#if VERIFY_DECLOCKING
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc, bool clocking
+#else
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc
+#endif
+                   )
+    {
+        for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
+
+        // Ports with data in round robin order: [rr_port, num_ports)
+        // then [0, rr_port)
+        auto visit = [&](int port) {
+            if ( in_port_busy[port] <= 0 ) arbitratePort(port, in_port_busy, out_port_busy, progress_vc);
+            return false;
+        };
+        xbar_mask_for_each(port_data_mask, rr_port, num_ports, visit);
+        xbar_mask_for_each(port_data_mask, 0, rr_port, visit);
+
+        // Every port that wasn't busy moves on to the next VC,
+        // whether or not it was granted
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( in_port_busy[i] <= 0 || progress_vc[i] >= 0 ) {
+                rr_vcs[i] = (rr_vcs[i] + 1) % num_vcs;
+            }
+        }
+        rr_port = (rr_port + 1) % num_ports;
+
+#if VERIFY_DECLOCKING
+        if ( clocking ) {
+            rr_port_shadow = rr_port;
+        }
+#endif
+
+        return;
+    }
+
+    void reportSkippedCycles(Cycle_t cycles) {
+#if VERIFY_DECLOCKING
+        rr_port_shadow = (rr_port_shadow + cycles) % num_ports;
+        if ( rr_port_shadow != rr_port ) std::cout << "  PROBLEM:  rr_port = "
+                         << rr_port << ", rr_port_shadow = " << rr_port_shadow <<
+                         ", cycles = " << cycles << std::endl;
+#else
+        rr_port = (rr_port + cycles) % num_ports;
+#endif
+    }
+
+    bool canSkipStalledCycles() { return true; }
+
+    void reportSkippedStalledCycles(Cycle_t cycles, int const* in_port_busy) {
+        // Each skipped cycle would have advanced the VC of every port
+        // that wasn't busy
+        int vc_steps = cycles % num_vcs;
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( in_port_busy[i] <= 0 ) rr_vcs[i] = (rr_vcs[i] + vc_steps) % num_vcs;
+        }
+        rr_port = (rr_port + cycles) % num_ports;
+    }
+
+    void dumpState(std::ostream& stream) {
+        stream << "Current round robin port: " << rr_port << std::endl;
+        stream << "  Current round robin VC by port:" << std::endl;
+        for ( int i = 0; i < num_ports; i++ ) {
+            stream << i << ": " << rr_vcs[i] << std::endl;
+        }
+    }
+
+private:
+
+    // Grant the first occupied VC at or after rr_vcs[port] whose
+    // destination is free and has the credits
+    void arbitratePort(int port, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        const uint64_t* vc_mask = &vc_head_masks[port * vc_mask_words];
+        internal_router_event** heads = &vc_heads[port * num_vcs];
+        int start = rr_vcs[port];
+
+        auto grant = [&](int vc) {
+            internal_router_event* src_event = heads[vc];
+            int next_port = src_event->getNextPort();
+            if ( out_port_busy[next_port] > 0 ) return false;
+
+            int flits = src_event->getFlitCount();
+            if ( xbar_in_credits[next_port * num_vcs + src_event->getVC()] < flits ) return false;
+
+            // Tell the router what to move
+            progress_vc[port] = vc;
+
+            // Need to set the busy values
+            in_port_busy[port] = flits;
+            out_port_busy[next_port] = flits;
+            return true;
+        };
+        if ( xbar_mask_for_each(vc_mask, start, num_vcs, grant) ) return;
+        xbar_mask_for_each(vc_mask, 0, start, grant);
+    }
+
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_XBAR_ARB_RR_MASK_H
@@ -0,0 +1,290 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "sketchInspector.h"
+
+#include <sst/core/simulation.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace SST {
+namespace Merlin {
+
+// Record tags
+enum {
+    SKETCH_LINK_NAME = 1,    // link id, name length, name bytes
+    SKETCH_LINK_WINDOW = 2,  // link id, window, packets, bits
+    SKETCH_LATENCY = 3       // window, cell count, (cell index delta, count)...
+};
+
+SST::Core::ThreadSafe::Spinlock SketchNetworkInspector::mapLock;
+SketchNetworkInspector::streamMap_t SketchNetworkInspector::streamMap;
+
+SketchNetworkInspector::SketchNetworkInspector(ComponentId_t id, Params &params, const std::string& sub_id) :
+    TimedNetworkInspector(id),
+    link_window(0),
+    link_packets(0),
+    link_bits(0)
+{
+    Output& output = Simulation::getSimulation()->getSimulationOutput();
+
+    string filename = params.find<string>("output_file", "network_sketch.bin");
+    if ( Simulation::getSimulation()->getNumRanks().rank > 1 ) {
+        filename = filename + "." + to_string(Simulation::getSimulation()->getRank().rank);
+    }
+
+    // Router name is everything before the first :
+    string fullname = getName();
+    size_t index = fullname.find(":");
+    string link_name = index == string::npos ? fullname : fullname.substr(0,index);
+    link_name = link_name + ":" + params.find<string>("port_name", sub_id);
+
+    mapLock.lock();
+
+    streamMap_t::iterator iter = streamMap.find(filename);
+    if ( iter == streamMap.end() ) {
+        // First inspector for this file, set up the stream
+        stream = new Stream();
+
+        UnitAlgebra window = params.find<UnitAlgebra>("window", "1us");
+        if ( !window.hasUnits("s") ) {
+            output.fatal(CALL_INFO, -1, "sketch_network_inspector: window must be specified in units of s\n");
+        }
+        stream->window_ns = (window / UnitAlgebra("1ns")).getRoundedValue();
+        stream->group_size = params.find<int>("group_size", 1);
+        stream->num_groups = params.find<int>("num_groups", 64);
+        stream->width = params.find<int>("sketch_width", 4096);
+        stream->depth = params.find<int>("sketch_depth", 2);
+        stream->bins = params.find<int>("latency_bins", 32);
+        stream->buffer_size = params.find<size_t>("buffer_size", 1048576);
+
+        if ( stream->window_ns == 0 || stream->group_size < 1 || stream->num_groups < 1 ||
+             stream->width < 1 || stream->depth < 1 || stream->bins < 2 || stream->bins > 65 ) {
+            output.fatal(CALL_INFO, -1, "sketch_network_inspector: invalid parameters (window, group_size, num_groups, "
+                         "sketch_width and sketch_depth must be positive and latency_bins between 2 and 65)\n");
+        }
+
+        // If every group pair fits in a single row, index directly
+        uint64_t pairs = (uint64_t)stream->num_groups * stream->num_groups;
+        stream->exact = pairs <= (uint64_t)stream->width;
+        if ( stream->exact ) {
+            stream->width = pairs;
+            stream->depth = 1;
+        }
+
+        stream->cells.assign((size_t)stream->width * stream->depth * stream->bins, 0);
+        stream->window = 0;
+        stream->next_link_id = 0;
+        stream->active = 0;
+
+        stream->fp = fopen(filename.c_str(), "wb");
+        if ( stream->fp == NULL ) {
+            output.fatal(CALL_INFO, -1, "sketch_network_inspector: unable to open %s for writing\n", filename.c_str());
+        }
+
+        const char magic[4] = { 'M', 'S', 'K', '1' };
+        stream->buffer.insert(stream->buffer.end(), magic, magic + 4);
+        stream->putVarint(stream->window_ns);
+        stream->putVarint(stream->group_size);
+        stream->putVarint(stream->num_groups);
+        stream->putVarint(stream->width);
+        stream->putVarint(stream->depth);
+        stream->putVarint(stream->bins);
+        stream->putVarint(stream->exact);
+
+        streamMap[filename] = stream;
+    }
+    else {
+        stream = iter->second;
+    }
+    stream->active++;
+
+    mapLock.unlock();
+
+    stream->lock.lock();
+    link_id = stream->next_link_id++;
+    stream->putVarint(SKETCH_LINK_NAME);
+    stream->putVarint(link_id);
+    stream->putVarint(link_name.size());
+    stream->buffer.insert(stream->buffer.end(), link_name.begin(), link_name.end());
+    stream->lock.unlock();
+}
+
+
+void
+SketchNetworkInspector::inspectNetworkData(SimpleNetwork::Request* req)
+{
+    // Without timing information only link utilization is tracked
+    uint64_t window = getCurrentSimTimeNano() / stream->window_ns;
+    if ( window != link_window ) endLinkWindow();
+    link_window = window;
+    link_packets++;
+    link_bits += req->size_in_bits;
+}
+
+
+void
+SketchNetworkInspector::inspectTimedNetworkData(SimpleNetwork::Request* req, SimTime_t injection_time, bool ejection)
+{
+    SimTime_t now = getCurrentSimTimeNano();
+    uint64_t window = now / stream->window_ns;
+    if ( window != link_window ) endLinkWindow();
+    link_window = window;
+    link_packets++;
+    link_bits += req->size_in_bits;
+
+    if ( !ejection ) return;
+
+    uint64_t src_group = std::min<uint64_t>(req->src / stream->group_size, stream->num_groups - 1);
+    uint64_t dest_group = std::min<uint64_t>(req->dest / stream->group_size, stream->num_groups - 1);
+
+    stream->lock.lock();
+    // In multithreaded runs another thread may already have moved the
+    // shared window on; the sample then counts toward the newer window.
+    if ( window > stream->window ) {
+        stream->closeWindow();
+        stream->window = window;
+    }
+    stream->recordLatency(src_group * stream->num_groups + dest_group, now - injection_time);
+    stream->flush(false);
+    stream->lock.unlock();
+}
+
+
+void
+SketchNetworkInspector::endLinkWindow()
+{
+    if ( link_packets == 0 ) return;
+
+    stream->lock.lock();
+    stream->putVarint(SKETCH_LINK_WINDOW);
+    stream->putVarint(link_id);
+    stream->putVarint(link_window);
+    stream->putVarint(link_packets);
+    stream->putVarint(link_bits);
+    stream->flush(false);
+    stream->lock.unlock();
+
+    link_packets = 0;
+    link_bits = 0;
+}
+
+
+void
+SketchNetworkInspector::finish()
+{
+    endLinkWindow();
+
+    // The last inspector on a stream writes out what is left and
+    // closes the file
+    mapLock.lock();
+    stream->lock.lock();
+    bool last = --stream->active == 0;
+    if ( last ) {
+        stream->closeWindow();
+        stream->flush(true);
+        fclose(stream->fp);
+    }
+    stream->lock.unlock();
+
+    if ( last ) {
+        for ( streamMap_t::iterator iter = streamMap.begin(); iter != streamMap.end(); ++iter ) {
+            if ( iter->second == stream ) {
+                streamMap.erase(iter);
+                break;
+            }
+        }
+        delete stream;
+    }
+    stream = NULL;
+    mapLock.unlock();
+}
+
+
+void
+SketchNetworkInspector::Stream::putVarint(uint64_t value)
+{
+    while ( value >= 0x80 ) {
+        buffer.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((uint8_t)value);
+}
+
+
+void
+SketchNetworkInspector::Stream::recordLatency(uint64_t pair, SimTime_t latency)
+{
+    // Bin 0 holds zero latency, bin b holds [2^(b-1), 2^b) ns and the
+    // last bin holds everything beyond
+    int bin = latency == 0 ? 0 : 64 - __builtin_clzll(latency);
+    if ( bin >= bins ) bin = bins - 1;
+
+    for ( int row = 0; row < depth; ++row ) {
+        uint64_t col;
+        if ( exact ) {
+            col = pair;
+        }
+        else {
+            // splitmix64 finalizer, seeded differently for each row
+            uint64_t hash = pair + (row + 1) * 0x9E3779B97F4A7C15ULL;
+            hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+            hash = hash ^ (hash >> 31);
+            col = hash % width;
+        }
+        uint32_t cell = ((uint32_t)row * width + col) * bins + bin;
+        if ( cells[cell]++ == 0 ) touched.push_back(cell);
+    }
+}
+
+
+void
+SketchNetworkInspector::Stream::closeWindow()
+{
+    if ( touched.empty() ) return;
+
+    std::sort(touched.begin(), touched.end());
+
+    putVarint(SKETCH_LATENCY);
+    putVarint(window);
+    putVarint(touched.size());
+    uint32_t prev = 0;
+    for ( uint32_t cell : touched ) {
+        putVarint(cell - prev);
+        putVarint(cells[cell]);
+        cells[cell] = 0;
+        prev = cell;
+    }
+    touched.clear();
+}
+
+
+void
+SketchNetworkInspector::Stream::flush(bool force)
+{
+    if ( buffer.empty() || (!force && buffer.size() < buffer_size) ) return;
+    fwrite(buffer.data(), 1, buffer.size(), fp);
+    buffer.clear();
+}
+
+} // namespace Merlin
+} // namespace SST
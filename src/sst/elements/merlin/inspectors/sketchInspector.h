@@ -0,0 +1,137 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_SKETCHINSPECTOR_H
+#define COMPONENTS_MERLIN_SKETCHINSPECTOR_H
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/interfaces/simpleNetwork.h>
+#include <sst/core/threadsafe.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sst/elements/merlin/inspectors/timedInspector.h"
+
+namespace SST {
+using namespace SST::Interfaces;
+namespace Merlin {
+
+/*
+ * Streams link utilization and group to group latency histograms to a
+ * compact binary file, one record set per time window.
+ *
+ * Every port the inspector is loaded on accumulates packets and bits
+ * sent during the current window and appends them to the stream when
+ * the window changes.  Ports connected to endpoints additionally add
+ * each delivered packet's latency to a histogram for its (source
+ * group, destination group) pair.  The histograms live in a fixed
+ * size table shared by every inspector writing to the same file.  If
+ * all group pairs fit in the table it is indexed directly, otherwise
+ * it is used as a count-min sketch with sketch_depth hashed rows, so
+ * memory does not grow with the size of the network or the length of
+ * the run.  Only the non-zero cells of a window are written, and the
+ * write buffer is flushed to disk whenever it reaches buffer_size.
+ *
+ * All integers in the file are unsigned LEB128 varints.  See
+ * sketchToMatrix.py for a description of the format and for
+ * converting it into CSV matrices.
+ */
+class SketchNetworkInspector : public TimedNetworkInspector {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        SketchNetworkInspector,
+        "merlin",
+        "sketch_network_inspector",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Streams per window link utilization and group to group latency histograms to a binary file",
+        SST::Interfaces::SimpleNetwork::NetworkInspector)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"output_file",   "Name of the output file.  In multi-rank runs the rank is appended.", "network_sketch.bin"},
+        {"window",        "Length of a time window.", "1us"},
+        {"group_size",    "Number of consecutive endpoint ids in a latency group.", "1"},
+        {"num_groups",    "Number of latency groups.  Endpoints past the last group are counted in the last group.", "64"},
+        {"sketch_width",  "Number of histograms per row of the latency table.", "4096"},
+        {"sketch_depth",  "Number of hashed rows used when the group pairs don't fit in one row.", "2"},
+        {"latency_bins",  "Number of log2 latency bins per histogram.", "32"},
+        {"buffer_size",   "Size in bytes the write buffer can reach before it is written to the file.", "1048576"}
+    )
+
+    SketchNetworkInspector(ComponentId_t id, Params& params, const std::string& sub_id);
+    ~SketchNetworkInspector() {}
+
+    void finish();
+
+    void inspectNetworkData(SimpleNetwork::Request* req);
+    void inspectTimedNetworkData(SimpleNetwork::Request* req, SimTime_t injection_time, bool ejection);
+
+private:
+
+    // State shared by all inspectors writing the same file.  Only
+    // accessed while holding lock.
+    struct Stream {
+        FILE* fp;
+        std::vector<uint8_t> buffer;
+        size_t buffer_size;
+
+        SimTime_t window_ns;
+        int group_size;
+        int num_groups;
+        int width;
+        int depth;
+        int bins;
+        bool exact;
+
+        uint64_t window;
+        std::vector<uint32_t> cells;
+        std::vector<uint32_t> touched;
+
+        uint32_t next_link_id;
+        int active;
+
+        SST::Core::ThreadSafe::Spinlock lock;
+
+        void putVarint(uint64_t value);
+        void recordLatency(uint64_t pair, SimTime_t latency);
+        void closeWindow();
+        void flush(bool force);
+    };
+
+    void endLinkWindow();
+
+    Stream* stream;
+    uint32_t link_id;
+
+    uint64_t link_window;
+    uint64_t link_packets;
+    uint64_t link_bits;
+
+    typedef std::map<std::string, Stream*> streamMap_t;
+    static streamMap_t streamMap;
+    static SST::Core::ThreadSafe::Spinlock mapLock;
+};
+
+} // namespace Merlin
+} // namespace SST
+#endif
@@ -0,0 +1,51 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TIMEDINSPECTOR_H
+#define COMPONENTS_MERLIN_TIMEDINSPECTOR_H
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/interfaces/simpleNetwork.h>
+
+namespace SST {
+using namespace SST::Interfaces;
+namespace Merlin {
+
+/*
+ * NetworkInspector that also wants to know when the packet entered
+ * the network.  The Request alone does not carry that information,
+ * so PortControl checks each inspector it loads for this interface
+ * and, if present, calls inspectTimedNetworkData() instead of
+ * inspectNetworkData().
+ */
+class TimedNetworkInspector : public SimpleNetwork::NetworkInspector {
+public:
+    TimedNetworkInspector(ComponentId_t id) :
+        SimpleNetwork::NetworkInspector(id)
+    {}
+
+    virtual ~TimedNetworkInspector() {}
+
+    // injection_time is in ns.  ejection is true when the port the
+    // packet is leaving on is connected to an endpoint.
+    virtual void inspectTimedNetworkData(SimpleNetwork::Request* req, SimTime_t injection_time, bool ejection) = 0;
+};
+
+} // namespace Merlin
+} // namespace SST
+#endif
@@ -548,7 +548,7 @@ void LinkControl::handle_input(Event* ev)
     BaseRtrEvent* base_event = static_cast<BaseRtrEvent*>(ev);
     if ( base_event->getType() == BaseRtrEvent::CREDIT ) {
     	credit_event* ce = static_cast<credit_event*>(ev);
-        router_credits[ce->vc] += ce->credits;
+        ce->forEachCredit([this](int vc, int credits) { router_credits[vc] += credits; });
         delete ev;
 
         // If we're waiting, we need to send a wakeup event to the
@@ -121,7 +121,7 @@ PortControl::recv(int vc)
 	// Need to update vc_heads
 	if ( input_buf[vc].empty() ) {
 	    vc_heads[vc] = NULL;
-	    parent->dec_vcs_with_data();
+	    parent->dec_vcs_with_data(port_number, vc);
 	}
 	else {
         auto event = input_buf[vc].front();
@@ -136,8 +136,16 @@ PortControl::recv(int vc)
 	// For now, we're just going to send the credits back to the
 	// other side.  The required BW to do this will not be taken
 	// into account.
-	port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return]));
-	port_ret_credits[vc_return] = 0;
+	if ( credit_batch == 0 ) {
+	    port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return]));
+	    port_ret_credits[vc_return] = 0;
+	}
+	else if ( !credit_flush_pending ) {
+	    // Credits for all VCs are returned together at the end of
+	    // the batch window
+	    credit_timing->send(credit_batch,NULL);
+	    credit_flush_pending = true;
+	}
 
 #if TRACK
     if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
@@ -237,6 +245,9 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     output_buf_count(NULL),
     port_ret_credits(NULL),
     port_out_credits(NULL),
+    credit_timing(NULL),
+    credit_batch(0),
+    credit_flush_pending(false),
     idle_start(0),
 	sai_win_start(0),
 	sai_port_disabled(false),
@@ -368,6 +379,13 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
         port_link->addRecvLatency(1,input_latency_timebase);
     }
 
+    credit_batch = params.find<int>("credit_batch",0);
+    if ( credit_batch > 0 ) {
+        // Will get the flit cycle time base once link BW is known
+        credit_timing = configureSelfLink(link_port_name + "_credit_timing", "1GHz",
+                                          new Event::Handler<PortControl>(this,&PortControl::handle_credit_flush));
+    }
+
     enable_congestion_management = params.find<bool>("enable_congestion_management","false");
 
     found = false;
@@ -427,15 +445,18 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     std::vector<std::string> inspector_names;
     params.find_array<std::string>("network_inspectors",inspector_names);
 
-    // Create any NetworkInspectors
+    // Create any NetworkInspectors.  They all get the inspector.*
+    // params, plus the name of the port they are on.
+    Params inspector_params = params.get_scoped_params("inspector");
+    inspector_params.insert("port_name", link_port_name);
     for ( unsigned int i = 0; i < inspector_names.size(); i++ ) {
-        Params empty;
         SimpleNetwork::NetworkInspector* ni = loadAnonymousSubComponent<SimpleNetwork::NetworkInspector>
-            (inspector_names[i], "inspector_slot", i, ComponentInfo::INSERT_STATS, empty, port_name);
+            (inspector_names[i], "inspector_slot", i, ComponentInfo::INSERT_STATS, inspector_params, port_name);
         if ( ni == NULL ) {
             merlin_abort.fatal(CALL_INFO,1,"NetworkInspector: %s, not found.\n",inspector_names[i].c_str());
         }
         network_inspectors.push_back(ni);
+        timed_inspectors.push_back(dynamic_cast<TimedNetworkInspector*>(ni));
     }
 
     dlink_thresh = params.find<float>("dlink_thresh",-1.0);
@@ -672,6 +693,7 @@ PortControl::init(unsigned int phase) {
         UnitAlgebra link_clock = link_bw / flit_size;
         flit_cycle = getTimeConverter(link_clock);
         output_timing->setDefaultTimeBase(flit_cycle);
+        if ( credit_timing != NULL ) credit_timing->setDefaultTimeBase(flit_cycle);
         delete ev;
 
         // Get initialization event from endpoint, but only if I am a host port
@@ -924,18 +946,20 @@ PortControl::handle_input_n2r(Event* ev)
 	case BaseRtrEvent::CREDIT:
     {
 	    credit_event* ce = static_cast<credit_event*>(ev);
-	    port_out_credits[ce->vc] += ce->credits;
+	    ce->forEachCredit([this](int vc, int credits) {
+            port_out_credits[vc] += credits;
 
-        if ( oql_track_remote ) {
-            if ( oql_track_port ) {
-                for ( int i = 0; i < num_vcs; ++i ) {
-                    output_queue_lengths[i] -= ce->credits;
+            if ( oql_track_remote ) {
+                if ( oql_track_port ) {
+                    for ( int i = 0; i < num_vcs; ++i ) {
+                        output_queue_lengths[i] -= credits;
+                    }
+                }
+                else {
+                    output_queue_lengths[vc] -= credits;
                 }
             }
-            else {
-                output_queue_lengths[ce->vc] -= ce->credits;
-            }
-        }
+        });
 
         delete ce;
 
@@ -972,7 +996,7 @@ PortControl::handle_input_n2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, rtr_event->getVC(), rtr_event);
             vc_heads[curr_vc] = rtr_event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number, curr_vc);
 	    }
 
 	    if ( event->getTraceType() != SST::Interfaces::SimpleNetwork::Request::NONE ) {
@@ -1019,7 +1043,7 @@ PortControl::handle_input_r2r(Event* ev)
 	case BaseRtrEvent::CREDIT:
 	{
 	    credit_event* ce = static_cast<credit_event*>(ev);
-	    port_out_credits[ce->vc] += ce->credits;
+	    ce->forEachCredit([this](int vc, int credits) { port_out_credits[vc] += credits; });
 	    delete ce;
 
 	    // If we're waiting, we need to send a wakeup event to the
@@ -1055,7 +1079,7 @@ PortControl::handle_input_r2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, event->getVC(), event);
             vc_heads[curr_vc] = event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number, curr_vc);
 	    }
 
 	    if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
@@ -1087,6 +1111,22 @@ PortControl::handle_input_r2r(Event* ev)
 #endif
 }
 
+void
+PortControl::handle_credit_flush(Event* ev) {
+    // One event per MAX_BATCH_VCS VCs, skipping groups with nothing
+    // to return
+    for ( int base = 0; base < num_vcs; base += credit_event::MAX_BATCH_VCS ) {
+        int count = num_vcs - base < credit_event::MAX_BATCH_VCS ? num_vcs - base : credit_event::MAX_BATCH_VCS;
+        bool pending = false;
+        for ( int i = base; i < base + count; i++ ) pending |= port_ret_credits[i] != 0;
+        if ( !pending ) continue;
+
+        port_link->send(1,new credit_event(base, count, &port_ret_credits[base]));
+        for ( int i = base; i < base + count; i++ ) port_ret_credits[i] = 0;
+    }
+    credit_flush_pending = false;
+}
+
 void
 PortControl::handle_output(Event* ev) {
 #if TRACK
@@ -1125,6 +1165,7 @@ PortControl::handle_output(Event* ev) {
 	    // Need to return credits to the output buffer
 	    int size = send_event->getFlitCount();
 	    xbar_in_credits[vc_to_send] += size;
+	    if ( parent->getRequestNotifyOnCredit() ) parent->notifyEvent();
         if ( !oql_track_remote ) {
             if ( oql_track_port ) {
                 for ( int i = 0; i < num_vcs; ++i ) {
@@ -1164,7 +1205,14 @@ PortControl::handle_output(Event* ev) {
 
         // Send the request to all the registered NetworkInspectors
         for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
-            network_inspectors[i]->inspectNetworkData(send_event->inspectRequest());
+            if ( timed_inspectors[i] ) {
+                timed_inspectors[i]->inspectTimedNetworkData(send_event->inspectRequest(),
+                                                             send_event->getEncapsulatedEvent()->getInjectionTime(),
+                                                             host_port);
+            }
+            else {
+                network_inspectors[i]->inspectNetworkData(send_event->inspectRequest());
+            }
         }
 
 	    if ( host_port ) {
@@ -32,6 +32,7 @@
 #include <cstring>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/inspectors/timedInspector.h"
 
 using namespace SST;
 
@@ -62,6 +63,7 @@ public:
         {"input_buf_size",     "Size of input buffers specified in b or B (can include SI prefix)."},
         {"output_buf_size",    "Size of output buffers specified in b or B (can include SI prefix)."},
         {"network_inspectors", "Comma separated list of network inspectors to put on output ports.", ""},
+        {"inspector.*",        "Parameters passed to each of the network inspectors.", ""},
         {"dlink_thresh",       ""},
         {"num_vns",            "Number of VNs set in router or python file (-1 if not set in the parent router)."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
@@ -73,7 +75,9 @@ public:
         {"enable_congestion_management", "Turn on congestion management","false"},
         {"cm_outstanding_threshold", "Threshold for the amount of data outstanding to a host before congestion management can trigger","2*output_buf_size"},
         {"cm_pktsize_threshold", "Minimum size of a packet to be considered part of a stream with regards to congestion management","128B"},
-        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"}
+        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"},
+        {"credit_batch",       "If greater than zero, credits are returned for up to 16 VCs per event at most once every credit_batch flit cycles "
+                               "instead of once per packet.","0"}
     )
 
     // SST_ELI_DOCUMENT_STATISTICS(
@@ -185,6 +189,11 @@ private:
     int* port_ret_credits;
     int* port_out_credits;
 
+    // Self link used to return batched credits
+    Link* credit_timing;
+    int credit_batch;
+    bool credit_flush_pending;
+
     // Represents the start of when a port was idle
     // If the buffer was empty we instantiate this to the current time
     SimTime_t idle_start;
@@ -348,6 +357,8 @@ public:
 private:
 
     std::vector<SST::Interfaces::SimpleNetwork::NetworkInspector*> network_inspectors;
+    // Entry is NULL for inspectors that aren't TimedNetworkInspectors
+    std::vector<TimedNetworkInspector*> timed_inspectors;
 
     void dumpQueueState(port_queue_t& q, std::ostream& stream);
     void dumpQueueState(port_queue_t& q, Output& out);
@@ -355,6 +366,7 @@ private:
     void handle_input_n2r(Event* ev);
     void handle_input_r2r(Event* ev);
     void handle_output(Event* ev);
+    void handle_credit_flush(Event* ev);
     void handle_failed(Event* ev);
     void handleSAIWindow(Event* ev);
     void reenablePort(Event* ev);
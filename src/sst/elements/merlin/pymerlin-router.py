@@ -23,10 +23,13 @@ class hr_router(RouterTemplate):
     def __init__(self):
         RouterTemplate.__init__(self)
         self._declareParams("params",["link_bw","flit_size","xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size",
-                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
+                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm",
+                                      "event_driven"])
 
         self._declareParams("params",["qos_settings"],"portcontrol.arbitration.")
-        self._declareParams("params",["output_arb"],"portcontrol.")
+        self._declareParams("params",["output_arb", "credit_batch"],"portcontrol.")
+        self._declareParams("params",["inspector.output_file","inspector.window","inspector.group_size","inspector.num_groups",
+                                      "inspector.sketch_width","inspector.sketch_depth","inspector.latency_bins","inspector.buffer_size"],"portcontrol.")
 
         self._setCallbackOnWrite("qos_settings",self._qos_callback)
         self._subscribeToPlatformParamSet("router")
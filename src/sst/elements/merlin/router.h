@@ -28,6 +28,9 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
+
+#include "sst/elements/merlin/eventPool.h"
 
 namespace SST {
 namespace Merlin {
@@ -43,29 +46,64 @@ class internal_router_event;
 class Router : public Component {
 private:
     bool requestNotifyOnEvent;
+    bool requestNotifyOnCredit;
 
 protected:
     inline void setRequestNotifyOnEvent(bool state)
     { requestNotifyOnEvent = state; }
 
+    inline void setRequestNotifyOnCredit(bool state)
+    { requestNotifyOnCredit = state; }
+
     int vcs_with_data;
 
+    // Bit masks of the VCs that have an event at their head.  Only
+    // kept once initVCHeadMasks() has been called.  vc_head_masks
+    // has vc_mask_words words per port; port_data_mask has one bit
+    // per port that has any VC set.
+    std::vector<uint64_t> vc_head_masks;
+    std::vector<uint64_t> port_data_mask;
+    int vc_mask_words;
+
+    void initVCHeadMasks(int num_ports, int num_vcs) {
+        vc_mask_words = (num_vcs + 63) / 64;
+        vc_head_masks.assign(num_ports * vc_mask_words, 0);
+        port_data_mask.assign((num_ports + 63) / 64, 0);
+    }
+
 public:
 
     Router(ComponentId_t id) :
         Component(id),
         requestNotifyOnEvent(false),
-        vcs_with_data(0)
+        requestNotifyOnCredit(false),
+        vcs_with_data(0),
+        vc_mask_words(0)
     {}
 
     virtual ~Router() {}
 
     inline bool getRequestNotifyOnEvent() { return requestNotifyOnEvent; }
+    inline bool getRequestNotifyOnCredit() { return requestNotifyOnCredit; }
 
     virtual void notifyEvent() {}
 
-    inline void inc_vcs_with_data() { vcs_with_data++; }
-    inline void dec_vcs_with_data() { vcs_with_data--; }
+    inline void inc_vcs_with_data(int port, int vc) {
+        vcs_with_data++;
+        if ( vc_mask_words == 0 ) return;
+        vc_head_masks[port * vc_mask_words + (vc >> 6)] |= (uint64_t)1 << (vc & 63);
+        port_data_mask[port >> 6] |= (uint64_t)1 << (port & 63);
+    }
+    inline void dec_vcs_with_data(int port, int vc) {
+        vcs_with_data--;
+        if ( vc_mask_words == 0 ) return;
+        uint64_t* masks = &vc_head_masks[port * vc_mask_words];
+        masks[vc >> 6] &= ~((uint64_t)1 << (vc & 63));
+        for ( int i = 0; i < vc_mask_words; i++ ) {
+            if ( masks[i] != 0 ) return;
+        }
+        port_data_mask[port >> 6] &= ~((uint64_t)1 << (port & 63));
+    }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
     virtual int const* getOutputBufferCredits() = 0;
@@ -86,6 +124,10 @@ public:
 
     inline RtrEventType getType() const { return type; }
 
+    // Router events are allocated from thread-local pools
+    static void* operator new(std::size_t size) { return RtrEventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { RtrEventPool::release(ptr, size); }
+
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
         Event::serialize_order(ser);
         ser & type;
@@ -340,8 +382,19 @@ public:
 
 class credit_event : public BaseRtrEvent {
 public:
+    // vc value used for events that return credits for several VCs
+    static const int BATCH = -1;
+    // Most VCs a single batched event carries credits for
+    static const int MAX_BATCH_VCS = 16;
+
     int vc;
     int credits;
+    // Credits for VCs batch_base to batch_base + num_batch - 1, only
+    // used when vc is BATCH.  Kept inline so a batched return costs
+    // no more allocations than a single one.
+    int batch_base;
+    int num_batch;
+    int batch[MAX_BATCH_VCS];
 
     credit_event() :
 	BaseRtrEvent(BaseRtrEvent::CREDIT)
@@ -353,6 +406,31 @@ public:
 	credits(credits)
     {}
 
+    // Creates a batched credit return for num_vcs VCs starting at
+    // base, num_vcs must be at most MAX_BATCH_VCS
+    credit_event(int base, int num_vcs, int* vc_credits) :
+	BaseRtrEvent(BaseRtrEvent::CREDIT),
+	vc(BATCH),
+	credits(0),
+	batch_base(base),
+	num_batch(num_vcs)
+    {
+        for ( int i = 0; i < num_vcs; ++i ) batch[i] = vc_credits[i];
+    }
+
+    // Calls func(vc, credits) for every VC this event returns
+    // credits for
+    template <typename F>
+    inline void forEachCredit(F func) const {
+        if ( vc != BATCH ) {
+            func(vc, credits);
+            return;
+        }
+        for ( int i = 0; i < num_batch; ++i ) {
+            if ( batch[i] != 0 ) func(batch_base + i, batch[i]);
+        }
+    }
+
     virtual void print(const std::string& header, Output &out) const  override {
         out.output("%s credit_event to be delivered at %" PRIu64 " with priority %d\n",
                 header.c_str(), getDeliveryTime(), getPriority());
@@ -362,6 +440,11 @@ public:
         BaseRtrEvent::serialize_order(ser);
         ser & vc;
         ser & credits;
+        if ( vc == BATCH ) {
+            ser & batch_base;
+            ser & num_batch;
+            for ( int i = 0; i < num_batch; ++i ) ser & batch[i];
+        }
     }
 
 private:
@@ -646,8 +729,23 @@ public:
     virtual void arbitrate(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc) = 0;
 #endif
     virtual void setPorts(int num_ports, int num_vcs) = 0;
+    // Optional view of the router's state for arbiters that work from
+    // bit masks rather than polling every port.  vc_heads and
+    // xbar_in_credits are indexed by port * num_vcs + vc, masks are as
+    // kept by Router.  Called after setPorts().
+    virtual void setRouterState(internal_router_event** vc_heads, int const* xbar_in_credits,
+                                const uint64_t* vc_head_masks, const uint64_t* port_data_mask) {}
     virtual bool isOkayToPauseClock() { return true; }
     virtual void reportSkippedCycles(Cycle_t cycles) {};
+    // Used by the router's event driven mode.  After an arbitration
+    // that granted nothing, the router may skip cycles until a busy
+    // port frees up, credits return or a new event reaches a VC head,
+    // since nothing could be granted before then.  Arbiters whose
+    // state changes in cycles without grants must be able to account
+    // for the skipped cycles in reportSkippedStalledCycles().
+    // in_port_busy is as it was through all of the skipped cycles.
+    virtual bool canSkipStalledCycles() { return false; }
+    virtual void reportSkippedStalledCycles(Cycle_t cycles, int const* in_port_busy) {};
     virtual void dumpState(std::ostream& stream) {};
 
 };
@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Converts the output of merlin.sketch_network_inspector into CSV
+# matrices.
+#
+# File format (all integers are unsigned LEB128 varints):
+#   "MSK1" window_ns group_size num_groups width depth bins exact
+#   followed by records, each starting with a tag:
+#     1  link name:    link_id length name_bytes
+#     2  link window:  link_id window packets bits
+#     3  latency:      window count (cell_delta value){count}
+#   A latency cell index is (row * width + column) * bins + bin.
+#
+# Writes:
+#   <prefix>_link_bits.csv      bits sent per link (rows) and window (columns),
+#                               or utilization if --link-bw is given
+#   <prefix>_latency_count.csv  packets per (source group, destination group)
+#   <prefix>_latency_mean.csv   estimated mean latency in ns per group pair
+#   <prefix>_latency_p<N>.csv   estimated latency percentile in ns per group
+#                               pair, for each --percentile N
+#
+# Several files (e.g. one per rank) can be given; their results are
+# merged.
+
+import argparse
+import sys
+
+TAG_LINK_NAME = 1
+TAG_LINK_WINDOW = 2
+TAG_LATENCY = 3
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def done(self):
+        return self.pos >= len(self.data)
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.data):
+                raise EOFError("truncated record")
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7f) << shift
+            if byte < 0x80:
+                return value
+            shift += 7
+
+
+class Sketch:
+    def __init__(self):
+        self.header = None
+        # link name -> {window: bits}
+        self.links = dict()
+        # window -> {cell: count}
+        self.latency = dict()
+
+    def load(self, filename):
+        with open(filename, "rb") as f:
+            data = f.read()
+        if data[0:4] != b"MSK1":
+            sys.exit("%s: not a sketch inspector file" % filename)
+
+        r = Reader(data)
+        r.pos = 4
+        header = tuple(r.varint() for _ in range(7))
+        if self.header is None:
+            self.header = header
+        elif self.header != header:
+            sys.exit("%s: written with different inspector parameters" % filename)
+
+        names = dict()
+        while not r.done():
+            tag = r.varint()
+            if tag == TAG_LINK_NAME:
+                link_id = r.varint()
+                length = r.varint()
+                names[link_id] = data[r.pos:r.pos + length].decode()
+                r.pos += length
+                self.links.setdefault(names[link_id], dict())
+            elif tag == TAG_LINK_WINDOW:
+                link_id, window, packets, bits = (r.varint() for _ in range(4))
+                windows = self.links[names[link_id]]
+                windows[window] = windows.get(window, 0) + bits
+            elif tag == TAG_LATENCY:
+                window = r.varint()
+                cells = self.latency.setdefault(window, dict())
+                cell = 0
+                for _ in range(r.varint()):
+                    cell += r.varint()
+                    cells[cell] = cells.get(cell, 0) + r.varint()
+            else:
+                sys.exit("%s: unknown record type %d at offset %d" % (filename, tag, r.pos))
+
+    def histograms(self, first, last):
+        # Returns the latency histogram of every group pair, summed over
+        # windows [first, last].  For hashed tables each bin is the
+        # minimum over the rows (count-min estimate).
+        window_ns, group_size, num_groups, width, depth, bins, exact = self.header
+        table = [0] * (width * depth * bins)
+        for window, cells in self.latency.items():
+            if window < first or window > last:
+                continue
+            for cell, count in cells.items():
+                table[cell] += count
+
+        hists = []
+        for pair in range(num_groups * num_groups):
+            hist = None
+            for row in range(depth):
+                if exact:
+                    col = pair
+                else:
+                    col = row_hash(pair, row) % width
+                base = (row * width + col) * bins
+                counts = table[base:base + bins]
+                hist = counts if hist is None else [min(a, b) for a, b in zip(hist, counts)]
+            hists.append(hist)
+        return hists
+
+
+def row_hash(pair, row):
+    # Must match SketchNetworkInspector::Stream::recordLatency
+    mask = 0xffffffffffffffff
+    h = (pair + (row + 1) * 0x9E3779B97F4A7C15) & mask
+    h = ((h ^ (h >> 30)) * 0xBF58476D1CE4E5B9) & mask
+    h = ((h ^ (h >> 27)) * 0x94D049BB133111EB) & mask
+    return h ^ (h >> 31)
+
+
+def bin_mid(b):
+    # Bin 0 is zero latency, bin b covers [2^(b-1), 2^b) ns
+    return 0.0 if b == 0 else 1.5 * (1 << (b - 1))
+
+
+def percentile(hist, pct):
+    total = sum(hist)
+    if total == 0:
+        return 0
+    target = total * pct / 100.0
+    running = 0
+    for b, count in enumerate(hist):
+        running += count
+        if running >= target:
+            # Upper edge of the bin
+            return 0 if b == 0 else (1 << b)
+    return 1 << (len(hist) - 1)
+
+
+def write_matrix(filename, num_groups, value):
+    with open(filename, "w") as f:
+        f.write("src\\dest," + ",".join(str(d) for d in range(num_groups)) + "\n")
+        for s in range(num_groups):
+            f.write("%d,%s\n" % (s, ",".join(str(value(s, d)) for d in range(num_groups))))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert sketch_network_inspector output to CSV matrices")
+    parser.add_argument("files", nargs="+", help="inspector output files")
+    parser.add_argument("-o", "--prefix", default="network_sketch", help="prefix for the CSV files")
+    parser.add_argument("--first", type=int, default=0, help="first window to include in the latency matrices")
+    parser.add_argument("--last", type=int, default=sys.maxsize, help="last window to include in the latency matrices")
+    parser.add_argument("--link-bw", type=float, default=None,
+                        help="link bandwidth in Gb/s; if given link utilization is reported instead of bits")
+    parser.add_argument("--percentile", type=float, action="append", default=[],
+                        help="also write a matrix with this latency percentile (can be repeated)")
+    args = parser.parse_args()
+
+    sketch = Sketch()
+    for filename in args.files:
+        sketch.load(filename)
+
+    window_ns, group_size, num_groups, width, depth, bins, exact = sketch.header
+    if not exact:
+        print("Note: latency histograms are count-min estimates (%d rows of %d)" % (depth, width))
+
+    # Link matrix
+    windows = sorted(set(w for link in sketch.links.values() for w in link))
+    columns = list(range(windows[0], windows[-1] + 1)) if windows else []
+    with open(args.prefix + "_link_bits.csv", "w") as f:
+        f.write("link," + ",".join(str(w * window_ns) for w in columns) + "\n")
+        for name in sorted(sketch.links):
+            link = sketch.links[name]
+            if args.link_bw:
+                row = ("%.4f" % (link.get(w, 0) / (window_ns * args.link_bw)) for w in columns)
+            else:
+                row = (str(link.get(w, 0)) for w in columns)
+            f.write(name + "," + ",".join(row) + "\n")
+
+    # Latency matrices
+    hists = sketch.histograms(args.first, args.last)
+
+    def hist(s, d):
+        return hists[s * num_groups + d]
+
+    write_matrix(args.prefix + "_latency_count.csv", num_groups, lambda s, d: sum(hist(s, d)))
+
+    def mean(s, d):
+        h = hist(s, d)
+        total = sum(h)
+        if total == 0:
+            return 0
+        return "%.1f" % (sum(bin_mid(b) * c for b, c in enumerate(h)) / total)
+
+    write_matrix(args.prefix + "_latency_mean.csv", num_groups, mean)
+
+    for pct in args.percentile:
+        write_matrix("%s_latency_p%g.csv" % (args.prefix, pct), num_groups,
+                     lambda s, d: percentile(hist(s, d), pct))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Adaptive routing test
+#
+# All-to-all traffic between test NICs on a small dragonfly, hyperx or
+# torus using the given routing algorithm, e.g.:
+#
+#   sst adaptive_routing_test.py --model-options="--topo dragonfly --algorithm ugal-l"
+#   sst adaptive_routing_test.py --model-options="--topo hyperx --algorithm DAL"
+#   sst adaptive_routing_test.py --model-options="--topo torus --algorithm adaptive"
+#
+# --credit_batch sets the routers' credit return window in flit cycles,
+# 0 returns credits once per packet.
+#
+# Every NIC must receive all of its packets, and the output must be the
+# same from run to run.
+import sst
+import argparse
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--topo", help="topology: dragonfly, hyperx or torus", default="dragonfly")
+parser.add_argument("--algorithm", help="routing algorithm for the topology", default="minimal")
+parser.add_argument("--messages", help="messages sent by each NIC to each peer", type=int, default=10)
+parser.add_argument("--credit_batch", help="router credit return window in flit cycles", type=int, default=0)
+args = parser.parse_args()
+
+if __name__ == "__main__":
+
+    if args.topo == "dragonfly":
+        topo = topoDragonFly()
+        topo.hosts_per_router = 2
+        topo.routers_per_group = 4
+        topo.intergroup_links = 1
+        topo.num_groups = 9
+    elif args.topo == "hyperx":
+        topo = topoHyperX()
+        topo.shape = "4x4"
+        topo.width = "1x1"
+        topo.local_ports = 2
+    elif args.topo == "torus":
+        topo = topoTorus()
+        topo.shape = "4x4"
+        topo.width = "1x1"
+        topo.local_ports = 2
+    else:
+        raise ValueError("unknown topology '%s'" % args.topo)
+
+    topo.algorithm = args.algorithm
+    topo.link_latency = "20ns"
+
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+    router.credit_batch = args.credit_batch
+
+    topo.router = router
+
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = TestJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.num_messages = args.messages
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Crossbar arbitration benchmark
+#
+# One hr_router of the given radix with a test NIC on every port, each
+# sending messages to all the others. Run it once per arbiter and radix
+# and compare the wall-clock times reported by --print-timing-info, e.g.:
+#
+#   for r in 8 16 32 64 128; do
+#       for a in xbar_arb_rr xbar_arb_rr_mask xbar_arb_lru xbar_arb_lru_mask; do
+#           sst --print-timing-info benchXbarArb.py --model-options="--arb $a --radix $r"
+#       done
+#   done
+#
+# The _mask arbiters make the same grants as the arbiters they are named
+# after, so each pair should report the same simulated time. So should runs
+# with and without --event-driven.
+import sst
+import argparse
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--arb", help="crossbar arbitration unit, e.g., xbar_arb_rr, xbar_arb_rr_mask, xbar_arb_lru, xbar_arb_lru_mask", default="xbar_arb_lru")
+parser.add_argument("--radix", help="number of router ports", type=int, default=32)
+parser.add_argument("--vns", help="number of virtual networks", type=int, default=2)
+parser.add_argument("--event-driven", help="stop clocking the crossbar while it is stalled", action="store_true")
+parser.add_argument("--messages", help="messages sent by each NIC to each peer", type=int, default=20)
+args = parser.parse_args()
+
+if __name__ == "__main__":
+
+    topo = topoSingle()
+    topo.num_ports = args.radix
+    topo.link_latency = "20ns"
+
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = args.vns
+    router.xbar_arb = "merlin." + args.arb
+    router.event_driven = args.event_driven
+
+    topo.router = router
+
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = TestJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.num_messages = args.messages
+    ep.message_size = "256B"
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
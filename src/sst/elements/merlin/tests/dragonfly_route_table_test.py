@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Dragonfly route table test
+#
+# All-to-all traffic with minimal, table driven routing on a dragonfly with
+# failed global links.  The tables can be written to and read back from
+# files named <prefix>.<router id>, e.g.:
+#
+#   sst dragonfly_route_table_test.py --model-options="--write /tmp/rt"
+#   sst dragonfly_route_table_test.py --model-options="--read /tmp/rt"
+#
+# Both runs must deliver every packet and give the same output.
+import sst
+import argparse
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--write", help="prefix of the route table files to write", default="")
+parser.add_argument("--read", help="prefix of the route table files to read", default="")
+parser.add_argument("--messages", help="messages sent by each NIC to each peer", type=int, default=10)
+args = parser.parse_args()
+
+if __name__ == "__main__":
+
+    topo = topoDragonFly()
+    topo.hosts_per_router = 2
+    topo.routers_per_group = 4
+    topo.intergroup_links = 2
+    topo.num_groups = 5
+    topo.algorithm = "minimal"
+    topo.link_latency = "20ns"
+
+    # Each failed pair keeps its other slice, so minimal routes between
+    # the groups have to move over to it
+    topo.config_failed_links = True
+    topo.failed_links = [ "0:1:0", "2:3:1", "1:4:0" ]
+
+    topo.route_table = True
+    if args.write != "":
+        topo.route_table_write = args.write
+    if args.read != "":
+        topo.route_table_read = args.read
+
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+
+    topo.router = router
+
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = TestJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.num_messages = args.messages
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
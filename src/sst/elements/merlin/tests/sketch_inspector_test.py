@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Sketch network inspector test
+#
+# All-to-all traffic between test NICs on a small dragonfly with
+# merlin.sketch_network_inspector loaded on every router port, e.g.:
+#
+#   sst sketch_inspector_test.py --model-options="--output /tmp/sketch.bin"
+#   ../sketchToMatrix.py /tmp/sketch.bin -o /tmp/sketch
+#
+# Pairs of NICs form a latency group.  --sketch_width below the number
+# of group pairs (400) makes the inspector hash them into a count-min
+# sketch instead of indexing them directly.
+import sst
+import argparse
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--output", help="inspector output file", default="network_sketch.bin")
+parser.add_argument("--sketch_width", help="histograms per row of the latency table", type=int, default=4096)
+parser.add_argument("--messages", help="messages sent by each NIC to each peer", type=int, default=10)
+args = parser.parse_args()
+
+if __name__ == "__main__":
+
+    topo = topoDragonFly()
+    topo.hosts_per_router = 2
+    topo.routers_per_group = 4
+    topo.intergroup_links = 1
+    topo.num_groups = 5
+    topo.algorithm = "minimal"
+    topo.link_latency = "20ns"
+
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+
+    router.network_inspectors = ["merlin.sketch_network_inspector"]
+    router.inspector.output_file = args.output
+    router.inspector.window = "200ns"
+    router.inspector.group_size = 2
+    router.inspector.num_groups = 20
+    router.inspector.sketch_width = args.sketch_width
+    router.inspector.sketch_depth = 2
+    # Small enough that the buffer is flushed several times during the run
+    router.inspector.buffer_size = 4096
+
+    topo.router = router
+
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = TestJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.num_messages = args.messages
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
@@ -2,6 +2,8 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import os
+import glob
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -67,6 +69,40 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_hyperx_128(self):
          self.merlin_test_template("hyperx_128_test")
 
+    def test_merlin_hyperx_128_event_driven(self):
+         self.merlin_test_template("hyperx_128_test_ed", refcase="hyperx_128_test")
+
+    def test_merlin_hyperx_128_lru_mask(self):
+         self.merlin_test_template("hyperx_128_test_lru_mask", refcase="hyperx_128_test")
+
+    def test_merlin_dragon_72_lru_mask(self):
+        self.merlin_test_template("dragon_72_test_lru_mask", refcase="dragon_72_test")
+
+    def test_merlin_xbar_arb_rr_mask(self):
+        self.merlin_xbar_arb_template("xbar_arb_rr", 16)
+        self.merlin_xbar_arb_template("xbar_arb_rr", 72)
+
+    def test_merlin_xbar_arb_lru_mask(self):
+        self.merlin_xbar_arb_template("xbar_arb_lru", 72)
+
+    def test_merlin_dragonfly_ugal_l(self):
+        self.merlin_adaptive_template("dragonfly", "ugal-l", 72)
+
+    def test_merlin_dragonfly_par(self):
+        self.merlin_adaptive_template("dragonfly", "par", 72)
+
+    def test_merlin_hyperx_dal(self):
+        self.merlin_adaptive_template("hyperx", "DAL", 32)
+
+    def test_merlin_torus_adaptive(self):
+        self.merlin_adaptive_template("torus", "adaptive", 32)
+
+    def test_merlin_dragonfly_credit_batch(self):
+        self.merlin_credit_batch_template("dragonfly", "ugal-l", 72, 4)
+
+    def test_merlin_torus_credit_batch(self):
+        self.merlin_credit_batch_template("torus", "adaptive", 32, 4)
+
     def test_merlin_dragon_128_platform(self):
         self.merlin_test_template("dragon_128_platform_test", True)
 
@@ -76,10 +112,19 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_dragon_128_fl(self):
         self.merlin_test_template("dragon_128_test_fl")
 
+    def test_merlin_dragonfly_route_table(self):
+        self.merlin_route_table_template()
+
+    def test_merlin_sketch_inspector_exact(self):
+        self.merlin_sketch_inspector_template(4096)
+
+    def test_merlin_sketch_inspector_countmin(self):
+        self.merlin_sketch_inspector_template(64)
+
 
 #####
 
-    def merlin_test_template(self, testcase, cwd=False):
+    def merlin_test_template(self, testcase, cwd=False, refcase=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -89,7 +134,8 @@ class testcase_merlin_Component(SSTTestCase):
         testDataFileName="test_merlin_{0}".format(testcase)
 
         sdlfile = "{0}/{1}.py".format(test_path, testcase)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        refDataFileName = testDataFileName if refcase is None else "test_merlin_{0}".format(refcase)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, refDataFileName)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
@@ -113,3 +159,221 @@ class testcase_merlin_Component(SSTTestCase):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    # Runs adaptive_routing_test.py twice. There is no reference output, so
+    # every NIC must send and receive all of its packets and both runs must
+    # give the same output.
+    def merlin_adaptive_template(self, topo, algorithm, num_nics):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/adaptive_routing_test.py".format(test_path)
+        testcase = "{0}_{1}".format(topo, algorithm.lower().replace("-", "_"))
+        otherargs = '--model-options="--topo {0} --algorithm {1}"'.format(topo, algorithm)
+
+        outfiles = []
+        for run in range(2):
+            testDataFileName="test_merlin_{0}_{1}".format(testcase, run)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            with open(outfile, 'r') as fp:
+                lines = fp.readlines()
+            sent = [line for line in lines if "Finished sending packets" in line]
+            received = [line for line in lines if "received all packets" in line]
+            missing = [line for line in lines if "didn't receive" in line or "received event with dest" in line]
+            self.assertTrue(len(sent) == num_nics and len(received) == num_nics and len(missing) == 0,
+                    "Output file {0} does not show all {1} NICs sending and receiving all packets".format(outfile, num_nics))
+            outfiles.append(outfile)
+
+        cmp_result = testing_compare_sorted_diff(testcase, outfiles[1], outfiles[0])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testcase)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Output File {1}".format(outfiles[1], outfiles[0]))
+
+    # Runs adaptive_routing_test.py returning credits once per packet and
+    # batched over credit_batch flit cycles.  Batching only delays credits,
+    # so both runs must deliver every packet and give the same output.
+    def merlin_credit_batch_template(self, topo, algorithm, num_nics, credit_batch):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/adaptive_routing_test.py".format(test_path)
+        testcase = "{0}_credit_batch".format(topo)
+
+        outfiles = []
+        for batch in [0, credit_batch]:
+            testDataFileName="test_merlin_{0}_{1}".format(testcase, batch)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+            otherargs = '--model-options="--topo {0} --algorithm {1} --credit_batch {2}"'.format(topo, algorithm, batch)
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            with open(outfile, 'r') as fp:
+                lines = fp.readlines()
+            sent = [line for line in lines if "Finished sending packets" in line]
+            received = [line for line in lines if "received all packets" in line]
+            missing = [line for line in lines if "didn't receive" in line or "received event with dest" in line]
+            self.assertTrue(len(sent) == num_nics and len(received) == num_nics and len(missing) == 0,
+                    "Output file {0} does not show all {1} NICs sending and receiving all packets".format(outfile, num_nics))
+            outfiles.append(outfile)
+
+        cmp_result = testing_compare_sorted_diff(testcase, outfiles[1], outfiles[0])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testcase)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Output File {1}".format(outfiles[1], outfiles[0]))
+
+    # Runs sketch_inspector_test.py and converts its output with
+    # sketchToMatrix.py.  Every NIC sends messages packets to every NIC,
+    # so each pair of two NIC latency groups sees 4 * messages packets.
+    # The directly indexed table must count exactly that, a count-min
+    # sketch may only overestimate it.
+    def merlin_sketch_inspector_template(self, sketch_width, num_nics=40, num_groups=20, messages=10, msg_bits=64):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/sketch_inspector_test.py".format(test_path)
+        script = "{0}/../sketchToMatrix.py".format(test_path)
+        testDataFileName="test_merlin_sketch_inspector_{0}".format(sketch_width)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        sketchfile = "{0}/{1}.bin".format(outdir, testDataFileName)
+        prefix = "{0}/{1}".format(outdir, testDataFileName)
+
+        # Remove files left by an earlier run, multi-rank runs write one per rank
+        for f in glob.glob(sketchfile + "*"):
+            os.remove(f)
+
+        otherargs = '--model-options="--output {0} --sketch_width {1} --messages {2}"'.format(sketchfile, sketch_width, messages)
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        with open(outfile, 'r') as fp:
+            received = [line for line in fp if "received all packets" in line]
+        self.assertTrue(len(received) == num_nics, "Output file {0} does not show all {1} NICs receiving all packets".format(outfile, num_nics))
+
+        sketchfiles = sorted(glob.glob(sketchfile + "*"))
+        self.assertTrue(len(sketchfiles) > 0, "Inspector output file {0} was not written".format(sketchfile))
+
+        cmd = "python3 {0} {1} -o {2} --percentile 50 --percentile 99".format(script, " ".join(sketchfiles), prefix)
+        rtn = OSCommand(cmd).run()
+        log_debug("sketchToMatrix.py result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sketchToMatrix.py failed on {0}".format(sketchfile))
+
+        def read_matrix(name):
+            with open("{0}_{1}.csv".format(prefix, name), 'r') as fp:
+                rows = [line.strip().split(",") for line in fp.readlines()[1:]]
+            return [[float(v) for v in row[1:]] for row in rows]
+
+        expected = 4 * messages
+        count = read_matrix("latency_count")
+        mean = read_matrix("latency_mean")
+        p50 = read_matrix("latency_p50")
+        p99 = read_matrix("latency_p99")
+        self.assertTrue(len(count) == num_groups and all(len(row) == num_groups for row in count),
+                        "Latency count matrix is not {0}x{0}".format(num_groups))
+        for s in range(num_groups):
+            for d in range(num_groups):
+                if sketch_width >= num_groups * num_groups:
+                    self.assertTrue(count[s][d] == expected,
+                                    "Group pair {0},{1} counted {2} packets, expected {3}".format(s, d, count[s][d], expected))
+                else:
+                    self.assertTrue(count[s][d] >= expected,
+                                    "Group pair {0},{1} estimated {2} packets, at least {3} were sent".format(s, d, count[s][d], expected))
+                self.assertTrue(mean[s][d] > 0 and 0 < p50[s][d] <= p99[s][d],
+                                "Group pair {0},{1} has invalid latency estimates".format(s, d))
+
+        # Every packet is sent at least once, by its destination router
+        with open("{0}_link_bits.csv".format(prefix), 'r') as fp:
+            links = [line.strip().split(",") for line in fp.readlines()[1:]]
+        total_bits = sum(int(v) for link in links for v in link[1:])
+        self.assertTrue(len(links) > 0 and total_bits >= num_nics * num_nics * messages * msg_bits,
+                        "Link matrix accounts for {0} bits, at least {1} were delivered".format(total_bits, num_nics * num_nics * messages * msg_bits))
+
+    # Runs dragonfly_route_table_test.py once writing its route tables and
+    # once reading them back.  Both runs must deliver every packet and give
+    # the same output.
+    def merlin_route_table_template(self, num_nics=40, num_routers=20):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/dragonfly_route_table_test.py".format(test_path)
+        testcase = "dragonfly_route_table"
+        prefix = "{0}/test_merlin_{1}.rt".format(outdir, testcase)
+
+        outfiles = []
+        for mode in ["write", "read"]:
+            testDataFileName="test_merlin_{0}_{1}".format(testcase, mode)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+            otherargs = '--model-options="--{0} {1}"'.format(mode, prefix)
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            if mode == "write":
+                for rtr in range(num_routers):
+                    tablefile = "{0}.{1}".format(prefix, rtr)
+                    self.assertTrue(os_test_file(tablefile, "-s"), "Route table file {0} was not written".format(tablefile))
+
+            with open(outfile, 'r') as fp:
+                lines = fp.readlines()
+            sent = [line for line in lines if "Finished sending packets" in line]
+            received = [line for line in lines if "received all packets" in line]
+            missing = [line for line in lines if "didn't receive" in line or "received event with dest" in line]
+            self.assertTrue(len(sent) == num_nics and len(received) == num_nics and len(missing) == 0,
+                    "Output file {0} does not show all {1} NICs sending and receiving all packets".format(outfile, num_nics))
+            outfiles.append(outfile)
+
+        cmp_result = testing_compare_sorted_diff(testcase, outfiles[1], outfiles[0])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testcase)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Output File {1}".format(outfiles[1], outfiles[0]))
+
+    # Runs benchXbarArb.py with an arbiter and with its _mask version, which
+    # must make the same grants and so give the same output
+    def merlin_xbar_arb_template(self, arb, radix, messages=5):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/benchXbarArb.py".format(test_path)
+        outfiles = []
+        for a in [arb, arb + "_mask"]:
+            testDataFileName="test_merlin_{0}_{1}".format(a, radix)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+            otherargs = '--model-options="--arb {0} --radix {1} --messages {2}"'.format(a, radix, messages)
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+            outfiles.append(outfile)
+
+        testcase = "{0}_mask_{1}".format(arb, radix)
+        cmp_result = testing_compare_sorted_diff(testcase, outfiles[1], outfiles[0])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testcase)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Output File {1}".format(outfiles[1], outfiles[0]))
@@ -313,6 +313,16 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
             vns[i].algorithm = MIN_A;
             vns[i].num_vcs = 2;
         }
+        else if ( !vn_route_algos[i].compare("ugal-l") ) {
+            vns[i].algorithm = UGAL_L;
+            vns[i].num_vcs = 3;
+        }
+        else if ( !vn_route_algos[i].compare("par") ) {
+            // Needs an extra VC for the second local hop taken in
+            // the source group when a packet is diverted
+            vns[i].algorithm = PAR;
+            vns[i].num_vcs = 4;
+        }
         else {
             fatal(CALL_INFO_LONG,1,"ERROR: Unknown routing algorithm specified: %s\n",vn_route_algos[i].c_str());
         }
@@ -321,6 +331,12 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
 
     rng = new RNG::XORShiftRNG(rtr_id+1);
 
+    path_weights.resize(2 * params.n);
+
+    use_route_table = p.find<bool>("route_table", false);
+    route_table_read = p.find<std::string>("route_table_read", "");
+    route_table_write = p.find<std::string>("route_table_write", "");
+
     output.verbose(CALL_INFO, 1, 1, "%u:%u:  ID: %u   Params:  p = %u  a = %u  k = %u  h = %u  g = %u\n",
             group_id, router_id, rtr_id, params.p, params.a, params.k, params.h, params.g);
 }
@@ -830,10 +846,173 @@ void topo_dragonfly::route_adaptive_local(int port, int vc, internal_router_even
 
 }
 
+void topo_dragonfly::build_route_table()
+{
+    std::string suffix = "." + std::to_string(rtr_id);
+    int dests = params.g * params.a;
+
+    if ( route_table_read != "" ) {
+        route_table.read(route_table_read + suffix, dests, params.n, params.k, output);
+    }
+    else {
+        route_table.generate(dests, params.n, [this](int slice, int dest) -> uint16_t {
+            uint32_t group = dest / params.a;
+            uint32_t router = dest % params.a;
+            if ( group == group_id ) {
+                return router == router_id ? RouteTable::LOCAL : port_for_router(router);
+            }
+            // If the link for this slice has failed, use the next
+            // working one.  Every router in the group makes the same
+            // substitution, so packets stay on one path.
+            for ( uint32_t i = 0; i < params.n; ++i ) {
+                int port = port_for_group(group, (slice + i) % params.n);
+                if ( port != -1 ) return port;
+            }
+            output.fatal(CALL_INFO, -1, "No working global links from group %u to group %u\n", group_id, group);
+            return 0;
+        });
+    }
+
+    if ( route_table_write != "" ) {
+        route_table.write(route_table_write + suffix,
+                          "merlin.dragonfly minimal routes for router " + std::to_string(rtr_id) +
+                          ", indexed by global slice and destination router", output);
+    }
+}
+
+// Minimal routing using the precomputed table.  Same routes as
+// route_nonadaptive() for the minimal algorithm as long as no global
+// links have failed.  When the link for the packet's global slice has
+// failed, the table routes over the next working slice instead, but
+// global_slice is not updated, so routers further along look up the
+// original slice and make the same substitution.
+void topo_dragonfly::route_minimal_table(int port, int vc, internal_router_event* ev)
+{
+    topo_dragonfly_event *td_ev = static_cast<topo_dragonfly_event*>(ev);
+    if ( route_table.empty() ) build_route_table();
+
+    // Came in from another group.  Increment VC
+    if ( is_port_global(port) ) td_ev->setVC(vc+1);
+
+    int next_port = route_table.lookup(td_ev->global_slice, td_ev->dest.group * params.a + td_ev->dest.router);
+    if ( next_port == RouteTable::LOCAL ) next_port = td_ev->dest.host;
+    td_ev->setNextPort(next_port);
+}
+
+void topo_dragonfly::route_ugal_par(int port, int vc, internal_router_event* ev)
+{
+    topo_dragonfly_event *td_ev = static_cast<topo_dragonfly_event*>(ev);
+    int vn = ev->getVN();
+
+    // The choice between the minimal and valiant path is made at the
+    // source router.  PAR gets a second chance at the next router in
+    // the source group, everything else follows the chosen path.
+    if ( (uint32_t)port >= params.p ) {
+        if ( vns[vn].algorithm == PAR && route_par_divert(port,vc,td_ev) ) return;
+        return route_nonadaptive(port,vc,ev);
+    }
+
+    int const* loads = port_loads.getLoads(vc, getCurrentSimCycle());
+
+    if ( td_ev->dest.group == group_id ) {
+        if ( td_ev->dest.router != router_id ) {
+            // Direct route is one hop, valiant route through the
+            // intermediate router is two.  Both start at this router,
+            // so the local view is all that is used here.
+            int direct_weight = loads[port_for_router(td_ev->dest.router)];
+            int valiant_weight = 2 * loads[port_for_router(td_ev->dest.mid_group_shadow)] + vns[vn].bias;
+            td_ev->dest.mid_group = direct_weight <= valiant_weight ? td_ev->dest.router : td_ev->dest.mid_group_shadow;
+        }
+        return route_nonadaptive(port,vc,ev);
+    }
+
+    // Weigh the minimal and valiant path over every slice.  Weights
+    // are stored as [minimal slices | valiant slices].  The queue on
+    // the first hop is weighed by the number of hops in the path.
+    int* weights = path_weights.data();
+    for ( int i = 0; i < (int)params.n; ++i ) {
+        int dest_port = port_for_group(td_ev->dest.group, i);
+        int val_port = port_for_group(td_ev->dest.mid_group_shadow, i);
+
+        weights[i] = std::numeric_limits<int>::max();
+        if ( dest_port != -1 ) {
+            int hops = hops_to_router(td_ev->dest.group, td_ev->dest.router, i);
+            weights[i] = hops * loads[dest_port] + hops;
+        }
+
+        weights[params.n + i] = std::numeric_limits<int>::max();
+        if ( val_port != -1 ) {
+            int hops = valiant_hops(router_id, td_ev->dest.mid_group_shadow, td_ev->dest.group, td_ev->dest.router, i);
+            weights[params.n + i] = hops * loads[val_port] + hops + vns[vn].bias;
+        }
+    }
+
+    int route = PortLoadSnapshot::selectMin(weights, 2 * params.n, rng);
+    if ( weights[route] == std::numeric_limits<int>::max() ) {
+        // No usable global links, nothing to choose from
+        return route_nonadaptive(port,vc,ev);
+    }
+    if ( route < (int)params.n ) {
+        td_ev->dest.mid_group = td_ev->dest.group;
+        td_ev->global_slice = route;
+    }
+    else {
+        td_ev->dest.mid_group = td_ev->dest.mid_group_shadow;
+        td_ev->global_slice = route - params.n;
+    }
+    route_nonadaptive(port,vc,ev);
+}
+
+// PAR re-evaluates minimally routed packets when they reach the router
+// in the source group that owns their global link.  If the valiant
+// path now looks better, the packet is diverted.  Returns true if the
+// packet was diverted and the next port has been set.
+bool topo_dragonfly::route_par_divert(int port, int vc, topo_dragonfly_event* td_ev)
+{
+    if ( !is_port_local_group(port) || td_ev->src_group != group_id ||
+         td_ev->dest.group == group_id || td_ev->dest.mid_group != td_ev->dest.group ) {
+        return false;
+    }
+
+    int min_port = port_for_group(td_ev->dest.group, td_ev->global_slice);
+    if ( min_port == -1 || !is_port_global(min_port) ) return false;
+
+    int vn = td_ev->getVN();
+    SimTime_t now = getCurrentSimCycle();
+    int const* loads = port_loads.getLoads(vc, now);
+    // Valiant routes that need another local hop use the next VC
+    int const* next_loads = port_loads.getLoads(vc + 1, now);
+
+    int hops = hops_to_router(td_ev->dest.group, td_ev->dest.router, td_ev->global_slice);
+    int min_weight = hops * loads[min_port] + hops;
+
+    int* weights = path_weights.data();
+    for ( int i = 0; i < (int)params.n; ++i ) {
+        int val_port = port_for_group(td_ev->dest.mid_group_shadow, i);
+        weights[i] = std::numeric_limits<int>::max();
+        if ( val_port == -1 ) continue;
+        int val_hops = valiant_hops(router_id, td_ev->dest.mid_group_shadow, td_ev->dest.group, td_ev->dest.router, i);
+        int queue = is_port_global(val_port) ? loads[val_port] : next_loads[val_port];
+        weights[i] = val_hops * queue + val_hops + vns[vn].bias;
+    }
+
+    int route = PortLoadSnapshot::selectMin(weights, params.n, rng);
+    if ( weights[route] >= min_weight ) return false;
+
+    int next_port = port_for_group(td_ev->dest.mid_group_shadow, route);
+    if ( !is_port_global(next_port) ) td_ev->setVC(vc + 1);
+    td_ev->dest.mid_group = td_ev->dest.mid_group_shadow;
+    td_ev->global_slice = route;
+    td_ev->setNextPort(next_port);
+    return true;
+}
+
 void topo_dragonfly::route_packet(int port, int vc, internal_router_event* ev) {
     int vn = ev->getVN();
     if ( vns[vn].algorithm == UGAL ) return route_ugal(port,vc,ev);
     if ( vns[vn].algorithm == MIN_A ) return route_mina(port,vc,ev);
+    if ( vns[vn].algorithm == MINIMAL && use_route_table ) return route_minimal_table(port,vc,ev);
+    if ( vns[vn].algorithm == UGAL_L || vns[vn].algorithm == PAR ) return route_ugal_par(port,vc,ev);
     route_nonadaptive(port,vc,ev);
     route_adaptive_local(port,vc,ev);
 }
@@ -857,6 +1036,8 @@ internal_router_event* topo_dragonfly::process_input(RtrEvent* ev)
     case VALIANT:
     case ADAPTIVE_LOCAL:
     case UGAL:
+    case UGAL_L:
+    case PAR:
         if ( dstAddr.group == group_id ) {
             // staying within group, set mid_group to be an intermediate router within group
             do {
@@ -1060,6 +1241,7 @@ topo_dragonfly::setOutputQueueLengthsArray(int const* array, int vcs)
 {
     output_queue_lengths = array;
     num_vcs = vcs;
+    port_loads.setQueueLengthsArray(array, params.k, vcs);
 }
 
 void topo_dragonfly::idToLocation(int id, dgnflyAddr *location)
@@ -1102,6 +1284,18 @@ int32_t topo_dragonfly::hops_to_router(uint32_t group, uint32_t router, uint32_t
     return hops;
 }
 
+// Hops from src_router in this group to router in group when going
+// through mid_group, using the same slice for both global hops
+int32_t topo_dragonfly::valiant_hops(uint32_t src_router, uint32_t mid_group, uint32_t group, uint32_t router, uint32_t slice)
+{
+    int hops = 2;
+    if ( group_to_global_port.getRouterPortPair(mid_group,slice).router != src_router ) hops++;
+    if ( group_to_global_port.getRouterPortPairForGroup(mid_group, group_id, slice).router !=
+         group_to_global_port.getRouterPortPairForGroup(mid_group, group, slice).router ) hops++;
+    if ( group_to_global_port.getRouterPortPairForGroup(group, mid_group, slice).router != router ) hops++;
+    return hops;
+}
+
 /* returns local router port if group can't be reached from this router */
 int32_t topo_dragonfly::port_for_group(uint32_t group, uint32_t slice, int id)
 {
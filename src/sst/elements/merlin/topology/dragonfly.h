@@ -27,6 +27,8 @@
 #include <sst/core/rng/sstrng.h>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/portLoad.h"
+#include "sst/elements/merlin/topology/routeTable.h"
 
 
 
@@ -192,7 +194,7 @@ public:
         {"dragonfly.intergroup_per_router", "Number of links per router connected to other groups."},
         {"dragonfly.intergroup_links",      "Number of links between each pair of groups."},
         {"dragonfly.num_groups",            "Number of groups in network."},
-        {"dragonfly.algorithm",             "Routing algorithm to use [minmal (default) | valiant].", "minimal"},
+        {"dragonfly.algorithm",             "Routing algorithm to use [minmal (default) | valiant | adaptive-local | ugal | min-a | ugal-l | par].", "minimal"},
         {"dragonfly.adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
         {"dragonfly.global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"dragonfly.global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
@@ -202,12 +204,16 @@ public:
         {"intergroup_per_router", "Number of links per router connected to other groups."},
         {"intergroup_links",      "Number of links between each pair of groups."},
         {"num_groups",            "Number of groups in network."},
-        {"algorithm",             "Routing algorithm to use [minmal (default) | valiant].", "minimal"},
+        {"algorithm",             "Routing algorithm to use [minmal (default) | valiant | adaptive-local | ugal | min-a | ugal-l | par].", "minimal"},
         {"adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
         {"global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
         {"config_failed_links",   "Controls whether or not failed links are considered","False"},
         {"failed_links",          "List of global links to mark as failed.  Only needs to be passed to router 0. Format is \"group1:group2:slice\"",""},
+        {"route_table",           "Use a precomputed destination to port table for minimal routing.  Each router keeps up to one entry per router and global link slice.","false"},
+        {"route_table_read",      "If set, minimal routing tables are read from <value>.<router id> instead of being generated.  Can be used to supply "
+                                  "tables that route around failed links.",""},
+        {"route_table_write",     "If set, the minimal routing table of each router is written to <value>.<router id>.",""},
     )
 
     enum RouteAlgo {
@@ -215,7 +221,9 @@ public:
         VALIANT,
         ADAPTIVE_LOCAL,
         UGAL,
-        MIN_A
+        MIN_A,
+        UGAL_L,
+        PAR
     };
 
     RouteToGroup group_to_global_port;
@@ -237,6 +245,18 @@ public:
     int num_vcs;
     int num_vns;
 
+    PortLoadSnapshot port_loads;
+    // Scratch space for candidate path weights
+    std::vector<int> path_weights;
+
+    // Precomputed minimal routes, indexed by slice and destination
+    // router.  Built on first use since failed link information is
+    // not available until after init.
+    bool use_route_table;
+    RouteTable route_table;
+    std::string route_table_read;
+    std::string route_table_write;
+
     global_route_mode_t global_route_mode;
 
 public:
@@ -281,6 +301,7 @@ private:
     int32_t port_for_group(uint32_t group, uint32_t global_slice, int id = -1);
     int32_t port_for_group_init(uint32_t group, uint32_t global_slice);
     int32_t hops_to_router(uint32_t group, uint32_t router, uint32_t slice);
+    int32_t valiant_hops(uint32_t src_router, uint32_t mid_group, uint32_t group, uint32_t router, uint32_t slice);
 
     inline bool is_port_endpoint(uint32_t port) const { return ( port < params.p ); }
     inline bool is_port_local_group(uint32_t port) const { return (port >= params.p && port < (params.p + params.a -1 )); }
@@ -296,9 +317,13 @@ private:
     vn_info* vns;
 
     void route_nonadaptive(int port, int vc, internal_router_event* ev);
+    void route_minimal_table(int port, int vc, internal_router_event* ev);
+    void build_route_table();
     void route_adaptive_local(int port, int vc, internal_router_event* ev);
     void route_ugal(int port, int vc, internal_router_event* ev);
     void route_mina(int port, int vc, internal_router_event* ev);
+    void route_ugal_par(int port, int vc, internal_router_event* ev);
+    bool route_par_divert(int port, int vc, topo_dragonfly_event* td_ev);
 
 
 };
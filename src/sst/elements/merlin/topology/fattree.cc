@@ -104,7 +104,7 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
 
     parseShape(shape, downs, ups);
 
-    int total_hosts = 1;
+    total_hosts = 1;
     for ( int i = 0; i < levels; i++ ) {
         total_hosts *= downs[i];
     }
@@ -143,7 +143,10 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
 
     low_host = level_group * rid;
     high_host = low_host + rid - 1;
-    
+
+    use_route_table = params.find<bool>("route_table", false);
+    route_table_read = params.find<std::string>("route_table_read", "");
+    route_table_write = params.find<std::string>("route_table_write", "");
 }
 
 
@@ -165,9 +168,36 @@ void topo_fattree::route_deterministic(int port, int vc, internal_router_event*
 }
 
 
+void topo_fattree::build_route_table()
+{
+    std::string suffix = "." + std::to_string(id);
+
+    if ( route_table_read != "" ) {
+        route_table.read(route_table_read + suffix, total_hosts, 1, num_ports, output);
+    }
+    else {
+        route_table.generate(total_hosts, 1, [this](int slice, int dest) -> uint16_t {
+            if ( dest >= low_host && dest <= high_host ) return (dest - low_host) / down_route_factor;
+            return down_ports + ((dest/down_route_factor) % up_ports);
+        });
+    }
+
+    if ( route_table_write != "" ) {
+        route_table.write(route_table_write + suffix,
+                          "merlin.fattree routes for router " + std::to_string(id) + ", indexed by destination", output);
+    }
+}
+
+
 void topo_fattree::route_packet(int port, int vc, internal_router_event* ev)
 {
-    route_deterministic(port,vc,ev);
+    if ( use_route_table ) {
+        if ( route_table.empty() ) build_route_table();
+        ev->setNextPort(route_table.lookup(0, ev->getDest()));
+    }
+    else {
+        route_deterministic(port,vc,ev);
+    }
     
     int dest = ev->getDest();
     // Down routes are always deterministic and are already done in route
@@ -24,6 +24,7 @@
 #include <sst/core/params.h>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routeTable.h"
 
 namespace SST {
 namespace Merlin {
@@ -48,7 +49,10 @@ public:
 
         {"shape",               "Shape of the fattree"},
         {"routing_alg",         "Routing algorithm to use. [deterministic | adaptive]","deterministic"},
-        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."}
+        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."},
+        {"route_table",         "Use a precomputed destination to port table for deterministic routes.  Each router keeps up to one entry per host.","false"},
+        {"route_table_read",    "If set, routing tables are read from <value>.<router id> instead of being generated.",""},
+        {"route_table_write",   "If set, the routing table of each router is written to <value>.<router id>.",""}
     )
 
 
@@ -59,6 +63,7 @@ private:
 
     int high_host;
     int low_host;
+    int total_hosts;
 
     int down_route_factor;
 
@@ -82,6 +87,15 @@ private:
 
     vn_info* vns;
 
+    // Precomputed deterministic routes, indexed by destination.
+    // Built on first use.
+    bool use_route_table;
+    RouteTable route_table;
+    std::string route_table_read;
+    std::string route_table_write;
+
+    void build_route_table();
+
     void parseShape(const std::string &shape, int *downs, int *ups) const;
 
 
@@ -110,6 +110,10 @@ topo_hyperx::topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int r
             vns[i].algorithm = VDAL;
             vns[i].num_vcs = 2 * dimensions;
         }
+        else if ( !vn_route_algos[i].compare("DAL") ) {
+            vns[i].algorithm = DAL;
+            vns[i].num_vcs = 2 * dimensions;
+        }
         else if ( !vn_route_algos[i].compare("DOR-ND") ) {
             vns[i].algorithm = DORND;
             vns[i].num_vcs = 1;
@@ -184,6 +188,10 @@ topo_hyperx::route_packet(int port, int vc, internal_router_event* ev)
     else if ( vns[vn].algorithm == VDAL ) {
         return routeVDAL(port,vc,tt_ev);
     }
+
+    else if ( vns[vn].algorithm == DAL ) {
+        return routeDAL(port,vc,tt_ev);
+    }
     
     // Look for opportunities to adaptively route
 
@@ -359,6 +367,8 @@ topo_hyperx::setOutputQueueLengthsArray(int const* array, int vcs)
 {
     output_queue_lengths = array;
     num_vcs = vcs;
+    port_loads.setQueueLengthsArray(array, local_port_start, vcs);
+    port_weights.resize(local_port_start);
 }
 
 
@@ -697,3 +707,75 @@ topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
     ev->setVC(next_vc);
 }
 
+
+void
+topo_hyperx::routeDAL(int port, int vc, topo_hyperx_event* ev) {
+    // Check to see if we made it to the dest router
+    int dest_router = get_dest_router(ev->getDest());
+    if ( dest_router == router_id ) {
+        ev->setNextPort(get_dest_local_port(ev->getDest()));
+        return;
+    }
+
+    // Packets move up one VC on every hop.  A packet may be derouted
+    // at most once in each dimension, so it takes at most two hops
+    // per dimension and 2 * dimensions VCs always suffice.
+    int vn = ev->getVN();
+    int next_vc = port >= local_port_start ? vns[vn].start_vc : vc + 1;
+    int const* loads = port_loads.getLoads(next_vc, getCurrentSimCycle());
+
+    // Weigh every network port.  Ports in aligned dimensions are never
+    // taken.  In unaligned dimensions the minimal links are weighted
+    // by their queue length and the derouting links by twice that
+    // plus one, unless the packet was already derouted in that
+    // dimension.
+    int* weights = port_weights.data();
+    for ( int dim = 0; dim < dimensions; ++dim ) {
+        int start = port_start[dim];
+        int count = (dim_size[dim] - 1) * dim_width[dim];
+
+        if ( ev->dest_loc[dim] == id_loc[dim] ) {
+            for ( int i = start; i < start + count; ++i ) {
+                weights[i] = std::numeric_limits<int>::max();
+            }
+            continue;
+        }
+
+        if ( ev->derouted_dims & (1 << dim) ) {
+            for ( int i = start; i < start + count; ++i ) {
+                weights[i] = std::numeric_limits<int>::max();
+            }
+        }
+        else {
+            for ( int i = start; i < start + count; ++i ) {
+                weights[i] = 2 * loads[i] + 1;
+            }
+        }
+
+        int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
+        offset = start + (offset * dim_width[dim]);
+        for ( int i = offset; i < offset + dim_width[dim]; ++i ) {
+            weights[i] = loads[i];
+        }
+    }
+
+    int min_port = PortLoadSnapshot::selectMin(weights, local_port_start, rng);
+
+    // Find the dimension of the chosen port and record a deroute
+    int dim = dimensions - 1;
+    for ( int i = 0; i < dimensions - 1; ++i ) {
+        if ( min_port < port_start[i+1] ) {
+            dim = i;
+            break;
+        }
+    }
+    int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
+    offset = port_start[dim] + (offset * dim_width[dim]);
+    if ( min_port < offset || min_port >= offset + dim_width[dim] ) {
+        ev->derouted_dims |= (1 << dim);
+    }
+    ev->last_routing_dim = dim;
+
+    ev->setNextPort(min_port);
+    ev->setVC(next_vc);
+}
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/portLoad.h"
 
 namespace SST {
 namespace Merlin {
@@ -43,13 +44,16 @@ public:
 
     id_type id;
     bool rerouted;
+    // Dimensions the packet has already been derouted in (DAL)
+    uint32_t derouted_dims;
 
-    topo_hyperx_event() : internal_router_event() {}
+    topo_hyperx_event() : internal_router_event(), derouted_dims(0) {}
     topo_hyperx_event(int dim) :
         internal_router_event(),
         dimensions(dim),
         last_routing_dim(-1),
-        val_route_dest(false)
+        val_route_dest(false),
+        derouted_dims(0)
     {
         dest_loc = new int[dim];
         val_loc = new int[dim];
@@ -94,6 +98,7 @@ public:
         ser & val_route_dest;
         ser & id;
         ser & rerouted;
+        ser & derouted_dims;
     }
 
 protected:
@@ -161,7 +166,7 @@ public:
         {"hyperx.width", "Number of links between routers in each dimension, specified in same manner as for shape.  "
                          "For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"hyperx.local_ports",  "Number of endpoints attached to each router."},
-        {"hyperx.algorithm",    "Routing algorithm to use.", "DOR"},
+        {"hyperx.algorithm",    "Routing algorithm to use [DOR (default) | DOR-ND | MIN-A | valiant | DOAL | VDAL | DAL].", "DOR"},
 
 
         {"shape", "Shape of the mesh specified as the number of routers in each dimension, where each dimension "
@@ -169,7 +174,7 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  "
                   "For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
-        {"algorithm", "Routing algorithm to use.", "DOR"}
+        {"algorithm", "Routing algorithm to use [DOR (default) | DOR-ND | MIN-A | valiant | DOAL | VDAL | DAL].", "DOR"}
     )
 
     enum RouteAlgo {
@@ -178,7 +183,8 @@ public:
         MINA,
         VALIANT,
         DOAL,
-        VDAL
+        VDAL,
+        DAL
     };
 
 private:
@@ -198,6 +204,10 @@ private:
     int const* output_credits;
     int const* output_queue_lengths;
     int num_vcs;
+
+    PortLoadSnapshot port_loads;
+    // Scratch space for per-port weights
+    std::vector<int> port_weights;
     int num_vns;
 
     RNG::SSTRandom* rng;
@@ -249,6 +259,7 @@ private:
     void routeMINA(int port, int vc, topo_hyperx_event* ev);
     void routeDOAL(int port, int vc, topo_hyperx_event* ev);
     void routeVDAL(int port, int vc, topo_hyperx_event* ev);
+    void routeDAL(int port, int vc, topo_hyperx_event* ev);
     void routeValiant(int port, int vc, topo_hyperx_event* ev);
 };
 
@@ -0,0 +1,108 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_PORTLOAD_H
+#define COMPONENTS_MERLIN_TOPOLOGY_PORTLOAD_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/rng/sstrng.h>
+
+#include <limits>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Cached, per-VC view of a router's output queue lengths.
+ *
+ * The router exposes the queue lengths as a port-major array (index
+ * port * num_vcs + vc), so scanning many ports for a single VC
+ * strides through memory.  Adaptive routing algorithms that weigh a
+ * large number of candidate ports (UGAL over all slices, DAL over
+ * every port in the unaligned dimensions) instead take a snapshot of
+ * the VC they are routing on.  The snapshot is gathered into a
+ * contiguous array at most once per cycle and is reused by every
+ * routing decision made on that VC during the same cycle, so all
+ * packets routed in a cycle see the same start-of-cycle view of the
+ * router.  Candidate weights are then computed with flat loops that
+ * the compiler can vectorize.
+ */
+class PortLoadSnapshot {
+public:
+    PortLoadSnapshot() :
+        queue_lengths(nullptr),
+        num_ports(0),
+        num_vcs(0)
+    {}
+
+    void setQueueLengthsArray(int const* array, int ports, int vcs) {
+        queue_lengths = array;
+        num_ports = ports;
+        num_vcs = vcs;
+        loads.assign((size_t)ports * vcs, 0);
+        // Stamps hold cycle + 1 so that zero means "never gathered"
+        stamps.assign(vcs, 0);
+    }
+
+    // Returns the queue length of every port on the specified VC,
+    // indexed by port, as of the first request made in cycle now.
+    inline int const* getLoads(int vc, SimTime_t now) {
+        int* dst = &loads[(size_t)vc * num_ports];
+        if ( stamps[vc] != now + 1 ) {
+            int const* src = queue_lengths + vc;
+            for ( int p = 0; p < num_ports; ++p ) {
+                dst[p] = src[p * num_vcs];
+            }
+            stamps[vc] = now + 1;
+        }
+        return dst;
+    }
+
+    // Returns the index of the smallest weight, choosing randomly
+    // between ties.  Returns -1 if count is zero.
+    static int selectMin(int const* weights, int count, RNG::SSTRandom* rng) {
+        if ( count == 0 ) return -1;
+        int min = std::numeric_limits<int>::max();
+        for ( int i = 0; i < count; ++i ) {
+            min = weights[i] < min ? weights[i] : min;
+        }
+        int ties = 0;
+        for ( int i = 0; i < count; ++i ) {
+            ties += (weights[i] == min);
+        }
+        int pick = ties == 1 ? 0 : rng->generateNextUInt32() % ties;
+        for ( int i = 0; i < count; ++i ) {
+            if ( weights[i] == min && pick-- == 0 ) return i;
+        }
+        return -1;
+    }
+
+private:
+    int const* queue_lengths;
+    int num_ports;
+    int num_vcs;
+
+    std::vector<int> loads;
+    std::vector<SimTime_t> stamps;
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_PORTLOAD_H
@@ -25,7 +25,7 @@ class topoFatTree(Topology):
         Topology.__init__(self)
         self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_ups","_downs","_routers_per_level","_groups_per_level","_start_ids",
                                      "_total_hosts"])
-        self._declareParams("main",["shape","routing_alg","adaptive_threshold"])        
+        self._declareParams("main",["shape","routing_alg","adaptive_threshold","route_table","route_table_read","route_table_write"])        
         self._setCallbackOnWrite("shape",self._shape_callback)
         self._subscribeToPlatformParamSet("topology")
 
@@ -202,6 +202,7 @@ class topoTorus(_topoMeshBase):
 
     def __init__(self):
         _topoMeshBase.__init__(self)
+        self._declareParams("main",["algorithm"])
 
     def getName(self):
         return "Torus"
@@ -0,0 +1,147 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "routeTable.h"
+
+#include <stdio.h>
+
+using namespace SST::Merlin;
+
+const uint16_t RouteTable::LOCAL;
+const int RouteTable::MAX_EXPANSION;
+
+void
+RouteTable::expand()
+{
+    // Find the largest block size that every run boundary is aligned
+    // to.  Runs starting a new slice always start at 0.
+    shift = 0;
+    while ( (1 << (shift + 1)) < num_dests ) {
+        int mask = (1 << (shift + 1)) - 1;
+        bool aligned = true;
+        for ( const Run& run : runs ) {
+            if ( run.first & mask ) {
+                aligned = false;
+                break;
+            }
+        }
+        if ( !aligned ) break;
+        shift++;
+    }
+
+    slice_start.assign(num_slices + 1, runs.size());
+    for ( int i = runs.size() - 1; i >= 0; --i ) {
+        slice_start[runs[i].slice] = i;
+    }
+
+    stride = ((num_dests - 1) >> shift) + 1;
+    table.clear();
+    if ( (int64_t)num_slices * stride > (int64_t)MAX_EXPANSION * runs.size() ) {
+        // Too sparse to expand, lookups search the runs
+        table.shrink_to_fit();
+        return;
+    }
+    table.resize(num_slices * stride);
+
+    for ( size_t i = 0; i < runs.size(); ++i ) {
+        const Run& run = runs[i];
+        int last = num_dests;
+        if ( i + 1 < runs.size() && runs[i+1].slice == run.slice ) last = runs[i+1].first;
+        for ( int block = run.first >> shift; block < ((last - 1) >> shift) + 1; ++block ) {
+            table[run.slice * stride + block] = run.port;
+        }
+    }
+}
+
+int
+RouteTable::lookup_runs(int slice, int dest) const
+{
+    // Find the last run of the slice that starts at or before dest
+    int low = slice_start[slice];
+    int high = slice_start[slice + 1] - 1;
+    while ( low < high ) {
+        int mid = (low + high + 1) / 2;
+        if ( runs[mid].first <= dest ) low = mid;
+        else high = mid - 1;
+    }
+    return runs[low].port;
+}
+
+void
+RouteTable::read(const std::string& filename, int dests, int slices, int num_ports, Output& output)
+{
+    FILE* fp = fopen(filename.c_str(), "r");
+    if ( fp == NULL ) {
+        output.fatal(CALL_INFO, -1, "Unable to open route table file %s\n", filename.c_str());
+    }
+
+    // Skip the comment line
+    int c;
+    while ( (c = fgetc(fp)) != EOF && c != '\n' );
+
+    if ( fscanf(fp, "dests %d slices %d", &num_dests, &num_slices) != 2 ||
+         num_dests != dests || num_slices != slices ) {
+        output.fatal(CALL_INFO, -1, "Route table file %s does not match this router (expected %d dests and %d slices)\n",
+                     filename.c_str(), dests, slices);
+    }
+
+    // Each line is: slice first_dest last_dest port
+    runs.clear();
+    int slice, first, last, port;
+    int next = 0;
+    int curr_slice = 0;
+    while ( fscanf(fp, "%d %d %d %d", &slice, &first, &last, &port) == 4 ) {
+        if ( slice != curr_slice ) {
+            if ( slice != curr_slice + 1 || next != num_dests ) break;
+            curr_slice = slice;
+            next = 0;
+        }
+        if ( first != next || last < first || last >= num_dests ) break;
+        if ( port != LOCAL && (port < 0 || port >= num_ports) ) {
+            fclose(fp);
+            output.fatal(CALL_INFO, -1, "Route table file %s routes destinations %d to %d of slice %d to port %d, "
+                         "but the router only has %d ports\n", filename.c_str(), first, last, slice, port, num_ports);
+        }
+        runs.push_back(Run(slice, first, port));
+        next = last + 1;
+    }
+    fclose(fp);
+
+    if ( curr_slice != num_slices - 1 || next != num_dests ) {
+        output.fatal(CALL_INFO, -1, "Route table file %s is malformed or does not cover all destinations\n", filename.c_str());
+    }
+
+    expand();
+}
+
+void
+RouteTable::write(const std::string& filename, const std::string& header, Output& output) const
+{
+    FILE* fp = fopen(filename.c_str(), "w");
+    if ( fp == NULL ) {
+        output.fatal(CALL_INFO, -1, "Unable to open route table file %s for writing\n", filename.c_str());
+    }
+
+    fprintf(fp, "# %s\n", header.c_str());
+    fprintf(fp, "dests %d slices %d\n", num_dests, num_slices);
+    for ( size_t i = 0; i < runs.size(); ++i ) {
+        const Run& run = runs[i];
+        int last = num_dests - 1;
+        if ( i + 1 < runs.size() && runs[i+1].slice == run.slice ) last = runs[i+1].first - 1;
+        fprintf(fp, "%d %d %d %d\n", run.slice, run.first, last, run.port);
+    }
+    fclose(fp);
+}
@@ -0,0 +1,124 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
+#define COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
+
+#include <sst/core/output.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Precomputed destination to output port table for deterministic
+ * routing.
+ *
+ * The table is built from runs of consecutive destinations that
+ * leave on the same port, one set of runs per slice (for topologies
+ * where the route also depends on e.g. the global link slice).  The
+ * runs are what gets read from and written to file.  For lookups the
+ * runs are expanded into a flat array, where each entry covers a
+ * power of two sized block of destinations.  The block size is the
+ * largest one that all run boundaries are aligned to, so a lookup is
+ * a shift and a single indexed load.  If the flat array would be more
+ * than MAX_EXPANSION times the number of runs, it is not built and
+ * lookups do a binary search over the slice's runs instead.
+ */
+class RouteTable {
+public:
+    // Port value topologies can use to mark destinations that need
+    // special handling (e.g. delivery to a local host port)
+    static const uint16_t LOCAL = 0xffff;
+
+    // Largest flat table, in entries per run, built for lookups
+    static const int MAX_EXPANSION = 4;
+
+    RouteTable() :
+        num_dests(0),
+        num_slices(0),
+        shift(0),
+        stride(0)
+    {}
+
+    bool empty() const { return runs.empty(); }
+
+    // Builds the table by calling route(slice, dest), which returns
+    // the output port for dest when routing on the given slice
+    template <typename F>
+    void generate(int dests, int slices, F route) {
+        num_dests = dests;
+        num_slices = slices;
+        runs.clear();
+        for ( int s = 0; s < slices; ++s ) {
+            for ( int d = 0; d < dests; ++d ) {
+                uint16_t port = route(s, d);
+                if ( d == 0 || runs.back().port != port ) {
+                    runs.push_back(Run(s, d, port));
+                }
+            }
+        }
+        expand();
+    }
+
+    // Reads the runs from filename and builds the table.  Fatal if
+    // the file does not match the expected number of destinations and
+    // slices, or names a port other than LOCAL that the router does
+    // not have.
+    void read(const std::string& filename, int dests, int slices, int num_ports, Output& output);
+
+    // Writes the runs to filename, header is written as a comment on
+    // the first line
+    void write(const std::string& filename, const std::string& header, Output& output) const;
+
+    inline int lookup(int slice, int dest) const {
+        if ( table.empty() ) return lookup_runs(slice, dest);
+        return table[slice * stride + (dest >> shift)];
+    }
+
+private:
+    struct Run {
+        int slice;
+        int first;
+        uint16_t port;
+
+        Run(int slice, int first, uint16_t port) :
+            slice(slice), first(first), port(port) {}
+    };
+
+    void expand();
+    int lookup_runs(int slice, int dest) const;
+
+    int num_dests;
+    int num_slices;
+    int shift;
+    int stride;
+
+    std::vector<Run> runs;
+    // Index of the first run of each slice, plus one past the last run
+    std::vector<int> slice_start;
+    std::vector<uint16_t> table;
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
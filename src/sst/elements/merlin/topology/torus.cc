@@ -15,6 +15,8 @@
 #include <sst_config.h>
 #include "torus.h"
 
+#include "sst/core/rng/xorshift.h"
+
 #include <algorithm>
 #include <stdlib.h>
 
@@ -82,10 +84,49 @@ topo_torus::topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr
 
     id_loc = new int[dimensions];
     idToLocation(router_id, id_loc);
+
+    vns = new vn_info[num_vns];
+
+    std::vector<std::string> vn_route_algos;
+    if ( params.is_value_array("algorithm") ) {
+        params.find_array<std::string>("algorithm", vn_route_algos);
+        if ( vn_route_algos.size() != num_vns ) {
+            output.fatal(CALL_INFO, -1, "ERROR: When specifying routing algorithms per VN, algorithm list length must match number of VNs (%d VNs, %lu algorithms).\n",num_vns,vn_route_algos.size());
+        }
+    }
+    else {
+        std::string route_algo = params.find<std::string>("algorithm", "DOR");
+        for ( int i = 0; i < num_vns; ++i ) vn_route_algos.push_back(route_algo);
+    }
+
+    // Setup the routing algorithms.  DOR uses a pair of VCs to break
+    // the cycle at the dateline.  Adaptive adds a third VC that can
+    // be used on any minimal route and falls back to the DOR pair as
+    // escape VCs.
+    int curr_vc = 0;
+    for ( int i = 0; i < num_vns; ++i ) {
+        vns[i].start_vc = curr_vc;
+        if ( !vn_route_algos[i].compare("DOR") ) {
+            vns[i].algorithm = DOR;
+            vns[i].num_vcs = 2;
+        }
+        else if ( !vn_route_algos[i].compare("adaptive") ) {
+            vns[i].algorithm = ADAPTIVE;
+            vns[i].num_vcs = 3;
+        }
+        else {
+            output.fatal(CALL_INFO,-1,"Unknown routing mode specified: %s\n",vn_route_algos[i].c_str());
+        }
+        curr_vc += vns[i].num_vcs;
+    }
+
+    rng = new RNG::XORShiftRNG(router_id+1);
 }
 
 topo_torus::~topo_torus()
 {
+    delete rng;
+    delete [] vns;
     delete [] id_loc;
     delete [] dim_size;
     delete [] dim_width;
@@ -95,11 +136,24 @@ topo_torus::~topo_torus()
 void
 topo_torus::route_packet(int port, int vc, internal_router_event* ev)
 {
-    int dest_router = get_dest_router(ev->getDest());
+    topo_torus_event *tt_ev = static_cast<topo_torus_event*>(ev);
+    if ( vns[ev->getVN()].algorithm == ADAPTIVE ) {
+        route_adaptive(port, vc, tt_ev);
+    }
+    else {
+        route_dor(port, vc, tt_ev);
+    }
+}
+
+
+void
+topo_torus::route_dor(int port, int vc, topo_torus_event* tt_ev)
+{
+    int dest_router = get_dest_router(tt_ev->getDest());
     if ( dest_router == router_id ) {
-        ev->setNextPort(get_dest_local_port(ev->getDest()));
+        tt_ev->setNextPort(get_dest_local_port(tt_ev->getDest()));
     } else {
-        topo_torus_event *tt_ev = static_cast<topo_torus_event*>(ev);
+        int start_vc = vns[tt_ev->getVN()].start_vc;
 
         for ( int dim = tt_ev->routing_dim ; dim < dimensions ; dim++ ) {
             if ( tt_ev->dest_loc[dim] != id_loc[dim] ) {
@@ -123,7 +177,7 @@ topo_torus::route_packet(int port, int vc, internal_router_event* ev)
                 tt_ev->setNextPort(p);
 
                 if ( id_loc[dim] == 0 && port < local_port_start ) { // Crossing dateline
-                    int new_vc = vc ^ 1;
+                    int new_vc = start_vc + ((vc - start_vc) ^ 1);
                     tt_ev->setVC(new_vc); // Toggle VC
                     output.verbose(CALL_INFO, 1, 1, "Crossing dateline.  Changing from VC %d to %d\n", vc, new_vc);
                 }
@@ -133,7 +187,7 @@ topo_torus::route_packet(int port, int vc, internal_router_event* ev)
             } else {
                 // Time to change direction
                 tt_ev->routing_dim++;
-                tt_ev->setVC(vc & (~1)); // Reset the VC
+                tt_ev->setVC(start_vc); // Reset the VC
             }
         }
     }
@@ -146,7 +200,7 @@ topo_torus::process_input(RtrEvent* ev)
 {
     topo_torus_event* tt_ev = new topo_torus_event(dimensions);
     tt_ev->setEncapsulatedEvent(ev);
-    tt_ev->setVC(tt_ev->getVN() * 2);
+    tt_ev->setVC(vns[tt_ev->getVN()].start_vc);
     
     // Need to figure out what the torus address is for easier
     // routing.
@@ -189,7 +243,8 @@ void topo_torus::routeInitData(int port, internal_router_event* ev, std::vector<
 
 
     } else {
-        route_packet(port, 0, ev);
+        // Queue lengths are not available yet, so always use DOR
+        route_dor(port, vns[ev->getVN()].start_vc, static_cast<topo_torus_event*>(ev));
         outPorts.push_back(ev->getNextPort());
     }
 }
@@ -284,4 +339,78 @@ topo_torus::getEndpointID(int port)
     return (router_id * num_local_ports) + (port - local_port_start);
 }
 
+void
+topo_torus::setOutputQueueLengthsArray(int const* array, int vcs)
+{
+    output_queue_lengths = array;
+    num_vcs = vcs;
+    port_loads.setQueueLengthsArray(array, local_port_start, vcs);
+    port_weights.resize(local_port_start);
+}
+
+
+void
+topo_torus::route_adaptive(int port, int vc, topo_torus_event* tt_ev)
+{
+    int dest_router = get_dest_router(tt_ev->getDest());
+    if ( dest_router == router_id ) {
+        tt_ev->setNextPort(get_dest_local_port(tt_ev->getDest()));
+        return;
+    }
+
+    int start_vc = vns[tt_ev->getVN()].start_vc;
+    int adaptive_vc = start_vc + 2;
+    SimTime_t now = getCurrentSimCycle();
+    int const* loads = port_loads.getLoads(adaptive_vc, now);
+
+    // Weigh the links in every minimal direction by their queue
+    // length on the adaptive VC.  Everything else is never taken.
+    // The escape route is the dimension order route in the first
+    // unaligned dimension.
+    int* weights = port_weights.data();
+    for ( int i = 0; i < local_port_start; ++i ) {
+        weights[i] = std::numeric_limits<int>::max();
+    }
+
+    int escape_port = -1;
+    int escape_vc = start_vc;
+    for ( int dim = 0 ; dim < dimensions ; dim++ ) {
+        if ( tt_ev->dest_loc[dim] == id_loc[dim] ) continue;
+
+        int dist_neg = id_loc[dim] - tt_ev->dest_loc[dim];
+        if ( dist_neg < 0 ) dist_neg += dim_size[dim];
+        int dist_pos = tt_ev->dest_loc[dim] - id_loc[dim];
+        if ( dist_pos < 0 ) dist_pos += dim_size[dim];
+
+        for ( int dir = 0; dir < 2; ++dir ) {
+            if ( (dir == 0 && dist_pos > dist_neg) || (dir == 1 && dist_neg > dist_pos) ) continue;
+            int start = port_start[dim][dir];
+            for ( int i = start; i < start + dim_width[dim]; ++i ) {
+                weights[i] = loads[i];
+            }
+        }
+
+        if ( escape_port == -1 ) {
+            int go_pos = (dist_pos <= dist_neg);
+            escape_port = choose_multipath(port_start[dim][(go_pos) ? 0 : 1], dim_width[dim],
+                                           (go_pos) ? dist_pos : dist_neg);
+            // The escape VCs are split by whether the rest of the
+            // path in this dimension still crosses the dateline
+            bool crosses = go_pos ? (tt_ev->dest_loc[dim] < id_loc[dim]) : (tt_ev->dest_loc[dim] > id_loc[dim]);
+            escape_vc = crosses ? start_vc : start_vc + 1;
+        }
+    }
 
+    // Take the least loaded adaptive route unless the escape route is
+    // less loaded
+    int min_port = PortLoadSnapshot::selectMin(weights, local_port_start, rng);
+    int escape_load = port_loads.getLoads(escape_vc, now)[escape_port];
+    if ( weights[min_port] <= escape_load ) {
+        tt_ev->setNextPort(min_port);
+        tt_ev->setVC(adaptive_vc);
+    }
+    else {
+        tt_ev->setNextPort(escape_port);
+        tt_ev->setVC(escape_vc);
+    }
+}
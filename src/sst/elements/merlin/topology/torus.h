@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/portLoad.h"
 
 namespace SST {
 namespace Merlin {
@@ -94,8 +95,14 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  For "
                   "example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
+        {"algorithm", "Routing algorithm to use [DOR (default) | adaptive].  Can be specified per VN as an array.", "DOR"},
     )
 
+    enum RouteAlgo {
+        DOR,
+        ADAPTIVE
+    };
+
 
 private:
     int router_id;
@@ -111,7 +118,24 @@ private:
     int local_port_start;
 
     int num_vns;
-    
+
+    int const* output_queue_lengths;
+    int num_vcs;
+
+    PortLoadSnapshot port_loads;
+    // Scratch space for per-port weights
+    std::vector<int> port_weights;
+
+    struct vn_info {
+        int start_vc;
+        int num_vcs;
+        RouteAlgo algorithm;
+    };
+
+    vn_info* vns;
+
+    RNG::SSTRandom* rng;
+
 public:
     topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns);
     ~topo_torus();
@@ -127,9 +151,11 @@ public:
 
     virtual void getVCsPerVN(std::vector<int>& vcs_per_vn) {
         for ( int i = 0; i < num_vns; ++i ) {
-            vcs_per_vn[i] = 2;
+            vcs_per_vn[i] = vns[i].num_vcs;
         }
     }
+
+    virtual void setOutputQueueLengthsArray(int const* array, int vcs);
     
 protected:
     virtual int choose_multipath(int start_port, int num_ports, int dest_dist);
@@ -140,6 +166,8 @@ private:
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
 
+    void route_dor(int port, int vc, topo_torus_event* ev);
+    void route_adaptive(int port, int vc, topo_torus_event* ev);
 };
 
 }
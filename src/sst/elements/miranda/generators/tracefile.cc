@@ -0,0 +1,374 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sst/elements/miranda/generators/tracefile.h>
+
+#ifdef HAVE_LIBZ
+#include "zlib.h"
+#endif
+
+using namespace SST::Miranda;
+
+MirandaTraceWriter::MirandaTraceWriter() : file(NULL), compressBlocks(true) {
+	memset(&header, 0, sizeof(header));
+}
+
+MirandaTraceWriter::~MirandaTraceWriter() {
+	close();
+}
+
+bool MirandaTraceWriter::open(const std::string& path, const uint32_t recordsPerBlock, const bool compress) {
+	file = fopen(path.c_str(), "wb");
+
+	if(NULL == file) {
+		return false;
+	}
+
+	compressBlocks = compress;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MIRANDA_TRACE_MAGIC, sizeof(header.magic));
+	header.version = MIRANDA_TRACE_VERSION;
+	header.recordsPerBlock = (0 == recordsPerBlock) ? 1 : recordsPerBlock;
+
+	block.clear();
+	block.reserve(header.recordsPerBlock);
+
+	// Counts are filled in when the trace is closed
+	return 1 == fwrite(&header, sizeof(header), 1, file);
+}
+
+bool MirandaTraceWriter::append(const MirandaTraceRecord& record) {
+	if(NULL == file) {
+		return false;
+	}
+
+	block.push_back(record);
+	header.recordCount++;
+
+	if(block.size() == header.recordsPerBlock) {
+		return flushBlock();
+	}
+
+	return true;
+}
+
+bool MirandaTraceWriter::flushBlock() {
+	if(block.empty()) {
+		return true;
+	}
+
+	const uint8_t* raw = reinterpret_cast<const uint8_t*>(&block[0]);
+	const size_t rawBytes = block.size() * sizeof(MirandaTraceRecord);
+
+	MirandaTraceBlockHeader blockHeader;
+	blockHeader.compressed = 0;
+	blockHeader.recordCount = (uint32_t) block.size();
+	blockHeader.storedBytes = rawBytes;
+
+	const uint8_t* stored = raw;
+
+#ifdef HAVE_LIBZ
+	if(compressBlocks) {
+		uLongf compressedBytes = compressBound(rawBytes);
+		compressBuffer.resize(compressedBytes);
+
+		if(Z_OK == compress2(&compressBuffer[0], &compressedBytes, raw, rawBytes, Z_DEFAULT_COMPRESSION) &&
+				compressedBytes < rawBytes) {
+			blockHeader.compressed = 1;
+			blockHeader.storedBytes = compressedBytes;
+			stored = &compressBuffer[0];
+		}
+	}
+#endif
+
+	block.clear();
+	header.blockCount++;
+
+	return 1 == fwrite(&blockHeader, sizeof(blockHeader), 1, file) &&
+		blockHeader.storedBytes == fwrite(stored, 1, blockHeader.storedBytes, file);
+}
+
+bool MirandaTraceWriter::close() {
+	if(NULL == file) {
+		return true;
+	}
+
+	bool success = flushBlock();
+
+	success = success && (0 == fseek(file, 0, SEEK_SET));
+	success = success && (1 == fwrite(&header, sizeof(header), 1, file));
+	success = (0 == fclose(file)) && success;
+
+	file = NULL;
+	return success;
+}
+
+MirandaTraceReader::MirandaTraceReader() :
+	mapped(NULL), mappedBytes(0), recordCount(0), recordsPerBlock(0) {}
+
+MirandaTraceReader::~MirandaTraceReader() {
+	close();
+}
+
+bool MirandaTraceReader::open(const std::string& path) {
+	close();
+
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0) {
+		error = "unable to open the trace file";
+		return false;
+	}
+
+	struct stat fileInfo;
+	if(0 != fstat(fd, &fileInfo) || (size_t) fileInfo.st_size < sizeof(MirandaTraceHeader)) {
+		::close(fd);
+		error = "trace file is too short to hold a trace header";
+		return false;
+	}
+
+	void* region = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+
+	if(MAP_FAILED == region) {
+		error = "unable to map the trace file";
+		return false;
+	}
+
+	mapped = static_cast<const uint8_t*>(region);
+	mappedBytes = fileInfo.st_size;
+
+	// Blocks are consumed in order, let the kernel read ahead
+	madvise(region, mappedBytes, MADV_SEQUENTIAL);
+
+	MirandaTraceHeader header;
+	memcpy(&header, mapped, sizeof(header));
+
+	if(0 != memcmp(header.magic, MIRANDA_TRACE_MAGIC, sizeof(header.magic))) {
+		close();
+		error = "file is not a Miranda trace";
+		return false;
+	}
+
+	if(MIRANDA_TRACE_VERSION != header.version) {
+		close();
+		error = "unsupported Miranda trace version";
+		return false;
+	}
+
+	recordsPerBlock = header.recordsPerBlock;
+
+	// Walk the block headers once so blocks can be found directly
+	size_t offset = sizeof(header);
+	uint64_t records = 0;
+
+	for(uint64_t i = 0; i < header.blockCount; ++i) {
+		MirandaTraceBlockHeader blockHeader;
+
+		if(offset + sizeof(blockHeader) > mappedBytes) {
+			close();
+			error = "trace file is truncated";
+			return false;
+		}
+
+		memcpy(&blockHeader, mapped + offset, sizeof(blockHeader));
+
+		if(blockHeader.storedBytes > mappedBytes - offset - sizeof(blockHeader)) {
+			close();
+			error = "trace file is truncated";
+			return false;
+		}
+
+		blockOffsets.push_back(offset);
+		records += blockHeader.recordCount;
+		offset += sizeof(blockHeader) + blockHeader.storedBytes;
+	}
+
+	if(records != header.recordCount) {
+		close();
+		error = "trace record count does not match its blocks";
+		return false;
+	}
+
+	recordCount = records;
+	return true;
+}
+
+void MirandaTraceReader::close() {
+	if(NULL != mapped) {
+		munmap(const_cast<uint8_t*>(mapped), mappedBytes);
+	}
+
+	mapped = NULL;
+	mappedBytes = 0;
+	recordCount = 0;
+	blockOffsets.clear();
+	error.clear();
+}
+
+bool MirandaTraceReader::readBlock(const uint64_t block, std::vector<MirandaTraceRecord>* records, std::string* message) const {
+	if(block >= blockOffsets.size()) {
+		*message = "trace block is out of range";
+		return false;
+	}
+
+	MirandaTraceBlockHeader blockHeader;
+	memcpy(&blockHeader, mapped + blockOffsets[block], sizeof(blockHeader));
+
+	const uint8_t* stored = mapped + blockOffsets[block] + sizeof(blockHeader);
+	const size_t rawBytes = (size_t) blockHeader.recordCount * sizeof(MirandaTraceRecord);
+
+	records->resize(blockHeader.recordCount);
+
+	if(0 == rawBytes) {
+		return true;
+	}
+
+	if(blockHeader.compressed) {
+#ifdef HAVE_LIBZ
+		uLongf decodedBytes = rawBytes;
+
+		if(Z_OK != uncompress(reinterpret_cast<uint8_t*>(&(*records)[0]), &decodedBytes, stored, blockHeader.storedBytes) ||
+				decodedBytes != rawBytes) {
+			*message = "unable to decompress a trace block";
+			return false;
+		}
+#else
+		*message = "trace is compressed but Miranda was built without libz";
+		return false;
+#endif
+	} else {
+		if(blockHeader.storedBytes != rawBytes) {
+			*message = "trace block size does not match its record count";
+			return false;
+		}
+
+		memcpy(&(*records)[0], stored, rawBytes);
+	}
+
+	return true;
+}
+
+MirandaTracePrefetcher::MirandaTracePrefetcher(const MirandaTraceReader* traceReader, const uint32_t ringBlocks) :
+	reader(traceReader), ring((0 == ringBlocks) ? 1 : ringBlocks),
+	consumeBlock(0), consumeRecord(0), holdingSlot(false), stopping(false) {
+
+	for(size_t i = 0; i < ring.size(); ++i) {
+		ring[i].full = false;
+		ring[i].failed = false;
+	}
+}
+
+MirandaTracePrefetcher::~MirandaTracePrefetcher() {
+	stop();
+}
+
+void MirandaTracePrefetcher::start() {
+	helper = std::thread(&MirandaTracePrefetcher::decodeBlocks, this);
+}
+
+void MirandaTracePrefetcher::stop() {
+	{
+		std::lock_guard<std::mutex> guard(ringLock);
+		stopping = true;
+	}
+
+	ringChanged.notify_all();
+
+	if(helper.joinable()) {
+		helper.join();
+	}
+}
+
+void MirandaTracePrefetcher::decodeBlocks() {
+	for(uint64_t block = 0; block < reader->getBlockCount(); ++block) {
+		Slot& slot = ring[block % ring.size()];
+
+		{
+			std::unique_lock<std::mutex> guard(ringLock);
+			ringChanged.wait(guard, [&] { return stopping || !slot.full; });
+
+			if(stopping) {
+				return;
+			}
+		}
+
+		// The slot is empty so the consumer will not touch it while it is filled
+		slot.failed = !reader->readBlock(block, &slot.records, &slot.message);
+
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			slot.full = true;
+		}
+
+		ringChanged.notify_all();
+
+		if(slot.failed) {
+			return;
+		}
+	}
+}
+
+bool MirandaTracePrefetcher::advanceBlock() {
+	if(holdingSlot) {
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			ring[consumeBlock % ring.size()].full = false;
+		}
+
+		ringChanged.notify_all();
+
+		holdingSlot = false;
+		consumeBlock++;
+		consumeRecord = 0;
+	}
+
+	if(consumeBlock >= reader->getBlockCount()) {
+		return false;
+	}
+
+	Slot& slot = ring[consumeBlock % ring.size()];
+
+	{
+		std::unique_lock<std::mutex> guard(ringLock);
+		ringChanged.wait(guard, [&] { return slot.full; });
+	}
+
+	if(slot.failed) {
+		error = slot.message;
+		return false;
+	}
+
+	holdingSlot = true;
+	return true;
+}
+
+const MirandaTraceRecord* MirandaTracePrefetcher::next() {
+	while(!holdingSlot || consumeRecord >= ring[consumeBlock % ring.size()].records.size()) {
+		if(!advanceBlock()) {
+			return NULL;
+		}
+	}
+
+	return &ring[consumeBlock % ring.size()].records[consumeRecord++];
+}
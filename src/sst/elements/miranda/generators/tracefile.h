@@ -0,0 +1,180 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_TRACE_FILE
+#define _H_SST_MIRANDA_TRACE_FILE
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Binary Miranda trace files.
+ *
+ * A trace starts with a header giving the record and block counts and is
+ * followed by blocks of fixed size records. Each block has a small header
+ * and is compressed with zlib when Miranda is built with libz (blocks which
+ * do not shrink are stored as they are). All fields are in host byte order.
+ *
+ * A record is a read, a write or a fence. It may depend on up to
+ * MIRANDA_TRACE_MAX_DEPS earlier records, given as distances back from the
+ * record (1 is the record immediately before it).
+ */
+
+#define MIRANDA_TRACE_MAGIC     "MIRTRACE"
+#define MIRANDA_TRACE_VERSION   1
+#define MIRANDA_TRACE_MAX_DEPS  2
+
+typedef enum {
+	MIRANDA_TRACE_READ  = 0,
+	MIRANDA_TRACE_WRITE = 1,
+	MIRANDA_TRACE_FENCE = 2
+} MirandaTraceOp;
+
+struct MirandaTraceHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t recordsPerBlock;
+	uint64_t recordCount;
+	uint64_t blockCount;
+};
+
+struct MirandaTraceBlockHeader {
+	uint32_t compressed;
+	uint32_t recordCount;
+	uint64_t storedBytes;
+};
+
+struct MirandaTraceRecord {
+	uint64_t address;
+	uint32_t length;
+	uint8_t  op;
+	uint8_t  depCount;
+	uint16_t reserved;
+	uint32_t deps[MIRANDA_TRACE_MAX_DEPS];
+};
+
+class MirandaTraceWriter {
+public:
+	MirandaTraceWriter();
+	~MirandaTraceWriter();
+
+	// Returns false if the file could not be created, blocks are stored
+	// uncompressed if compress is false (or Miranda was built without libz)
+	bool open(const std::string& path, const uint32_t recordsPerBlock, const bool compress = true);
+	bool append(const MirandaTraceRecord& record);
+	bool close();
+
+	uint64_t getRecordCount() const { return header.recordCount; }
+
+private:
+	bool flushBlock();
+
+	FILE* file;
+	bool compressBlocks;
+	MirandaTraceHeader header;
+	std::vector<MirandaTraceRecord> block;
+	std::vector<uint8_t> compressBuffer;
+};
+
+/*
+ * Read only view of a trace. The whole file is mapped, so decoding a block
+ * is a decompression straight out of the page cache. Blocks may be read
+ * from several threads at once.
+ */
+class MirandaTraceReader {
+public:
+	MirandaTraceReader();
+	~MirandaTraceReader();
+
+	// Returns false and sets the error if the file is not a readable trace
+	bool open(const std::string& path);
+	void close();
+
+	uint64_t getRecordCount() const { return recordCount; }
+	uint64_t getBlockCount() const { return blockOffsets.size(); }
+	const std::string& getError() const { return error; }
+
+	// Decode a block into records, returns false with a message on error
+	bool readBlock(const uint64_t block, std::vector<MirandaTraceRecord>* records, std::string* message) const;
+
+private:
+	const uint8_t* mapped;
+	size_t mappedBytes;
+	uint64_t recordCount;
+	uint32_t recordsPerBlock;
+	std::vector<size_t> blockOffsets;
+	std::string error;
+};
+
+/*
+ * Decodes the blocks of a trace in order on a helper thread into a ring of
+ * blocks, so the consumer only waits when decompression falls behind.
+ */
+class MirandaTracePrefetcher {
+public:
+	MirandaTracePrefetcher(const MirandaTraceReader* traceReader, const uint32_t ringBlocks);
+	~MirandaTracePrefetcher();
+
+	void start();
+	void stop();
+
+	/*
+	 * Next record of the trace, NULL at the end of the trace or on error
+	 * (check getError()). The record stays valid until the next call.
+	 */
+	const MirandaTraceRecord* next();
+
+	const std::string& getError() const { return error; }
+
+private:
+	struct Slot {
+		std::vector<MirandaTraceRecord> records;
+		bool full;
+		bool failed;
+		std::string message;
+	};
+
+	void decodeBlocks();
+	bool advanceBlock();
+
+	const MirandaTraceReader* reader;
+	std::vector<Slot> ring;
+
+	// Consumer position
+	uint64_t consumeBlock;
+	size_t consumeRecord;
+	bool holdingSlot;
+	std::string error;
+
+	std::thread helper;
+	std::mutex ringLock;
+	std::condition_variable ringChanged;
+	bool stopping;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,127 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/tracegen.h>
+
+using namespace SST::Miranda;
+
+TraceGenerator::TraceGenerator( ComponentId_t id, Params& params ) :
+	RequestGenerator(id, params), prefetcher(NULL) {
+	build(params);
+}
+
+void TraceGenerator::build(Params& params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+
+	out = new Output("TraceGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string traceFile = params.find<std::string>("tracefile", "");
+	if("" == traceFile) {
+		out->fatal(CALL_INFO, -1, "Error: the tracefile parameter naming the trace to replay was not specified\n");
+	}
+
+	if(!reader.open(traceFile)) {
+		out->fatal(CALL_INFO, -1, "Error: %s: %s\n", traceFile.c_str(), reader.getError().c_str());
+	}
+
+	requestsPerCall = params.find<uint64_t>("requests_per_call", 1);
+	if(0 == requestsPerCall) {
+		requestsPerCall = 1;
+	}
+
+	const uint64_t prefetchBlocks = params.find<uint64_t>("prefetch_blocks", 4);
+	const uint64_t depWindow = params.find<uint64_t>("dependency_window", 4096);
+
+	uint64_t recentSize = 1;
+	while(recentSize < depWindow) {
+		recentSize <<= 1;
+	}
+
+	recentRequests.resize(recentSize, 0);
+	recentMask = recentSize - 1;
+	recordIndex = 0;
+
+	out->verbose(CALL_INFO, 1, 0, "Trace file:         %s\n", traceFile.c_str());
+	out->verbose(CALL_INFO, 1, 0, "Trace records:      %" PRIu64 "\n", reader.getRecordCount());
+	out->verbose(CALL_INFO, 1, 0, "Trace blocks:       %" PRIu64 "\n", reader.getBlockCount());
+	out->verbose(CALL_INFO, 1, 0, "Prefetch blocks:    %" PRIu64 "\n", prefetchBlocks);
+	out->verbose(CALL_INFO, 1, 0, "Dependency window:  %" PRIu64 "\n", recentSize);
+
+	prefetcher = new MirandaTracePrefetcher(&reader, (uint32_t) prefetchBlocks);
+	prefetcher->start();
+}
+
+TraceGenerator::~TraceGenerator() {
+	delete prefetcher;
+	delete out;
+}
+
+void TraceGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	for(uint64_t j = 0; j < requestsPerCall && !isFinished(); ++j) {
+		const MirandaTraceRecord* record = prefetcher->next();
+
+		if(NULL == record) {
+			out->fatal(CALL_INFO, -1, "Error: trace ended after %" PRIu64 " of %" PRIu64 " records: %s\n",
+				recordIndex, reader.getRecordCount(), prefetcher->getError().c_str());
+		}
+
+		GeneratorRequest* req = NULL;
+
+		switch(record->op) {
+		case MIRANDA_TRACE_READ:
+			out->verbose(CALL_INFO, 8, 0, "Issuing READ request for address %" PRIu64 "\n", record->address);
+			req = new MemoryOpRequest(record->address, record->length, READ);
+			break;
+		case MIRANDA_TRACE_WRITE:
+			out->verbose(CALL_INFO, 8, 0, "Issuing WRITE request for address %" PRIu64 "\n", record->address);
+			req = new MemoryOpRequest(record->address, record->length, WRITE);
+			break;
+		case MIRANDA_TRACE_FENCE:
+			out->verbose(CALL_INFO, 8, 0, "Issuing FENCE request\n");
+			req = new FenceOpRequest();
+			break;
+		default:
+			out->fatal(CALL_INFO, -1, "Error: trace record %" PRIu64 " has unknown operation %" PRIu32 "\n",
+				recordIndex, (uint32_t) record->op);
+		}
+
+		for(uint32_t k = 0; k < record->depCount && k < MIRANDA_TRACE_MAX_DEPS; ++k) {
+			const uint64_t distance = record->deps[k];
+
+			if(0 == distance || distance > recordIndex || distance > recentRequests.size()) {
+				out->verbose(CALL_INFO, 4, 0, "Dependency of record %" PRIu64 " on %" PRIu64 " records back is outside the window, ignored\n",
+					recordIndex, distance);
+				continue;
+			}
+
+			req->addDependency(recentRequests[(recordIndex - distance) & recentMask]);
+		}
+
+		recentRequests[recordIndex & recentMask] = req->getRequestID();
+		recordIndex++;
+
+		q->push_back(req);
+	}
+}
+
+bool TraceGenerator::isFinished() {
+	return recordIndex >= reader.getRecordCount();
+}
+
+void TraceGenerator::completed() {
+	prefetcher->stop();
+}
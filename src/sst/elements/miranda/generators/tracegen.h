@@ -0,0 +1,73 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_TRACE_GEN
+#define _H_SST_MIRANDA_TRACE_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/miranda/generators/tracefile.h>
+#include <sst/core/output.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+class TraceGenerator : public RequestGenerator {
+
+public:
+	TraceGenerator( ComponentId_t id, Params& params );
+	void build(Params& params);
+	~TraceGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		TraceGenerator,
+		"miranda",
+		"TraceGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Replays a block compressed binary Miranda trace, decompressing ahead on a helper thread",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "tracefile",        "Binary Miranda trace to replay", "" },
+		{ "prefetch_blocks",  "Number of trace blocks decompressed ahead of the requests being generated", "4" },
+		{ "requests_per_call", "Number of trace records turned into requests each time the CPU asks for more", "1" },
+		{ "dependency_window", "Number of recent records whose requests can be named as dependencies, older dependencies are treated as satisfied", "4096" }
+	)
+
+private:
+	Output* out;
+
+	MirandaTraceReader reader;
+	MirandaTracePrefetcher* prefetcher;
+
+	uint64_t requestsPerCall;
+	uint64_t recordIndex;
+
+	// Request IDs of the most recent records, indexed by record number
+	std::vector<uint64_t> recentRequests;
+	uint64_t recentMask;
+};
+
+}
+}
+
+#endif
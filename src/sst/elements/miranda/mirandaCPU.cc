@@ -72,6 +72,7 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
         stdMemHandlers = new StdMemHandler(this, out);
 
 	maxOpLookup = params.find<uint64_t>("max_reorder_lookups", 16);
+	pendingRequests = new MirandaDependencyGraph(maxOpLookup);
 
 	out->verbose(CALL_INFO, 1, 0, "Loaded memory interface successfully.\n");
 
@@ -169,6 +170,7 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 }
 
 RequestGenCPU::~RequestGenCPU() {
+	delete pendingRequests;
 	delete out;
 }
 
@@ -193,6 +195,26 @@ void RequestGenCPU::handleSrcEvent( Event* ev ) {
 	srcReqEvent = event;
 }
 
+void RequestGenCPU::enqueueGenerated() {
+	// Announce the whole batch first so requests may depend on later ones in it
+	for(uint32_t i = 0; i < generatedRequests.size(); ++i) {
+		pendingRequests->expect(generatedRequests.at(i)->getRequestID());
+	}
+
+	for(uint32_t i = 0; i < generatedRequests.size(); ++i) {
+		GeneratorRequest* nxtRq = generatedRequests.at(i);
+		const ReqOperation op = nxtRq->getOperation();
+
+		if(op != READ && op != WRITE && op != CUSTOM && op != REQ_FENCE) {
+			out->fatal(CALL_INFO, -1, "Error, invalid operation \n");
+		}
+
+		pendingRequests->add(nxtRq);
+	}
+
+	generatedRequests.clear();
+}
+
 void RequestGenCPU::loadGenerator( MirandaReqEvent* event ) {
 
 	std::string& generator = event->generators.front().first;
@@ -242,10 +264,8 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 			out->verbose(CALL_INFO, 4, 0, "-> Entry has all parts satisfied, removing ID=%" PRIu64 ", total processing time: %" PRIu64 "ns\n",
 				cpuReq->getOriginalReqID(), (getCurrentSimTimeNano() - cpuReq->getIssueTime()));
 
-			// Notify every pending request that there may be a satisfied dependency
-			for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
-			}
+			// Release the pending requests which depend on this one
+			pendingRequests->complete(cpuReq->getOriginalReqID());
 
 			delete cpuReq;
 		}
@@ -383,6 +403,44 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
     }
 }
 
+bool RequestGenCPU::slotsFull(const ReqOperation op) const {
+    return requestsPending[op] >= maxRequestsPending[op];
+}
+
+bool RequestGenCPU::fenceCanRetire() const {
+    if(0 == requestsInFlight.size()) {
+        out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
+        return true;
+    }
+
+    out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
+    return false;
+}
+
+void RequestGenCPU::retireFence(GeneratorRequest* fence) {
+    delete fence;
+}
+
+void RequestGenCPU::issue(GeneratorRequest* req, const uint32_t issuedThisCycle) {
+    out->verbose(CALL_INFO, 4, 0, "Will attempt to issue as free slots in the load/store unit.\n");
+    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
+            req->getRequestID(), issuedThisCycle);
+
+    if(CUSTOM == req->getOperation()) {
+        issueCustomRequest(static_cast<CustomOpRequest*>(req));
+    } else {
+        MemoryOpRequest* memOpReq = dynamic_cast<MemoryOpRequest*>(req);
+
+        if(NULL == memOpReq) {
+            out->fatal(CALL_INFO, -1, "Error, invalid operation \n");
+        }
+
+        issueRequest(memOpReq);
+    }
+
+    delete req;
+}
+
 bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     if ( ! reqGen ) {
@@ -392,7 +450,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
     statCycles->addData(1);
 
     if (reqGen->isFinished()) {
-        if ( (pendingRequests.size() == 0) &&
+        if ( pendingRequests->empty() && generatedRequests.empty() &&
                 (0 == requestsPending[READ]) &&
                 (0 == requestsPending[WRITE]) &&
                 (0 == requestsPending[CUSTOM]) ) {
@@ -436,105 +494,45 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
     out->verbose(CALL_INFO, 2, 0, "Custom Requests pending %" PRIu32 ", maximum permitted %" PRIu32 ".\n",
             requestsPending[CUSTOM], maxRequestsPending[CUSTOM]);
 
-    bool issued = false;
     uint32_t reqsIssuedThisCycle = 0;
-    std::vector<uint32_t> delReqs;
+
+    // Pick up anything the generator queued outside of generate()
+    enqueueGenerated();
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
-    for(int i = pendingRequests.size(); i < maxOpLookup; ++i) {
+    for(int i = pendingRequests->size(); i < maxOpLookup; ++i) {
         if( reqGen->isFinished()) {
             break;
     	} else {
-            reqGen->generate(&pendingRequests);
+            reqGen->generate(&generatedRequests);
+            enqueueGenerated();
     	}
     }
 
-    for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-        if(reqsIssuedThisCycle == reqMaxPerCycle) {
-            statMaxIssuePerCycle->addData(1);
-            break;
-    	}
-
-	// Only a certain number of lookups are allowed, if we exceed this then we
+    // Walk the pending requests in generation order, see MirandaDependencyGraph::issue
+    switch(pendingRequests->issue(*this, reqMaxPerCycle, &reqsIssuedThisCycle)) {
+    case ISSUE_MAX_PER_CYCLE:
+        statMaxIssuePerCycle->addData(1);
+        break;
+    case ISSUE_REORDER_LIMIT:
+        // Only a certain number of lookups are allowed, if we exceed this then we
         // must exit the issue loop
-    	if(i == maxOpLookup) {
-            out->verbose(CALL_INFO, 2, 0, "Hit maximum reorder limit this cycle, no further operations will issue.\n");
-            statCyclesHitReorderLimit->addData(1);
-            break;
-    	}
-
-        MemoryOpRequest* memOpReq;
-	GeneratorRequest* nxtRq = pendingRequests.at(i);
-
-	if(nxtRq->getOperation() == REQ_FENCE) {
-            if(0 == requestsInFlight.size()) {
-		out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
-
-                // Keep record we will delete fence at i
-    		delReqs.push_back(i);
-
-                // Delete the fence
-    		delete nxtRq;
-            } else {
-                out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
-            }
-
-            statCyclesHitFence->addData(1);
-
-            // Fence operations do now allow anything else to complete in this cycle
-            break;
-        } else if (nxtRq->getOperation() == CUSTOM) {
-            if (requestsPending[CUSTOM] < maxRequestsPending[CUSTOM]) {
-                out->verbose(CALL_INFO, 4, 0, "Will attempt to issue as free slots in the load/store unit.\n");
-
-		if(nxtRq->canIssue()) {
-                    issued = true;
-                    reqsIssuedThisCycle++;
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
-                            nxtRq->getRequestID(), reqsIssuedThisCycle);
-
-    		    // Keep record we will delete at index i
-                    delReqs.push_back(i);
-
-                    issueCustomRequest(static_cast<CustomOpRequest*>(nxtRq));
-
-                    delete nxtRq;
-                }
-            }
-        } else if ( ( memOpReq = dynamic_cast<MemoryOpRequest*>(nxtRq) ) ) {
-
-            if( requestsPending[memOpReq->getOperation()] < maxRequestsPending[memOpReq->getOperation()] ) {
-                out->verbose(CALL_INFO, 4, 0, "Will attempt to issue as free slots in the load/store unit.\n");
-
-
-		if(nxtRq->canIssue()) {
-                    issued = true;
-                    reqsIssuedThisCycle++;
-
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
-                            nxtRq->getRequestID(), reqsIssuedThisCycle);
-
-    		    // Keep record we will delete at index i
-                    delReqs.push_back(i);
-
-                    issueRequest(memOpReq);
-
-                    delete nxtRq;
-		} else {
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " in queue, has dependencies which are not satisfied, wait.\n",
-                            nxtRq->getRequestID());
-                }
-    	    } else {
-                out->verbose(CALL_INFO, 4, 0, "All load/store/custom slots occupied, no more issues will be attempted.\n");
-    	        break;
-            }
-	} else {
-            out->fatal(CALL_INFO, -1, "Error, invalid operation \n");
-        }
+        out->verbose(CALL_INFO, 2, 0, "Hit maximum reorder limit this cycle, no further operations will issue.\n");
+        statCyclesHitReorderLimit->addData(1);
+        break;
+    case ISSUE_FENCE:
+        // Fence operations do now allow anything else to complete in this cycle
+        statCyclesHitFence->addData(1);
+        break;
+    case ISSUE_SLOTS_FULL:
+        out->verbose(CALL_INFO, 4, 0, "All load/store/custom slots occupied, no more issues will be attempted.\n");
+        break;
+    case ISSUE_DONE:
+        break;
     }
 
-    pendingRequests.erase(delReqs);
+    const bool issued = (reqsIssuedThisCycle > 0);
 
     if(issued) {
 	statCyclesWithIssue->addData(1);
@@ -21,6 +21,7 @@
 #include <sst/core/statapi/stataccumulator.h>
 
 #include "mirandaGenerator.h"
+#include "mirandaDepGraph.h"
 #include "mirandaEvent.h"
 #include "mirandaMemMgr.h"
 
@@ -135,6 +136,14 @@ private:
 	void issueRequest(MemoryOpRequest* req);
 	void issueCustomRequest(CustomOpRequest* req);
 	void handleSrcEvent( SST::Event* );
+	void enqueueGenerated();
+
+	// Called back from MirandaDependencyGraph::issue
+	friend class MirandaDependencyGraph;
+	bool slotsFull(const ReqOperation op) const;
+	bool fenceCanRetire() const;
+	void retireFence(GeneratorRequest* fence);
+	void issue(GeneratorRequest* req, const uint32_t issuedThisCycle);
 
  	Output* out;
 
@@ -147,7 +156,8 @@ private:
 	MirandaReqEvent* srcReqEvent;
         StdMemHandler* stdMemHandlers;
 
-	MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+	MirandaRequestQueue<GeneratorRequest*> generatedRequests;
+	MirandaDependencyGraph* pendingRequests;
 	MirandaMemoryManager* memMgr;
 
         SharedRegion * addrMap;
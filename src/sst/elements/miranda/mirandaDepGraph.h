@@ -0,0 +1,473 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_DEP_GRAPH
+#define _H_SST_MIRANDA_DEP_GRAPH
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "mirandaGenerator.h"
+
+namespace SST {
+namespace Miranda {
+
+// Why an issue walk stopped
+typedef enum {
+	ISSUE_DONE,
+	ISSUE_MAX_PER_CYCLE,
+	ISSUE_REORDER_LIMIT,
+	ISSUE_FENCE,
+	ISSUE_SLOTS_FULL
+} MirandaIssueStop;
+
+/*
+ * Requests waiting to issue in the CPU, kept in generation order.
+ *
+ * Every request records how many of its dependencies are still
+ * outstanding, and every request ID which is depended upon keeps the list
+ * of requests waiting on it, so a completion only touches its own
+ * dependents. Requests without outstanding dependencies are marked in a
+ * bitmap indexed by generation sequence, a ring covering the oldest
+ * request in the graph to the newest. Marking a request ready or issuing
+ * it is O(1), and issue finds the next ready request by scanning forward
+ * 64 requests per word, so it visits ready requests in the same order a
+ * scan of the whole queue would.
+ *
+ * Requests are also linked per operation type, which lets the issue logic
+ * find the next fence or the next request of a type without a scan, and
+ * the graph tracks the first request beyond the reorder window.
+ *
+ * A dependency on a request which has already completed (or a fence which
+ * has retired) is satisfied. Requests generated together should all be
+ * announced with expect() before they are added, so dependencies between
+ * them are kept whatever order they are added in.
+ */
+class MirandaDependencyGraph {
+public:
+	static const uint32_t NONE = UINT32_MAX;
+
+	MirandaDependencyGraph(const uint32_t window) :
+		windowSize(window), nextSeq(0), count(0), freeList(NONE),
+		head(NONE), tail(NONE), windowEnd(NONE), readyBase(0), readyFirst(0) {
+
+		for(uint32_t i = 0; i < OPCOUNT; ++i) {
+			opHead[i] = NONE;
+			opTail[i] = NONE;
+		}
+	}
+
+	bool empty() const { return 0 == count; }
+	uint32_t size() const { return count; }
+
+	GeneratorRequest* request(const uint32_t node) const { return nodes[node].req; }
+	ReqOperation operation(const uint32_t node) const { return nodes[node].op; }
+
+	// Oldest request and the request after node, in generation order
+	uint32_t first() const { return head; }
+	uint32_t next(const uint32_t node) const { return nodes[node].next; }
+
+	// Oldest request of an operation type and the next one of the same type
+	uint32_t firstOf(const ReqOperation op) const { return opHead[op]; }
+	uint32_t nextOf(const uint32_t node) const { return nodes[node].nextOp; }
+
+	// First request outside the reorder window (NONE if every request is inside it)
+	uint32_t firstOutsideWindow() const { return windowEnd; }
+
+	// True if node a was generated before node b
+	bool before(const uint32_t a, const uint32_t b) const {
+		return nodes[a].seq < nodes[b].seq;
+	}
+
+	// Oldest request without outstanding dependencies and the next one after node (NONE at the end)
+	uint32_t firstReady() const { return readyFrom(readyFirst); }
+	uint32_t nextReady(const uint32_t node) const { return readyFrom(nodes[node].seq + 1); }
+
+	// The request with this ID is about to be added
+	void expect(const uint64_t reqID) {
+		live.insert(reqID);
+	}
+
+	void add(GeneratorRequest* req) {
+		// The ring must hold every sequence from the oldest request to this one
+		while(nextSeq - readyBase >= readyNodes.size()) {
+			growReady();
+		}
+
+		const uint32_t node = allocateNode();
+		Node& n = nodes[node];
+
+		n.req = req;
+		n.op = req->getOperation();
+		n.seq = nextSeq++;
+		n.waitingOn = 0;
+
+		n.prev = tail;
+		n.next = NONE;
+		if(NONE == tail) {
+			head = node;
+		} else {
+			nodes[tail].next = node;
+		}
+		tail = node;
+
+		n.prevOp = opTail[n.op];
+		n.nextOp = NONE;
+		if(NONE == opTail[n.op]) {
+			opHead[n.op] = node;
+		} else {
+			nodes[opTail[n.op]].nextOp = node;
+		}
+		opTail[n.op] = node;
+
+		count++;
+		if(count == windowSize + 1) {
+			windowEnd = node;
+		}
+
+		live.insert(req->getRequestID());
+
+		const std::vector<uint64_t>& deps = req->getDependencies();
+		for(size_t i = 0; i < deps.size(); ++i) {
+			if(0 == live.count(deps[i])) {
+				continue;
+			}
+
+			dependents[deps[i]].push_back(std::make_pair(node, n.seq));
+			n.waitingOn++;
+		}
+
+		// Fences wait for everything in flight rather than for dependencies
+		if(0 == n.waitingOn && REQ_FENCE != n.op) {
+			markReady(node);
+		} else if(readyFirst == n.seq) {
+			readyFirst = nextSeq;
+		}
+	}
+
+	/*
+	 * The request with this ID has completed, release the requests waiting
+	 * on it. Requests are only released by completions which happen while
+	 * they are in the graph.
+	 */
+	void complete(const uint64_t reqID) {
+		live.erase(reqID);
+
+		std::unordered_map<uint64_t, std::vector< std::pair<uint32_t, uint64_t> > >::iterator waiters = dependents.find(reqID);
+
+		if(waiters == dependents.end()) {
+			return;
+		}
+
+		for(size_t i = 0; i < waiters->second.size(); ++i) {
+			Node& n = nodes[waiters->second[i].first];
+
+			// The waiter may already have left the graph (a fence)
+			if(NULL == n.req || n.seq != waiters->second[i].second) {
+				continue;
+			}
+
+			n.waitingOn--;
+
+			if(0 == n.waitingOn && REQ_FENCE != n.op) {
+				markReady(waiters->second[i].first);
+			}
+		}
+
+		dependents.erase(waiters);
+	}
+
+	/*
+	 * Issue for one cycle, in generation order. Only the requests which can
+	 * issue or which end the walk are visited: ready requests, the first
+	 * fence, the next load/store of a type with no free slots and the first
+	 * request beyond the reorder window. Requests in between would be
+	 * skipped anyway, so this issues exactly what a scan of the whole
+	 * window would.
+	 *
+	 * The core provides slotsFull(op), fenceCanRetire(), issue(req, issued)
+	 * and retireFence(req). Requests passed to issue and retireFence have left
+	 * the graph and belong to the core.
+	 */
+	template<typename Core>
+	MirandaIssueStop issue(Core& core, const uint32_t maxPerCycle, uint32_t* issued) {
+		// The window and the first fence are those at the start of the cycle
+		const uint32_t fence = opHead[REQ_FENCE];
+		const uint32_t lastLookup = windowEnd;
+
+		uint32_t slotsFullAt[OPCOUNT];
+		for(uint32_t op = 0; op < OPCOUNT; ++op) {
+			slotsFullAt[op] = NONE;
+		}
+
+		for(ReqOperation op : { READ, WRITE }) {
+			if(core.slotsFull(op)) {
+				slotsFullAt[op] = opHead[op];
+			}
+		}
+
+		uint32_t nextReadyNode = firstReady();
+		uint32_t following = head;
+
+		*issued = 0;
+
+		while(NONE != following) {
+			if(*issued == maxPerCycle) {
+				return ISSUE_MAX_PER_CYCLE;
+			}
+
+			uint32_t nxt = earliest(nextReadyNode, fence);
+			nxt = earliest(nxt, slotsFullAt[READ]);
+			nxt = earliest(nxt, slotsFullAt[WRITE]);
+			nxt = earliest(nxt, lastLookup);
+
+			if(NONE == nxt) {
+				break;
+			}
+
+			if(nxt == lastLookup) {
+				return ISSUE_REORDER_LIMIT;
+			}
+
+			// Nothing else issues in a cycle which reaches a fence
+			if(nxt == fence) {
+				if(core.fenceCanRetire()) {
+					core.retireFence(remove(fence));
+				}
+
+				return ISSUE_FENCE;
+			}
+
+			const ReqOperation op = nodes[nxt].op;
+
+			if(nxt == slotsFullAt[op]) {
+				return ISSUE_SLOTS_FULL;
+			}
+
+			// A ready request, move past it before it leaves the graph
+			following = nodes[nxt].next;
+			nextReadyNode = nextReady(nxt);
+
+			if(CUSTOM == op) {
+				if(!core.slotsFull(CUSTOM)) {
+					(*issued)++;
+					core.issue(remove(nxt), *issued);
+				}
+			} else {
+				const uint32_t nextSameOp = nodes[nxt].nextOp;
+
+				(*issued)++;
+				core.issue(remove(nxt), *issued);
+
+				// Once the slots fill up the next request of this type stops the walk
+				if(core.slotsFull(op)) {
+					slotsFullAt[op] = nextSameOp;
+				}
+			}
+		}
+
+		return ISSUE_DONE;
+	}
+
+	// Remove an issued or retired request, returns the request
+	GeneratorRequest* remove(const uint32_t node) {
+		Node& n = nodes[node];
+		GeneratorRequest* req = n.req;
+
+		if(isReady(n.seq)) {
+			clearReady(n.seq);
+		}
+
+		// The window slides forward when a request inside it leaves
+		if(NONE != windowEnd && (node == windowEnd || n.seq < nodes[windowEnd].seq)) {
+			windowEnd = nodes[windowEnd].next;
+		}
+
+		if(NONE == n.prev) {
+			head = n.next;
+		} else {
+			nodes[n.prev].next = n.next;
+		}
+
+		if(NONE == n.next) {
+			tail = n.prev;
+		} else {
+			nodes[n.next].prev = n.prev;
+		}
+
+		if(NONE == n.prevOp) {
+			opHead[n.op] = n.nextOp;
+		} else {
+			nodes[n.prevOp].nextOp = n.nextOp;
+		}
+
+		if(NONE == n.nextOp) {
+			opTail[n.op] = n.prevOp;
+		} else {
+			nodes[n.nextOp].prevOp = n.prevOp;
+		}
+
+		const ReqOperation op = n.op;
+
+		n.req = NULL;
+		n.next = freeList;
+		freeList = node;
+		count--;
+
+		readyBase = (NONE == head) ? nextSeq : nodes[head].seq;
+
+		// A fence is done when it leaves the graph
+		if(REQ_FENCE == op) {
+			complete(req->getRequestID());
+		}
+
+		return req;
+	}
+
+private:
+	struct Node {
+		GeneratorRequest* req;
+		ReqOperation op;
+		uint64_t seq;
+		uint32_t waitingOn;
+		uint32_t prev;
+		uint32_t next;
+		uint32_t prevOp;
+		uint32_t nextOp;
+	};
+
+	// Whichever of two nodes (either may be NONE) was generated first
+	uint32_t earliest(const uint32_t a, const uint32_t b) const {
+		if(NONE == a) return b;
+		if(NONE == b) return a;
+		return before(a, b) ? a : b;
+	}
+
+	bool isReady(const uint64_t seq) const {
+		const uint64_t slot = seq & (readyNodes.size() - 1);
+		return 0 != (readyBits[slot >> 6] & (UINT64_C(1) << (slot & 63)));
+	}
+
+	void markReady(const uint32_t node) {
+		const uint64_t seq = nodes[node].seq;
+		const uint64_t slot = seq & (readyNodes.size() - 1);
+
+		readyBits[slot >> 6] |= UINT64_C(1) << (slot & 63);
+		readyNodes[slot] = node;
+
+		if(seq < readyFirst) {
+			readyFirst = seq;
+		}
+	}
+
+	void clearReady(const uint64_t seq) {
+		const uint64_t slot = seq & (readyNodes.size() - 1);
+
+		readyBits[slot >> 6] &= ~(UINT64_C(1) << (slot & 63));
+
+		if(seq == readyFirst) {
+			readyFirst = readySeqFrom(seq + 1);
+		}
+	}
+
+	// Sequence of the first ready request at or after seq, nextSeq if there is none
+	uint64_t readySeqFrom(uint64_t seq) const {
+		const uint64_t mask = readyNodes.size() - 1;
+
+		while(seq < nextSeq) {
+			const uint64_t bits = readyBits[(seq & mask) >> 6] >> (seq & 63);
+
+			if(0 != bits) {
+				seq += __builtin_ctzll(bits);
+				return (seq < nextSeq) ? seq : nextSeq;
+			}
+
+			seq = (seq | 63) + 1;
+		}
+
+		return nextSeq;
+	}
+
+	uint32_t readyFrom(const uint64_t seq) const {
+		const uint64_t found = readySeqFrom(seq);
+		return (found == nextSeq) ? NONE : readyNodes[found & (readyNodes.size() - 1)];
+	}
+
+	// Double the ring, keeping the ready requests from the oldest in the graph on
+	void growReady() {
+		const uint64_t capacity = readyNodes.empty() ? 64 : 2 * readyNodes.size();
+		std::vector<uint64_t> bits(capacity / 64, 0);
+		std::vector<uint32_t> readyAt(capacity, 0);
+
+		for(uint64_t seq = readyBase; seq < nextSeq; ++seq) {
+			if(isReady(seq)) {
+				const uint64_t slot = seq & (capacity - 1);
+				bits[slot >> 6] |= UINT64_C(1) << (slot & 63);
+				readyAt[slot] = readyNodes[seq & (readyNodes.size() - 1)];
+			}
+		}
+
+		readyBits.swap(bits);
+		readyNodes.swap(readyAt);
+	}
+
+	uint32_t allocateNode() {
+		if(NONE != freeList) {
+			const uint32_t node = freeList;
+			freeList = nodes[node].next;
+			return node;
+		}
+
+		nodes.push_back(Node());
+		return (uint32_t) (nodes.size() - 1);
+	}
+
+	const uint32_t windowSize;
+	uint64_t nextSeq;
+	uint32_t count;
+
+	std::vector<Node> nodes;
+	uint32_t freeList;
+
+	uint32_t head;
+	uint32_t tail;
+	uint32_t windowEnd;
+	uint32_t opHead[OPCOUNT];
+	uint32_t opTail[OPCOUNT];
+
+	// Ring over generation sequences [readyBase, nextSeq), a power of two
+	// long: a bit per request with no outstanding dependencies and its node.
+	// readyFirst is the first ready sequence, nextSeq if none is ready.
+	std::vector<uint64_t> readyBits;
+	std::vector<uint32_t> readyNodes;
+	uint64_t readyBase;
+	uint64_t readyFirst;
+
+	// Request ID -> (node, sequence) of the requests waiting on it
+	std::unordered_map<uint64_t, std::vector< std::pair<uint32_t, uint64_t> > > dependents;
+
+	// IDs of requests which have been generated but not completed or retired
+	std::unordered_set<uint64_t> live;
+};
+
+}
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include <sst/core/subcomponent.h>
 #include <sst/core/component.h>
 #include <sst/core/output.h>
+#include <sst/core/warnmacros.h>
 #include <sst/core/interfaces/stdMem.h>
 
 #include <queue>
@@ -51,6 +52,10 @@ public:
 		dependsOn.push_back(depReq);
 	}
 
+	const std::vector<uint64_t>& getDependencies() const {
+		return dependsOn;
+	}
+
 	void satisfyDependency(const GeneratorRequest* req) {
 		satisfyDependency(req->getRequestID());
 	}
@@ -124,6 +129,10 @@ public:
 		return maxCapacity;
 	}
 
+	void clear() {
+		curSize = 0;
+	}
+
        	QueueType at(const uint32_t index) {
                	return theQ[index];
        	}
@@ -220,9 +229,9 @@ class RequestGenerator : public SubComponent {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Miranda::RequestGenerator)
 
-	RequestGenerator( ComponentId_t id, Params& params) : SubComponent(id) {}
+	RequestGenerator( ComponentId_t id, Params& UNUSED(params)) : SubComponent(id) {}
 	~RequestGenerator() {}
-	virtual void generate(MirandaRequestQueue<GeneratorRequest*>* q) { }
+	virtual void generate(MirandaRequestQueue<GeneratorRequest*>* UNUSED(q)) { }
 	virtual bool isFinished() { return true; }
 	virtual void completed() { }
 
@@ -2,6 +2,7 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -71,9 +72,25 @@ class testcase_miranda_Component(SSTTestCase):
     def test_miranda_gupsgen(self):
         self.miranda_test_template("gupsgen")
 
+    def test_miranda_tracegen(self):
+        #  tracegen  Replays tracegen.trc (converted from tracegen.txt with sst-miranda-tracecvt)
+        self.miranda_test_template("tracegen", set_cwd=True)
+
+    def test_miranda_streambench_tight(self):
+        #  streambench_tight  streambench with a small reorder window and few load/store slots
+        self.miranda_limits_template("streambench_tight", "streambench", ["cpu"])
+
+    def test_miranda_spmvgen_tight(self):
+        #  spmvgen_tight  spmvgen with a small reorder window and few load/store slots
+        self.miranda_limits_template("spmvgen_tight", "spmvgen", ["cpu0", "cpu1"])
+
+    def test_miranda_tracegen_tight(self):
+        #  tracegen_tight  tracegen, whose trace has fences, with the same tight limits
+        self.miranda_limits_template("tracegen_tight", "tracegen", ["cpu"], num_requests=312, set_cwd=True, stops=["cycles_hit_fence"])
+
 #####
 
-    def miranda_test_template(self, testcase, testtimeout=240):
+    def miranda_test_template(self, testcase, set_cwd=False, testtimeout=240):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -88,7 +105,11 @@ class testcase_miranda_Component(SSTTestCase):
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
 
-        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+        # set_cwd runs sst in the tests directory, for SDLs which open files relative to it
+        if set_cwd:
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+        else:
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
 
         testing_remove_component_warning_from_file(outfile)
 
@@ -106,4 +127,61 @@ class testcase_miranda_Component(SSTTestCase):
         if (cmp_result == False):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
-        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
\ No newline at end of file
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    def miranda_limits_template(self, testcase, refcase, cpus, num_requests=None, set_cwd=False, stops=[], testtimeout=240):
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        # Set the various file paths
+        testDataFileName="test_miranda_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        reffile = "{0}/refFiles/test_miranda_{1}.out".format(test_path, refcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        if set_cwd:
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+        else:
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        testing_remove_component_warning_from_file(outfile)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("miranda test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        # The limits change when requests issue but not which requests there
+        # are, so the request counts and the number of completed requests must
+        # match the reference run with the default limits (or num_requests
+        # where the reference holds no latencies)
+        stat_re = re.compile(r"^\s*(\S+)\.(\S+) : Accumulator : Sum\.u64 = (\d+); .*Count\.u64 = (\d+);")
+
+        def read_stats(path):
+            stats = {}
+            with open(path, 'r') as fp:
+                for line in fp:
+                    match = stat_re.match(line)
+                    if match:
+                        stats[(match.group(1), match.group(2))] = (int(match.group(3)), int(match.group(4)))
+            return stats
+
+        out_stats = read_stats(outfile)
+        ref_stats = read_stats(reffile)
+
+        for cpu in cpus:
+            for stat in ["read_reqs", "write_reqs", "split_read_reqs", "split_write_reqs", "req_latency"]:
+                ref = ref_stats.get((cpu, stat))
+                out = out_stats.get((cpu, stat))
+                self.assertTrue(out is not None, "Output file {0} has no statistic {1}.{2}".format(outfile, cpu, stat))
+                if stat == "req_latency":
+                    ref = num_requests if num_requests is not None else ref[1]
+                    out = out[1]
+                self.assertTrue(out == ref, "Output file {0} shows {1}.{2} = {3}, reference run {4}".format(outfile, cpu, stat, out, ref))
+
+            # Issue cycles which must have ended at the given limit
+            for stat in stops:
+                out = out_stats.get((cpu, stat))
+                self.assertTrue(out is not None and out[1] > 0, "Output file {0} shows no {1}.{2}".format(outfile, cpu, stat))
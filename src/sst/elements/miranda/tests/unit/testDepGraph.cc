@@ -0,0 +1,284 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Unit checks for MirandaDependencyGraph: ready order, release on
+ * completion, fences, the reorder window and dependencies on requests
+ * which have already completed.
+ */
+
+#include <sst_config.h>
+
+#include <vector>
+
+#include <sst/elements/miranda/mirandaDepGraph.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::Miranda;
+
+std::atomic<uint64_t> SST::Miranda::GeneratorRequest::nextGeneratorRequestID(0);
+
+static std::vector<GeneratorRequest*> readyList(const MirandaDependencyGraph& graph) {
+	std::vector<GeneratorRequest*> result;
+
+	for(uint32_t node = graph.firstReady(); node != MirandaDependencyGraph::NONE; node = graph.nextReady(node)) {
+		result.push_back(graph.request(node));
+	}
+
+	return result;
+}
+
+static uint32_t findNode(const MirandaDependencyGraph& graph, const GeneratorRequest* req) {
+	for(uint32_t node = graph.first(); node != MirandaDependencyGraph::NONE; node = graph.next(node)) {
+		if(graph.request(node) == req) {
+			return node;
+		}
+	}
+
+	return MirandaDependencyGraph::NONE;
+}
+
+static void add(MirandaDependencyGraph& graph, GeneratorRequest* req) {
+	graph.expect(req->getRequestID());
+	graph.add(req);
+}
+
+// Requests become ready in generation order once their dependencies complete
+static void testReleaseOrder() {
+	MirandaDependencyGraph graph(16);
+
+	MemoryOpRequest* a = new MemoryOpRequest(0, 8, READ);
+	MemoryOpRequest* b = new MemoryOpRequest(64, 8, WRITE);
+	MemoryOpRequest* c = new MemoryOpRequest(128, 8, READ);
+	MemoryOpRequest* d = new MemoryOpRequest(192, 8, READ);
+	const uint64_t aID = a->getRequestID();
+	const uint64_t bID = b->getRequestID();
+
+	b->addDependency(a->getRequestID());
+	c->addDependency(a->getRequestID());
+	c->addDependency(b->getRequestID());
+
+	add(graph, a);
+	add(graph, b);
+	add(graph, c);
+	add(graph, d);
+
+	CHECK(4 == graph.size());
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ a, d }));
+
+	delete graph.remove(findNode(graph, a));
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ d }));
+
+	graph.complete(aID);
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ b, d }));
+
+	delete graph.remove(findNode(graph, b));
+	graph.complete(bID);
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ c, d }));
+
+	delete graph.remove(findNode(graph, c));
+	delete graph.remove(findNode(graph, d));
+	CHECK(graph.empty());
+}
+
+// Fences are never ready, they leave the graph when they retire
+static void testFence() {
+	MirandaDependencyGraph graph(16);
+
+	MemoryOpRequest* a = new MemoryOpRequest(0, 8, READ);
+	FenceOpRequest* f = new FenceOpRequest();
+	MemoryOpRequest* b = new MemoryOpRequest(64, 8, READ);
+	MemoryOpRequest* c = new MemoryOpRequest(128, 8, READ);
+
+	c->addDependency(f->getRequestID());
+
+	add(graph, a);
+	add(graph, f);
+	add(graph, b);
+	add(graph, c);
+
+	CHECK(findNode(graph, f) == graph.firstOf(REQ_FENCE));
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ a, b }));
+
+	const uint64_t aID = a->getRequestID();
+	delete graph.remove(findNode(graph, a));
+	graph.complete(aID);
+
+	// Retiring the fence releases the requests which named it
+	delete graph.remove(graph.firstOf(REQ_FENCE));
+	CHECK(MirandaDependencyGraph::NONE == graph.firstOf(REQ_FENCE));
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ b, c }));
+
+	delete graph.remove(findNode(graph, b));
+	delete graph.remove(findNode(graph, c));
+	CHECK(graph.empty());
+}
+
+// The first request beyond the window moves as requests leave
+static void testWindow() {
+	MirandaDependencyGraph graph(2);
+	std::vector<GeneratorRequest*> reqs;
+
+	for(int i = 0; i < 4; ++i) {
+		reqs.push_back(new MemoryOpRequest(64 * i, 8, READ));
+		add(graph, reqs.back());
+	}
+
+	CHECK(graph.request(graph.firstOutsideWindow()) == reqs[2]);
+
+	delete graph.remove(findNode(graph, reqs[1]));
+	CHECK(graph.request(graph.firstOutsideWindow()) == reqs[3]);
+
+	delete graph.remove(findNode(graph, reqs[0]));
+	CHECK(MirandaDependencyGraph::NONE == graph.firstOutsideWindow());
+
+	delete graph.remove(findNode(graph, reqs[2]));
+	delete graph.remove(findNode(graph, reqs[3]));
+	CHECK(graph.empty());
+}
+
+// A dependency on a request which completed before the dependent was added is satisfied
+static void testCompletedDependency() {
+	MirandaDependencyGraph graph(16);
+
+	MemoryOpRequest* a = new MemoryOpRequest(0, 8, READ);
+	const uint64_t aID = a->getRequestID();
+	add(graph, a);
+	delete graph.remove(findNode(graph, a));
+	graph.complete(aID);
+
+	FenceOpRequest* f = new FenceOpRequest();
+	const uint64_t fID = f->getRequestID();
+	add(graph, f);
+	delete graph.remove(findNode(graph, f));
+
+	// Issued but not completed, so still outstanding
+	MemoryOpRequest* b = new MemoryOpRequest(64, 8, READ);
+	const uint64_t bID = b->getRequestID();
+	add(graph, b);
+	delete graph.remove(findNode(graph, b));
+
+	MemoryOpRequest* c = new MemoryOpRequest(128, 8, READ);
+	c->addDependency(aID);
+	c->addDependency(fID);
+	add(graph, c);
+
+	MemoryOpRequest* d = new MemoryOpRequest(192, 8, READ);
+	d->addDependency(aID);
+	d->addDependency(bID);
+	add(graph, d);
+
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ c }));
+
+	graph.complete(bID);
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ c, d }));
+
+	delete graph.remove(findNode(graph, c));
+	delete graph.remove(findNode(graph, d));
+	CHECK(graph.empty());
+}
+
+// Requests generated together may depend on later requests of the same batch
+static void testBatchDependency() {
+	MirandaDependencyGraph graph(16);
+
+	MemoryOpRequest* a = new MemoryOpRequest(0, 8, READ);
+	MemoryOpRequest* b = new MemoryOpRequest(64, 8, READ);
+	a->addDependency(b->getRequestID());
+
+	graph.expect(a->getRequestID());
+	graph.expect(b->getRequestID());
+	graph.add(a);
+	graph.add(b);
+
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ b }));
+
+	const uint64_t bID = b->getRequestID();
+	delete graph.remove(findNode(graph, b));
+	graph.complete(bID);
+	CHECK((readyList(graph) == std::vector<GeneratorRequest*>{ a }));
+
+	delete graph.remove(findNode(graph, a));
+	CHECK(graph.empty());
+}
+
+// A waiting request keeps the ready ring spanning every request generated
+// since, ready order must survive the ring growing and crossing words
+static void testReadyRing() {
+	MirandaDependencyGraph graph(4096);
+
+	MemoryOpRequest* blocker = new MemoryOpRequest(0, 8, READ);
+	MemoryOpRequest* oldest = new MemoryOpRequest(64, 8, READ);
+	const uint64_t blockerID = blocker->getRequestID();
+
+	oldest->addDependency(blockerID);
+	graph.expect(blockerID);
+	add(graph, oldest);
+
+	// Many more requests pass through than the graph ever holds
+	for(uint32_t i = 0; i < 1000; ++i) {
+		MemoryOpRequest* req = new MemoryOpRequest(128 + 64 * i, 8, WRITE);
+		add(graph, req);
+
+		CHECK(graph.request(graph.firstReady()) == req);
+		delete graph.remove(graph.firstReady());
+	}
+
+	CHECK(1 == graph.size());
+	CHECK(MirandaDependencyGraph::NONE == graph.firstReady());
+
+	// Every third request waits on the blocker as well
+	std::vector<GeneratorRequest*> all = { oldest };
+	std::vector<GeneratorRequest*> ready;
+
+	for(uint32_t i = 0; i < 200; ++i) {
+		MemoryOpRequest* req = new MemoryOpRequest(64 * 1024 + 64 * i, 8, READ);
+
+		if(0 == i % 3) {
+			req->addDependency(blockerID);
+		} else {
+			ready.push_back(req);
+		}
+
+		all.push_back(req);
+		add(graph, req);
+	}
+
+	CHECK(readyList(graph) == ready);
+
+	graph.complete(blockerID);
+	CHECK(readyList(graph) == all);
+
+	for(size_t i = 0; i < all.size(); ++i) {
+		CHECK(graph.request(graph.firstReady()) == all[i]);
+		delete graph.remove(graph.firstReady());
+	}
+
+	CHECK(graph.empty());
+	CHECK(MirandaDependencyGraph::NONE == graph.firstReady());
+
+	delete blocker;
+}
+
+int main() {
+	testReleaseOrder();
+	testFence();
+	testWindow();
+	testCompletedDependency();
+	testBatchDependency();
+	testReadyRing();
+
+	return SST::UnitTest::result("testDepGraph");
+}
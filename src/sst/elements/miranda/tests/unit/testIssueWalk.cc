@@ -0,0 +1,387 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Checks MirandaDependencyGraph::issue against the scan RequestGenCPU used
+ * before the dependency graph: every entry of the pending queue is visited
+ * in order until the reorder window, the issue limit, a fence or a full
+ * load/store unit ends the cycle. Both are driven through the same
+ * randomized workloads, with fences, custom operations, dependencies and
+ * random memory latencies, for a range of issue limits, window sizes and
+ * slot counts. The cycle each request issues in, the cycle each fence
+ * retires in and the stop statistics must be identical.
+ */
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <sst/elements/miranda/mirandaDepGraph.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::Miranda;
+
+std::atomic<uint64_t> SST::Miranda::GeneratorRequest::nextGeneratorRequestID(0);
+
+struct IssueConfig {
+	uint32_t maxPerCycle;
+	uint32_t window;
+	uint32_t maxPending[OPCOUNT];
+};
+
+// A request of the workload, dependencies are indices of earlier requests
+struct WorkloadRequest {
+	ReqOperation op;
+	std::vector<uint64_t> deps;
+};
+
+// Replays the same randomized workload and memory latencies for a seed
+class IssueModel {
+public:
+	IssueModel(const IssueConfig& cfg, const uint64_t seed, const uint64_t total) :
+		statMaxPerCycle(0), statReorderLimit(0), statFence(0), cfg(cfg),
+		workload(seed), latency(seed * 7 + 1), total(total), now(0) {
+
+		for(uint32_t op = 0; op < OPCOUNT; ++op) {
+			pending[op] = 0;
+		}
+	}
+
+	virtual ~IssueModel() {}
+
+	void tick() {
+		completeArrived();
+
+		for(uint64_t i = queued(); i < cfg.window; ++i) {
+			if(requests.size() >= total) {
+				break;
+			}
+
+			generate();
+		}
+
+		issueCycle();
+		now++;
+	}
+
+	bool finished() {
+		return requests.size() >= total && 0 == queued() && inFlight.empty();
+	}
+
+	// Issue and fence retire events, in order
+	std::vector<uint64_t> events;
+	uint64_t statMaxPerCycle;
+	uint64_t statReorderLimit;
+	uint64_t statFence;
+
+protected:
+	virtual uint64_t queued() = 0;
+	virtual void enqueue(const uint64_t index) = 0;
+	virtual void completed(const uint64_t index) = 0;
+	virtual void issueCycle() = 0;
+
+	void issued(const uint64_t index) {
+		pending[requests[index].op]++;
+		inFlight.insert(std::make_pair(now + 1 + latency() % 30, index));
+		events.push_back((now << 24) | (index << 1));
+	}
+
+	void retired(const uint64_t index) {
+		events.push_back((now << 24) | (index << 1) | 1);
+	}
+
+	bool slotsFull(const ReqOperation op) const {
+		return pending[op] >= cfg.maxPending[op];
+	}
+
+	const IssueConfig cfg;
+	std::vector<WorkloadRequest> requests;
+	std::multimap<uint64_t, uint64_t> inFlight;
+
+private:
+	// A few requests at a time, as generators do
+	void generate() {
+		const uint32_t count = 1 + workload() % 4;
+
+		for(uint32_t k = 0; k < count && requests.size() < total; ++k) {
+			const uint64_t index = requests.size();
+			const uint32_t roll = workload() % 100;
+
+			WorkloadRequest req;
+			req.op = (roll < 3) ? REQ_FENCE : (roll < 50) ? READ : (roll < 90) ? WRITE : CUSTOM;
+
+			// The old queue only released dependencies on requests still waiting
+			// in it, so only name those which have neither completed nor are fences
+			const uint32_t depCount = workload() % 3;
+			for(uint32_t d = 0; d < depCount && index > 0; ++d) {
+				const uint64_t dep = index - 1 - workload() % std::min<uint64_t>(index, 40);
+
+				if(0 == done.count(dep) && REQ_FENCE != requests[dep].op &&
+						req.deps.end() == std::find(req.deps.begin(), req.deps.end(), dep)) {
+					req.deps.push_back(dep);
+				}
+			}
+
+			requests.push_back(req);
+			enqueue(index);
+		}
+	}
+
+	void completeArrived() {
+		while(!inFlight.empty() && inFlight.begin()->first <= now) {
+			const uint64_t index = inFlight.begin()->second;
+			inFlight.erase(inFlight.begin());
+
+			pending[requests[index].op]--;
+			done.insert(index);
+			completed(index);
+		}
+	}
+
+	std::mt19937_64 workload;
+	std::mt19937_64 latency;
+	const uint64_t total;
+	std::set<uint64_t> done;
+	uint32_t pending[OPCOUNT];
+
+protected:
+	uint64_t now;
+};
+
+// The scan over the pending queue from before the dependency graph
+class ScanModel : public IssueModel {
+public:
+	ScanModel(const IssueConfig& cfg, const uint64_t seed, const uint64_t total) :
+		IssueModel(cfg, seed, total) {}
+
+protected:
+	uint64_t queued() { return queue.size(); }
+
+	void enqueue(const uint64_t index) {
+		queue.push_back(index);
+		waitingOn[index] = requests[index].deps;
+	}
+
+	void completed(const uint64_t index) {
+		for(uint64_t q : queue) {
+			std::vector<uint64_t>& deps = waitingOn[q];
+			std::vector<uint64_t>::iterator found = std::find(deps.begin(), deps.end(), index);
+
+			if(found != deps.end()) {
+				deps.erase(found);
+			}
+		}
+	}
+
+	void issueCycle() {
+		std::vector<uint64_t> remaining;
+		uint32_t issuedThisCycle = 0;
+		uint32_t i = 0;
+
+		for(; i < queue.size(); ++i) {
+			if(issuedThisCycle == cfg.maxPerCycle) {
+				statMaxPerCycle++;
+				break;
+			}
+
+			if(i == cfg.window) {
+				statReorderLimit++;
+				break;
+			}
+
+			const uint64_t index = queue[i];
+			const ReqOperation op = requests[index].op;
+			const bool ready = waitingOn[index].empty();
+
+			if(REQ_FENCE == op) {
+				if(inFlight.empty()) {
+					retired(index);
+					i++;
+				}
+
+				statFence++;
+				break;
+			} else if(CUSTOM == op) {
+				if(!slotsFull(CUSTOM) && ready) {
+					issuedThisCycle++;
+					issued(index);
+					continue;
+				}
+			} else if(slotsFull(op)) {
+				break;
+			} else if(ready) {
+				issuedThisCycle++;
+				issued(index);
+				continue;
+			}
+
+			remaining.push_back(index);
+		}
+
+		remaining.insert(remaining.end(), queue.begin() + i, queue.end());
+		queue.swap(remaining);
+	}
+
+private:
+	std::vector<uint64_t> queue;
+	std::map<uint64_t, std::vector<uint64_t> > waitingOn;
+};
+
+// The same workload through MirandaDependencyGraph::issue
+class GraphModel : public IssueModel {
+public:
+	GraphModel(const IssueConfig& cfg, const uint64_t seed, const uint64_t total) :
+		IssueModel(cfg, seed, total), graph(cfg.window) {}
+
+	~GraphModel() {
+		while(!graph.empty()) {
+			delete graph.remove(graph.first());
+		}
+	}
+
+	// Called back from MirandaDependencyGraph::issue
+	bool slotsFull(const ReqOperation op) const {
+		return IssueModel::slotsFull(op);
+	}
+
+	bool fenceCanRetire() const {
+		return inFlight.empty();
+	}
+
+	void retireFence(GeneratorRequest* fence) {
+		retired(indexOf[fence->getRequestID()]);
+		delete fence;
+	}
+
+	void issue(GeneratorRequest* req, const uint32_t /* issuedThisCycle */) {
+		issued(indexOf[req->getRequestID()]);
+		delete req;
+	}
+
+protected:
+	uint64_t queued() { return graph.size(); }
+
+	void enqueue(const uint64_t index) {
+		const WorkloadRequest& workReq = requests[index];
+		GeneratorRequest* req = NULL;
+
+		if(REQ_FENCE == workReq.op) {
+			req = new FenceOpRequest();
+		} else if(CUSTOM == workReq.op) {
+			req = new CustomOpRequest(NULL);
+		} else {
+			req = new MemoryOpRequest(index * 64, 8, workReq.op);
+		}
+
+		for(uint64_t dep : workReq.deps) {
+			req->addDependency(requestID[dep]);
+		}
+
+		requestID[index] = req->getRequestID();
+		indexOf[req->getRequestID()] = index;
+
+		graph.expect(req->getRequestID());
+		graph.add(req);
+	}
+
+	void completed(const uint64_t index) {
+		graph.complete(requestID[index]);
+	}
+
+	void issueCycle() {
+		uint32_t issuedThisCycle = 0;
+
+		switch(graph.issue(*this, cfg.maxPerCycle, &issuedThisCycle)) {
+		case ISSUE_MAX_PER_CYCLE:
+			statMaxPerCycle++;
+			break;
+		case ISSUE_REORDER_LIMIT:
+			statReorderLimit++;
+			break;
+		case ISSUE_FENCE:
+			statFence++;
+			break;
+		case ISSUE_SLOTS_FULL:
+		case ISSUE_DONE:
+			break;
+		}
+	}
+
+private:
+	MirandaDependencyGraph graph;
+	std::map<uint64_t, uint64_t> requestID;
+	std::map<uint64_t, uint64_t> indexOf;
+};
+
+static void testAgainstScan() {
+	std::mt19937 configs(5);
+	uint32_t completedRuns = 0;
+	uint64_t stops[3] = { 0, 0, 0 };
+
+	for(uint32_t run = 0; run < 400; ++run) {
+		IssueConfig cfg;
+		cfg.maxPerCycle = (0 == run % 7) ? 0 : configs() % 5;
+		cfg.window = configs() % 20;
+		cfg.maxPending[READ] = 1 + configs() % 8;
+		cfg.maxPending[WRITE] = 1 + configs() % 8;
+		cfg.maxPending[CUSTOM] = 1 + configs() % 4;
+		cfg.maxPending[REQ_FENCE] = 0;
+
+		ScanModel scan(cfg, run + 1, 3000);
+		GraphModel graph(cfg, run + 1, 3000);
+
+		for(uint32_t cycle = 0; cycle < 20000 && !(scan.finished() && graph.finished()); ++cycle) {
+			scan.tick();
+			graph.tick();
+		}
+
+		CHECK(scan.events == graph.events);
+		CHECK(scan.statMaxPerCycle == graph.statMaxPerCycle);
+		CHECK(scan.statReorderLimit == graph.statReorderLimit);
+		CHECK(scan.statFence == graph.statFence);
+
+		if(scan.events != graph.events) {
+			fprintf(stderr, "run %" PRIu32 ": issue %" PRIu32 " window %" PRIu32 " diverges\n",
+				run, cfg.maxPerCycle, cfg.window);
+		}
+
+		if(scan.finished() && graph.finished()) {
+			completedRuns++;
+		}
+
+		stops[0] += graph.statMaxPerCycle;
+		stops[1] += graph.statReorderLimit;
+		stops[2] += graph.statFence;
+	}
+
+	// The workloads have to reach every exit for the comparison to mean much
+	CHECK(completedRuns > 0);
+	CHECK(stops[0] > 0);
+	CHECK(stops[1] > 0);
+	CHECK(stops[2] > 0);
+}
+
+int main() {
+	testAgainstScan();
+
+	return SST::UnitTest::result("testIssueWalk");
+}
@@ -0,0 +1,147 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Unit checks for the binary Miranda trace: traces written with
+ * MirandaTraceWriter read back record for record through the prefetcher
+ * for a range of block and ring sizes, compressed and stored, and broken
+ * traces are rejected.
+ */
+
+#include <sst_config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <sst/elements/miranda/generators/tracefile.h>
+#include <sst/elements/unitTest.h>
+
+using namespace SST::Miranda;
+
+static MirandaTraceRecord makeRecord(const uint64_t i) {
+	MirandaTraceRecord record = {};
+
+	record.address = (i * 64) & 0xffff;
+	record.length = 1 + (i % 16);
+	record.op = i % 3;
+	record.depCount = i % 3;
+	record.deps[0] = 1;
+	record.deps[1] = 1 + (i % 7);
+
+	return record;
+}
+
+static bool sameRecord(const MirandaTraceRecord& a, const MirandaTraceRecord& b) {
+	return a.address == b.address && a.length == b.length && a.op == b.op &&
+		a.depCount == b.depCount && a.deps[0] == b.deps[0] && a.deps[1] == b.deps[1];
+}
+
+static std::string tracePath(const char* name) {
+	char path[256];
+	snprintf(path, sizeof(path), "testTraceFile.%d.%s", (int) getpid(), name);
+	return path;
+}
+
+static void writeTrace(const std::string& path, const uint64_t records, const uint32_t recordsPerBlock, const bool compress) {
+	MirandaTraceWriter writer;
+
+	CHECK(writer.open(path, recordsPerBlock, compress));
+
+	for(uint64_t i = 0; i < records; ++i) {
+		CHECK(writer.append(makeRecord(i)));
+	}
+
+	CHECK(records == writer.getRecordCount());
+	CHECK(writer.close());
+}
+
+static void testRoundTrip() {
+	const std::string path = tracePath("trc");
+	const uint32_t blockSizes[] = { 1, 3, 64, 1000 };
+	const uint32_t ringSizes[] = { 1, 2, 5 };
+	const uint64_t recordCounts[] = { 0, 1, 7, 5000 };
+
+	for(const bool compress : { false, true }) {
+		for(const uint32_t recordsPerBlock : blockSizes) {
+			for(const uint64_t records : recordCounts) {
+				writeTrace(path, records, recordsPerBlock, compress);
+
+				MirandaTraceReader reader;
+				CHECK(reader.open(path));
+				CHECK(records == reader.getRecordCount());
+				CHECK((records + recordsPerBlock - 1) / recordsPerBlock == reader.getBlockCount());
+
+				for(const uint32_t ringBlocks : ringSizes) {
+					MirandaTracePrefetcher prefetcher(&reader, ringBlocks);
+					prefetcher.start();
+
+					uint64_t matched = 0;
+					for(uint64_t i = 0; i < records; ++i) {
+						const MirandaTraceRecord* record = prefetcher.next();
+
+						if(NULL != record && sameRecord(*record, makeRecord(i))) {
+							matched++;
+						}
+					}
+
+					CHECK(records == matched);
+					CHECK(NULL == prefetcher.next());
+					CHECK(prefetcher.getError().empty());
+				}
+
+				// Stopping part way through must not wait on the helper thread
+				MirandaTracePrefetcher early(&reader, 1);
+				early.start();
+				early.next();
+				early.stop();
+			}
+		}
+	}
+
+	unlink(path.c_str());
+}
+
+static void testBrokenTraces() {
+	const std::string path = tracePath("bad");
+	MirandaTraceReader reader;
+
+	CHECK(!reader.open(path));
+	CHECK(!reader.getError().empty());
+
+	FILE* file = fopen(path.c_str(), "wb");
+	fputs("not a trace file at all, just some text", file);
+	fclose(file);
+
+	CHECK(!reader.open(path));
+	CHECK(!reader.getError().empty());
+
+	writeTrace(path, 100, 16, false);
+	CHECK(0 == truncate(path.c_str(), 200));
+
+	CHECK(!reader.open(path));
+	CHECK(!reader.getError().empty());
+
+	unlink(path.c_str());
+}
+
+int main() {
+	testRoundTrip();
+	testBrokenTraces();
+
+	return SST::UnitTest::result("testTraceFile");
+}
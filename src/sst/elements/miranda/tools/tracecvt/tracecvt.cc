@@ -0,0 +1,239 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Converts between the text and binary forms of a Miranda trace.
+ *
+ * The text form has one record per line, blank lines and lines starting
+ * with '#' are ignored:
+ *
+ *   R <address> <length> [<dependency> ...]
+ *   W <address> <length> [<dependency> ...]
+ *   F [<dependency> ...]
+ *
+ * Dependencies are distances back to earlier records, 1 is the record on
+ * the line before. Numbers may be given in decimal or as 0x hexadecimal.
+ */
+
+#include <sst_config.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <sst/elements/miranda/generators/tracefile.h>
+
+using namespace SST::Miranda;
+
+static void usage() {
+	fprintf(stderr, "usage: sst-miranda-tracecvt [-b <records per block>] [-u] <trace.txt> <trace.trc>\n");
+	fprintf(stderr, "       sst-miranda-tracecvt -d <trace.trc>\n");
+	fprintf(stderr, "  -b  records in each trace block (default 4096)\n");
+	fprintf(stderr, "  -u  store blocks uncompressed\n");
+	fprintf(stderr, "  -d  print a binary trace in the text form\n");
+}
+
+static bool parseNumber(char* token, uint64_t* value) {
+	char* end = NULL;
+	*value = strtoull(token, &end, 0);
+	return (end != token) && ('\0' == *end);
+}
+
+static bool parseRecord(char* line, MirandaTraceRecord* record, std::string* error) {
+	memset(record, 0, sizeof(MirandaTraceRecord));
+
+	char* save = NULL;
+	char* token = strtok_r(line, " \t\r\n", &save);
+
+	if(0 == strcmp(token, "R") || 0 == strcmp(token, "W")) {
+		record->op = ('R' == token[0]) ? MIRANDA_TRACE_READ : MIRANDA_TRACE_WRITE;
+
+		uint64_t length = 0;
+		char* addressToken = strtok_r(NULL, " \t\r\n", &save);
+		char* lengthToken = strtok_r(NULL, " \t\r\n", &save);
+
+		if(NULL == addressToken || NULL == lengthToken ||
+				!parseNumber(addressToken, &record->address) || !parseNumber(lengthToken, &length)) {
+			*error = "reads and writes need an address and a length";
+			return false;
+		}
+
+		if(0 == length || length > UINT32_MAX) {
+			*error = "length is out of range";
+			return false;
+		}
+
+		record->length = (uint32_t) length;
+	} else if(0 == strcmp(token, "F")) {
+		record->op = MIRANDA_TRACE_FENCE;
+	} else {
+		*error = "unknown operation '" + std::string(token) + "'";
+		return false;
+	}
+
+	while(NULL != (token = strtok_r(NULL, " \t\r\n", &save))) {
+		uint64_t distance = 0;
+
+		if(!parseNumber(token, &distance) || 0 == distance || distance > UINT32_MAX) {
+			*error = "dependency '" + std::string(token) + "' is not a distance back to an earlier record";
+			return false;
+		}
+
+		if(record->depCount == MIRANDA_TRACE_MAX_DEPS) {
+			*error = "too many dependencies";
+			return false;
+		}
+
+		record->deps[record->depCount++] = (uint32_t) distance;
+	}
+
+	return true;
+}
+
+static int convert(const char* inputPath, const char* outputPath, const uint32_t recordsPerBlock, const bool compress) {
+	FILE* input = fopen(inputPath, "rt");
+
+	if(NULL == input) {
+		fprintf(stderr, "Error: unable to open %s\n", inputPath);
+		return 1;
+	}
+
+	MirandaTraceWriter writer;
+
+	if(!writer.open(outputPath, recordsPerBlock, compress)) {
+		fprintf(stderr, "Error: unable to create %s\n", outputPath);
+		fclose(input);
+		return 1;
+	}
+
+	char line[4096];
+	uint64_t lineNumber = 0;
+
+	while(NULL != fgets(line, sizeof(line), input)) {
+		lineNumber++;
+
+		const char* first = line + strspn(line, " \t\r\n");
+		if('\0' == *first || '#' == *first) {
+			continue;
+		}
+
+		MirandaTraceRecord record;
+		std::string error;
+
+		if(!parseRecord(line, &record, &error)) {
+			fprintf(stderr, "Error: %s:%" PRIu64 ": %s\n", inputPath, lineNumber, error.c_str());
+			fclose(input);
+			writer.close();
+			return 1;
+		}
+
+		if(!writer.append(record)) {
+			fprintf(stderr, "Error: unable to write to %s\n", outputPath);
+			fclose(input);
+			writer.close();
+			return 1;
+		}
+	}
+
+	fclose(input);
+
+	const uint64_t records = writer.getRecordCount();
+
+	if(!writer.close()) {
+		fprintf(stderr, "Error: unable to write to %s\n", outputPath);
+		return 1;
+	}
+
+	printf("Wrote %" PRIu64 " records to %s\n", records, outputPath);
+	return 0;
+}
+
+static int dump(const char* inputPath) {
+	MirandaTraceReader reader;
+
+	if(!reader.open(inputPath)) {
+		fprintf(stderr, "Error: %s: %s\n", inputPath, reader.getError().c_str());
+		return 1;
+	}
+
+	std::vector<MirandaTraceRecord> records;
+	std::string error;
+
+	for(uint64_t block = 0; block < reader.getBlockCount(); ++block) {
+		if(!reader.readBlock(block, &records, &error)) {
+			fprintf(stderr, "Error: %s: %s\n", inputPath, error.c_str());
+			return 1;
+		}
+
+		for(size_t i = 0; i < records.size(); ++i) {
+			const MirandaTraceRecord& record = records[i];
+
+			switch(record.op) {
+			case MIRANDA_TRACE_READ:
+			case MIRANDA_TRACE_WRITE:
+				printf("%c 0x%" PRIx64 " %" PRIu32, (MIRANDA_TRACE_READ == record.op) ? 'R' : 'W',
+					record.address, record.length);
+				break;
+			case MIRANDA_TRACE_FENCE:
+				printf("F");
+				break;
+			default:
+				fprintf(stderr, "Error: %s: unknown operation %" PRIu32 "\n", inputPath, (uint32_t) record.op);
+				return 1;
+			}
+
+			for(uint32_t k = 0; k < record.depCount && k < MIRANDA_TRACE_MAX_DEPS; ++k) {
+				printf(" %" PRIu32, record.deps[k]);
+			}
+
+			printf("\n");
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	uint32_t recordsPerBlock = 4096;
+	bool compress = true;
+	bool dumpTrace = false;
+	int next = 1;
+
+	for(; next < argc && '-' == argv[next][0]; ++next) {
+		if(0 == strcmp(argv[next], "-b") && next + 1 < argc) {
+			recordsPerBlock = (uint32_t) strtoul(argv[++next], NULL, 0);
+		} else if(0 == strcmp(argv[next], "-u")) {
+			compress = false;
+		} else if(0 == strcmp(argv[next], "-d")) {
+			dumpTrace = true;
+		} else {
+			usage();
+			return 1;
+		}
+	}
+
+	if(dumpTrace && argc - next == 1) {
+		return dump(argv[next]);
+	}
+
+	if(!dumpTrace && argc - next == 2) {
+		return convert(argv[next], argv[next + 1], recordsPerBlock, compress);
+	}
+
+	usage();
+	return 1;
+}
@@ -0,0 +1,61 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Checks shared by the element unit tests in <element>/tests/unit. Each test
+ * is a standalone program built from element code which does not need SST-Core
+ * at link time (see unitTest.am). A test makes its CHECKs and ends main() with
+ *
+ *     return SST::UnitTest::result("testName");
+ */
+
+#ifndef _H_SST_ELEMENTS_UNIT_TEST
+#define _H_SST_ELEMENTS_UNIT_TEST
+
+#include <stdio.h>
+
+namespace SST {
+namespace UnitTest {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void fail(const char* file, const int line, const char* cond) {
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, cond);
+    failures()++;
+}
+
+/* Report the outcome, returns the exit status for main() */
+inline int result(const char* name) {
+    if (0 == failures()) {
+        printf("%s: all checks passed\n", name);
+        return 0;
+    }
+
+    fprintf(stderr, "%s: %d checks failed\n", name, failures());
+    return 1;
+}
+
+}
+}
+
+#define CHECK(cond) do { \
+    if (!(cond)) \
+        SST::UnitTest::fail(__FILE__, __LINE__, #cond); \
+} while (0)
+
+#endif
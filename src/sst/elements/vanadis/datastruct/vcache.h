@@ -16,103 +16,215 @@
 #ifndef _H_VANADIS_CACHE
 #define _H_VANADIS_CACHE
 
+#include <cstddef>
 #include <cstdint>
-#include <list>
-#include <type_traits>
-#include <unordered_map>
+#include <vector>
 
 namespace SST {
 namespace Vanadis {
 
-template <typename I, typename T> class VanadisCache {
+/*
+ * Fixed capacity, set associative tag store with pseudo-LRU replacement.
+ *
+ * Keys are hashed to a set and each lookup only searches the ways of that
+ * set. Every way has a recently-used bit which is set when the way is
+ * accessed; when that would leave every bit in the set on, the other bits
+ * are cleared. The victim is the first invalid way, otherwise the first way
+ * whose bit is clear, so the most recently used entry of a set is never
+ * replaced (as long as the set has more than one way).
+ *
+ * The tag store hands out slot indices in [0, capacity()) so that callers
+ * can keep the data for each entry in their own flat arrays.
+ */
+template <typename I> class VanadisCacheTags {
 public:
-    VanadisCache(const size_t cache_entries) { reset(cache_entries); }
+    static const size_t npos = static_cast<size_t>(-1);
+
+    VanadisCacheTags(const size_t cache_entries, const size_t set_ways = 8) { reset(cache_entries, set_ways); }
+
+    // Capacity is rounded down to a multiple of the associativity, an
+    // associativity of more than 64 ways is not supported.
+    void reset(const size_t cache_entries, const size_t set_ways = 8) {
+        ways = (set_ways < 1) ? 1 : ((set_ways > 64) ? 64 : set_ways);
+        if (cache_entries < ways) {
+            ways = (cache_entries < 1) ? 1 : cache_entries;
+        }
 
-    ~VanadisCache() {
-        ordering_q.clear();
-        data_values.clear();
+        sets = (cache_entries / ways < 1) ? 1 : (cache_entries / ways);
+
+        keys.assign(sets * ways, I());
+        valid.assign(sets, 0);
+        recent.assign(sets, 0);
+        entry_count = 0;
     }
 
     void clear() {
-        for (auto next_value : data_values) {
-            delete next_value.second;
+        valid.assign(sets, 0);
+        recent.assign(sets, 0);
+        entry_count = 0;
+    }
+
+    // Slot holding key (and mark it recently used) or npos
+    size_t lookup(const I& key) {
+        const size_t set = setOf(key);
+        const size_t way = wayOf(set, key);
+
+        if (way == npos) {
+            return npos;
         }
 
-        ordering_q.clear();
-        data_values.clear();
+        markUsed(set, way);
+        return (set * ways) + way;
     }
 
-    void reset(const size_t cache_entries) {
-        clear();
+    // Slot holding key, without changing the replacement state, or npos
+    size_t peek(const I& key) const {
+        const size_t set = setOf(key);
+        const size_t way = wayOf(set, key);
 
-        max_entries = cache_entries;
-        data_values.reserve(cache_entries);
+        return (way == npos) ? npos : ((set * ways) + way);
     }
 
-    bool contains(const I& value) const { return (data_values.find(value) != data_values.end()); }
+    bool contains(const I& key) const { return peek(key) != npos; }
 
-    T find(const I& key) {
-        send_key_to_front(key);
-        return data_values.find(key)->second;
-    }
+    // Allocate a slot for a key which is not present. If a valid entry had to
+    // be replaced evicted is set to true and the slot still holds the old
+    // data until the caller overwrites it.
+    size_t insert(const I& key, bool& evicted) {
+        const size_t set = setOf(key);
+        const uint64_t full = (ways == 64) ? ~UINT64_C(0) : ((UINT64_C(1) << ways) - 1);
+
+        size_t way = 0;
+
+        if (valid[set] != full) {
+            while ((valid[set] >> way) & 1) {
+                way++;
+            }
 
-    void store(const I& key, T value) {
-        if (contains(key)) {
-            send_key_to_front(key);
-	    data_values[key] = value;
+            valid[set] |= (UINT64_C(1) << way);
+            entry_count++;
+            evicted = false;
         } else {
-            kill_lru_key();
-            data_values.insert(std::pair<I, T>(key, value));
-            ordering_q.push_front(key);
+            while ((recent[set] >> way) & 1) {
+                way++;
+            }
+
+            evicted = true;
         }
+
+        keys[(set * ways) + way] = key;
+        markUsed(set, way);
+
+        return (set * ways) + way;
+    }
+
+    size_t size() const { return entry_count; }
+    size_t capacity() const { return sets * ways; }
+    size_t associativity() const { return ways; }
+
+private:
+    size_t setOf(const I& key) const {
+        // Fibonacci hashing spreads aligned addresses over all of the sets,
+        // the high half of the product is then scaled to the set count
+        const uint64_t hash = (static_cast<uint64_t>(key) * UINT64_C(0x9E3779B97F4A7C15)) >> 32;
+        return static_cast<size_t>((hash * sets) >> 32);
     }
 
-    void touch(const I& key) {
-        if (contains(key)) {
-            send_key_to_front(key);
+    size_t wayOf(const size_t set, const I& key) const {
+        const uint64_t set_valid = valid[set];
+        const I* set_keys = &keys[set * ways];
+
+        for (size_t i = 0; i < ways; ++i) {
+            if (((set_valid >> i) & 1) && (set_keys[i] == key)) {
+                return i;
+            }
         }
+
+        return npos;
     }
 
-    size_t size() const { return data_values.size(); }
-    size_t capacity() const { return max_entries; }
+    void markUsed(const size_t set, const size_t way) {
+        const uint64_t full = (ways == 64) ? ~UINT64_C(0) : ((UINT64_C(1) << ways) - 1);
 
-private:
-    void kill_lru_key() {
-        // if we aren't full yet, then keep entries otherwise we will
-        // throw away
-        if (ordering_q.size() < max_entries) {
-            return;
+        recent[set] |= (UINT64_C(1) << way);
+
+        if (recent[set] == full) {
+            recent[set] = (UINT64_C(1) << way);
         }
+    }
+
+    size_t ways;
+    size_t sets;
+    size_t entry_count;
 
-        I remove_key = ordering_q.back();
-        ordering_q.pop_back();
+    std::vector<I> keys;
+    std::vector<uint64_t> valid;
+    std::vector<uint64_t> recent;
+};
 
-        auto find_key = data_values.find(remove_key);
-        delete find_key->second;
-        data_values.erase(find_key);
+/*
+ * Set associative cache of values, see VanadisCacheTags for the
+ * organization. Values are held inline. If the value type is a pointer
+ * the cache owns the objects and deletes them when they are replaced or
+ * the cache is cleared.
+ */
+template <typename I, typename T> class VanadisCache {
+public:
+    VanadisCache(const size_t cache_entries, const size_t set_ways = 8) : tags(cache_entries, set_ways) {
+        data_values.resize(tags.capacity());
     }
 
-    void send_key_to_front(const I& key) {
-        bool found_key = false;
+    ~VanadisCache() { clear(); }
 
-        for (auto order_itr = ordering_q.begin(); order_itr != ordering_q.end();) {
-            if (key == (*order_itr)) {
-                ordering_q.erase(order_itr);
-                found_key = true;
-                break;
-            } else {
-                order_itr++;
-            }
+    void clear() {
+        for (size_t i = 0; i < data_values.size(); ++i) {
+            releaseValue(data_values[i]);
+            data_values[i] = T();
+        }
+
+        tags.clear();
+    }
+
+    void reset(const size_t cache_entries, const size_t set_ways = 8) {
+        clear();
+
+        tags.reset(cache_entries, set_ways);
+        data_values.assign(tags.capacity(), T());
+    }
+
+    bool contains(const I& key) const { return tags.contains(key); }
+
+    // The key must be present
+    T find(const I& key) { return data_values[tags.lookup(key)]; }
+
+    // Returns true if a different entry had to be replaced
+    bool store(const I& key, T value) {
+        size_t slot = tags.lookup(key);
+        bool evicted = false;
+
+        if (slot == VanadisCacheTags<I>::npos) {
+            slot = tags.insert(key, evicted);
         }
 
-        if (found_key) {
-            ordering_q.push_front(key);
+        if (data_values[slot] != value) {
+            releaseValue(data_values[slot]);
         }
+
+        data_values[slot] = value;
+        return evicted;
     }
 
-    size_t max_entries;
-    std::list<I> ordering_q;
-    std::unordered_map<I, T> data_values;
+    void touch(const I& key) { tags.lookup(key); }
+
+    size_t size() const { return tags.size(); }
+    size_t capacity() const { return tags.capacity(); }
+
+private:
+    template <typename V> static void releaseValue(V* value) { delete value; }
+    template <typename V> static void releaseValue(const V& value) {}
+
+    VanadisCacheTags<I> tags;
+    std::vector<T> data_values;
 };
 
 } // namespace Vanadis
@@ -0,0 +1,293 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_ISSUE_QUEUE
+#define _H_VANADIS_ISSUE_QUEUE
+
+#include "inst/vinst.h"
+#include "inst/vinsttype.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Per hardware thread issue queue with wakeup/select.
+ *
+ * Instructions are inserted in program order once their registers have
+ * been renamed. Each physical register has a ready bit, an instruction
+ * waits on every input register that is not ready when it is inserted
+ * and is woken when the producers of those registers complete
+ * execution. Only instructions with all inputs ready are on the ready
+ * list, which is kept oldest first so selection is deterministic.
+ *
+ * The queue also tracks what is needed to keep memory operations in
+ * order: a load or store may only issue if it is the oldest un-issued
+ * memory operation and there is no older fence that has not retired.
+ */
+class VanadisIssueQueue
+{
+public:
+    VanadisIssueQueue(const size_t slots, const uint16_t int_phys_regs, const uint16_t fp_phys_regs) :
+        entries(slots),
+        int_ready(int_phys_regs, true),
+        fp_ready(fp_phys_regs, true),
+        int_waiters(int_phys_regs),
+        fp_waiters(fp_phys_regs),
+        next_seq(0),
+        dispatched(0)
+    {
+        free_entries.reserve(slots);
+        for ( size_t i = slots; i > 0; --i ) {
+            free_entries.push_back((uint32_t)(i - 1));
+        }
+
+        ready.reserve(slots);
+        in_flight.reserve(slots);
+    }
+
+    // Number of instructions at the front of the ROB which have been
+    // inserted (renamed) and not yet retired
+    size_t countDispatched() const { return dispatched; }
+
+    // Insert an instruction whose physical registers have been assigned.
+    // Output registers become not-ready until the instruction completes.
+    void insert(VanadisInstruction* ins)
+    {
+        assert(!free_entries.empty());
+
+        const uint32_t index = free_entries.back();
+        free_entries.pop_back();
+
+        Entry& entry  = entries[index];
+        entry.ins     = ins;
+        entry.seq     = next_seq++;
+        entry.pending = 0;
+
+        for ( uint16_t i = 0; i < ins->countISAIntRegIn(); ++i ) {
+            const uint16_t phys_reg = ins->getPhysIntRegIn(i);
+            if ( !int_ready[phys_reg] ) {
+                int_waiters[phys_reg].push_back(index);
+                entry.pending++;
+            }
+        }
+
+        for ( uint16_t i = 0; i < ins->countISAFPRegIn(); ++i ) {
+            const uint16_t phys_reg = ins->getPhysFPRegIn(i);
+            if ( !fp_ready[phys_reg] ) {
+                fp_waiters[phys_reg].push_back(index);
+                entry.pending++;
+            }
+        }
+
+        // SYSCALLs write their registers in place (through the OS handler),
+        // the core stops renaming behind them until they retire so nothing
+        // else can be waiting on those registers
+        if ( INST_SYSCALL != ins->getInstFuncType() ) {
+            for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+                int_ready[ins->getPhysIntRegOut(i)] = false;
+            }
+
+            for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+                fp_ready[ins->getPhysFPRegOut(i)] = false;
+            }
+        }
+
+        switch ( ins->getInstFuncType() ) {
+        case INST_LOAD:
+        case INST_STORE:
+            unissued_mem.push_back(entry.seq);
+            break;
+        case INST_FENCE:
+            fences.push_back(entry.seq);
+            break;
+        default:
+            break;
+        }
+
+        if ( 0 == entry.pending ) { insertReady(index); }
+
+        dispatched++;
+    }
+
+    size_t countReady() const { return ready.size(); }
+
+    VanadisInstruction* peekReady(const size_t ready_index) const { return entries[ready[ready_index]].ins; }
+
+    // Can the ready instruction issue without reordering memory operations?
+    bool memoryOrderAllows(const size_t ready_index) const
+    {
+        const Entry& entry = entries[ready[ready_index]];
+
+        switch ( entry.ins->getInstFuncType() ) {
+        case INST_LOAD:
+        case INST_STORE:
+            return (unissued_mem.front() == entry.seq) && (fences.empty() || (fences.front() > entry.seq));
+        default:
+            return true;
+        }
+    }
+
+    // Remove the ready instruction from the queue, it is tracked until it
+    // completes execution so its output registers can be woken
+    void issueReady(const size_t ready_index)
+    {
+        const uint32_t index = ready[ready_index];
+        Entry&         entry = entries[index];
+
+        switch ( entry.ins->getInstFuncType() ) {
+        case INST_LOAD:
+        case INST_STORE:
+            unissued_mem.pop_front();
+            break;
+        default:
+            break;
+        }
+
+        in_flight.push_back(entry.ins);
+        entry.ins = nullptr;
+
+        ready.erase(ready.begin() + ready_index);
+        free_entries.push_back(index);
+    }
+
+    // Mark the outputs of every issued instruction which has completed
+    // execution as ready, waking up the instructions which depend on them.
+    // Must be called before any completed instruction is retired.
+    void wakeup()
+    {
+        size_t keep = 0;
+
+        for ( size_t i = 0; i < in_flight.size(); ++i ) {
+            VanadisInstruction* ins = in_flight[i];
+
+            if ( !ins->completedExecution() ) {
+                in_flight[keep++] = ins;
+                continue;
+            }
+
+            for ( uint16_t j = 0; j < ins->countISAIntRegOut(); ++j ) {
+                wakeRegister(ins->getPhysIntRegOut(j), int_ready, int_waiters);
+            }
+
+            for ( uint16_t j = 0; j < ins->countISAFPRegOut(); ++j ) {
+                wakeRegister(ins->getPhysFPRegOut(j), fp_ready, fp_waiters);
+            }
+        }
+
+        in_flight.resize(keep);
+    }
+
+    // Called for every instruction removed from the front of the ROB
+    void retire(VanadisInstruction* ins)
+    {
+        if ( INST_FENCE == ins->getInstFuncType() ) { fences.pop_front(); }
+
+        dispatched--;
+    }
+
+    // Drop everything, used on a pipeline clear. All registers mapped by the
+    // retirement table hold retired values and so are ready.
+    void clear()
+    {
+        free_entries.clear();
+        for ( size_t i = entries.size(); i > 0; --i ) {
+            entries[i - 1].ins = nullptr;
+            free_entries.push_back((uint32_t)(i - 1));
+        }
+
+        std::fill(int_ready.begin(), int_ready.end(), true);
+        std::fill(fp_ready.begin(), fp_ready.end(), true);
+
+        for ( auto& waiters : int_waiters ) {
+            waiters.clear();
+        }
+
+        for ( auto& waiters : fp_waiters ) {
+            waiters.clear();
+        }
+
+        ready.clear();
+        in_flight.clear();
+        unissued_mem.clear();
+        fences.clear();
+
+        dispatched = 0;
+    }
+
+private:
+    struct Entry
+    {
+        Entry() : ins(nullptr), seq(0), pending(0) {}
+
+        VanadisInstruction* ins;
+        uint64_t            seq;
+        uint32_t            pending;
+    };
+
+    void insertReady(const uint32_t index)
+    {
+        const uint64_t seq = entries[index].seq;
+
+        // Wakeups are mostly for recent instructions, so search from the back
+        auto pos = ready.end();
+        while ( pos != ready.begin() && entries[*(pos - 1)].seq > seq ) {
+            pos--;
+        }
+
+        ready.insert(pos, index);
+    }
+
+    void wakeRegister(
+        const uint16_t phys_reg, std::vector<bool>& reg_ready, std::vector<std::vector<uint32_t>>& reg_waiters)
+    {
+        reg_ready[phys_reg] = true;
+
+        for ( const uint32_t index : reg_waiters[phys_reg] ) {
+            if ( 0 == --entries[index].pending ) { insertReady(index); }
+        }
+
+        reg_waiters[phys_reg].clear();
+    }
+
+    std::vector<Entry>    entries;
+    std::vector<uint32_t> free_entries;
+
+    std::vector<bool>                  int_ready;
+    std::vector<bool>                  fp_ready;
+    std::vector<std::vector<uint32_t>> int_waiters;
+    std::vector<std::vector<uint32_t>> fp_waiters;
+
+    // Entry indices of instructions with all inputs ready, oldest first
+    std::vector<uint32_t> ready;
+
+    std::vector<VanadisInstruction*> in_flight;
+
+    std::deque<uint64_t> unissued_mem;
+    std::deque<uint64_t> fences;
+
+    uint64_t next_seq;
+    size_t   dispatched;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -24,6 +24,9 @@
 #include "lsq/vlsq.h"
 #include "os/vcpuos.h"
 #include "vbranch/vbranchbasic.h"
+#include "vbranch/vbranchbimodal.h"
+#include "vbranch/vbranchgshare.h"
+#include "vbranch/vbranchtage.h"
 #include "vbranch/vbranchunit.h"
 #include "velf/velfinfo.h"
 #include "vinsloader.h"
@@ -89,6 +92,7 @@ public:
         tls_ptr = 0;
 
         thread_rob = nullptr;
+        ins_pool   = nullptr;
 		  fpflags = nullptr;
 
         icache_line_width = params.find<uint64_t>("icache_line_width", 64);
@@ -197,6 +201,9 @@ public:
 
     virtual void setThreadROB(VanadisCircularQueue<VanadisInstruction*>* thr_rob) { thread_rob = thr_rob; }
 
+    // Pool the instructions pushed into the ROB are copied into
+    void setInstructionPool(VanadisInstructionPool* pool) { ins_pool = pool; }
+
     void     setHardwareThread(const uint32_t thr) { hw_thr = thr; }
     uint32_t getHardwareThread() const { return hw_thr; }
 
@@ -220,6 +227,7 @@ protected:
 
     bool                                       wantDelegatedLoad;
     VanadisCircularQueue<VanadisInstruction*>* thread_rob;
+    VanadisInstructionPool*                    ins_pool;
 
     // VanadisCircularQueue<VanadisInstruction*>* decoded_q;
 
@@ -817,7 +817,7 @@ public:
                                     "delay slot...\n");
 
                                 for ( uint32_t i = 0; i < bundle->getInstructionCount(); ++i ) {
-                                    VanadisInstruction* next_ins = bundle->getInstructionByIndex(i)->clone();
+                                    VanadisInstruction* next_ins = bundle->getInstructionByIndex(i)->clone(ins_pool);
 
                                     output->verbose(
                                         CALL_INFO, 16, 0, "---> --> issuing ins addr: 0x0%llx, %s...\n",
@@ -885,7 +885,7 @@ public:
                                 }
 
                                 for ( uint32_t i = 0; i < delay_bundle->getInstructionCount(); ++i ) {
-                                    VanadisInstruction* next_ins = delay_bundle->getInstructionByIndex(i)->clone();
+                                    VanadisInstruction* next_ins = delay_bundle->getInstructionByIndex(i)->clone(ins_pool);
 
                                     output->verbose(
                                         CALL_INFO, 16, 0, "---> --> issuing ins addr: 0x0%llx, %s...\n",
@@ -919,7 +919,7 @@ public:
                                 output->verbose(
                                     CALL_INFO, 16, 0, "---> --> issuing ins addr: 0x0%llx, %s...\n",
                                     next_ins->getInstructionAddress(), next_ins->getInstCode());
-                                thread_rob->push(next_ins->clone());
+                                thread_rob->push(next_ins->clone(ins_pool));
                             }
 
                             uop_bundles_used++;
@@ -479,7 +479,7 @@ public:
                                 }
                             }
 
-                            thread_rob->push(next_ins->clone());
+                            thread_rob->push(next_ins->clone(ins_pool));
                         }
 
                         // Move to the next address, if we had a branch we should have
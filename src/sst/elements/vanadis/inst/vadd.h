@@ -36,7 +36,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisAddInstruction*    clone() override { return new VanadisAddInstruction(*this); }
+    VanadisAddInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisAddInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
 
     const char* getInstCode() const override
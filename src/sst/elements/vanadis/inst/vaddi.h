@@ -36,7 +36,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisAddImmInstruction* clone() override { return new VanadisAddImmInstruction(*this); }
+    VanadisAddImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisAddImmInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override {
 			if(sizeof(gpr_format) == 8) {
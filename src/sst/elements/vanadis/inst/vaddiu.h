@@ -36,7 +36,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisAddImmUnsignedInstruction* clone() override { return new VanadisAddImmUnsignedInstruction(*this); }
+    VanadisAddImmUnsignedInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisAddImmUnsignedInstruction(*this);
+    }
     VanadisFunctionalUnitType         getInstFuncType() const override { return INST_INT_ARITH; }
 
     const char* getInstCode() const override { return "ADDIU"; }
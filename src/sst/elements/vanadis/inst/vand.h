@@ -35,7 +35,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisAndInstruction*    clone() override { return new VanadisAndInstruction(*this); }
+    VanadisAndInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisAndInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override { return "AND"; }
 
@@ -35,7 +35,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisAndImmInstruction* clone() override { return new VanadisAndImmInstruction(*this); }
+    VanadisAndImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisAndImmInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override { return "ANDI"; }
 
@@ -37,7 +37,10 @@ public:
         isa_int_regs_in[1] = src_2;
     }
 
-    VanadisBranchRegCompareInstruction* clone() override { return new VanadisBranchRegCompareInstruction(*this); }
+    VanadisBranchRegCompareInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisBranchRegCompareInstruction(*this);
+    }
     const char*                         getInstCode() const override
     {
         switch ( compare_type ) {
@@ -38,7 +38,10 @@ public:
         isa_int_regs_in[0] = src_1;
     }
 
-    VanadisBranchRegCompareImmInstruction* clone() override { return new VanadisBranchRegCompareImmInstruction(*this); }
+    VanadisBranchRegCompareImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisBranchRegCompareImmInstruction(*this);
+    }
     const char*                            getInstCode() const override { return "BCMPI"; }
 
     void printToBuffer(char* buffer, size_t buffer_size) override
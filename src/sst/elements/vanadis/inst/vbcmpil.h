@@ -40,9 +40,9 @@ public:
         isa_int_regs_out[0] = link_reg;
     }
 
-    VanadisBranchRegCompareImmLinkInstruction* clone() override
+    VanadisBranchRegCompareImmLinkInstruction* clone(VanadisInstructionPool* pool) override
     {
-        return new VanadisBranchRegCompareImmLinkInstruction(*this);
+        return new (pool) VanadisBranchRegCompareImmLinkInstruction(*this);
     }
     const char* getInstCode() const override { return "BCMPIL"; }
 
@@ -36,7 +36,10 @@ public:
         isa_fp_regs_in[0] = cond_reg;
     }
 
-    VanadisBranchFPInstruction* clone() override { return new VanadisBranchFPInstruction(*this); }
+    VanadisBranchFPInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisBranchFPInstruction(*this);
+    }
 
     const char* getInstCode() const override
     {
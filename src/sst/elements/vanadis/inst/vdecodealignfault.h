@@ -36,9 +36,9 @@ public:
         VanadisInstructionFault(address, hw_thr, isa_opts, msg)
     {}
 
-    VanadisInstruction* clone() override
+    VanadisInstruction* clone(VanadisInstructionPool* pool) override
     {
-        return new VanadisInstructionDecodeAlignmentFault(ins_address, hw_thread, isa_options);
+        return new (pool) VanadisInstructionDecodeAlignmentFault(ins_address, hw_thread, isa_options);
     }
 
     const char* getInstCode() const override { return "ALIGN_FAULT"; }
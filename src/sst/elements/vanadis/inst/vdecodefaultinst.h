@@ -31,9 +31,9 @@ public:
         VanadisInstructionFault(address, hw_thr, isa_opts)
     {}
 
-    VanadisInstruction* clone() override
+    VanadisInstruction* clone(VanadisInstructionPool* pool) override
     {
-        return new VanadisInstructionDecodeFault(ins_address, hw_thread, isa_options);
+        return new (pool) VanadisInstructionDecodeFault(ins_address, hw_thread, isa_options);
     }
 
     const char* getInstCode() const override { return "DECODE_FAULT"; }
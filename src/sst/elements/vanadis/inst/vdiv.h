@@ -36,7 +36,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisDivideInstruction* clone() override { return new VanadisDivideInstruction(*this); }
+    VanadisDivideInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisDivideInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_DIV; }
 
     const char* getInstCode() const override
@@ -37,7 +37,10 @@ public:
         isa_int_regs_out[1] = remain_dest;
     }
 
-    VanadisDivideRemainderInstruction* clone() override { return new VanadisDivideRemainderInstruction(*this); }
+    VanadisDivideRemainderInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisDivideRemainderInstruction(*this);
+    }
     VanadisFunctionalUnitType          getInstFuncType() const override { return INST_INT_DIV; }
     const char*                        getInstCode() const override { 
 		if(sizeof(gpr_format)==8) {
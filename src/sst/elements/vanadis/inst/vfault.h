@@ -43,7 +43,10 @@ public:
         fault_msg = "";
     }
 
-    VanadisInstruction* clone() override { return new VanadisInstructionFault(ins_address, hw_thread, isa_options); }
+    VanadisInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisInstructionFault(ins_address, hw_thread, isa_options);
+    }
 
     const char* getInstCode() const override { return "FAULT"; }
 
@@ -34,7 +34,10 @@ public:
         fence = fenceT;
     }
 
-    virtual VanadisFenceInstruction* clone() { return new VanadisFenceInstruction(*this); }
+    virtual VanadisFenceInstruction* clone(VanadisInstructionPool* pool)
+    {
+        return new (pool) VanadisFenceInstruction(*this);
+    }
 
     bool createsLoadFence() const { return (fence == VANADIS_LOAD_FENCE) || (fence == VANADIS_LOAD_STORE_FENCE); }
 
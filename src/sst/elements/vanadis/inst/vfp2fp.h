@@ -50,7 +50,10 @@ public:
         }
     }
 
-    VanadisFP2FPInstruction*  clone() override { return new VanadisFP2FPInstruction(*this); }
+    VanadisFP2FPInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFP2FPInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
@@ -47,7 +47,10 @@ public:
         }
     }
 
-    VanadisFP2GPRInstruction* clone() override { return new VanadisFP2GPRInstruction(*this); }
+    VanadisFP2GPRInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFP2GPRInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
 
     const char* getInstCode() const override
@@ -53,7 +53,10 @@ public:
         }
     }
 
-    VanadisFPAddInstruction*  clone() override { return new VanadisFPAddInstruction(*this); }
+    VanadisFPAddInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPAddInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
@@ -54,7 +54,10 @@ public:
         }
     }
 
-    VanadisFPConvertInstruction* clone() override { return new VanadisFPConvertInstruction(*this); }
+    VanadisFPConvertInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPConvertInstruction(*this);
+    }
     VanadisFunctionalUnitType    getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
@@ -53,7 +53,10 @@ public:
         }
     }
 
-    VanadisFPDivideInstruction* clone() override { return new VanadisFPDivideInstruction(*this); }
+    VanadisFPDivideInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPDivideInstruction(*this);
+    }
     VanadisFunctionalUnitType   getInstFuncType() const override { return INST_FP_DIV; }
 
     const char* getInstCode() const override
@@ -46,7 +46,10 @@ public:
       	}
     }
 
-    VanadisFPFlagsReadInstruction*  clone() override { return new VanadisFPFlagsReadInstruction(*this); }
+    VanadisFPFlagsReadInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPFlagsReadInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
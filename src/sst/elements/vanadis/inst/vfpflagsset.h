@@ -43,7 +43,10 @@ public:
       	}
     }
 
-    VanadisFPFlagsSetInstruction*  clone() override { return new VanadisFPFlagsSetInstruction(*this); }
+    VanadisFPFlagsSetInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPFlagsSetInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
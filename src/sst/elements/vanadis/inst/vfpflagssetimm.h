@@ -42,7 +42,10 @@ public:
 		}
     }
 
-    VanadisFPFlagsSetImmInstruction*  clone() override { return new VanadisFPFlagsSetImmInstruction(*this); }
+    VanadisFPFlagsSetImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPFlagsSetImmInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
@@ -53,7 +53,10 @@ public:
         }
     }
 
-    VanadisFPMultiplyInstruction* clone() override { return new VanadisFPMultiplyInstruction(*this); }
+    VanadisFPMultiplyInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPMultiplyInstruction(*this);
+    }
     VanadisFunctionalUnitType     getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
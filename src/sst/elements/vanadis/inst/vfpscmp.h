@@ -51,7 +51,10 @@ public:
         }
     }
 
-    VanadisFPSetRegCompareInstruction* clone() override { return new VanadisFPSetRegCompareInstruction(*this); }
+    VanadisFPSetRegCompareInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPSetRegCompareInstruction(*this);
+    }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
@@ -56,7 +56,10 @@ public:
         }
     }
 
-    VanadisFPSignLogicInstruction* clone() override { return new VanadisFPSignLogicInstruction(*this); }
+    VanadisFPSignLogicInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPSignLogicInstruction(*this);
+    }
     VanadisFunctionalUnitType      getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
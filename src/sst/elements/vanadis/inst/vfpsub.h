@@ -53,7 +53,10 @@ public:
         }
     }
 
-    VanadisFPSubInstruction*  clone() override { return new VanadisFPSubInstruction(*this); }
+    VanadisFPSubInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisFPSubInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
     const char* getInstCode() const override
@@ -49,7 +49,10 @@ public:
         }
     }
 
-    VanadisGPR2FPInstruction* clone() override { return new VanadisGPR2FPInstruction(*this); }
+    VanadisGPR2FPInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisGPR2FPInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
 
     const char* getInstCode() const override
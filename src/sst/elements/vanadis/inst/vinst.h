@@ -18,6 +18,7 @@
 
 #include "decoder/visaopts.h"
 #include "inst/regfile.h"
+#include "inst/vinstpool.h"
 #include "inst/vinsttype.h"
 #include "inst/vregfmt.h"
 
@@ -47,30 +48,7 @@ public:
         count_isa_fp_reg_in(c_isa_fp_reg_in),
         count_isa_fp_reg_out(c_isa_fp_reg_out)
     {
-
-        phys_int_regs_in = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        std::memset(phys_int_regs_in, 0, count_phys_int_reg_in);
-
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-        std::memset(phys_int_regs_out, 0, count_phys_int_reg_out);
-
-        isa_int_regs_in = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        std::memset(isa_int_regs_in, 0, count_isa_int_reg_in);
-
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-        std::memset(isa_int_regs_out, 0, count_isa_int_reg_out);
-
-        phys_fp_regs_in = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        std::memset(phys_fp_regs_in, 0, count_phys_fp_reg_in);
-
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-        std::memset(phys_fp_regs_out, 0, count_phys_fp_reg_out);
-
-        isa_fp_regs_in = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        std::memset(isa_fp_regs_in, 0, count_isa_fp_reg_in);
-
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-        std::memset(isa_fp_regs_out, 0, count_isa_fp_reg_out);
+        layoutRegisters();
 
         trapError             = false;
         hasExecuted           = false;
@@ -81,18 +59,22 @@ public:
         hasROBSlot            = false;
     }
 
-    virtual ~VanadisInstruction()
+    virtual ~VanadisInstruction() { delete[] reg_heap; }
+
+    // Instructions carry a header in front of them recording where their
+    // memory came from, see VanadisInstructionPool. new (pool) allocates from
+    // a hardware thread's pool, a plain new (used for the decoded templates)
+    // from the heap. delete returns the memory to wherever it came from.
+    static void* operator new(std::size_t size, VanadisInstructionPool* pool)
     {
-        if ( phys_int_regs_in != nullptr ) delete[] phys_int_regs_in;
-        if ( phys_int_regs_out != nullptr ) delete[] phys_int_regs_out;
-        if ( isa_int_regs_in != nullptr ) delete[] isa_int_regs_in;
-        if ( isa_int_regs_out != nullptr ) delete[] isa_int_regs_out;
-        if ( phys_fp_regs_in != nullptr ) delete[] phys_fp_regs_in;
-        if ( phys_fp_regs_out != nullptr ) delete[] phys_fp_regs_out;
-        if ( isa_fp_regs_in != nullptr ) delete[] isa_fp_regs_in;
-        if ( isa_fp_regs_out != nullptr ) delete[] isa_fp_regs_out;
+        return (pool == nullptr) ? VanadisInstructionPool::allocateUnpooled(size) : pool->allocate(size);
     }
 
+    static void* operator new(std::size_t size) { return VanadisInstructionPool::allocateUnpooled(size); }
+
+    static void operator delete(void* ptr) { VanadisInstructionPool::release(ptr); }
+    static void operator delete(void* ptr, VanadisInstructionPool* pool) { VanadisInstructionPool::release(ptr); }
+
     VanadisInstruction(const VanadisInstruction& copy_me) :
         ins_address(copy_me.ins_address),
         hw_thread(copy_me.hw_thread),
@@ -115,17 +97,7 @@ public:
         isFrontOfROB          = false;
         hasROBSlot            = false;
 
-        phys_int_regs_in  = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-
-        isa_int_regs_in  = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-
-        phys_fp_regs_in  = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-
-        isa_fp_regs_in  = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
+        layoutRegisters();
 
         for ( uint16_t i = 0; i < count_phys_int_reg_in; ++i ) {
             phys_int_regs_in[i] = copy_me.phys_int_regs_in[i];
@@ -305,7 +277,8 @@ public:
     void setPhysFPRegIn(const uint16_t index, const uint16_t reg) { phys_fp_regs_in[index] = reg; }
     void setPhysFPRegOut(const uint16_t index, const uint16_t reg) { phys_fp_regs_out[index] = reg; }
 
-    virtual VanadisInstruction* clone() = 0;
+    // Copy this instruction, pool may be nullptr to allocate from the heap
+    virtual VanadisInstruction* clone(VanadisInstructionPool* pool) = 0;
 
     void markEndOfMicroOpGroup() { enduOpGroup = true; }
     bool endsMicroOpGroup() const { return enduOpGroup; }
@@ -351,6 +324,46 @@ public:
     virtual void performFPFlagsUpdate() const {}
 
 protected:
+    // Change the number of integer input registers after construction, the
+    // values of the registers which remain are kept
+    void resizeIntRegIn(const uint16_t count)
+    {
+        // The old arrays are laid out back to back, either in reg_storage
+        // (which layoutRegisters() overwrites, so take a copy) or in
+        // reg_heap (which stays valid until it is deleted below)
+        uint16_t        saved_inline[inline_reg_slots];
+        uint16_t* const old_heap = reg_heap;
+        const uint16_t* old_base = old_heap;
+
+        if ( old_heap == nullptr ) {
+            std::memcpy(saved_inline, reg_storage, sizeof(reg_storage));
+            old_base = saved_inline;
+        }
+
+        const uint16_t old_counts[8] = { count_phys_int_reg_in, count_phys_int_reg_out, count_isa_int_reg_in,
+                                         count_isa_int_reg_out, count_phys_fp_reg_in,   count_phys_fp_reg_out,
+                                         count_isa_fp_reg_in,   count_isa_fp_reg_out };
+
+        count_phys_int_reg_in = count;
+        count_isa_int_reg_in  = count;
+
+        layoutRegisters();
+
+        uint16_t* const new_regs[8] = { phys_int_regs_in, phys_int_regs_out, isa_int_regs_in, isa_int_regs_out,
+                                        phys_fp_regs_in,  phys_fp_regs_out,  isa_fp_regs_in,  isa_fp_regs_out };
+        const uint16_t  new_counts[8] = { count_phys_int_reg_in, count_phys_int_reg_out, count_isa_int_reg_in,
+                                         count_isa_int_reg_out, count_phys_fp_reg_in,   count_phys_fp_reg_out,
+                                         count_isa_fp_reg_in,   count_isa_fp_reg_out };
+
+        for ( int i = 0; i < 8; ++i ) {
+            const uint16_t keep = (old_counts[i] < new_counts[i]) ? old_counts[i] : new_counts[i];
+            if ( keep > 0 ) { std::memcpy(new_regs[i], old_base, keep * sizeof(uint16_t)); }
+            old_base += old_counts[i];
+        }
+
+        delete[] old_heap;
+    }
+
     const uint64_t ins_address;
     const uint32_t hw_thread;
 
@@ -383,6 +396,43 @@ protected:
     bool hasROBSlot;
 
     const VanadisDecoderOptions* isa_options;
+
+private:
+    // Point the register arrays into reg_storage, or into a single heap
+    // allocation for the rare instruction with too many registers, so that
+    // copying an instruction does not need to allocate
+    void layoutRegisters()
+    {
+        const size_t total = (size_t)count_phys_int_reg_in + count_phys_int_reg_out + count_isa_int_reg_in +
+                             count_isa_int_reg_out + count_phys_fp_reg_in + count_phys_fp_reg_out +
+                             count_isa_fp_reg_in + count_isa_fp_reg_out;
+
+        reg_heap        = (total > inline_reg_slots) ? new uint16_t[total] : nullptr;
+        uint16_t* next  = (reg_heap != nullptr) ? reg_heap : reg_storage;
+        std::memset(next, 0, total * sizeof(uint16_t));
+
+        phys_int_regs_in = (count_phys_int_reg_in > 0) ? next : nullptr;
+        next += count_phys_int_reg_in;
+        phys_int_regs_out = (count_phys_int_reg_out > 0) ? next : nullptr;
+        next += count_phys_int_reg_out;
+        isa_int_regs_in = (count_isa_int_reg_in > 0) ? next : nullptr;
+        next += count_isa_int_reg_in;
+        isa_int_regs_out = (count_isa_int_reg_out > 0) ? next : nullptr;
+        next += count_isa_int_reg_out;
+
+        phys_fp_regs_in = (count_phys_fp_reg_in > 0) ? next : nullptr;
+        next += count_phys_fp_reg_in;
+        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? next : nullptr;
+        next += count_phys_fp_reg_out;
+        isa_fp_regs_in = (count_isa_fp_reg_in > 0) ? next : nullptr;
+        next += count_isa_fp_reg_in;
+        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? next : nullptr;
+    }
+
+    static const uint16_t inline_reg_slots = 16;
+
+    uint16_t  reg_storage[inline_reg_slots];
+    uint16_t* reg_heap;
 };
 
 } // namespace Vanadis
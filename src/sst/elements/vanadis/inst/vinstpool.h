@@ -0,0 +1,227 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_INSTRUCTION_POOL
+#define _H_VANADIS_INSTRUCTION_POOL
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisInstructionPool;
+
+/*
+ * Every instruction is preceded by this header so that a plain delete
+ * can return the memory to the pool it came from (or to the heap for
+ * instructions which were not allocated from a pool, such as the
+ * decoded templates held in the micro-op cache).
+ */
+struct alignas(16) VanadisInstructionBlockHeader
+{
+    VanadisInstructionPool* pool;
+    uint32_t                size_class;
+};
+
+/*
+ * Free lists of instruction sized blocks for a single hardware thread.
+ *
+ * Blocks are recycled by size class, so instruction types of similar size
+ * share a list. The lists are intrusive (a free block holds the pointer to
+ * the next free block) so allocating and releasing are a pointer pop and
+ * push with no calls into the system allocator once the pool has warmed
+ * up to the number of instructions the thread keeps in flight.
+ */
+class VanadisInstructionPool
+{
+    static const size_t granularity = 16;
+    static const size_t num_classes = 48;
+
+public:
+    VanadisInstructionPool() : allocated_blocks(0)
+    {
+        for ( size_t i = 0; i < num_classes; ++i ) {
+            free_lists[i] = nullptr;
+        }
+    }
+
+    ~VanadisInstructionPool()
+    {
+        for ( size_t i = 0; i < num_classes; ++i ) {
+            while ( free_lists[i] != nullptr ) {
+                FreeBlock* next = free_lists[i]->next;
+                ::operator delete(free_lists[i]);
+                free_lists[i] = next;
+            }
+        }
+    }
+
+    // Returns memory for an instruction of size bytes, the header is placed
+    // in front of the returned pointer
+    void* allocate(const size_t size)
+    {
+        const size_t block_size = sizeof(VanadisInstructionBlockHeader) + size;
+        const size_t size_class = (block_size + granularity - 1) / granularity;
+
+        VanadisInstructionBlockHeader* header;
+
+        if ( size_class >= num_classes ) {
+            header = static_cast<VanadisInstructionBlockHeader*>(::operator new(block_size));
+            header->pool = nullptr;
+        }
+        else {
+            if ( free_lists[size_class] == nullptr ) {
+                header = static_cast<VanadisInstructionBlockHeader*>(::operator new(size_class * granularity));
+                allocated_blocks++;
+            }
+            else {
+                FreeBlock* block       = free_lists[size_class];
+                free_lists[size_class] = block->next;
+                header                 = reinterpret_cast<VanadisInstructionBlockHeader*>(block);
+            }
+
+            header->pool = this;
+        }
+
+        header->size_class = (uint32_t)size_class;
+        return header + 1;
+    }
+
+    // Memory for instructions which do not come from a pool
+    static void* allocateUnpooled(const size_t size)
+    {
+        VanadisInstructionBlockHeader* header = static_cast<VanadisInstructionBlockHeader*>(
+            ::operator new(sizeof(VanadisInstructionBlockHeader) + size));
+        header->pool       = nullptr;
+        header->size_class = 0;
+        return header + 1;
+    }
+
+    // Return memory from allocate() or allocateUnpooled() to where it came from
+    static void release(void* ptr)
+    {
+        if ( ptr == nullptr ) { return; }
+
+        VanadisInstructionBlockHeader* header = static_cast<VanadisInstructionBlockHeader*>(ptr) - 1;
+
+        if ( header->pool == nullptr ) { ::operator delete(header); }
+        else {
+            header->pool->push(header);
+        }
+    }
+
+    // Number of blocks this pool has requested from the system allocator
+    uint64_t countAllocatedBlocks() const { return allocated_blocks; }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+public:
+    /*
+     * Collects the memory of many instructions whose destructors have
+     * already been run, such as everything squashed from the ROB on a
+     * misspeculation, and returns it in one go. Blocks are chained by
+     * size class as they are added and each chain is spliced onto its
+     * free list with a single update when the batch is released.
+     */
+    class ReleaseBatch
+    {
+    public:
+        ReleaseBatch() : pool(nullptr)
+        {
+            for ( size_t i = 0; i < num_classes; ++i ) {
+                heads[i] = nullptr;
+                tails[i] = nullptr;
+            }
+        }
+
+        ~ReleaseBatch() { release(); }
+
+        // ptr is memory from allocate() or allocateUnpooled()
+        void add(void* ptr)
+        {
+            if ( ptr == nullptr ) { return; }
+
+            VanadisInstructionBlockHeader* header = static_cast<VanadisInstructionBlockHeader*>(ptr) - 1;
+
+            if ( header->pool == nullptr ) {
+                ::operator delete(header);
+                return;
+            }
+
+            if ( pool == nullptr ) { pool = header->pool; }
+
+            // Blocks are expected to come from one pool, any others are
+            // returned individually
+            if ( header->pool != pool ) {
+                header->pool->push(header);
+                return;
+            }
+
+            const uint32_t size_class = header->size_class;
+            FreeBlock*     block      = reinterpret_cast<FreeBlock*>(header);
+
+            block->next = heads[size_class];
+            if ( tails[size_class] == nullptr ) { tails[size_class] = block; }
+            heads[size_class] = block;
+        }
+
+        // Splice everything added so far onto the pool's free lists
+        void release()
+        {
+            if ( pool == nullptr ) { return; }
+
+            for ( size_t i = 0; i < num_classes; ++i ) {
+                if ( heads[i] != nullptr ) {
+                    tails[i]->next      = pool->free_lists[i];
+                    pool->free_lists[i] = heads[i];
+                    heads[i]            = nullptr;
+                    tails[i]            = nullptr;
+                }
+            }
+
+            pool = nullptr;
+        }
+
+    private:
+        VanadisInstructionPool* pool;
+        FreeBlock*              heads[num_classes];
+        FreeBlock*              tails[num_classes];
+    };
+
+private:
+
+    void push(VanadisInstructionBlockHeader* header)
+    {
+        const uint32_t size_class = header->size_class;
+        FreeBlock*     block      = reinterpret_cast<FreeBlock*>(header);
+
+        block->next            = free_lists[size_class];
+        free_lists[size_class] = block;
+    }
+
+    FreeBlock* free_lists[num_classes];
+    uint64_t   allocated_blocks;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
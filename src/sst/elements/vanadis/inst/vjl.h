@@ -38,7 +38,10 @@ public:
         takenAddress        = pc;
     }
 
-    VanadisJumpLinkInstruction* clone() override { return new VanadisJumpLinkInstruction(*this); }
+    VanadisJumpLinkInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisJumpLinkInstruction(*this);
+    }
 
     const char* getInstCode() const override { return "JL"; }
 
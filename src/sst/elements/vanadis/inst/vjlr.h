@@ -40,7 +40,10 @@ public:
         isa_int_regs_out[0] = returnAddrReg;
     }
 
-    VanadisJumpRegLinkInstruction* clone() { return new VanadisJumpRegLinkInstruction(*this); }
+    VanadisJumpRegLinkInstruction* clone(VanadisInstructionPool* pool)
+    {
+        return new (pool) VanadisJumpRegLinkInstruction(*this);
+    }
 
     virtual const char* getInstCode() const { return "JLR"; }
 
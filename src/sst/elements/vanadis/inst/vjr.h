@@ -33,7 +33,10 @@ public:
         isa_int_regs_in[0] = jump_to_reg;
     }
 
-    VanadisJumpRegInstruction* clone() { return new VanadisJumpRegInstruction(*this); }
+    VanadisJumpRegInstruction* clone(VanadisInstructionPool* pool)
+    {
+        return new (pool) VanadisJumpRegInstruction(*this);
+    }
 
     virtual const char* getInstCode() const { return "JR"; }
 
@@ -37,7 +37,10 @@ public:
         takenAddress = pc;
     }
 
-    VanadisJumpInstruction* clone() override { return new VanadisJumpInstruction(*this); }
+    VanadisJumpInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisJumpInstruction(*this);
+    }
 
     const char* getInstCode() const override { return "JMP"; }
 
@@ -55,7 +55,7 @@ public:
         }
     }
 
-    VanadisLoadInstruction* clone() { return new VanadisLoadInstruction(*this); }
+    VanadisLoadInstruction* clone(VanadisInstructionPool* pool) { return new (pool) VanadisLoadInstruction(*this); }
 
     bool performSignExtension() const { return signed_extend; }
 
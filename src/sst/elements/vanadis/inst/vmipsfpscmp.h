@@ -56,7 +56,10 @@ public:
         }
     }
 
-    VanadisMIPSFPSetRegCompareInstruction* clone() override { return new VanadisMIPSFPSetRegCompareInstruction(*this); }
+    VanadisMIPSFPSetRegCompareInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisMIPSFPSetRegCompareInstruction(*this);
+    }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const override { return INST_FP_ARITH; }
 
@@ -36,7 +36,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisModuloInstruction* clone() override { return new VanadisModuloInstruction(*this); }
+    VanadisModuloInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisModuloInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_DIV; }
 
     const char* getInstCode() const override
@@ -38,7 +38,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisMoveCompareImmInstruction* clone() override { return new VanadisMoveCompareImmInstruction(*this); }
+    VanadisMoveCompareImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisMoveCompareImmInstruction(*this);
+    }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
 
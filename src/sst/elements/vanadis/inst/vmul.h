@@ -36,7 +36,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisMultiplyInstruction* clone() override { return new VanadisMultiplyInstruction(*this); }
+    VanadisMultiplyInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisMultiplyInstruction(*this);
+    }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override
@@ -37,7 +37,10 @@ public:
         imm_value = immediate;
     }
 
-    VanadisMultiplyImmInstruction* clone() override { return new VanadisMultiplyImmInstruction(*this); }
+    VanadisMultiplyImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisMultiplyImmInstruction(*this);
+    }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override { return "MULI"; }
@@ -37,7 +37,10 @@ public:
         isa_int_regs_out[1] = dest_hi;
     }
 
-    VanadisMultiplySplitInstruction* clone() override { return new VanadisMultiplySplitInstruction(*this); }
+    VanadisMultiplySplitInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisMultiplySplitInstruction(*this);
+    }
     VanadisFunctionalUnitType        getInstFuncType() const override { return INST_INT_ARITH; }
 
     const char* getInstCode() const override { return "MULSPLIT"; }
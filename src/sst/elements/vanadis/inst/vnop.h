@@ -28,7 +28,7 @@ public:
         VanadisInstruction(addr, hw_thr, isa_opts, 0, 0, 0, 0, 0, 0, 0, 0)
     {}
 
-    VanadisNoOpInstruction* clone() { return new VanadisNoOpInstruction(*this); }
+    VanadisNoOpInstruction* clone(VanadisInstructionPool* pool) { return new (pool) VanadisNoOpInstruction(*this); }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_NOOP; }
 
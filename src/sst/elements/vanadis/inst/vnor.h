@@ -35,7 +35,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    virtual VanadisNorInstruction* clone() { return new VanadisNorInstruction(*this); }
+    virtual VanadisNorInstruction* clone(VanadisInstructionPool* pool)
+    {
+        return new (pool) VanadisNorInstruction(*this);
+    }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_INT_ARITH; }
 
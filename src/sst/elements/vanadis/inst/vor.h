@@ -35,7 +35,7 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    virtual VanadisOrInstruction* clone() { return new VanadisOrInstruction(*this); }
+    virtual VanadisOrInstruction* clone(VanadisInstructionPool* pool) { return new (pool) VanadisOrInstruction(*this); }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_INT_ARITH; }
 
@@ -36,7 +36,7 @@ public:
         imm_value = immediate;
     }
 
-    VanadisOrImmInstruction* clone() { return new VanadisOrImmInstruction(*this); }
+    VanadisOrImmInstruction* clone(VanadisInstructionPool* pool) { return new (pool) VanadisOrImmInstruction(*this); }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_INT_ARITH; }
 
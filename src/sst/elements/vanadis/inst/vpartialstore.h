@@ -39,7 +39,10 @@ public:
 
     virtual bool isPartialStore() { return true; }
 
-    VanadisPartialStoreInstruction* clone() { return new VanadisPartialStoreInstruction(*this); }
+    VanadisPartialStoreInstruction* clone(VanadisInstructionPool* pool)
+    {
+        return new (pool) VanadisPartialStoreInstruction(*this);
+    }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_STORE; }
 
@@ -35,7 +35,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisPCAddImmInstruction* clone() override { return new VanadisPCAddImmInstruction(*this); }
+    VanadisPCAddImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisPCAddImmInstruction(*this);
+    }
     VanadisFunctionalUnitType   getInstFuncType() const override { return INST_INT_ARITH; }
     const char*                 getInstCode() const override { 
 		if(sizeof(gpr_format) == 8) {
@@ -38,7 +38,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisSetRegCompareInstruction* clone() override { return new VanadisSetRegCompareInstruction(*this); }
+    VanadisSetRegCompareInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisSetRegCompareInstruction(*this);
+    }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override { return "CMPSET"; }
@@ -38,7 +38,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisSetRegCompareImmInstruction* clone() override { return new VanadisSetRegCompareImmInstruction(*this); }
+    VanadisSetRegCompareImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisSetRegCompareImmInstruction(*this);
+    }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override { return "CMPSETI"; }
@@ -35,7 +35,10 @@ public:
         imm_value           = immediate;
     }
 
-    VanadisSetRegisterInstruction* clone() override { return new VanadisSetRegisterInstruction(*this); }
+    VanadisSetRegisterInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisSetRegisterInstruction(*this);
+    }
     VanadisFunctionalUnitType      getInstFuncType() const override { return INST_INT_ARITH; }
     const char*                    getInstCode() const override { return "SETREG"; }
 
@@ -37,7 +37,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisShiftLeftLogicalInstruction* clone() override { return new VanadisShiftLeftLogicalInstruction(*this); }
+    VanadisShiftLeftLogicalInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisShiftLeftLogicalInstruction(*this);
+    }
     VanadisFunctionalUnitType           getInstFuncType() const override { return INST_INT_ARITH; }
     const char*                         getInstCode() const override { return "SLL"; }
 
@@ -38,7 +38,10 @@ public:
         imm_value = immediate;
     }
 
-    VanadisShiftLeftLogicalImmInstruction* clone() override { return new VanadisShiftLeftLogicalImmInstruction(*this); }
+    VanadisShiftLeftLogicalImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisShiftLeftLogicalImmInstruction(*this);
+    }
     VanadisFunctionalUnitType              getInstFuncType() const override { return INST_INT_ARITH; }
     const char*                            getInstCode() const override
     {
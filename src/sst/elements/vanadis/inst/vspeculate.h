@@ -58,8 +58,11 @@ public:
     virtual VanadisDelaySlotRequirement getDelaySlotType() const { return delayType; }
     uint64_t                            getInstructionWidth() const { return ins_width; }
 
+    // Address execution continues at if the branch is not taken
+    uint64_t getNotTakenAddress() const { return calculateStandardNotTakenAddress(); }
+
 protected:
-    uint64_t calculateStandardNotTakenAddress()
+    uint64_t calculateStandardNotTakenAddress() const
     {
         uint64_t new_addr = getInstructionAddress();
 
@@ -37,9 +37,9 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisShiftRightArithmeticInstruction* clone() override
+    VanadisShiftRightArithmeticInstruction* clone(VanadisInstructionPool* pool) override
     {
-        return new VanadisShiftRightArithmeticInstruction(*this);
+        return new (pool) VanadisShiftRightArithmeticInstruction(*this);
     }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
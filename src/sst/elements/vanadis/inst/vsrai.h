@@ -38,9 +38,9 @@ public:
         imm_value = immediate;
     }
 
-    VanadisShiftRightArithmeticImmInstruction* clone() override
+    VanadisShiftRightArithmeticImmInstruction* clone(VanadisInstructionPool* pool) override
     {
-        return new VanadisShiftRightArithmeticImmInstruction(*this);
+        return new (pool) VanadisShiftRightArithmeticImmInstruction(*this);
     }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
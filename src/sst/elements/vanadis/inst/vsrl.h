@@ -37,7 +37,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisShiftRightLogicalInstruction* clone() override { return new VanadisShiftRightLogicalInstruction(*this); }
+    VanadisShiftRightLogicalInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisShiftRightLogicalInstruction(*this);
+    }
     VanadisFunctionalUnitType            getInstFuncType() const override { return INST_INT_ARITH; }
     const char*                          getInstCode() const override { return "SRL"; }
 
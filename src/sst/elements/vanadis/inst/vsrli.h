@@ -38,9 +38,9 @@ public:
         imm_value = immediate;
     }
 
-    VanadisShiftRightLogicalImmInstruction* clone() override
+    VanadisShiftRightLogicalImmInstruction* clone(VanadisInstructionPool* pool) override
     {
-        return new VanadisShiftRightLogicalImmInstruction(*this);
+        return new (pool) VanadisShiftRightLogicalImmInstruction(*this);
     }
 
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
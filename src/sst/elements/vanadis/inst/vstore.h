@@ -61,7 +61,7 @@ public:
         }
     }
 
-    VanadisStoreInstruction* clone() { return new VanadisStoreInstruction(*this); }
+    VanadisStoreInstruction* clone(VanadisInstructionPool* pool) { return new (pool) VanadisStoreInstruction(*this); }
 
     virtual bool isPartialStore() { return false; }
 
@@ -37,7 +37,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisSubInstruction*    clone() override { return new VanadisSubInstruction(*this); }
+    VanadisSubInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisSubInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override
     {
@@ -42,7 +42,10 @@ public:
         }
     }
 
-    VanadisSysCallInstruction* clone() { return new VanadisSysCallInstruction(*this); }
+    VanadisSysCallInstruction* clone(VanadisInstructionPool* pool)
+    {
+        return new (pool) VanadisSysCallInstruction(*this);
+    }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_SYSCALL; }
 
@@ -35,7 +35,10 @@ public:
         isa_int_regs_out[0] = dest;
     }
 
-    VanadisTruncateInstruction* clone() override { return new VanadisTruncateInstruction(*this); }
+    VanadisTruncateInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisTruncateInstruction(*this);
+    }
     VanadisFunctionalUnitType   getInstFuncType() const override { return INST_INT_ARITH; }
     const char*                 getInstCode() const override { return "TRUNC"; }
 
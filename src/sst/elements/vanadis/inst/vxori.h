@@ -36,7 +36,10 @@ public:
         imm_value = immediate;
     }
 
-    VanadisXorImmInstruction* clone() override { return new VanadisXorImmInstruction(*this); }
+    VanadisXorImmInstruction* clone(VanadisInstructionPool* pool) override
+    {
+        return new (pool) VanadisXorImmInstruction(*this);
+    }
     VanadisFunctionalUnitType getInstFuncType() const override { return INST_INT_ARITH; }
     const char*               getInstCode() const override { return "XORI"; }
 
@@ -76,6 +76,7 @@ v_cpu_0.addParams({
        "issues_per_cycle" :  issues_per_cycle,
        "retires_per_cycle" : retires_per_cycle,
        "auto_clock_syscall" : auto_clock_sys,
+       "report_sim_rate" : os.getenv("VANADIS_REPORT_SIM_RATE", 0),
        "pause_when_retire_address" : os.getenv("VANADIS_HALT_AT_ADDRESS", 0)
 #       "reorder_slots" : 32,
 #       "decodes_per_cycle" : 2,
@@ -106,7 +107,7 @@ vanadis_os_hdlr = "vanadis.Vanadis" + vanadis_isa + "OSHandler"
 decode0     = v_cpu_0.setSubComponent( "decoder0", vanadis_decoder )
 os_hdlr     = decode0.setSubComponent( "os_handler", vanadis_os_hdlr )
 #os_hdlr     = decode0.setSubComponent( "os_handler", "vanadis.VanadisMIPSOSHandler" )
-branch_pred = decode0.setSubComponent( "branch_unit", "vanadis.VanadisBasicBranchUnit" )
+branch_pred = decode0.setSubComponent( "branch_unit", os.getenv("VANADIS_BRANCH_UNIT", "vanadis.VanadisBasicBranchUnit") )
 
 decode0.addParams({
 	"uop_cache_entries" : 1536,
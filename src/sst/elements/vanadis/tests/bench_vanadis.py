@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2021 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2021, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Runs the binaries under tests/small through basic_vanadis.py and
+# reports the simulation rate of each (instructions retired per second
+# of host time).  The binaries must already have been built with the
+# Makefiles in tests/small.
+#
+#   python3 bench_vanadis.py [-r repeats] [--sst path-to-sst]
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+test_dir = os.path.dirname(os.path.abspath(__file__))
+
+# Same list as testsuite_default_vanadis.py
+benchmarks = [
+    ("small/basic-io", "hello-world"),
+    ("small/basic-io", "hello-world-CC"),
+    ("small/basic-io", "printf-check"),
+    ("small/basic-math", "sqrt-double"),
+    ("small/basic-math", "sqrt-float"),
+    ("small/basic-ops", "test-branch"),
+    ("small/basic-ops", "test-shift"),
+]
+
+rate_re = re.compile(r"retired (\d+) instructions in (\d+) cycles, ([0-9.]+) seconds host time")
+
+
+def run(sst, exe):
+    env = dict(os.environ)
+    env["VANADIS_EXE"] = exe
+    env["VANADIS_REPORT_SIM_RATE"] = "1"
+
+    # The simulated OS writes its output files to the working directory
+    with tempfile.TemporaryDirectory() as run_dir:
+        result = subprocess.run([sst, os.path.join(test_dir, "basic_vanadis.py")], cwd=run_dir, env=env,
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+
+    match = rate_re.search(result.stdout)
+    if result.returncode != 0 or match is None:
+        return None
+    return int(match.group(1)), int(match.group(2)), float(match.group(3))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the Vanadis simulation rate for the tests/small binaries")
+    parser.add_argument("-r", "--repeats", type=int, default=3, help="runs per binary, the fastest is reported")
+    parser.add_argument("--sst", default="sst", help="sst executable")
+    args = parser.parse_args()
+
+    print("%-16s %12s %12s %10s %14s" % ("binary", "instructions", "cycles", "seconds", "instructions/s"))
+
+    total_ins = 0
+    total_seconds = 0.0
+    for elf_dir, elf_file in benchmarks:
+        exe = os.path.join(test_dir, elf_dir, elf_file)
+        if not os.path.isfile(exe):
+            print("%-16s not built, skipping" % elf_file)
+            continue
+
+        best = None
+        for _ in range(args.repeats):
+            sample = run(args.sst, exe)
+            if sample is None:
+                break
+            if best is None or sample[2] < best[2]:
+                best = sample
+
+        if best is None:
+            print("%-16s failed" % elf_file)
+            continue
+
+        ins, cycles, seconds = best
+        total_ins += ins
+        total_seconds += seconds
+        print("%-16s %12d %12d %10.3f %14.0f" % (elf_file, ins, cycles, seconds, ins / seconds if seconds > 0 else 0))
+
+    if total_seconds > 0:
+        print("%-16s %12d %12s %10.3f %14.0f" % ("total", total_ins, "", total_seconds, total_ins / total_seconds))
+
+
+if __name__ == "__main__":
+    main()
@@ -29,6 +29,12 @@ def build_vanadis_test_matrix():
     testlist.append(["basic_vanadis.py", "small/basic-ops", "test-branch", 300])
     testlist.append(["basic_vanadis.py", "small/basic-ops", "test-shift", 300])
 
+    # Run the branch heavy tests with each of the direction predicting branch
+    # units as well, the program output must not change
+    for branch_unit in ["VanadisBimodalBranchUnit", "VanadisGShareBranchUnit", "VanadisTAGEBranchUnit"]:
+        testlist.append(["basic_vanadis.py", "small/basic-ops", "test-branch", 300, branch_unit])
+        testlist.append(["basic_vanadis.py", "small/basic-io", "printf-check", 120, branch_unit])
+
     # Process each line and crack up into an index, hash, options and sdl file
     for testnum, test_info in enumerate(testlist):
         # Make testnum start at 1
@@ -37,10 +43,13 @@ def build_vanadis_test_matrix():
         elftestdir = test_info[1]
         elffile = test_info[2]
         timeout_sec = test_info[3]
+        branch_unit = test_info[4] if len(test_info) > 4 else "VanadisBasicBranchUnit"
         testname = "{0}_{1}".format(elftestdir.replace("/", "_"), elffile)
+        if branch_unit != "VanadisBasicBranchUnit":
+            testname = "{0}_{1}".format(testname, branch_unit)
 
         # Build the test_data structure
-        test_data = (testnum, testname, sdlfile, elftestdir, elffile, timeout_sec)
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, branch_unit)
         vanadis_test_matrix.append(test_data)
 
 ################################################################################
@@ -96,18 +105,20 @@ class testcase_vanadis(SSTTestCase):
 #####
 
     @parameterized.expand(vanadis_test_matrix, name_func=gen_custom_name)
-    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, timeout_sec):
+    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, branch_unit):
         self._checkSkipConditions()
 
-        log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec))
-        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec)
+        log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}; using sdl={2} and branch unit {6}".format(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, branch_unit))
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, branch_unit)
 
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, testtimeout=120, branch_unit="VanadisBasicBranchUnit"):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = "{0}/vanadis_tests/{1}/{2}".format(self.get_test_output_run_dir(), elftestdir,elffile)
+        if branch_unit != "VanadisBasicBranchUnit":
+            outdir = "{0}_{1}".format(outdir, branch_unit)
         tmpdir = self.get_test_output_tmp_dir()
         os.makedirs(outdir)
 
@@ -125,6 +136,7 @@ class testcase_vanadis(SSTTestCase):
         # Set the Vanadis EXE path
         testfilepath = "{0}/{1}/{2}".format(test_path, elftestdir, elffile)
         os.environ['VANADIS_EXE'] = testfilepath
+        os.environ['VANADIS_BRANCH_UNIT'] = "vanadis.{0}".format(branch_unit)
 
         oscmd = self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=outdir, timeout_sec=testtimeout)
 
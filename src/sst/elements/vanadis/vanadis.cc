@@ -173,12 +173,14 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
             CALL_INFO, 8, 0, "Reorder buffer set to %" PRIu32 " entries, these are shared by all threads.\n",
             rob_count);
         rob.push_back(new VanadisCircularQueue<VanadisInstruction*>(rob_count));
+        ins_pools.push_back(new VanadisInstructionPool());
         // WE NEED ISA INTEGER AND FP COUNTS HERE NOT ZEROS
         issue_isa_tables.push_back(new VanadisISATable(
             thread_decoders[i]->getDecoderOptions(), thread_decoders[i]->countISAIntReg(),
             thread_decoders[i]->countISAFPReg()));
 
         thread_decoders[i]->setThreadROB(rob[i]);
+        thread_decoders[i]->setInstructionPool(ins_pools[i]);
 
         for ( uint16_t j = 0; j < thread_decoders[i]->countISAIntReg(); ++j ) {
             issue_isa_tables[i]->setIntPhysReg(j, int_register_stacks[i]->pop());
@@ -198,23 +200,12 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     delete[] decoder_name;
 
-    uint16_t max_int_regs = 0;
-    uint16_t max_fp_regs  = 0;
-
+    // Every instruction in a thread's ROB can be waiting in its issue queue
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        max_int_regs = std::max(max_int_regs, thread_decoders[i]->countISAIntReg());
-        max_fp_regs  = std::max(max_fp_regs, thread_decoders[i]->countISAFPReg());
+        issue_queues.push_back(new VanadisIssueQueue(rob_count, int_reg_count, fp_reg_count));
     }
 
-    //	printf("MAX INT: %" PRIu16 ", MAX FP: %" PRIu16 "\n", max_int_regs,
-    // max_fp_regs );
-
-    tmp_not_issued_int_reg_read.reserve(max_int_regs);
-    tmp_int_reg_write.reserve(max_int_regs);
-    tmp_not_issued_fp_reg_read.reserve(max_fp_regs);
-    tmp_fp_reg_write.reserve(max_fp_regs);
-
-    resetRegisterUseTemps(max_int_regs, max_fp_regs);
+    select_start.resize(hw_threads, 0);
 
     //	memDataInterface =
     // loadUserSubComponent<Interfaces::SimpleMem>("mem_interface_data",
@@ -464,6 +455,8 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     }
 
     pause_on_retire_address = params.find<uint64_t>("pause_when_retire_address", 0);
+    report_sim_rate         = params.find<bool>("report_sim_rate", false);
+    ins_retired_total       = 0;
 
     // Register statistics ///////////////////////////////////////////////////////
     stat_ins_retired          = registerStatistic<uint64_t>("instructions_retired", "1");
@@ -494,6 +487,21 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
 	 for( VanadisFloatingPointFlags* next_fp_flags : fp_flags ) {
 		delete next_fp_flags;
 	 }
+
+    for ( VanadisIssueQueue* next_iq : issue_queues ) {
+        delete next_iq;
+    }
+
+    // Instructions still in flight belong to the pools, release them
+    // before the pools go away
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        for ( size_t j = 0; j < rob[i]->size(); ++j ) {
+            delete rob[i]->peekAt(j);
+        }
+
+        rob[i]->clear();
+        delete ins_pools[i];
+    }
 }
 
 void
@@ -557,159 +565,111 @@ VANADIS_COMPONENT::performDecode(const uint64_t cycle)
     return 0;
 }
 
-void
-VANADIS_COMPONENT::resetRegisterUseTemps(const uint16_t int_reg_count, const uint16_t fp_reg_count)
+int
+VANADIS_COMPONENT::performDispatch(const uint64_t cycle)
 {
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        if ( halted_masks[i] ) { continue; }
 
-    std::fill_n(tmp_not_issued_int_reg_read.begin(), int_reg_count, false);
-    std::fill_n(tmp_int_reg_write.begin(), int_reg_count, false);
+        VanadisIssueQueue* thr_iq = issue_queues[i];
 
-    std::fill_n(tmp_not_issued_fp_reg_read.begin(), fp_reg_count, false);
-    std::fill_n(tmp_fp_reg_write.begin(), fp_reg_count, false);
+        // Rename newly decoded instructions in program order and hand them to
+        // the issue queue
+        while ( thr_iq->countDispatched() < rob[i]->size() ) {
+            const size_t rob_index = thr_iq->countDispatched();
 
-    /*
-        for (uint16_t i = 0; i < int_reg_count; ++i) {
-            tmp_not_issued_int_reg_read[i] = false;
-            tmp_int_reg_write[i] = false;
-        }
+            // SYSCALLs read and write the registers in place, nothing behind
+            // one is renamed until it has retired
+            if ( (rob_index > 0) && (INST_SYSCALL == rob[i]->peekAt(rob_index - 1)->getInstFuncType()) ) { break; }
+
+            VanadisInstruction* ins = rob[i]->peekAt(rob_index);
 
-        for (uint16_t i = 0; i < fp_reg_count; ++i) {
-            tmp_not_issued_fp_reg_read[i] = false;
-            tmp_fp_reg_write[i] = false;
+            // We need places to store our output registers
+            if ( (INST_SYSCALL != ins->getInstFuncType()) &&
+                 ((int_register_stacks[i]->unused() < ins->countISAIntRegOut()) ||
+                  (fp_register_stacks[i]->unused() < ins->countISAFPRegOut())) ) {
+#ifdef VANADIS_BUILD_DEBUG
+                output->verbose(
+                    CALL_INFO, 16, 0,
+                    "----> insufficient output / req: int: %" PRIu16 " fp: %" PRIu16 " / free: int: %" PRIu16
+                    " fp: %" PRIu16 "\n",
+                    (uint16_t)ins->countISAIntRegOut(), (uint16_t)ins->countISAFPRegOut(),
+                    (uint16_t)int_register_stacks[i]->unused(), (uint16_t)fp_register_stacks[i]->unused());
+#endif
+                break;
+            }
+
+            assignRegistersToInstruction(
+                thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg(), ins,
+                int_register_stacks[i], fp_register_stacks[i], issue_isa_tables[i]);
+            ins->markRegistersAllocated();
+
+            thr_iq->insert(ins);
         }
-    */
+    }
+
+    return 0;
 }
 
-// TODO - rob_start found_store and found_load should be arrays per thread for this call I think?
 int
-VANADIS_COMPONENT::performIssue(const uint64_t cycle, uint32_t& rob_start, bool& found_store, bool& found_load)
+VANADIS_COMPONENT::performIssue(const uint64_t cycle)
 {
     const int output_verbosity = output->getVerboseLevel();
     bool      issued_an_ins    = false;
 
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
         if ( !halted_masks[i] ) {
-#ifdef VANADIS_BUILD_DEBUG
-            if ( output->getVerboseLevel() >= 4 ) {
-                issue_isa_tables[i]->print(output, register_files[i], print_int_reg, print_fp_reg);
-            }
-#endif
-            // we have not issued an instruction this cycle
-            issued_an_ins = false;
+            VanadisIssueQueue* thr_iq            = issue_queues[i];
+            bool               thr_issued_an_ins = false;
 
-            // Find the next instruction which has not been issued yet
-            for ( uint32_t j = rob_start; j < rob[i]->size(); ++j ) {
-                VanadisInstruction* ins = rob[i]->peekAt(j);
+            // Only instructions whose inputs are ready are considered, oldest
+            // first. Anything before select_start was already found unable to
+            // issue this cycle.
+            for ( size_t j = select_start[i]; j < thr_iq->countReady(); ++j ) {
+                VanadisInstruction* ins = thr_iq->peekReady(j);
 
-                if ( !ins->completedIssue() ) {
 #ifdef VANADIS_BUILD_DEBUG
-                    if ( output_verbosity >= 8 ) {
-                        ins->printToBuffer(instPrintBuffer, 1024);
-                        output->verbose(
-                            CALL_INFO, 8, 0, "--> Attempting issue for: rob[%" PRIu32 "]: 0x%llx / %s\n", j,
-                            ins->getInstructionAddress(), instPrintBuffer);
-                    }
-#endif
-                    const int resource_check = checkInstructionResources(
-                        ins, int_register_stacks[i], fp_register_stacks[i], issue_isa_tables[i]);
-
-#ifdef VANADIS_BUILD_DEBUG
-                    if ( output_verbosity >= 8 ) {
-                        output->verbose(
-                            CALL_INFO, 8, 0, "----> Check if registers are usable? result: %d (%s)\n", resource_check,
-                            (0 == resource_check) ? "success" : "cannot issue");
-                    }
+                if ( output_verbosity >= 8 ) {
+                    ins->printToBuffer(instPrintBuffer, 1024);
+                    output->verbose(
+                        CALL_INFO, 8, 0, "--> Attempting issue for: ready[%" PRIu32 "]: 0x%llx / %s\n", (uint32_t)j,
+                        ins->getInstructionAddress(), instPrintBuffer);
+                }
 #endif
 
-                    if ( 0 == resource_check ) {
-                        if ( ((INST_STORE == ins->getInstFuncType()) || (INST_LOAD == ins->getInstFuncType())) &&
-                             (found_load || found_store) ) {
-                            // We cannot issue
-                        }
-                        else {
-                            //							if(
-                            //(INST_LOAD == ins->getInstFuncType()) && (found_load ||
-                            // found_store) ) {
-                            //									//
-                            // We cannot issue 							} else {
-                            const int allocate_fu = allocateFunctionalUnit(ins);
+                // Keep loads and stores in order with each other and behind
+                // any fences, otherwise we could get an ordering violation in
+                // the memory system
+                if ( !thr_iq->memoryOrderAllows(j) ) { continue; }
 
-#ifdef VANADIS_BUILD_DEBUG
-                            if ( output_verbosity >= 8 ) {
-                                output->verbose(
-                                    CALL_INFO, 8, 0, "----> allocated functional unit: %s\n",
-                                    (0 == allocate_fu) ? "yes" : "no");
-                            }
-#endif
+                const int allocate_fu = allocateFunctionalUnit(ins);
 
-                            if ( 0 == allocate_fu ) {
-                                const int status = assignRegistersToInstruction(
-                                    thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg(), ins,
-                                    int_register_stacks[i], fp_register_stacks[i], issue_isa_tables[i]);
 #ifdef VANADIS_BUILD_DEBUG
-                                if ( output_verbosity >= 8 ) {
-                                    ins->printToBuffer(instPrintBuffer, 1024);
-                                    output->verbose(
-                                        CALL_INFO, 8, 0, "----> Issued for: %s / 0x%llx / status: %d\n",
-                                        instPrintBuffer, ins->getInstructionAddress(), status);
-                                }
-#endif
-                                ins->markIssued();
-                                ins_issued_this_cycle++;
-                                //									stat_ins_issued->addData(1);
-                                issued_an_ins = true;
-                            }
-                            //							}
-                        }
-                    }
-
-                    // if the instruction is *not* issued yet, we need to keep track
-                    // of which instructions are being read
-                    for ( uint16_t k = 0; k < ins->countISAIntRegIn(); ++k ) {
-                        tmp_not_issued_int_reg_read[ins->getISAIntRegIn(k)] = true;
-                    }
-
-                    for ( uint16_t k = 0; k < ins->countISAFPRegIn(); ++k ) {
-                        tmp_not_issued_fp_reg_read[ins->getISAFPRegIn(k)] = true;
-                    }
-                }
-
-                // Collect up all integer registers we write to
-                for ( uint16_t k = 0; k < ins->countISAIntRegOut(); ++k ) {
-                    tmp_int_reg_write[ins->getISAIntRegOut(k)] = true;
-                }
-
-                // Collect up all fp registers we write to
-                for ( uint16_t k = 0; k < ins->countISAFPRegOut(); ++k ) {
-                    tmp_fp_reg_write[ins->getISAFPRegOut(k)] = true;
+                if ( output_verbosity >= 8 ) {
+                    output->verbose(
+                        CALL_INFO, 8, 0, "----> allocated functional unit: %s\n", (0 == allocate_fu) ? "yes" : "no");
                 }
+#endif
 
-                // Keep track of whether we have seen a load or a store ahead of us
-                // that hasn't been issued, because that means the LSQ hasn't seen it
-                // yet and so we could get an ordering violation in the memory system
-                found_store |= (INST_STORE == ins->getInstFuncType()) && (!ins->completedIssue());
-                found_load |= (INST_LOAD == ins->getInstFuncType()) && (!ins->completedIssue());
-
-                // Keep track of whether we have seen any fences, we just ensure we
-                // cannot issue load/stores until fences complete
-                if ( UNLIKELY(INST_FENCE == ins->getInstFuncType()) ) {
-                    found_store = true;
-                    found_load  = true;
-                }
+                if ( 0 == allocate_fu ) {
+                    thr_iq->issueReady(j);
+                    ins->markIssued();
+                    ins_issued_this_cycle++;
 
-                // We issued an instruction this cycle, so exit
-                if ( issued_an_ins ) {
-                    // tell the caller where we got this from
-                    rob_start = j;
+                    // tell the next call where we got to
+                    select_start[i]   = j;
+                    thr_issued_an_ins = true;
                     break;
                 }
             }
 
             // Only print the table if we issued an instruction, reduce print out
             // clutter
-            if ( issued_an_ins && (output_verbosity >= 8) ) {
+            if ( thr_issued_an_ins && (output_verbosity >= 8) ) {
                 issue_isa_tables[i]->print(output, register_files[i], print_int_reg, print_fp_reg);
             }
+
+            issued_an_ins |= thr_issued_an_ins;
         }
         else {
             output->verbose(
@@ -884,8 +844,9 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                     "(new addr: 0x%llx)\n",
                     pipeline_reset_addr);
 #endif
-                thread_decoders[rob_front->getHWThread()]->getBranchPredictor()->push(
-                    spec_ins->getInstructionAddress(), pipeline_reset_addr);
+                thread_decoders[rob_front->getHWThread()]->getBranchPredictor()->update(
+                    spec_ins->getInstructionAddress(), pipeline_reset_addr,
+                    pipeline_reset_addr != spec_ins->getNotTakenAddress(), perform_pipeline_clear);
 
                 if ( (pause_on_retire_address > 0) &&
                      (rob_front->getInstructionAddress() == pause_on_retire_address) ) {
@@ -917,6 +878,7 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
         // can be cleared from the ROB
         if ( perform_cleanup ) {
             rob->pop();
+            issue_queues[rob_front->getHWThread()]->retire(rob_front);
 
 #ifdef VANADIS_BUILD_DEBUG
             if ( output->getVerboseLevel() >= 8 ) {
@@ -954,6 +916,7 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
             if ( perform_delay_cleanup ) {
 
                 VanadisInstruction* delay_ins = rob->pop();
+                issue_queues[delay_ins->getHWThread()]->retire(delay_ins);
 #ifdef VANADIS_BUILD_DEBUG
                 output->verbose(
                     CALL_INFO, 8, 0, "----> Retire delay: 0x%llx / %s\n", delay_ins->getInstructionAddress(),
@@ -1280,19 +1243,19 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         "=> Issue Stage  "
         "<==========================================================\n");
 #endif
-    // Clear our temps on a per-thread basis
+    performDispatch(cycle);
+
+    // Wake up anything waiting on instructions which completed outside of the
+    // execute stage (load responses, SYSCALLs)
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
+        issue_queues[i]->wakeup();
+        select_start[i] = 0;
     }
 
-    uint32_t rob_start   = 0;
-    bool     found_store = false;
-    bool     found_load  = false;
-
-    // Attempt to perform issues, cranking through the entire ROB call by call or until we
-    // reach the max issues this cycle
+    // Attempt to perform issues, selecting from the ready instructions call by
+    // call until we reach the max issues this cycle
     for ( uint32_t i = 0; i < issues_per_cycle; ++i ) {
-        if ( performIssue(cycle, rob_start, found_store, found_load) != 0 ) { break; }
+        if ( performIssue(cycle) != 0 ) { break; }
     }
 
     // Record how many instructions we issued this cycle
@@ -1308,6 +1271,12 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 #endif
     performExecute(cycle);
 
+    // Wake up the dependents of everything that completed this cycle, this
+    // has to happen before retire deletes the completed instructions
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        issue_queues[i]->wakeup();
+    }
+
     bool tick_return = false;
 
     // Retire
@@ -1336,6 +1305,7 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
+    ins_retired_total += ins_retired_this_cycle;
 
     uint64_t rob_total_count = 0;
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
@@ -1376,108 +1346,6 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     }
 }
 
-int
-VANADIS_COMPONENT::checkInstructionResources(
-    VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs, VanadisISATable* isa_table)
-{
-
-    bool      resources_good   = true;
-    const int output_verbosity = output->getVerboseLevel();
-
-    // We need places to store our output registers
-    resources_good &= (int_regs->unused() >= ins->countISAIntRegOut());
-    resources_good &= (fp_regs->unused() >= ins->countISAFPRegOut());
-
-    if ( !resources_good ) {
-#ifdef VANADIS_BUILD_DEBUG
-        output->verbose(
-            CALL_INFO, 16, 0,
-            "----> insufficient output / req: int: %" PRIu16 " fp: %" PRIu16 " / free: int: %" PRIu16 " fp: %" PRIu16
-            "\n",
-            (uint16_t)ins->countISAIntRegOut(), (uint16_t)ins->countISAFPRegOut(), (uint16_t)int_regs->unused(),
-            (uint16_t)fp_regs->unused());
-#endif
-        return 1;
-    }
-
-    // If there are any pending writes against our reads, we can't issue until
-    // they are done
-    const uint16_t int_reg_in_count = ins->countISAIntRegIn();
-    for ( uint16_t i = 0; i < int_reg_in_count; ++i ) {
-        const uint16_t ins_isa_reg = ins->getISAIntRegIn(i);
-        resources_good &= (!isa_table->pendingIntWrites(ins_isa_reg));
-
-        // Check there are no RAW in the pending instruction queue
-        resources_good &= (!tmp_int_reg_write[ins_isa_reg]);
-    }
-
-#ifdef VANADIS_BUILD_DEBUG
-    if ( output_verbosity >= 16 ) {
-        output->verbose(
-            CALL_INFO, 16, 0, "--> Check input integer registers, issue-status: %s\n", (resources_good ? "yes" : "no"));
-    }
-#endif
-
-    if ( !resources_good ) { return 2; }
-
-    const uint16_t fp_reg_in_count = ins->countISAFPRegIn();
-    for ( uint16_t i = 0; i < fp_reg_in_count; ++i ) {
-        const uint16_t ins_isa_reg = ins->getISAFPRegIn(i);
-        resources_good &= (!isa_table->pendingFPWrites(ins_isa_reg));
-
-        // Check there are no RAW in the pending instruction queue
-        resources_good &= (!tmp_fp_reg_write[ins_isa_reg]);
-    }
-
-#ifdef VANADIS_BUILD_DEBUG
-    if ( output_verbosity >= 16 ) {
-        output->verbose(
-            CALL_INFO, 16, 0, "--> Check input floating-point registers, issue-status: %s\n",
-            (resources_good ? "yes" : "no"));
-    }
-#endif
-
-    if ( !resources_good ) { return 3; }
-
-    const uint16_t int_reg_out_count = ins->countISAIntRegOut();
-    for ( uint16_t i = 0; i < int_reg_out_count; ++i ) {
-        const uint16_t ins_isa_reg = ins->getISAIntRegOut(i);
-
-        // Check there are no RAW in the pending instruction queue
-        resources_good &= (!tmp_not_issued_int_reg_read[ins_isa_reg]);
-    }
-
-#ifdef VANADIS_BUILD_DEBUG
-    if ( output_verbosity >= 16 ) {
-        output->verbose(
-            CALL_INFO, 16, 0, "--> Check output integer registers, issue-status: %s\n",
-            (resources_good ? "yes" : "no"));
-    }
-#endif
-
-    if ( !resources_good ) { return 4; }
-
-    const uint16_t fp_reg_out_count = ins->countISAFPRegOut();
-    for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
-        const uint16_t ins_isa_reg = ins->getISAFPRegOut(i);
-
-        // Check there are no RAW in the pending instruction queue
-        resources_good &= (!tmp_not_issued_fp_reg_read[ins_isa_reg]);
-    }
-
-#ifdef VANADIS_BUILD_DEBUG
-    if ( output_verbosity >= 16 ) {
-        output->verbose(
-            CALL_INFO, 16, 0, "--> Check output floating-point registers, issue-status: %s\n",
-            (resources_good ? "yes" : "no"));
-    }
-#endif
-
-    if ( !resources_good ) { return 5; }
-
-    return 0;
-}
-
 int
 VANADIS_COMPONENT::assignRegistersToInstruction(
     const uint16_t int_reg_count, const uint16_t fp_reg_count, VanadisInstruction* ins, VanadisRegisterStack* int_regs,
@@ -1606,7 +1474,13 @@ VANADIS_COMPONENT::assignRegistersToInstruction(
             // ins->getInstructionAddress());
             //} else {
             const uint16_t out_reg = int_regs->pop();
-            isa_table->setIntPhysReg(ins_isa_reg, out_reg);
+
+            // Renaming happens ahead of execution, so a write to the zero
+            // register goes to a scratch register which is never mapped,
+            // otherwise later readers would see the written value
+            if ( ins_isa_reg != ins->getISAOptions()->getRegisterIgnoreWrites() ) {
+                isa_table->setIntPhysReg(ins_isa_reg, out_reg);
+            }
             //}
 
             ins->setPhysIntRegOut(i, out_reg);
@@ -1685,11 +1559,18 @@ VANADIS_COMPONENT::recoverRetiredRegisters(
             // }
 
             // if( ! reg_also_input ) {
-            recovered_phys_reg_int.push_back(cur_phys_reg);
+            if ( UNLIKELY(isa_reg == ins->getISAOptions()->getRegisterIgnoreWrites()) ) {
+                // Zero register writes were never mapped, just free the
+                // scratch register
+                recovered_phys_reg_int.push_back(ins->getPhysIntRegOut(i));
+            }
+            else {
+                recovered_phys_reg_int.push_back(cur_phys_reg);
 
-            // Set the ISA register in the retirement table to point
-            // to the physical register used by this instruction
-            retire_isa_table->setIntPhysReg(isa_reg, ins->getPhysIntRegOut(i));
+                // Set the ISA register in the retirement table to point
+                // to the physical register used by this instruction
+                retire_isa_table->setIntPhysReg(isa_reg, ins->getPhysIntRegOut(i));
+            }
             //}
         }
     }
@@ -1762,11 +1643,25 @@ VANADIS_COMPONENT::recoverRetiredRegisters(
 
 void
 VANADIS_COMPONENT::setup()
-{}
+{
+    host_start_time = std::chrono::steady_clock::now();
+}
 
 void
 VANADIS_COMPONENT::finish()
-{}
+{
+    if ( report_sim_rate ) {
+        const double host_seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - host_start_time).count();
+
+        output->verbose(
+            CALL_INFO, 0, 0,
+            "Core %" PRIu16 " retired %" PRIu64 " instructions in %" PRIu64 " cycles, %.3f seconds host time (%.0f "
+            "instructions/second)\n",
+            core_id, ins_retired_total, current_cycle, host_seconds,
+            (host_seconds > 0) ? ((double)ins_retired_total / host_seconds) : 0.0);
+    }
+}
 
 void
 VANADIS_COMPONENT::printStatus(SST::Output& output)
@@ -2070,6 +1965,7 @@ VANADIS_COMPONENT::handleMisspeculate(const uint32_t hw_thr, const uint64_t new_
 
     lsq->clearLSQByThreadID(hw_thr);
     resetRegisterStacks(hw_thr);
+    issue_queues[hw_thr]->clear();
     clearROBMisspeculate(hw_thr);
 
     // Reset the ISA table to get correct ISA to physical mappings
@@ -2143,12 +2039,20 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr)
     VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[hw_thr];
     stat_rob_cleared_entries->addData(thr_rob->size());
 
-    // Delete all the instructions which we aren't going to process
+    // Destroy all the instructions which we aren't going to process and
+    // return their memory to the thread's instruction pool in one batch
+    // for reuse by the decoder
+    VanadisInstructionPool::ReleaseBatch squashed;
+
     for ( size_t i = 0; i < thr_rob->size(); ++i ) {
         VanadisInstruction* next_ins = thr_rob->peekAt(i);
-        delete next_ins;
+        void*               ins_mem  = dynamic_cast<void*>(next_ins);
+        next_ins->~VanadisInstruction();
+        squashed.add(ins_mem);
     }
 
+    squashed.release();
+
     // clear the ROB entries and reset
     thr_rob->clear();
 }
@@ -17,6 +17,7 @@
 #define _VANADIS_COMPONENT_H
 
 #include "datastruct/cqueue.h"
+#include "datastruct/vissuequeue.h"
 #include "decoder/vdecoder.h"
 #include "inst/isatable.h"
 #include "inst/regfile.h"
@@ -30,6 +31,7 @@
 #include "vfuncunit.h"
 
 #include <array>
+#include <chrono>
 #include <limits>
 #include <set>
 #include <sst/core/component.h>
@@ -131,7 +133,9 @@ public:
         { "decodes_per_cycle", "Number of instruction decodes per cycle" },
         { "print_int_reg", "Print integer registers true/false, auto set to true if verbose > 16" },
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
-                          "true if verbose > 16" })
+                          "true if verbose > 16" },
+        { "report_sim_rate", "Print the number of instructions retired per second of host time at the end of "
+                             "simulation true/false", "false" })
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "cycles", "Number of cycles the core executed", "cycles", 1 },
@@ -200,23 +204,18 @@ private:
 
     virtual bool tick(SST::Cycle_t);
 
-    void resetRegisterUseTemps(const uint16_t i_reg, const uint16_t f_reg);
-
     int assignRegistersToInstruction(
         const uint16_t int_reg_count, const uint16_t fp_reg_count, VanadisInstruction* ins,
         VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs, VanadisISATable* isa_table);
 
-    int checkInstructionResources(
-        VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs,
-        VanadisISATable* isa_table);
-
     int recoverRetiredRegisters(
         VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs,
         VanadisISATable* issue_isa_table, VanadisISATable* retire_isa_table);
 
     int  performFetch(const uint64_t cycle);
     int  performDecode(const uint64_t cycle);
-    int  performIssue(const uint64_t cycle, uint32_t& rob_start, bool& found_store, bool& found_load);
+    int  performDispatch(const uint64_t cycle);
+    int  performIssue(const uint64_t cycle);
     int  performExecute(const uint64_t cycle);
     int  performRetire(VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
     int  allocateFunctionalUnit(VanadisInstruction* ins);
@@ -235,6 +234,7 @@ private:
     uint32_t retires_per_cycle;
 
     std::vector<VanadisCircularQueue<VanadisInstruction*>*> rob;
+    std::vector<VanadisInstructionPool*>                    ins_pools;
     std::vector<VanadisDecoder*>                            thread_decoders;
     std::vector<const VanadisDecoderOptions*>               isa_options;
 
@@ -251,10 +251,8 @@ private:
     std::vector<VanadisISATable*> issue_isa_tables;
     std::vector<VanadisISATable*> retire_isa_tables;
 
-    std::vector<bool> tmp_not_issued_int_reg_read;
-    std::vector<bool> tmp_int_reg_write;
-    std::vector<bool> tmp_not_issued_fp_reg_read;
-    std::vector<bool> tmp_fp_reg_write;
+    std::vector<VanadisIssueQueue*> issue_queues;
+    std::vector<size_t>             select_start;
 
     std::list<VanadisInsCacheLoadRecord*>* icache_load_records;
 
@@ -297,6 +295,10 @@ private:
 
     uint64_t pause_on_retire_address;
 
+    bool                                  report_sim_rate;
+    uint64_t                              ins_retired_total;
+    std::chrono::steady_clock::time_point host_start_time;
+
     std::vector<VanadisFloatingPointFlags*> fp_flags;
 };
 
@@ -16,11 +16,9 @@
 #ifndef _H_VANADIS_BRANCH_UNIT_BASIC
 #define _H_VANADIS_BRANCH_UNIT_BASIC
 
+#include "datastruct/vcache.h"
 #include "vbranch/vbranchunit.h"
 
-#include <list>
-#include <unordered_map>
-
 namespace SST {
 namespace Vanadis {
 
@@ -34,7 +32,8 @@ public:
                                           SST::Vanadis::VanadisBranchUnit)
 
     SST_ELI_DOCUMENT_PARAMS({ "branch_entries", "Sets the number of entries in the underlying cache "
-                                                "of branch directions" })
+                                                "of branch directions" },
+                            { "branch_ways", "Sets the associativity of the branch direction cache", "8" })
 
     SST_ELI_DOCUMENT_STATISTICS({ "branch_cache_hit",
                                   "Counts the number of times a speculated "
@@ -49,41 +48,33 @@ public:
                                   "out because of capacity limits",
                                   "entries", 1 })
 
-    VanadisBasicBranchUnit(ComponentId_t id, Params& params) : VanadisBranchUnit(id, params) {
-        max_entries = params.find<uint32_t>("branch_entries", 64);
+    VanadisBasicBranchUnit(ComponentId_t id, Params& params) :
+        VanadisBranchUnit(id, params),
+        predict(params.find<uint32_t>("branch_entries", 64), params.find<uint32_t>("branch_ways", 8)) {
 
         stat_branch_hits = registerStatistic<uint64_t>("branch_cache_hit", "1");
         stat_branch_misses = registerStatistic<uint64_t>("branch_cache_miss", "1");
         stat_branch_cache_castout = registerStatistic<uint64_t>("branch_cache_castout", "1");
     }
 
-    virtual ~VanadisBasicBranchUnit() { clear(); }
+    virtual ~VanadisBasicBranchUnit() {}
 
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) {
-        if (predict.find(ins_addr) != predict.end()) {
-            predict[ins_addr] = pred_addr;
-        } else {
-            if (lru_keeper.size() >= max_entries) {
-                const uint64_t lru_victim = lru_expire();
-                predict.erase(predict.find(lru_victim));
-                stat_branch_cache_castout->addData(1);
-            }
-
-            lru_keeper.push_front(ins_addr);
-            predict.insert(std::pair<uint64_t, uint64_t>(ins_addr, pred_addr));
+        if (predict.store(ins_addr, pred_addr)) {
+            stat_branch_cache_castout->addData(1);
         }
     }
 
     virtual uint64_t predictAddress(const uint64_t addr) {
-        if (predict.find(addr) != predict.end()) {
-            return predict[addr];
+        if (predict.contains(addr)) {
+            return predict.find(addr);
         } else {
             return 0;
         }
     }
 
     virtual bool contains(const uint64_t addr) {
-        const bool found = predict.find(addr) != predict.end();
+        const bool found = predict.contains(addr);
 
         if (found) {
             stat_branch_hits->addData(1);
@@ -95,31 +86,7 @@ public:
     }
 
 protected:
-    void lru_reorder(const uint64_t addr) {
-        for (auto lru_itr = lru_keeper.begin(); lru_itr != lru_keeper.end();) {
-            if (addr == (*lru_itr)) {
-                lru_keeper.erase(lru_itr);
-                lru_keeper.push_front(addr);
-                break;
-            }
-        }
-    }
-
-    uint64_t lru_expire() {
-        const uint64_t back_entry = lru_keeper.back();
-        lru_keeper.pop_back();
-
-        return back_entry;
-    }
-
-    void clear() {
-        lru_keeper.clear();
-        predict.clear();
-    }
-
-    uint32_t max_entries;
-    std::list<uint64_t> lru_keeper;
-    std::unordered_map<uint64_t, uint64_t> predict;
+    VanadisCache<uint64_t, uint64_t> predict;
 
     Statistic<uint64_t>* stat_branch_cache_castout;
     Statistic<uint64_t>* stat_branch_hits;
@@ -0,0 +1,66 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_BIMODAL
+#define _H_VANADIS_BRANCH_UNIT_BIMODAL
+
+#include "vbranch/vbranchdir.h"
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisBimodalBranchUnit : public VanadisDirectionBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(VanadisBimodalBranchUnit, "vanadis", "VanadisBimodalBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Predicts branch directions with a table of two bit counters indexed by "
+                                          "the branch address (bimodal), targets come from a branch target buffer",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_DIRECTION_BRANCH_ELI_PARAMS,
+                            { "pht_entries", "Number of counters in the pattern history table, rounded down to a "
+                                             "power of two", "4096" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_DIRECTION_BRANCH_ELI_STATISTICS)
+
+    VanadisBimodalBranchUnit(ComponentId_t id, Params& params) : VanadisDirectionBranchUnit(id, params) {
+        index_bits = log2Entries(params.find<uint64_t>("pht_entries", 4096));
+
+        // Start weakly not taken
+        pht.assign(UINT64_C(1) << index_bits, 1);
+    }
+
+    virtual ~VanadisBimodalBranchUnit() {}
+
+protected:
+    virtual bool predictTaken(const uint64_t addr, const uint64_t history) { return pht[index(addr)] >= 2; }
+
+    virtual void train(const uint64_t addr, const uint64_t history, const bool taken) {
+        updateCounter(pht[index(addr)], taken);
+    }
+
+    size_t index(const uint64_t addr) const {
+        return static_cast<size_t>(pcBits(addr) & ((UINT64_C(1) << index_bits) - 1));
+    }
+
+    uint32_t index_bits;
+    std::vector<uint8_t> pht;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
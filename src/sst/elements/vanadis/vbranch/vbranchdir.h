@@ -0,0 +1,178 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_DIRECTION
+#define _H_VANADIS_BRANCH_UNIT_DIRECTION
+
+#include "datastruct/vcache.h"
+#include "vbranch/vbranchunit.h"
+
+#include <cstdint>
+#include <vector>
+
+#define VANADIS_DIRECTION_BRANCH_ELI_PARAMS                                                                   \
+    { "btb_entries", "Number of branch target buffer entries", "512" },                                    \
+    { "btb_ways", "Associativity of the branch target buffer", "4" }
+
+#define VANADIS_DIRECTION_BRANCH_ELI_STATISTICS                                                               \
+    { "branches", "Number of branches retired", "branches", 1 },                                            \
+    { "branch_mispredicts", "Number of retired branches which caused a pipeline clear", "branches", 1 },    \
+    { "direction_mispredicts", "Number of retired branches whose direction was mispredicted", "branches", 1 }, \
+    { "btb_hit", "Number of fetched branches predicted taken which found a target in the BTB", "hits", 1 },    \
+    { "btb_miss", "Number of fetched branches predicted taken without a target in the BTB", "misses", 1 },     \
+    { "btb_castout", "Number of BTB entries thrown out because of capacity limits", "entries", 1 }
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Common part of the branch units which predict the direction of a branch
+ * and take the target of taken branches from a set associative branch
+ * target buffer.
+ *
+ * A branch is only reported to the decoder as predicted (contains() returns
+ * true) when it is predicted taken and has a BTB entry, otherwise the
+ * decoder falls through to the next instruction.
+ *
+ * The global history is kept twice: the speculative history is extended
+ * with each prediction made at fetch and the retired history with the
+ * outcome of each retired branch. While fetch is on the correct path the
+ * two agree, so the tables are trained at retire using the retired history
+ * and arrive at the same entries the prediction used. On a misprediction
+ * the speculative history is restored from the retired history.
+ */
+class VanadisDirectionBranchUnit : public VanadisBranchUnit {
+
+public:
+    VanadisDirectionBranchUnit(ComponentId_t id, Params& params) :
+        VanadisBranchUnit(id, params),
+        btb(params.find<uint32_t>("btb_entries", 512), params.find<uint32_t>("btb_ways", 4)),
+        spec_history(0),
+        retired_history(0) {
+
+        stat_branches = registerStatistic<uint64_t>("branches", "1");
+        stat_mispredicts = registerStatistic<uint64_t>("branch_mispredicts", "1");
+        stat_direction_mispredicts = registerStatistic<uint64_t>("direction_mispredicts", "1");
+        stat_btb_hit = registerStatistic<uint64_t>("btb_hit", "1");
+        stat_btb_miss = registerStatistic<uint64_t>("btb_miss", "1");
+        stat_btb_castout = registerStatistic<uint64_t>("btb_castout", "1");
+    }
+
+    virtual ~VanadisDirectionBranchUnit() {}
+
+    virtual bool contains(const uint64_t addr) {
+        bool predict_taken = predictTaken(addr, spec_history);
+
+        if (predict_taken) {
+            if (btb.contains(addr)) {
+                stat_btb_hit->addData(1);
+            } else {
+                stat_btb_miss->addData(1);
+                predict_taken = false;
+            }
+        }
+
+        spec_history = (spec_history << 1) | (predict_taken ? 1 : 0);
+        return predict_taken;
+    }
+
+    virtual uint64_t predictAddress(const uint64_t addr) { return btb.contains(addr) ? btb.find(addr) : 0; }
+
+    virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) {
+        if (btb.store(ins_addr, pred_addr)) {
+            stat_btb_castout->addData(1);
+        }
+    }
+
+    virtual void update(const uint64_t ins_addr, const uint64_t target_addr, const bool taken,
+                        const bool mispredicted) {
+        stat_branches->addData(1);
+
+        if (mispredicted) {
+            stat_mispredicts->addData(1);
+        }
+
+        if (predictTaken(ins_addr, retired_history) != taken) {
+            stat_direction_mispredicts->addData(1);
+        }
+
+        train(ins_addr, retired_history, taken);
+
+        if (taken) {
+            push(ins_addr, target_addr);
+        }
+
+        retired_history = (retired_history << 1) | (taken ? 1 : 0);
+
+        if (mispredicted) {
+            spec_history = retired_history;
+        }
+    }
+
+protected:
+    // Direction prediction for the branch at addr given the global history,
+    // the most recent branch is in bit 0
+    virtual bool predictTaken(const uint64_t addr, const uint64_t history) = 0;
+
+    // Train the tables with the outcome of the branch at addr, history is the
+    // same history predictTaken() was given for this branch
+    virtual void train(const uint64_t addr, const uint64_t history, const bool taken) = 0;
+
+    // Instructions are at least 4 byte aligned (apart from compressed
+    // RISC-V instructions), drop the bits which never change
+    static uint64_t pcBits(const uint64_t addr) { return addr >> 2; }
+
+    // log2 of entries, rounded down, used to size the tables
+    static uint32_t log2Entries(uint64_t entries) {
+        uint32_t bits = 0;
+
+        while (entries > 1) {
+            entries >>= 1;
+            bits++;
+        }
+
+        return bits;
+    }
+
+    // Saturating two bit counter update, values 2 and 3 predict taken
+    static void updateCounter(uint8_t& counter, const bool taken) {
+        if (taken) {
+            if (counter < 3) {
+                counter++;
+            }
+        } else {
+            if (counter > 0) {
+                counter--;
+            }
+        }
+    }
+
+    VanadisCache<uint64_t, uint64_t> btb;
+
+    uint64_t spec_history;
+    uint64_t retired_history;
+
+    Statistic<uint64_t>* stat_branches;
+    Statistic<uint64_t>* stat_mispredicts;
+    Statistic<uint64_t>* stat_direction_mispredicts;
+    Statistic<uint64_t>* stat_btb_hit;
+    Statistic<uint64_t>* stat_btb_miss;
+    Statistic<uint64_t>* stat_btb_castout;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
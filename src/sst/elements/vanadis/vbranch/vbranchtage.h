@@ -0,0 +1,312 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TAGE
+#define _H_VANADIS_BRANCH_UNIT_TAGE
+
+#include "vbranch/vbranchdir.h"
+
+#include <cmath>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Compact TAGE direction predictor.
+ *
+ * A bimodal base table is backed by a number of tagged tables, each indexed
+ * and tagged with a hash of the branch address and a geometrically longer
+ * slice of the global history (up to 64 branches). The prediction comes
+ * from the matching table with the longest history (the provider), or from
+ * the next matching table when the provider entry is newly allocated and
+ * that has proven more reliable. On a misprediction an entry is allocated
+ * in a longer history table whose entry is not marked useful, and the
+ * useful bits are periodically aged so stale entries can be replaced.
+ */
+class VanadisTAGEBranchUnit : public VanadisDirectionBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(VanadisTAGEBranchUnit, "vanadis", "VanadisTAGEBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Predicts branch directions with a compact TAGE predictor (bimodal base "
+                                          "and tagged global history tables), targets come from a branch target "
+                                          "buffer",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_DIRECTION_BRANCH_ELI_PARAMS,
+                            { "base_entries", "Number of counters in the bimodal base table, rounded down to a "
+                                              "power of two", "4096" },
+                            { "tagged_tables", "Number of tagged tables (1 to 8)", "4" },
+                            { "tagged_entries", "Number of entries in each tagged table, rounded down to a power of "
+                                                "two", "1024" },
+                            { "tag_bits", "Number of tag bits in each tagged entry (4 to 16)", "9" },
+                            { "min_history", "History length used by the first tagged table", "4" },
+                            { "max_history", "History length used by the last tagged table (at most 64)", "64" },
+                            { "useful_reset_period", "Number of retired branches between ageing the useful bits",
+                              "262144" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_DIRECTION_BRANCH_ELI_STATISTICS)
+
+    VanadisTAGEBranchUnit(ComponentId_t id, Params& params) : VanadisDirectionBranchUnit(id, params) {
+        base_bits = log2Entries(params.find<uint64_t>("base_entries", 4096));
+        table_count = params.find<uint32_t>("tagged_tables", 4);
+        table_bits = log2Entries(params.find<uint64_t>("tagged_entries", 1024));
+        tag_bits = params.find<uint32_t>("tag_bits", 9);
+
+        uint32_t min_history = params.find<uint32_t>("min_history", 4);
+        uint32_t max_history = params.find<uint32_t>("max_history", 64);
+
+        useful_reset_period = params.find<uint64_t>("useful_reset_period", 262144);
+
+        Output& output = getSimulationOutput();
+
+        if ((table_count < 1) || (table_count > max_tables)) {
+            output.fatal(CALL_INFO, -1, "Error: tagged_tables must be between 1 and %" PRIu32 "\n", max_tables);
+        }
+
+        if ((tag_bits < 4) || (tag_bits > 16)) {
+            output.fatal(CALL_INFO, -1, "Error: tag_bits must be between 4 and 16\n");
+        }
+
+        max_history = (max_history > 64) ? 64 : max_history;
+        min_history = (min_history < 1) ? 1 : min_history;
+        min_history = (min_history > max_history) ? max_history : min_history;
+
+        // Geometric series of history lengths from min_history to max_history
+        for (uint32_t i = 0; i < table_count; ++i) {
+            if (table_count == 1) {
+                history_lengths[i] = max_history;
+            } else {
+                const double ratio = std::pow(static_cast<double>(max_history) / min_history,
+                                              static_cast<double>(i) / (table_count - 1));
+                history_lengths[i] = static_cast<uint32_t>(min_history * ratio + 0.5);
+            }
+
+            tables[i].assign(UINT64_C(1) << table_bits, TaggedEntry());
+        }
+
+        // Start weakly not taken
+        base.assign(UINT64_C(1) << base_bits, 1);
+
+        use_alt_on_new = 8;
+        updates_since_reset = 0;
+    }
+
+    virtual ~VanadisTAGEBranchUnit() {}
+
+protected:
+    struct TaggedEntry {
+        TaggedEntry() : tag(0), counter(0), useful(0), valid(false) {}
+
+        uint16_t tag;
+        // Three bit signed counter, -4 to 3, taken when >= 0
+        int8_t counter;
+        // Two bit useful counter
+        uint8_t useful;
+        bool valid;
+    };
+
+    // Result of looking up a branch in all of the tables
+    struct Lookup {
+        size_t indices[8];
+        uint16_t tags[8];
+
+        int provider;
+        int alternate;
+
+        bool provider_prediction;
+        bool alternate_prediction;
+        bool provider_new;
+        bool prediction;
+    };
+
+    virtual bool predictTaken(const uint64_t addr, const uint64_t history) {
+        Lookup lookup;
+        performLookup(addr, history, lookup);
+
+        return lookup.prediction;
+    }
+
+    virtual void train(const uint64_t addr, const uint64_t history, const bool taken) {
+        Lookup lookup;
+        performLookup(addr, history, lookup);
+
+        if (lookup.provider >= 0) {
+            TaggedEntry& provider = tables[lookup.provider][lookup.indices[lookup.provider]];
+
+            // Learn whether a newly allocated provider or the alternate
+            // prediction is more reliable
+            if (lookup.provider_new && (lookup.provider_prediction != lookup.alternate_prediction)) {
+                if (lookup.alternate_prediction == taken) {
+                    use_alt_on_new = (use_alt_on_new < 15) ? (use_alt_on_new + 1) : use_alt_on_new;
+                } else {
+                    use_alt_on_new = (use_alt_on_new > 0) ? (use_alt_on_new - 1) : use_alt_on_new;
+                }
+            }
+
+            if (lookup.provider_prediction != lookup.alternate_prediction) {
+                if (lookup.provider_prediction == taken) {
+                    provider.useful = (provider.useful < 3) ? (provider.useful + 1) : provider.useful;
+                } else {
+                    provider.useful = (provider.useful > 0) ? (provider.useful - 1) : provider.useful;
+                }
+            }
+
+            updateSignedCounter(provider.counter, taken);
+
+            // A new provider has not learned much yet, keep the alternate
+            // prediction trained too
+            if (lookup.provider_new && (lookup.alternate < 0)) {
+                updateCounter(base[baseIndex(addr)], taken);
+            }
+        } else {
+            updateCounter(base[baseIndex(addr)], taken);
+        }
+
+        // Allocate in a table with a longer history on a misprediction
+        if ((lookup.prediction != taken) && (lookup.provider < static_cast<int>(table_count) - 1)) {
+            bool allocated = false;
+
+            for (uint32_t i = lookup.provider + 1; i < table_count; ++i) {
+                TaggedEntry& entry = tables[i][lookup.indices[i]];
+
+                if (entry.useful == 0) {
+                    entry.tag = lookup.tags[i];
+                    entry.counter = taken ? 0 : -1;
+                    entry.valid = true;
+                    allocated = true;
+                    break;
+                }
+            }
+
+            if (!allocated) {
+                for (uint32_t i = lookup.provider + 1; i < table_count; ++i) {
+                    TaggedEntry& entry = tables[i][lookup.indices[i]];
+                    entry.useful = (entry.useful > 0) ? (entry.useful - 1) : 0;
+                }
+            }
+        }
+
+        if (++updates_since_reset >= useful_reset_period) {
+            updates_since_reset = 0;
+
+            for (uint32_t i = 0; i < table_count; ++i) {
+                for (TaggedEntry& entry : tables[i]) {
+                    entry.useful >>= 1;
+                }
+            }
+        }
+    }
+
+    void performLookup(const uint64_t addr, const uint64_t history, Lookup& lookup) const {
+        lookup.provider = -1;
+        lookup.alternate = -1;
+
+        for (uint32_t i = 0; i < table_count; ++i) {
+            const uint64_t table_history =
+                (history_lengths[i] >= 64) ? history : (history & ((UINT64_C(1) << history_lengths[i]) - 1));
+            const uint64_t pc = pcBits(addr);
+
+            lookup.indices[i] =
+                static_cast<size_t>((pc ^ (pc >> table_bits) ^ fold(table_history, history_lengths[i], table_bits)) &
+                                    ((UINT64_C(1) << table_bits) - 1));
+            lookup.tags[i] = static_cast<uint16_t>(
+                (pc ^ fold(table_history, history_lengths[i], tag_bits) ^
+                 (fold(table_history, history_lengths[i], tag_bits - 1) << 1)) &
+                ((UINT64_C(1) << tag_bits) - 1));
+        }
+
+        for (int i = static_cast<int>(table_count) - 1; i >= 0; --i) {
+            const TaggedEntry& entry = tables[i][lookup.indices[i]];
+
+            if (entry.valid && (entry.tag == lookup.tags[i])) {
+                if (lookup.provider < 0) {
+                    lookup.provider = i;
+                } else {
+                    lookup.alternate = i;
+                    break;
+                }
+            }
+        }
+
+        if (lookup.alternate >= 0) {
+            lookup.alternate_prediction = tables[lookup.alternate][lookup.indices[lookup.alternate]].counter >= 0;
+        } else {
+            lookup.alternate_prediction = base[baseIndex(addr)] >= 2;
+        }
+
+        if (lookup.provider >= 0) {
+            const TaggedEntry& provider = tables[lookup.provider][lookup.indices[lookup.provider]];
+
+            lookup.provider_prediction = provider.counter >= 0;
+            lookup.provider_new = (provider.useful == 0) && ((provider.counter == 0) || (provider.counter == -1));
+
+            lookup.prediction = (lookup.provider_new && (use_alt_on_new >= 8)) ? lookup.alternate_prediction
+                                                                               : lookup.provider_prediction;
+        } else {
+            lookup.provider_prediction = lookup.alternate_prediction;
+            lookup.provider_new = false;
+            lookup.prediction = lookup.alternate_prediction;
+        }
+    }
+
+    // XOR the low length bits of history together in chunks of bits
+    static uint64_t fold(uint64_t history, const uint32_t length, const uint32_t bits) {
+        uint64_t folded = 0;
+
+        for (uint32_t i = 0; i < length; i += bits) {
+            folded ^= history;
+            history = (bits >= 64) ? 0 : (history >> bits);
+        }
+
+        return folded & ((UINT64_C(1) << bits) - 1);
+    }
+
+    size_t baseIndex(const uint64_t addr) const {
+        return static_cast<size_t>(pcBits(addr) & ((UINT64_C(1) << base_bits) - 1));
+    }
+
+    static void updateSignedCounter(int8_t& counter, const bool taken) {
+        if (taken) {
+            if (counter < 3) {
+                counter++;
+            }
+        } else {
+            if (counter > -4) {
+                counter--;
+            }
+        }
+    }
+
+    static const uint32_t max_tables = 8;
+
+    uint32_t base_bits;
+    uint32_t table_count;
+    uint32_t table_bits;
+    uint32_t tag_bits;
+    uint32_t history_lengths[max_tables];
+
+    std::vector<uint8_t> base;
+    std::vector<TaggedEntry> tables[max_tables];
+
+    uint32_t use_alt_on_new;
+    uint64_t useful_reset_period;
+    uint64_t updates_since_reset;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
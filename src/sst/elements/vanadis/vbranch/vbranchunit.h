@@ -40,6 +40,15 @@ public:
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) = 0;
     virtual uint64_t predictAddress(const uint64_t addr) = 0;
     virtual bool contains(const uint64_t addr) = 0;
+
+    // Called when a branch retires. target_addr is where execution continues,
+    // taken is false if that is the fall through address and mispredicted is
+    // true if the pipeline is cleared because of this branch. Units which only
+    // track targets can rely on push().
+    virtual void update(const uint64_t ins_addr, const uint64_t target_addr, const bool taken,
+                        const bool mispredicted) {
+        push(ins_addr, target_addr);
+    }
 };
 
 } // namespace Vanadis
@@ -42,8 +42,10 @@ public:
 
     uint32_t getInstructionCount() const { return inst_bundle.size(); }
 
+    // The bundle takes ownership of newIns, it is the template copied into
+    // the ROB each time the bundle is issued
     void addInstruction(VanadisInstruction* newIns) {
-        inst_bundle.push_back(newIns->clone());
+        inst_bundle.push_back(newIns);
     }
 
     VanadisInstruction* getInstructionByIndex(const uint32_t index) {
@@ -19,6 +19,7 @@
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/subcomponent.h>
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
 #include <vector>
@@ -36,7 +37,8 @@ public:
 
         cache_line_width = cachelinewidth;
         uop_cache = new VanadisCache<uint64_t, VanadisInstructionBundle*>(uop_cache_size);
-        predecode_cache = new VanadisCache<uint64_t, std::vector<uint8_t>*>(predecode_cache_entries);
+        predecode_cache = new VanadisCacheTags<uint64_t>(predecode_cache_entries);
+        predecode_lines.resize(predecode_cache->capacity() * cache_line_width);
 
         mem_if = nullptr;
     }
@@ -52,6 +54,7 @@ public:
         // if the line width is changed then we have to flush our cache
         if (cache_line_width != new_line_width) {
             predecode_cache->clear();
+            predecode_lines.resize(predecode_cache->capacity() * new_line_width);
         }
 
         cache_line_width = new_line_width;
@@ -72,13 +75,6 @@ public:
                               (int)resp->data.size(), (int)cache_line_width);
             }
 
-            std::vector<uint8_t>* new_line = new std::vector<uint8_t>();
-            new_line->reserve(cache_line_width);
-
-            for (uint64_t i = 0; i < cache_line_width; ++i) {
-                new_line->push_back(resp->data[i]);
-            }
-
             output->verbose(CALL_INFO, 16, 0, "[ins-loader] ---> response has: %" PRIu64 " bytes in payload\n",
                             (uint64_t)resp->data.size());
 
@@ -104,7 +100,17 @@ public:
             output->verbose(CALL_INFO, 16, 0, "[ins-loader] ---> hit (addr=0x%llx), caching line in predecoder.\n",
                             resp->pAddr);
 
-            predecode_cache->store(resp->pAddr, new_line);
+            // Lines are held in a flat array indexed by the slot the tag store
+            // allocates for them
+            size_t line_slot = predecode_cache->lookup(resp->pAddr);
+
+            if (line_slot == VanadisCacheTags<uint64_t>::npos) {
+                bool evicted = false;
+                line_slot = predecode_cache->insert(resp->pAddr, evicted);
+            }
+
+            std::copy(resp->data.begin(), resp->data.begin() + cache_line_width,
+                      predecode_lines.begin() + (line_slot * cache_line_width));
 
             // Remove from pending load stores.
             pending_loads.erase(check_hit_local);
@@ -138,27 +144,31 @@ public:
                         "[fill-decode]: ins-addr: 0x%llx line-offset: %" PRIu64 " line-start=%" PRIu64 " / 0x%llx\n",
                         addr, inst_line_offset, cache_line_start, cache_line_start);
 
-        if (predecode_cache->contains(cache_line_start)) {
-            std::vector<uint8_t>* cached_bytes = predecode_cache->find(cache_line_start);
+        const size_t line_slot = predecode_cache->lookup(cache_line_start);
+
+        if (line_slot != VanadisCacheTags<uint64_t>::npos) {
+            const uint8_t* cached_bytes = &predecode_lines[line_slot * cache_line_width];
 
 				uint64_t bytes_from_this_line = std::min( static_cast<uint64_t>(buffer_req), cache_line_width - inst_line_offset );
 
 				output->verbose(CALL_INFO, 16, 0, "[fill-decode]: load %" PRIu64 " bytes from this line.\n", bytes_from_this_line);
 
             for (uint64_t i = 0; i < bytes_from_this_line; ++i) {
-                buffer[i] = cached_bytes->at(inst_line_offset + i);
+                buffer[i] = cached_bytes[inst_line_offset + i];
             }
 
 				if( bytes_from_this_line < buffer_req ) {
 					output->verbose(CALL_INFO, 16, 0, "[fill-decode]: requires split cache line load, first-line: %" PRIu64 " bytes\n", bytes_from_this_line);
 
-					if(predecode_cache->contains(cache_line_start + cache_line_width)) {
-						cached_bytes = predecode_cache->find(cache_line_start + cache_line_width);
+					const size_t next_line_slot = predecode_cache->lookup(cache_line_start + cache_line_width);
+
+					if(next_line_slot != VanadisCacheTags<uint64_t>::npos) {
+						cached_bytes = &predecode_lines[next_line_slot * cache_line_width];
 
 						output->verbose(CALL_INFO, 16, 0, "[fill-decode]: requires split cache line load, second-line: %" PRIu64 " bytes\n", (buffer_req - bytes_from_this_line));
 
 						for( uint64_t i = 0; i < (buffer_req - bytes_from_this_line); ++i ) {
-							buffer[bytes_from_this_line + i] = cached_bytes->at(i);
+							buffer[bytes_from_this_line + i] = cached_bytes[i];
 						}
 					} else {
 						output->verbose(CALL_INFO, 16, 0, "[fill-decode]: second line fill fails, line is not in predecode cache\n");
@@ -223,7 +233,7 @@ public:
 
 				if(predecode_cache->contains(line_start)) {
 					// line is already in the cache, touch to make sure it is kept in LRU
-					predecode_cache->touch(line_start);
+					predecode_cache->lookup(line_start);
 
 					output->verbose(CALL_INFO, 8, 0, "[ins-loader] ----> line (start-addr: 0x%llx) is already in pre-decode cache, updated LRU priority\n",
 						line_start);
@@ -293,7 +303,8 @@ private:
     SST::Interfaces::StandardMem* mem_if;
 
     VanadisCache<uint64_t, VanadisInstructionBundle*>* uop_cache;
-    VanadisCache<uint64_t, std::vector<uint8_t>*>* predecode_cache;
+    VanadisCacheTags<uint64_t>* predecode_cache;
+    std::vector<uint8_t> predecode_lines;
 
     std::unordered_map<SST::Interfaces::StandardMem::Request::id_t, SST::Interfaces::StandardMem::Read*> pending_loads;
 };